@@ -239,6 +239,8 @@ XrdConfig::XrdConfig()
    tlsNoVer   = false;
    tlsNoCAD   = true;
    NetTCPlep  = -1;
+   NetLSNnum  = 1;
+   NetLSNsteer= false;
    NetADM     = 0;
    coreV      = 1;
    Specs      = 0;
@@ -765,7 +767,9 @@ int XrdConfig::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError *eDest)
    TS_Xeq("adminpath",     xapath);
    TS_Xeq("allow",         xallow);
    TS_Xeq("homepath",      xhpath);
+   TS_Xeq("listeners",     xlsn);
    TS_Xeq("pidpath",       xpidf);
+   TS_Xeq("pollers",       xpoll);
    TS_Xeq("port",          xport);
    TS_Xeq("protocol",      xprot);
    TS_Xeq("report",        xrep);
@@ -787,6 +791,40 @@ int XrdConfig::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError *eDest)
 /******************************************************************************/
 /*                     P r i v a t e   F u n c t i o n s                      */
 /******************************************************************************/
+/******************************************************************************/
+/*                          A d d L i s t e n e r s                           */
+/******************************************************************************/
+
+int XrdConfig::AddListeners(XrdInet *netP, int opts, int blen)
+{
+   XrdInet *lsnP;
+   int i, numLsn = 1;
+
+// Bind additional listeners to the port of the one we already have. This
+// fails when the first socket came from systemd without SO_REUSEPORT, in
+// which case we simply run with fewer listeners.
+//
+   for (i = 1; i < NetLSNnum; i++)
+       {lsnP = new XrdInet(&Log, Police);
+        lsnP->setDefaults(opts, blen);
+        if (myDomain) lsnP->setDomain(myDomain);
+        if (lsnP->Bind(netP->Port(), "tcp"))
+           {Log.Say("Config warning: unable to add listeners on port ",
+                    std::to_string(netP->Port()).c_str());
+            delete lsnP;
+            break;
+           }
+        NetLSN.push_back(lsnP);
+        numLsn++;
+       }
+
+// Steer connections by cpu, if so wanted
+//
+   if (NetLSNsteer && numLsn > 1) netP->Steer(numLsn);
+   TRACE(NET, numLsn <<" listeners on port " <<netP->Port());
+   return 0;
+}
+
 /******************************************************************************/
 /*                               A S o c k e t                                */
 /******************************************************************************/
@@ -1265,6 +1303,7 @@ int XrdConfig::Setup(char *dfltp, char *libProt)
                 } else {
                  the_Opts = Net_Opts; the_Blen = Net_Blen;
                 }
+             if (NetLSNnum > 1 && cp->port) the_Opts |= XRDNET_REUSEPORT;
              if (the_Opts || the_Blen)
                 NetTCP[NetTCPlep]->setDefaults(the_Opts, the_Blen);
              if (myDomain) NetTCP[NetTCPlep]->setDomain(myDomain);
@@ -1278,12 +1317,18 @@ int XrdConfig::Setup(char *dfltp, char *libProt)
              if (!(cp->port)) arbNet = NetTCPlep;
              if (!NetTCPlep) XrdNetTCP = NetTCP[0];
              XrdOucEnv::Export("XRDPORT", ProtInfo.Port);
+             if (the_Opts & XRDNET_REUSEPORT
+             &&  AddListeners(NetTCP[NetTCPlep], the_Opts, the_Blen)) return 1;
             }
          if (!XrdProtLoad::Load(cp->libpath,cp->proname,cp->parms,
                                &ProtInfo, cp->dotls)) return 1;
          Firstcp = cp->Next; delete cp;
         }
 
+// Record the number of listeners for the statistics
+//
+   XrdInet::setListeners(NetTCPlep + 1 + static_cast<int>(NetLSN.size()));
+
 // Leave the env port number to be the first used port number. This may
 // or may not be the same as the default port number.
 //
@@ -1569,6 +1614,50 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
     return 0;
 }
 
+/******************************************************************************/
+/*                                  x l s n                                   */
+/******************************************************************************/
+
+/* Function: xlsn
+
+   Purpose:  To parse directive: listeners <num> [steer]
+
+             <num>    the number of SO_REUSEPORT listening sockets, each with
+                      its own accept thread, to open for each fixed port.
+                      The default is 1 (i.e. a single ordinary listener).
+             steer    have the kernel pick the listener by the cpu on which
+                      the connection arrived (Linux only).
+
+   Output: 0 upon success or 1 upon failure.
+*/
+
+int XrdConfig::xlsn(XrdSysError *eDest, XrdOucStream &Config)
+{
+    char *val;
+    int num;
+
+// Get the number of listeners
+//
+   if (!(val = Config.GetWord()) || !val[0])
+      {eDest->Emsg("Config", "listeners not specified"); return 1;}
+   if (XrdOuca2x::a2i(*eDest, "listeners", val, &num, 1, 256)) return 1;
+
+// Get the optional steer option
+//
+   NetLSNsteer = false;
+   if ((val = Config.GetWord()) && val[0])
+      {if (!strcmp(val, "steer")) NetLSNsteer = true;
+          else {eDest->Emsg("Config", "invalid listeners option -", val);
+                return 1;
+               }
+      }
+
+// Record the value
+//
+   NetLSNnum = num;
+   return 0;
+}
+
 /******************************************************************************/
 /*                                  x n e t                                   */
 /******************************************************************************/
@@ -1577,6 +1666,7 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
 
    Purpose:  To parse directive: network [tls] [[no]keepalive] [buffsz <blen>]
                                          [kaparms parms] [cache <ct>] [[no]dnr]
+                                         [cachefail <ft>] [dnrthreads <n>]
                                          [routes <rtype> [use <ifn1>,<ifn2>]]
                                          [[no]rpipa] [[no]dyndns]
 
@@ -1587,7 +1677,12 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
              kaparms   keepalive paramters as specfied by parms.
              <blen>    is the socket's send/rcv buffer size.
              <ct>      Seconds to cache address to name resolutions.
+             <ft>      Seconds to cache failed address to name resolutions.
              [no]dnr   do [not] perform a reverse DNS lookup if not needed.
+             <n>       Number of threads resolving names in the background. A
+                       connection whose name is not cached proceeds using its
+                       address. Zero (the default) resolves names inline, as
+                       is done whenever 1024 addresses are already waiting.
              routes    specifies the network configuration (see reference)
              [no]rpipa do [not] resolve private IP addresses.
              [no]dyndns This network does [not] use a dynamic DNS.
@@ -1599,7 +1694,7 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
 {
     char *val;
     int  i, n, V_keep = -1, V_nodnr = 0, V_istls = 0, V_blen = -1, V_ct = -1, V_assumev4;
-    int  v_rpip = -1, V_dyndns = -1;
+    int  v_rpip = -1, V_dyndns = -1, V_ft = -1, V_dnrt = -1;
     long long llp;
     struct netopts {const char *opname; int hasarg; int opval;
                            int *oploc;  const char *etxt;}
@@ -1611,8 +1706,10 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
         {"kaparms",    4, 0, &V_keep,   "option"},
         {"buffsz",     1, 0, &V_blen,   "network buffsz"},
         {"cache",      2, 0, &V_ct,     "cache time"},
+        {"cachefail",  2, 0, &V_ft,     "cache fail time"},
         {"dnr",        0, 0, &V_nodnr,  "option"},
         {"nodnr",      0, 1, &V_nodnr,  "option"},
+        {"dnrthreads", 5, 0, &V_dnrt,   "dnr thread count"},
         {"dyndns",     0, 1, &V_dyndns, "option"},
         {"nodyndns",   0, 0, &V_dyndns, "option"},
         {"routes",     3, 1, 0,         "routes"},
@@ -1663,6 +1760,10 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
                          {if (XrdOuca2x::a2tm(*eDest,ntopts[i].etxt,val,&n,0))
                              return 1;
                           *ntopts[i].oploc = n;
+                         } else if (ntopts[i].hasarg == 5)
+                         {if (XrdOuca2x::a2i(*eDest,ntopts[i].etxt,val,&n,0,64))
+                             return 1;
+                          *ntopts[i].oploc = n;
                          } else {
                           if (XrdOuca2x::a2sz(*eDest,ntopts[i].etxt,val,&llp,0))
                              return 1;
@@ -1693,7 +1794,8 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
         {if (V_dyndns && V_ct < 0) V_ct = 0;
          XrdNetAddr::SetDynDNS(V_dyndns != 0);
         }
-     if (V_ct >= 0) XrdNetAddr::SetCache(V_ct);
+     if (V_ct >= 0 || V_ft >= 0 || V_dnrt >= 0)
+        XrdNetAddr::SetCache(V_ct, V_ft, V_dnrt);
 
      if (v_rpip >= 0) XrdInet::netIF.SetRPIPA(v_rpip != 0);
      if (V_assumev4 >= 0) XrdInet::SetAssumeV4(true);
@@ -1777,6 +1879,76 @@ int XrdConfig::xpidf(XrdSysError *eDest, XrdOucStream &Config)
    return 0;
 }
   
+/******************************************************************************/
+/*                                 x p o l l                                  */
+/******************************************************************************/
+
+/* Function: xpoll
+
+   Purpose:  To parse directive: pollers {<num> | cores <n> | numa} [pin]
+                                         [inline <n>]
+
+             <num>    the number of poller threads. The default is 3.
+             cores    use one poller for every <n> cores we may run on.
+             numa     use one poller for each NUMA node.
+             pin      bind each poller and an equal share of the worker
+                      threads to the poller's cores or node.
+             inline   process up to <n> short requests per poll cycle on the
+                      poller thread instead of dispatching them. The default
+                      is 0 (i.e. always dispatch).
+
+   Output: 0 upon success or 1 upon failure.
+*/
+
+int XrdConfig::xpoll(XrdSysError *eDest, XrdOucStream &Config)
+{
+    XrdPoll::PollHow how = XrdPoll::pollNum;
+    char *val;
+    int num = 1, inl = 0;
+    bool pin = false;
+
+// Get the poller count or method
+//
+   if (!(val = Config.GetWord()) || !val[0])
+      {eDest->Emsg("Config", "pollers not specified"); return 1;}
+
+   if (!strcmp(val, "numa")) how = XrdPoll::pollNuma;
+      else if (!strcmp(val, "cores"))
+              {how = XrdPoll::pollCores;
+               if (!(val = Config.GetWord()) || !val[0])
+                  {eDest->Emsg("Config", "pollers cores value not specified");
+                   return 1;
+                  }
+               if (XrdOuca2x::a2i(*eDest, "pollers cores", val, &num, 1))
+                  return 1;
+              }
+      else if (XrdOuca2x::a2i(*eDest, "pollers", val, &num, 1, XRD_MAXPOLLERS))
+              return 1;
+
+// Get the optional pin and inline options
+//
+   while((val = Config.GetWord()) && val[0])
+        {if (!strcmp(val, "pin")) pin = true;
+            else if (!strcmp(val, "inline"))
+                    {if (!(val = Config.GetWord()) || !val[0])
+                        {eDest->Emsg("Config", "pollers inline value "
+                                               "not specified");
+                         return 1;
+                        }
+                     if (XrdOuca2x::a2i(*eDest, "pollers inline", val,
+                                        &inl, 0, 1024)) return 1;
+                    }
+            else {eDest->Emsg("Config", "invalid pollers option -", val);
+                  return 1;
+                 }
+        }
+
+// Record the values
+//
+   XrdPoll::setParms(how, num, pin, inl);
+   return 0;
+}
+
 /******************************************************************************/
 /*                                 x p o r t                                  */
 /******************************************************************************/
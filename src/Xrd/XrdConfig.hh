@@ -32,6 +32,8 @@
 #include "Xrd/XrdProtLoad.hh"
 #include "Xrd/XrdProtocol.hh"
 
+#include <vector>
+
 class XrdSysError;
 class XrdTcpMonInfo;
 class XrdNetSecurity;
@@ -53,10 +55,12 @@ int         ConfigXeq(char *var, XrdOucStream &Config, XrdSysError *eDest=0);
 XrdProtocol_Config  ProtInfo;
 XrdInet            *NetADM;
 XrdInet            *NetTCP[XrdProtLoad::ProtoMax+1];
+std::vector<XrdInet *> NetLSN;    // Additional SO_REUSEPORT listeners
 
 private:
 
 int   ASocket(const char *path, const char *fname, mode_t mode);
+int   AddListeners(XrdInet *netP, int opts, int blen);
 int   ConfigProc(void);
 int   getUG(char *parm, uid_t &theUid, gid_t &theGid);
 void  Manifest(const char *pidfn);
@@ -71,10 +75,12 @@ int   xallow(XrdSysError *edest, XrdOucStream &Config);
 int   xapath(XrdSysError *edest, XrdOucStream &Config);
 int   xhpath(XrdSysError *edest, XrdOucStream &Config);
 int   xbuf(XrdSysError *edest, XrdOucStream &Config);
+int   xlsn(XrdSysError *edest, XrdOucStream &Config);
 int   xnet(XrdSysError *edest, XrdOucStream &Config);
 int   xnkap(XrdSysError *edest, char *val);
 int   xlog(XrdSysError *edest, XrdOucStream &Config);
 int   xpidf(XrdSysError *edest, XrdOucStream &Config);
+int   xpoll(XrdSysError *edest, XrdOucStream &Config);
 int   xport(XrdSysError *edest, XrdOucStream &Config);
 int   xprot(XrdSysError *edest, XrdOucStream &Config);
 int   xrep(XrdSysError *edest, XrdOucStream &Config);
@@ -117,6 +123,8 @@ int                 PortTCP;      // TCP Port to listen on
 int                 PortUDP;      // UDP Port to listen on (currently unsupported)
 int                 PortTLS;      // TCP port to listen on for TLS connections
 int                 NetTCPlep;
+int                 NetLSNnum;    // Listeners per port
+bool                NetLSNsteer;  // Steer connections to listeners by cpu
 
 int                 AdminMode;
 int                 HomeMode;
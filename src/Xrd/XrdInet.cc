@@ -29,16 +29,26 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <netdb.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
 
 #ifdef HAVE_SYSTEMD
 #include <sys/socket.h>
 #include <systemd/sd-daemon.h>
 #endif
 
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysError.hh"
 
 #include "Xrd/XrdInet.hh"
@@ -65,6 +75,56 @@
 
        XrdNetIF    XrdInet::netIF;
 
+       int         XrdInet::numLsn  = 0;
+       int         XrdInet::accQMax = 0;
+       long long   XrdInet::numAcc  = 0;
+       long long   XrdInet::accWait = 0;
+       long long   XrdInet::accWMax = 0;
+       long long   XrdInet::ovfBase = 0;
+       long long   XrdInet::drpBase = 0;
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+XrdSysMutex accMutex;
+
+// Get the system wide listen queue overflows and drops (Linux only)
+//
+void lsnDrops(long long &ovf, long long &drp)
+{
+   char buff[8192], *hP, *vP, *hTok, *vTok, *hSave, *vSave;
+   int fd, rlen;
+
+   ovf = drp = 0;
+#if defined(__linux__)
+   if ((fd = open("/proc/net/netstat", O_RDONLY)) < 0) return;
+   rlen = read(fd, buff, sizeof(buff)-1);
+   close(fd);
+   if (rlen <= 0) return;
+   buff[rlen] = 0;
+
+// The file has a header line followed by a value line for each group
+//
+   if (!(hP = strstr(buff, "TcpExt:")) || !(vP = index(hP, '\n'))
+   ||  strncmp(vP+1, "TcpExt:", 7)) return;
+   *vP++ = 0;
+   if ((hSave = index(vP, '\n'))) *hSave = 0;
+
+   hTok = strtok_r(hP, " ", &hSave);
+   vTok = strtok_r(vP, " ", &vSave);
+   while(hTok && vTok)
+        {     if (!strcmp(hTok, "ListenOverflows")) ovf = atoll(vTok);
+         else if (!strcmp(hTok, "ListenDrops"))     drp = atoll(vTok);
+         hTok = strtok_r(0, " ", &hSave);
+         vTok = strtok_r(0, " ", &vSave);
+        }
+#endif
+}
+}
+
 /******************************************************************************/
 /*                                A c c e p t                                 */
 /******************************************************************************/
@@ -92,6 +152,7 @@ XrdLink *XrdInet::Accept(int opts, int timeout, XrdSysSemaphore *theSem)
 // will be doing a background check on this connection.
 //
    if (theSem) theSem->Post();
+   AcceptStats(myAddr.SockFD());
    if (!(netOpts & XRDNET_NORLKUP)) myAddr.Name();
 
 // Authorize by ip address or full (slow) hostname format. We defer the check
@@ -123,6 +184,40 @@ XrdLink *XrdInet::Accept(int opts, int timeout, XrdSysSemaphore *theSem)
    return lp;
 }
 
+/******************************************************************************/
+/* Private:                  A c c e p t S t a t s                            */
+/******************************************************************************/
+
+void XrdInet::AcceptStats(int sfd)
+{
+   int qlen = 0, wait = 0;
+
+#if defined(__linux__) && defined(TCP_INFO)
+   struct tcp_info tInfo;
+   socklen_t tLen;
+
+// The time since the client's last segment tells us how long the connection
+// sat in the accept queue. For a listening socket the kernel reports the
+// current accept queue length as the unacked count.
+//
+   tLen = sizeof(tInfo);
+   if (!getsockopt(sfd, IPPROTO_TCP, TCP_INFO, &tInfo, &tLen))
+      wait = static_cast<int>(tInfo.tcpi_last_ack_recv);
+   tLen = sizeof(tInfo);
+   if (!getsockopt(iofd, IPPROTO_TCP, TCP_INFO, &tInfo, &tLen))
+      qlen = static_cast<int>(tInfo.tcpi_unacked);
+#endif
+
+// Update the statistics
+//
+   accMutex.Lock();
+   numAcc++;
+   accWait += wait;
+   if (wait > accWMax) accWMax = wait;
+   if (qlen > accQMax) accQMax = qlen;
+   accMutex.UnLock();
+}
+
 /******************************************************************************/
 /*                                B i n d S D                                 */
 /******************************************************************************/
@@ -250,3 +345,72 @@ void XrdInet::Secure(XrdNetSecurity *secp)
    if (Patrol) Patrol->Merge(secp);
       else     Patrol = secp;
 }
+
+/******************************************************************************/
+/*                          s e t L i s t e n e r s                           */
+/******************************************************************************/
+
+void XrdInet::setListeners(int num)
+{
+   numLsn = num;
+   lsnDrops(ovfBase, drpBase);
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdInet::Stats(char *buff, int blen, int do_sync)
+{
+   static const char statfmt[] = "<stats id=\"lsn\"><num>%d</num>"
+   "<acc>%lld</acc><qmax>%d</qmax><wait>%lld</wait><wmax>%lld</wmax>"
+   "<ovf>%lld</ovf><drp>%lld</drp></stats>";
+   long long acc, wtot, wmax, ovf, drp;
+   int qmax;
+
+// Return number of bytes if so wanted
+//
+   if (!buff) return sizeof(statfmt) + (7*16);
+
+// Get the values. The average wait is reported in milliseconds. Queue
+// overflows and drops are system wide counts since we started.
+//
+   accMutex.Lock();
+   acc  = numAcc;
+   wtot = accWait;
+   wmax = accWMax;
+   qmax = accQMax;
+   accMutex.UnLock();
+   lsnDrops(ovf, drp);
+
+// Format and return
+//
+   return snprintf(buff, blen, statfmt, numLsn, acc, qmax,
+                   (acc ? wtot/acc : 0), wmax, ovf-ovfBase, drp-drpBase);
+}
+
+/******************************************************************************/
+/*                                 S t e e r                                  */
+/******************************************************************************/
+
+bool XrdInet::Steer(int nLsn)
+{
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+   struct sock_filter code[] =
+          {{BPF_LD  | BPF_W   | BPF_ABS, 0, 0, (__u32)(SKF_AD_OFF + SKF_AD_CPU)},
+           {BPF_ALU | BPF_MOD | BPF_K,   0, 0, (__u32)nLsn},
+           {BPF_RET | BPF_A,             0, 0, 0}
+          };
+   struct sock_fprog prog = {sizeof(code)/sizeof(code[0]), code};
+
+// The program returns the index of the listener in the group, which is the
+// order in which the listeners were bound.
+//
+   if (!setsockopt(iofd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+                   &prog, sizeof(prog))) return true;
+   eDest->Emsg("Steer", errno, "attach listener steering program");
+#else
+   eDest->Say("Config warning: listener steering is not supported.");
+#endif
+   return false;
+}
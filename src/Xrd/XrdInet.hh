@@ -56,6 +56,19 @@ XrdLink    *Connect(const char *host, int port, int opts=0, int timeout=-1);
 
 void        Secure(XrdNetSecurity *secp);
 
+// Record the number of listening sockets (used for statistics only)
+//
+static void setListeners(int num);
+
+// Steer() attaches a program to a SO_REUSEPORT group of listeners that picks
+// the listener by the cpu the connection arrived on (Linux only).
+//
+bool        Steer(int nLsn);
+
+// Stats() reports accept statistics for all listeners
+//
+static int  Stats(char *buff, int blen, int do_sync=0);
+
             XrdInet(XrdSysError *erp, XrdNetSecurity *secp=0)
                       : XrdNet(erp,0), Patrol(secp) {}
            ~XrdInet() {}
@@ -68,10 +81,19 @@ static
 XrdNetIF    netIF;
 
 private:
-int Listen();
+void AcceptStats(int sfd);
+int  Listen();
 
 XrdNetSecurity    *Patrol;
 static const char *TraceID;
 static  bool       AssumeV4;
+
+static  int        numLsn;     // Number of listening sockets
+static  int        accQMax;    // Longest accept queue seen
+static  long long  numAcc;     // Number of accepted connections
+static  long long  accWait;    // Total time connections waited (ms)
+static  long long  accWMax;    // Longest time a connection waited (ms)
+static  long long  ovfBase;    // System listen overflows at startup
+static  long long  drpBase;    // System listen drops at startup
 };
 #endif
@@ -310,6 +310,12 @@ bool XrdLink::Register(const char *hName)
    return linkXQ.Register(hName);
 }
   
+/******************************************************************************/
+/*                             R u n I n l i n e                              */
+/******************************************************************************/
+
+int XrdLink::RunInline() {return linkXQ.RunInline();}
+
 /******************************************************************************/
 /*                                  S e n d                                   */
 /******************************************************************************/
@@ -345,6 +351,18 @@ int XrdLink::Send(const sfVec *sfP, int sfN)
        return -1;
       }
 
+// If the vector only refers to memory, a gathered write does the job in a
+// single system call without corking the socket and without sendfile().
+//
+   struct iovec ioV[XrdOucSFVec::sfMax];
+   int i, bytes = 0;
+   for (i = 0; i < sfN && sfP[i].fdnum < 0; i++)
+       {ioV[i].iov_base = sfP[i].buffer;
+        ioV[i].iov_len  = sfP[i].sendsz;
+        bytes += sfP[i].sendsz;
+       }
+   if (i >= sfN) return Send(ioV, sfN, bytes);
+
 // Do the send
 //
    if (isTLS) return linkXQ.TLS_Send(sfP, sfN);
@@ -405,6 +423,12 @@ bool XrdLink::setNB() {return linkXQ.setNB();}
 void XrdLink::setLocation(XrdNetAddrInfo::LocInfo &loc)
                          {linkXQ.setLocation(loc);}
 
+/******************************************************************************/
+/*                             s e t I n l i n e                              */
+/******************************************************************************/
+
+void XrdLink::setInline(XrdProtocol *pp) {linkXQ.setInline(pp);}
+
 /******************************************************************************/
 /*                           s e t P r o t o c o l                            */
 /******************************************************************************/
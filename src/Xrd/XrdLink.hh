@@ -329,6 +329,19 @@ int             RecvAll(char *buff, int blen, int timeout=-1);
 
 bool        Register(const char *hName);
 
+//-----------------------------------------------------------------------------
+//! Process a single request on the calling (poller) thread provided the
+//! protocol says it can be done without blocking. The link is re-enabled
+//! afterwards.
+//!
+//! @return =0      the request was not processed; dispatch the link as usual.
+//!         >0      the request was processed and the link re-enabled.
+//!         <0      the request was processed but the link must be closed;
+//!                 it has been marked as such and must be dispatched.
+//-----------------------------------------------------------------------------
+
+int         RunInline();
+
 //-----------------------------------------------------------------------------
 //! Send data on a link. This calls may block unless the socket was marked
 //! nonblocking. If a block would occur, the data is copied for later sending.
@@ -371,7 +384,7 @@ static bool     sfOK;                   // True if Send(sfVec) enabled
 
 typedef XrdOucSFVec sfVec;
 
-int             Send(const sfVec *sdP, int sdn); // Iff sfOK is true
+int             Send(const sfVec *sdP, int sdn); // Iff sfOK or memory only
 
 //-----------------------------------------------------------------------------
 //! Wait for all outstanding requests to be completed on the link.
@@ -416,6 +429,15 @@ void            setLocation(XrdNetAddrInfo::LocInfo &loc);
 
 bool            setNB();
 
+//-----------------------------------------------------------------------------
+//! Allow RunInline() to ask a protocol whether it can run a request inline.
+//!
+//! @param  pp     pointer to the protocol object that implements Inline(). It
+//!                is only used while it is the link's current protocol.
+//-----------------------------------------------------------------------------
+
+void            setInline(XrdProtocol *pp);
+
 //-----------------------------------------------------------------------------
 //! Set the link's protocol.
 //!
@@ -131,6 +131,7 @@ void XrdLinkXeq::Reset()
    KeepFD   = false;
    Protocol = 0;
    ProtoAlt = 0;
+   ProtoInl = 0;
 
    LinkInfo.Reset();
    PollInfo.Zorch();
@@ -509,6 +510,40 @@ bool XrdLinkXeq::Register(const char *hName)
    return true;
 }
   
+/******************************************************************************/
+/*                             R u n I n l i n e                              */
+/******************************************************************************/
+
+int XrdLinkXeq::RunInline()
+{
+   char eBuff[256];
+   int rc;
+
+// Only run the protocol if it opted into inline processing and says the
+// request will not block. Unlike DoIt() we process exactly one request as we
+// are running on the poller thread.
+//
+   if (!Protocol || Protocol != ProtoInl || !Protocol->Inline(this)) return 0;
+   rc = Protocol->Process(this);
+
+// Re-enable the link or leave it disabled, as DoIt() would. Closing a link
+// can take a while so that is left to a worker: the link is marked as
+// terminating and the caller dispatches it.
+//
+   if (rc >= 0)
+      {if (!PollInfo.Poller || PollInfo.Poller->Enable(PollInfo)) return 1;
+       strlcpy(eBuff, "enable failed", sizeof(eBuff));
+      } else {
+       if (rc == -EINPROGRESS) return 1;
+       LinkInfo.opMutex.Lock();
+       strlcpy(eBuff, (LinkInfo.Etext ? LinkInfo.Etext : "request failed"),
+               sizeof(eBuff));
+       LinkInfo.opMutex.UnLock();
+      }
+   XrdPoll::Finish(PollInfo, eBuff);
+   return -1;
+}
+
 /******************************************************************************/
 /*                                  S e n d                                   */
 /******************************************************************************/
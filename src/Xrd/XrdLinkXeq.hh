@@ -96,6 +96,8 @@ int           RecvAll(char *buff, int blen, int timeout=-1);
 
 bool          Register(const char *hName);
 
+int           RunInline();
+
 int           Send(const char *buff, int blen);
 int           Send(const struct iovec *iov, int iocnt, int bytes=0);
 
@@ -107,6 +109,8 @@ void          setLocation(XrdNetAddrInfo::LocInfo &loc) {Addr.SetLocation(loc);}
 
 bool          setNB();
 
+void          setInline(XrdProtocol *pp) {ProtoInl = pp;}
+
 XrdProtocol  *setProtocol(XrdProtocol *pp, bool push);
 
 void          setProtName(const char *name);
@@ -178,6 +182,7 @@ static XrdSysMutex  statsMutex;
 //
 XrdProtocol   *Protocol;             // -> Protocol tied to the link
 XrdProtocol   *ProtoAlt;             // -> Alternate/stacked protocol
+XrdProtocol   *ProtoInl;             // -> Protocol that opted into Inline()
 
 // TLS section
 //
@@ -72,6 +72,7 @@ Where:
 #include "Xrd/XrdConfig.hh"
 #include "Xrd/XrdInet.hh"
 #include "Xrd/XrdLink.hh"
+#include "Xrd/XrdPoll.hh"
 #include "Xrd/XrdProtLoad.hh"
 #include "Xrd/XrdScheduler.hh"
 
@@ -92,6 +93,7 @@ XrdSysSemaphore  *theSem;
 XrdProtocol      *theProt;
 XrdInet          *theNet;
 int               thePort;
+int               lsnNum;
 static XrdConfig  Config;
 
 void              DoIt() {XrdLink *newlink;
@@ -100,9 +102,11 @@ void              DoIt() {XrdLink *newlink;
                          }
 
            XrdMain() : XrdJob("main accept"), theSem(0), theProt(0),
-                                              theNet(0), thePort(0) {}
-           XrdMain(XrdInet *nP) : XrdJob("main accept"), theSem(0),
-                                  theProt(0), theNet(nP), thePort(nP->Port()) {}
+                                              theNet(0), thePort(0),
+                                              lsnNum(-1) {}
+           XrdMain(XrdInet *nP, int lNum=-1)
+                     : XrdJob("main accept"), theSem(0), theProt(0),
+                       theNet(nP), thePort(nP->Port()), lsnNum(lNum) {}
           ~XrdMain() {}
 };
 
@@ -123,6 +127,11 @@ void *mainAccept(void *parg)
    Parms->theSem  = &accepted;
    Parms->theProt = (XrdProtocol *)&ProtSelect;
 
+// Additional listeners keep to the cpus of a poller when pollers are pinned
+// so that the accepts are scheduled on that poller's cpus.
+//
+   if (Parms->lsnNum >= 0) XrdPoll::PinWorker(Parms->lsnNum);
+
 // Simply schedule new accepts
 //
    while(1) {mySched->Schedule((XrdJob *)Parms);
@@ -206,6 +215,18 @@ int main(int argc, char *argv[])
               }
           }
 
+// Spawn a thread for each additional listener on a port
+//
+   for (i = 0; i < (int)Main.Config.NetLSN.size(); i++)
+       {XrdMain *Parms = new XrdMain(Main.Config.NetLSN[i], i+1);
+        sprintf(buff, "Port %d listener %d", Parms->thePort, i+1);
+        if ((retc = XrdSysThread::Run(&tid, mainAccept, (void *)Parms,
+                                      XRDSYSTHREAD_BIND, strdup(buff))))
+           {Main.Config.ProtInfo.eDest->Emsg("main", retc, "create", buff);
+            _exit(3);
+           }
+       }
+
 // Finally, start accepting connections on the main port
 //
    Main.theNet  = Main.Config.NetTCP[0];
@@ -27,9 +27,15 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <dirent.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
   
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
@@ -37,6 +43,7 @@
 #include "XrdSys/XrdSysPthread.hh"
 #include "Xrd/XrdLink.hh"
 #include "Xrd/XrdProtocol.hh"
+#include "Xrd/XrdScheduler.hh"
 
 #define  TRACE_IDENT pInfo.Link.ID
 #include "Xrd/XrdTrace.hh"
@@ -76,9 +83,16 @@ int           Stats(char *buff, int blen, int do_sync=0) {return 0;}
 /*                           G l o b a l   D a t a                            */
 /******************************************************************************/
   
-       XrdPoll   *XrdPoll::Pollers[XRD_NUMPOLLERS] = {0, 0, 0};
+       XrdPoll  **XrdPoll::Pollers    = 0;
+       int        XrdPoll::numPollers = XRD_NUMPOLLERS;
 
        XrdSysMutex  XrdPoll::doingAttach;
+       XrdSysMutex  XrdPoll::doingStats;
+
+       XrdPoll::PollHow XrdPoll::cfgHow = XrdPoll::pollNum;
+       int              XrdPoll::cfgNum = XRD_NUMPOLLERS;
+       bool             XrdPoll::cfgPin = false;
+       int              XrdPoll::inlMax = 0;
 
        const char *XrdPoll::TraceID = "Poll";
 
@@ -90,6 +104,13 @@ extern XrdScheduler Sched;
 
 using namespace XrdGlobal;
 
+namespace
+{
+#if defined(__linux__)
+cpu_set_t *pollCPU = 0;  // The cpus of each poller (pin mode only)
+#endif
+}
+
 /******************************************************************************/
 /*              T h r e a d   S t a r t u p   I n t e r f a c e               */
 /******************************************************************************/
@@ -121,6 +142,9 @@ XrdPoll::XrdPoll()
 
    TID=0;
    numAttached=numEnabled=numEvents=numInterrupts=0;
+   numInline=numDispatch=0;
+   statEvents=statRate=0;
+   statTime=time(0);
 
    if (XrdSysFD_Pipe(fildes) == 0)
       {CmdFD = fildes[1];
@@ -153,9 +177,24 @@ int XrdPoll::Attach(XrdPollInfo &pInfo)
 // Find a poller with the smallest number of entries
 //
    pp = Pollers[0];
-   for (i = 1; i < XRD_NUMPOLLERS; i++)
+   for (i = 1; i < numPollers; i++)
        if (pp->numAttached > Pollers[i]->numAttached) pp = Pollers[i];
 
+// When pollers are pinned prefer the poller on our cpu, as the link was
+// accepted there, unless it carries noticeably more links.
+//
+#if defined(__linux__)
+   int cpu;
+   if (pollCPU && (cpu = sched_getcpu()) >= 0)
+      for (i = 0; i < numPollers; i++)
+          if (CPU_ISSET(cpu, &pollCPU[i]))
+             {if (Pollers[i]->numAttached <= pp->numAttached
+                                           + pp->numAttached/8 + 16)
+                 pp = Pollers[i];
+              break;
+             }
+#endif
+
 // Include this FD into the poll set of the poller
 //
    if (!pp->Include(pInfo)) {doingAttach.UnLock(); return 0;}
@@ -265,6 +304,21 @@ int XrdPoll::getRequest()
    return 0;
 }
 
+/******************************************************************************/
+/*                             P i n W o r k e r                              */
+/******************************************************************************/
+
+void XrdPoll::PinWorker(int wNum)
+{
+#if defined(__linux__)
+// Workers are dealt out round robin to the pollers and bound to its cpus
+//
+   if (pollCPU)
+      pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t),
+                             &pollCPU[wNum % numPollers]);
+#endif
+}
+
 /******************************************************************************/
 /*                             P o l l 2 T e x t                              */
 /******************************************************************************/
@@ -284,6 +338,18 @@ char *XrdPoll::Poll2Text(short events)
   return (char *)0;
 }
 
+/******************************************************************************/
+/*                              s e t P a r m s                               */
+/******************************************************************************/
+
+void XrdPoll::setParms(PollHow how, int num, bool pin, int inl)
+{
+   cfgHow = how;
+   cfgNum = num;
+   cfgPin = pin;
+   inlMax = inl;
+}
+
 /******************************************************************************/
 /*                                 S e t u p                                  */
 /******************************************************************************/
@@ -294,13 +360,18 @@ int XrdPoll::Setup(int numfd)
    int maxfd, retc, i;
    struct XrdPollArg PArg;
 
+// Determine how many pollers we will have and, when pinning, their cpus
+//
+   numPollers = setCPUs();
+   Pollers = new XrdPoll *[numPollers];
+
 // Calculate the number of table entries per poller
 //
-   maxfd  = (numfd / XRD_NUMPOLLERS) + 16;
+   maxfd  = (numfd / numPollers) + 16;
 
 // Verify that we initialized the poller table
 //
-   for (i = 0; i < XRD_NUMPOLLERS; i++)
+   for (i = 0; i < numPollers; i++)
        {if (!(Pollers[i] = newPoller(i, maxfd))) return 0;
         Pollers[i]->PID = i;
 
@@ -313,6 +384,11 @@ int XrdPoll::Setup(int numfd)
                                       XRDSYSTHREAD_BIND, "Poller")))
            {Log.Emsg("Poll", retc, "create poller thread"); return 0;}
         Pollers[i]->TID = tid;
+#if defined(__linux__)
+        if (pollCPU && (retc = pthread_setaffinity_np(tid, sizeof(cpu_set_t),
+                                                     &pollCPU[i])))
+           Log.Emsg("Poll", retc, "pin poller thread");
+#endif
         PArg.PollSync.Wait();
         if (PArg.retcode)
            {Log.Emsg("Poll", PArg.retcode, "start poller");
@@ -320,6 +396,13 @@ int XrdPoll::Setup(int numfd)
            }
        }
 
+// When pinning, have workers bind themselves to the cpus of a poller. Memory
+// that a worker touches first (e.g. I/O buffers) is then node local as well.
+//
+#if defined(__linux__)
+   if (pollCPU) Sched.setWorkerInit(PinWorker);
+#endif
+
 // All done
 //
    return 1;
@@ -332,31 +415,187 @@ int XrdPoll::Setup(int numfd)
 int XrdPoll::Stats(char *buff, int blen, int do_sync)
 {
    static const char statfmt[] = "<stats id=\"poll\"><att>%d</att>"
-   "<en>%d</en><ev>%d</ev><int>%d</int></stats>";
-   int i, numatt = 0, numen = 0, numev = 0, numint = 0;
+   "<en>%d</en><ev>%d</ev><int>%d</int><inl>%d</inl><dsp>%d</dsp>"
+   "<np>%d</np>";
+   static const char pollfmt[] = "<poller id=\"%d\"><att>%d</att>"
+   "<ev>%d</ev><evr>%d</evr><inl>%d</inl><dsp>%d</dsp></poller>";
+   static const char statend[] = "</stats>";
+   int i, k, bnum, numatt = 0, numen = 0, numev = 0, numint = 0;
+   int numinl = 0, numdsp = 0;
+   time_t tNow;
    XrdPoll *pp;
 
 // Return number of bytes if so wanted
 //
-   if (!buff) return (sizeof(statfmt)+(4*16))*XRD_NUMPOLLERS;
+   if (!buff) return sizeof(statfmt)+(7*16)
+                  + (sizeof(pollfmt)+(6*16))*numPollers + sizeof(statend);
 
 // Get statistics. While we wish we could honor do_sync, doing so would be
 // costly and hardly worth it. So, we do not include code such as:
 //    x = pp->y; if (do_sync) while(x != pp->y) x = pp->y; tot += x;
 //
-   for (i = 0; i < XRD_NUMPOLLERS; i++)
+   for (i = 0; i < numPollers; i++)
        {pp = Pollers[i];
         numatt += pp->numAttached; 
         numen  += pp->numEnabled;
         numev  += pp->numEvents;
         numint += pp->numInterrupts;
+        numinl += pp->numInline;
+        numdsp += pp->numDispatch;
        }
 
-// Format and return
+// Format the totals
+//
+   bnum = snprintf(buff, blen, statfmt, numatt, numen, numev, numint,
+                   numinl, numdsp, numPollers);
+   if (bnum >= blen) return blen;
+
+// Add each poller. The event rate is taken over the interval since the last
+// sample, which is never shorter than a second.
 //
-   return snprintf(buff, blen, statfmt, numatt, numen, numev, numint);
+   doingStats.Lock();
+   tNow = time(0);
+   for (i = 0; i < numPollers; i++)
+       {pp = Pollers[i];
+        numev = pp->numEvents;
+        if (tNow > pp->statTime)
+           {pp->statRate   = (numev - pp->statEvents) / (tNow - pp->statTime);
+            pp->statEvents = numev;
+            pp->statTime   = tNow;
+           }
+        k = snprintf(buff+bnum, blen-bnum, pollfmt, i, pp->numAttached,
+                     numev, pp->statRate, pp->numInline, pp->numDispatch);
+        if ((bnum += k) >= blen) {doingStats.UnLock(); return blen;}
+       }
+   doingStats.UnLock();
+
+// Finish up
+//
+   k = snprintf(buff+bnum, blen-bnum, statend);
+   return bnum + k;
 }
   
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                               s e t C P U s                                */
+/******************************************************************************/
+
+namespace
+{
+#if defined(__linux__)
+// Parse a sysfs cpu list (e.g. "0-3,8-11") into a cpu set
+//
+bool cpuList(const char *path, cpu_set_t &cset)
+{
+   char buff[4096], *bP, *eP;
+   int fd, rlen, bcpu, ecpu;
+
+   CPU_ZERO(&cset);
+   if ((fd = open(path, O_RDONLY)) < 0) return false;
+   rlen = read(fd, buff, sizeof(buff)-1);
+   close(fd);
+   if (rlen <= 0) return false;
+   buff[rlen] = 0;
+
+   bP = buff;
+   while(*bP >= '0' && *bP <= '9')
+        {bcpu = ecpu = strtol(bP, &eP, 10);
+         if (*eP == '-') ecpu = strtol(eP+1, &eP, 10);
+         for (; bcpu <= ecpu && bcpu < CPU_SETSIZE; bcpu++) CPU_SET(bcpu, &cset);
+         if (*eP != ',') break;
+         bP = eP+1;
+        }
+   return CPU_COUNT(&cset) > 0;
+}
+#endif
+}
+
+int XrdPoll::setCPUs()
+{
+   char buff[80];
+   int n = cfgNum;
+
+#if defined(__linux__)
+   cpu_set_t allCPU, nodeCPU, *grpCPU;
+   int cpus[CPU_SETSIZE], ncpu = 0, ngrp = 0, i;
+
+// Get the list of cpus we may run on
+//
+   if (!sched_getaffinity(0, sizeof(allCPU), &allCPU))
+      for (i = 0; i < CPU_SETSIZE; i++)
+          if (CPU_ISSET(i, &allCPU)) cpus[ncpu++] = i;
+   if (!ncpu)
+      {if (cfgHow != pollNum) n = XRD_NUMPOLLERS;
+       cfgPin = false;
+       return (n > XRD_MAXPOLLERS ? XRD_MAXPOLLERS : n);
+      }
+   grpCPU = new cpu_set_t[XRD_MAXPOLLERS];
+
+// Carve up the cpus as requested
+//
+   switch(cfgHow)
+         {case pollNuma:
+               {DIR *dP = opendir("/sys/devices/system/node");
+                struct dirent *dent;
+                char path[320];
+                if (dP)
+                   {while(ngrp < XRD_MAXPOLLERS && (dent = readdir(dP)))
+                         {if (strncmp(dent->d_name, "node", 4)
+                          ||  dent->d_name[4] < '0' || dent->d_name[4] > '9')
+                             continue;
+                          snprintf(path, sizeof(path), "/sys/devices/system/"
+                                   "node/%s/cpulist", dent->d_name);
+                          if (!cpuList(path, nodeCPU)) continue;
+                          CPU_AND(&grpCPU[ngrp], &nodeCPU, &allCPU);
+                          if (CPU_COUNT(&grpCPU[ngrp])) ngrp++;
+                         }
+                    closedir(dP);
+                   }
+                if (!ngrp) {grpCPU[0] = allCPU; ngrp = 1;}
+               }
+               break;
+          case pollCores:
+               for (i = 0; i < ncpu; i++)
+                   {if (i % cfgNum == 0)
+                       {if (ngrp >= XRD_MAXPOLLERS) break;
+                        CPU_ZERO(&grpCPU[ngrp]); ngrp++;
+                       }
+                    CPU_SET(cpus[i], &grpCPU[ngrp-1]);
+                   }
+               break;
+          default:
+               ngrp = (cfgNum > XRD_MAXPOLLERS ? XRD_MAXPOLLERS : cfgNum);
+               for (i = 0; i < ngrp; i++) CPU_ZERO(&grpCPU[i]);
+               if (ngrp <= ncpu)
+                  for (i = 0; i < ncpu; i++)
+                      CPU_SET(cpus[i], &grpCPU[i*ngrp/ncpu]);
+                  else for (i = 0; i < ngrp; i++)
+                           CPU_SET(cpus[i % ncpu], &grpCPU[i]);
+               break;
+         }
+
+// Keep the cpu sets only if we will be pinning threads
+//
+   if (cfgPin) pollCPU = grpCPU;
+      else delete [] grpCPU;
+   n = ngrp;
+#else
+   cfgPin = false;
+   if (cfgHow == pollCores)
+      {long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+       n = (ncpu > 0 ? (static_cast<int>(ncpu) + cfgNum - 1) / cfgNum : 1);
+      } else if (cfgHow == pollNuma) n = 1;
+   if (n > XRD_MAXPOLLERS) n = XRD_MAXPOLLERS;
+#endif
+
+   snprintf(buff, sizeof(buff), "%d pollers%s", n,
+            (cfgPin ? " pinned to their cpus." : "."));
+   Log.Say("Config using ", buff);
+   return n;
+}
+
 /******************************************************************************/
 /*              I m p l e m e n t a t i o n   S p e c i f i c s               */
 /******************************************************************************/
@@ -30,9 +30,11 @@
 /******************************************************************************/
 
 #include <sys/poll.h>
+#include <time.h>
 #include "XrdSys/XrdSysPthread.hh"
 
 #define XRD_NUMPOLLERS 3
+#define XRD_MAXPOLLERS 256
 
 class XrdPollInfo;
 class XrdSysSemaphore;
@@ -65,6 +67,17 @@ static  int   Finish(XrdPollInfo &pInfo, const char *etxt=0); //Implementation s
 //
 static  char *Poll2Text(short events); // Implementation supplied
 
+// PinWorker() is called by each worker thread to bind itself to the cpus of
+//             the poller the worker was assigned to (pin mode only).
+//
+static  void  PinWorker(int wNum);     // Implementation supplied
+
+// setParms() is called at config time to establish the number of pollers
+//
+enum    PollHow {pollNum = 0, pollCores, pollNuma};
+
+static  void  setParms(PollHow how, int num, bool pin, int inl=0);
+
 // Setup() is called at config time to perform poller configuration
 //
 static  int   Setup(int numfd);        // Implementation supplied
@@ -84,7 +97,8 @@ static  int   Stats(char *buff, int blen, int do_sync=0);
 
 // The following table reference the pollers in effect
 //
-static     XrdPoll   *Pollers[XRD_NUMPOLLERS];
+static     XrdPoll  **Pollers;
+static     int        numPollers;
 
            XrdPoll();
 virtual   ~XrdPoll() {}
@@ -132,10 +146,26 @@ int           PipeBlen;
            int         numEnabled;     // Count of Enable() calls
            int         numEvents;      // Count of poll fd's dispatched
            int         numInterrupts;  // Number of interrupts (e.g., signals)
+           int         numInline;      // Requests processed on the poller
+           int         numDispatch;    // Links handed to the scheduler
+
+// Maximum number of requests processed inline per poll cycle (0 -> none)
+//
+static     int         inlMax;
 
 private:
 
+static     int          setCPUs();
+
 static     XrdSysMutex  doingAttach;
+static     XrdSysMutex  doingStats;
+static     PollHow      cfgHow;
+static     int          cfgNum;
+static     bool         cfgPin;
+
            int          numAttached;    // Number of fd's attached to poller
+           int          statEvents;     // Stats: numEvents at last sample
+           int          statRate;       // Stats: events/second at last sample
+           time_t       statTime;       // Stats: time of last sample
 };
 #endif
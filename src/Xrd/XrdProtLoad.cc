@@ -44,6 +44,7 @@ XrdProtocol *XrdProtLoad::Protocol[ProtoMax] = {0};
 char        *XrdProtLoad::ProtName[ProtoMax] = {0};
 int          XrdProtLoad::ProtPort[ProtoMax] = {0};
 bool         XrdProtLoad::ProtoTLS[ProtoMax] = {false};
+bool         XrdProtLoad::ProtoInl[ProtoMax] = {false};
 
 int          XrdProtLoad::ProtoCnt = 0;
 
@@ -116,9 +117,13 @@ int XrdProtLoad::Load(const char *lname, const char *pname,
        return 0;
       }
 
-// Obtain an instance of this protocol
+// Obtain an instance of this protocol. The protocol indicates that it
+// implements Inline() by setting inlOK, which only applies to this protocol.
 //
+   pi->xrdFlags &= ~XrdProtocol_Config::inlOK;
    xp = getProtocol(lname, pname, parms, pi);
+   ProtoInl[ProtoCnt] = (pi->xrdFlags & XrdProtocol_Config::inlOK) != 0;
+   pi->xrdFlags &= ~XrdProtocol_Config::inlOK;
    if (!xp) {Log.Emsg("Protocol","Protocol", pname, "could not be loaded");
              return 0;
             }
@@ -190,6 +195,7 @@ int XrdProtLoad::Process(XrdLink *lp)
 //
    lp->setProtocol(pp);
    lp->setProtName(ProtName[i]);
+   if (ProtoInl[i]) lp->setInline(pp);
 
 // Trace this load if so wanted
 //
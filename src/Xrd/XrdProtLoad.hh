@@ -71,6 +71,7 @@ static char          *ProtName[ProtoMax];   // ->Supported protocol names
 static XrdProtocol   *Protocol[ProtoMax];   // ->Supported protocol objects
 static int            ProtPort[ProtoMax];   // ->Supported protocol ports
 static bool           ProtoTLS[ProtoMax];   // ->Supported protocol objects TLS
+static bool           ProtoInl[ProtoMax];   // ->Supported protocol runs inline
 static int            ProtoCnt;             // Number in table (at least 1)
 
        int            myPort;
@@ -77,6 +77,7 @@ const char      *AdmPath;      // Admin path
 int              AdmMode;      // Admin path mode
 int              xrdFlags;
 static const int admPSet    = 0x00000001;  // The adminppath was set via cli
+static const int inlOK      = 0x00000002;  // Protocol implements Inline()
 
 const char      *myInst;       // Instance name
 const char      *myName;       // Host name
@@ -153,6 +154,16 @@ virtual void          Recycle(XrdLink *lp=0,int consec=0,const char *reason=0)=0
 //
 virtual int           Stats(char *buff, int blen, int do_sync=0) = 0;
 
+// Inline()    is invoked by a poller, when inline processing is enabled, to
+//             ask whether the request waiting on the link can be processed
+//             right away on the poller thread. It may only return true if
+//             the whole request is present and processing it never blocks.
+//             The default is to always dispatch the link to a worker thread.
+//             It is only invoked for protocols that set inlOK in xrdFlags of
+//             the XrdProtocol_Config object passed to XrdgetProtocol().
+//
+virtual bool          Inline(XrdLink *lp) {return false;}
+
             XrdProtocol(const char *jname): XrdJob(jname) {}
 virtual    ~XrdProtocol() {}
 };
@@ -29,6 +29,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sched.h>
 #include <signal.h>
 #include <stdio.h>
 #include <sys/resource.h>
@@ -41,6 +42,7 @@
 
 #include "Xrd/XrdJob.hh"
 #include "Xrd/XrdScheduler.hh"
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysLogger.hh"
 
@@ -66,6 +68,55 @@ class XrdSchedulerPID
                         {next = prev; pid = newpid;}
      ~XrdSchedulerPID() {}
      };
+
+// Each worker waits on its own semaphore so that a wakeup is always directed
+// at exactly one parked worker.
+//
+class XrdSchedulerWorker
+     {public:
+      XrdSchedulerWorker *next;
+      XrdSysSemaphore     wakeUp;
+      int                 qNum;   // Queue we are parked on
+      bool                isIdle; // Protected by that queue's lock
+
+      XrdSchedulerWorker() : next(0), wakeUp(0, "sched work"),
+                             qNum(0), isIdle(false) {}
+     ~XrdSchedulerWorker() {}
+     };
+
+// Pending work is kept in one queue per cpu. Jobs are queued on the queue of
+// the cpu the caller runs on and idle workers park themselves on the queue of
+// the cpu they last ran on. A worker first takes work from its own queue and
+// only then steals from the others.
+//
+class XrdSchedulerQueue
+     {public:
+      XrdSysMutex         qMutex;
+      XrdJob             *First;  // Pending work
+      XrdJob             *Last;
+      XrdSchedulerWorker *Idle;   // Workers parked on this queue
+      int                 numInQ; // Jobs in this queue
+      char                qPad[64];
+
+      XrdSchedulerQueue() : First(0), Last(0), Idle(0), numInQ(0) {}
+     ~XrdSchedulerQueue() {}
+     };
+
+// The work queues and the worker setup are kept outside of the scheduler so
+// that its layout stays as it was.
+//
+class XrdSchedulerWorkQ
+     {public:
+      static const int   maxQ = 64;
+      XrdSchedulerQueue *Q;
+      int                numQ;
+      int                wkrSeq;
+      void             (*wkrInit)(int wNum);
+
+      XrdSchedulerWorkQ(int n) : Q(new XrdSchedulerQueue[n]), numQ(n),
+                                 wkrSeq(0), wkrInit(0) {}
+     ~XrdSchedulerWorkQ() {delete [] Q;}
+     };
   
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
@@ -236,15 +287,17 @@ void XrdScheduler::DoIt()
 // Now check if there are too many idle threads (kill them if there are)
 //
    if (!num_JobsinQ)
-      {DispatchMutex.Lock(); num_idle = idl_Workers; DispatchMutex.UnLock();
+      {AtomicBeg(DispatchMutex);
+       num_idle = AtomicGet(idl_Workers);
+       AtomicEnd(DispatchMutex);
        num_kill = num_idle - min_Workers;
        TRACE(SCHED, num_Workers <<" threads; " <<num_idle <<" idle");
        if (num_kill > 0)
           {if (num_kill > 1) num_kill = num_kill/2;
            SchedMutex.Lock();
            num_Layoffs = num_kill;
-           while(num_kill--) WorkAvail.Post();
            SchedMutex.UnLock();
+           while(num_kill-- && WakeOne(0)) {}
           }
       }
 
@@ -345,37 +398,52 @@ void *XrdScheduler::Reaper()
   
 void XrdScheduler::Run()
 {
-   int waiting;
+   XrdSchedulerWorker me;
    XrdJob *jp;
+   int qNum, waiting, wNum = -1;
 
 // Wait for work then do it (an endless task for a worker thread)
 //
-   do {do {DispatchMutex.Lock();          idl_Workers++;DispatchMutex.UnLock();
-           WorkAvail.Wait();
-           DispatchMutex.Lock();waiting = --idl_Workers;DispatchMutex.UnLock();
-           SchedMutex.Lock();
-           if ((jp = WorkFirst))
-              {if (!(WorkFirst = jp->NextJob)) WorkLast = 0;
-               if (num_JobsinQ) num_JobsinQ--;
-                  else XrdLog->Emsg("Scheduler","Job queue count underflow!");
+   do {if (WorkQs->wkrInit && wNum < 0)
+          {AtomicBeg(DispatchMutex);
+           wNum = AtomicInc(WorkQs->wkrSeq);
+           AtomicEnd(DispatchMutex);
+           WorkQs->wkrInit(wNum);
+          }
+       qNum = myQueue();
+       if (!(jp = getJob(qNum)))
+          {XrdSchedulerQueue &wq = WorkQs->Q[qNum];
+
+        // Park ourselves on the queue of the cpu we are running on. We must
+        // look for work once more afterwards as a job may have been queued
+        // after we looked but before we could be seen as idle.
+        //
+           wq.qMutex.Lock();
+           me.next = wq.Idle; wq.Idle = &me;
+           me.qNum = qNum;    me.isIdle = true;
+           AtomicBeg(DispatchMutex);
+           AtomicInc(idl_Workers);
+           AtomicEnd(DispatchMutex);
+           wq.qMutex.UnLock();
+
+        // If we found work we must unpark. Should someone have beaten us to
+        // it, their wakeup is consumed and passed on to another idle worker.
+        //
+           if ((jp = getJob(qNum)))
+              {if (!Unpark(me)) {me.wakeUp.Wait(); WakeOne(qNum);}
               } else {
-               num_JobsinQ = 0;
-               if (num_Layoffs > 0)
-                  {num_Layoffs--;
-                   if (waiting)
-                      {num_TDestroy++; num_Workers--;
-                       TRACE(SCHED, "terminating thread; workers=" <<num_Workers);
-                       SchedMutex.UnLock();
-                       return;
-                      }
-                  }
+               me.wakeUp.Wait();
+               if (!(jp = getJob(myQueue())) && Layoff()) return;
               }
-           SchedMutex.UnLock();
-          } while(!jp);
+           if (!jp) continue;
+          }
 
     // Check if we should hire a new worker (we always want 1 idle thread)
     // before running this job.
     //
+       AtomicBeg(DispatchMutex);
+       waiting = AtomicGet(idl_Workers);
+       AtomicEnd(DispatchMutex);
        if (!waiting) hireWorker();
        if (TRACING(TRACE_SCHED) && *(jp->Comment) != '.')
           {TRACE(SCHED, "running " <<jp->Comment <<" inq=" <<num_JobsinQ);}
@@ -389,66 +457,79 @@ void XrdScheduler::Run()
   
 void XrdScheduler::Schedule(XrdJob *jp)
 {
-// Lock down our data area
-//
-   SchedMutex.Lock();
+   XrdSchedulerWorker *wP;
+   int qNum = myQueue(), inQ;
+   XrdSchedulerQueue &wq = WorkQs->Q[qNum];
 
-// Place the request on the queue and broadcast it
+// Place the request on the queue of the cpu we are running on and take one
+// of the workers parked on it, if any.
 //
    jp->NextJob  = 0;
-   if (WorkFirst)
-      {WorkLast->NextJob = jp;
-       WorkLast = jp;
+   wq.qMutex.Lock();
+   if (wq.Last)
+      {wq.Last->NextJob = jp;
+       wq.Last = jp;
       } else {
-       WorkFirst = jp;
-       WorkLast  = jp;
+       wq.First = jp;
+       wq.Last  = jp;
+      }
+   wq.numInQ++;
+   if ((wP = wq.Idle))
+      {wq.Idle = wP->next;
+       wP->isIdle = false;
+       AtomicBeg(DispatchMutex);
+       AtomicDec(idl_Workers);
+       AtomicEnd(DispatchMutex);
       }
-   WorkAvail.Post();
+   wq.qMutex.UnLock();
 
-// Calculate statistics
+// Calculate statistics (the maximum is approximate)
 //
-   num_Jobs++;
-   num_JobsinQ++;
-   if (num_JobsinQ > max_QLength) max_QLength = num_JobsinQ;
+   AtomicBeg(DispatchMutex);
+   AtomicInc(num_Jobs);
+   inQ = AtomicInc(num_JobsinQ) + 1;
+   AtomicEnd(DispatchMutex);
+   if (inQ > max_QLength) max_QLength = inQ;
 
-// Unlock the data area and return
+// Wake up the local worker or, failing that, at most one worker elsewhere
 //
-   SchedMutex.UnLock();
+   if (wP) wP->wakeUp.Post();
+      else WakeOne(qNum);
 }
 
 /******************************************************************************/
   
 void XrdScheduler::Schedule(int numjobs, XrdJob *jfirst, XrdJob *jlast)
 {
+   int qNum = myQueue(), inQ;
+   XrdSchedulerQueue &wq = WorkQs->Q[qNum];
 
-// Lock down our data area
-//
-   SchedMutex.Lock();
-
-// Place the request list on the queue
+// Place the request list on the local queue
 //
    jlast->NextJob = 0;
-   if (WorkFirst)
-      {WorkLast->NextJob = jfirst;
-       WorkLast = jlast;
+   wq.qMutex.Lock();
+   if (wq.Last)
+      {wq.Last->NextJob = jfirst;
+       wq.Last = jlast;
       } else {
-       WorkFirst = jfirst;
-       WorkLast  = jlast;
+       wq.First = jfirst;
+       wq.Last  = jlast;
       }
+   wq.numInQ += numjobs;
+   wq.qMutex.UnLock();
 
 // Calculate statistics
 //
-   num_Jobs    += numjobs;
-   num_JobsinQ += numjobs;
-   if (num_JobsinQ > max_QLength) max_QLength = num_JobsinQ;
+   AtomicBeg(DispatchMutex);
+   AtomicAdd(num_Jobs, numjobs);
+   AtomicFAdd(inQ, num_JobsinQ, numjobs);
+   AtomicEnd(DispatchMutex);
+   inQ += numjobs;
+   if (inQ > max_QLength) max_QLength = inQ;
 
-// Indicate number of jobs to work on
+// Wake up as many idle workers as we have jobs, local ones first
 //
-   while(numjobs--) WorkAvail.Post();
-
-// Unlock the data area and return
-//
-   SchedMutex.UnLock();
+   while(numjobs-- && WakeOne(qNum)) {}
 }
 
 /******************************************************************************/
@@ -530,6 +611,15 @@ void XrdScheduler::setParms(int minw, int maxw, int avlw, int maxi, int once)
    TRACE(SCHED,"Set stk_Workers=" <<stk_Workers <<" max_Workidl=" <<max_Workidl);
 }
 
+/******************************************************************************/
+/*                         s e t W o r k e r I n i t                          */
+/******************************************************************************/
+
+void XrdScheduler::setWorkerInit(void (*initFunc)(int wNum))
+{
+   WorkQs->wkrInit = initFunc;
+}
+
 /******************************************************************************/
 /*                                 S t a r t                                  */
 /******************************************************************************/
@@ -631,6 +721,37 @@ void XrdScheduler::TimeSched()
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
+/******************************************************************************/
+/*                                g e t J o b                                 */
+/******************************************************************************/
+
+XrdJob *XrdScheduler::getJob(int qNum)
+{
+   XrdJob *jp;
+   int i;
+
+// Take the oldest job from the given queue or, if it has none, steal the
+// oldest job from another queue. Empty queues are skipped without locking;
+// the count is rechecked under the lock.
+//
+   for (i = 0; i < WorkQs->numQ; i++)
+       {XrdSchedulerQueue &wq = WorkQs->Q[(qNum+i) % WorkQs->numQ];
+        if (!wq.numInQ) continue;
+        wq.qMutex.Lock();
+        if ((jp = wq.First))
+           {if (!(wq.First = jp->NextJob)) wq.Last = 0;
+            wq.numInQ--;
+            wq.qMutex.UnLock();
+            AtomicBeg(DispatchMutex);
+            AtomicDec(num_JobsinQ);
+            AtomicEnd(DispatchMutex);
+            return jp;
+           }
+        wq.qMutex.UnLock();
+       }
+   return 0;
+}
+
 /******************************************************************************/
 /*                           h i r e   W o r k e r                            */
 /******************************************************************************/
@@ -693,7 +814,59 @@ void XrdScheduler::Init(int minw, int maxw, int maxi)
    num_Layoffs =  0;
    num_Limited =  0;
    firstPID    =  0;
-   WorkFirst = WorkLast = TimerQueue = 0;
+   TimerQueue  =  0;
+   WorkLast    =  0;
+
+// Allocate one work queue per cpu
+//
+   long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+   if (ncpu < 1) ncpu = 1;
+      else if (ncpu > XrdSchedulerWorkQ::maxQ) ncpu = XrdSchedulerWorkQ::maxQ;
+   WorkQs = new XrdSchedulerWorkQ(static_cast<int>(ncpu));
+}
+
+/******************************************************************************/
+/*                                L a y o f f                                 */
+/******************************************************************************/
+
+bool XrdScheduler::Layoff()
+{
+   int waiting;
+
+// A woken worker that found nothing to do terminates if layoffs are pending
+// and there are other idle workers.
+//
+   AtomicBeg(DispatchMutex);
+   waiting = AtomicGet(idl_Workers);
+   AtomicEnd(DispatchMutex);
+
+   SchedMutex.Lock();
+   if (num_Layoffs > 0)
+      {num_Layoffs--;
+       if (waiting)
+          {num_TDestroy++; num_Workers--;
+           TRACE(SCHED, "terminating thread; workers=" <<num_Workers);
+           SchedMutex.UnLock();
+           return true;
+          }
+      }
+   SchedMutex.UnLock();
+   return false;
+}
+
+/******************************************************************************/
+/*                               m y Q u e u e                                */
+/******************************************************************************/
+
+int XrdScheduler::myQueue()
+{
+   if (WorkQs->numQ == 1) return 0;
+
+#if defined(__linux__)
+   int cpu = sched_getcpu();
+   if (cpu >= 0) return cpu % WorkQs->numQ;
+#endif
+   return static_cast<int>(XrdSysThread::Num() % WorkQs->numQ);
 }
 
 /******************************************************************************/
@@ -715,3 +888,66 @@ void XrdScheduler::traceExit(pid_t pid, int status)
                        }
    TRACE(SCHED, "Process " <<pid <<why <<retc);
 }
+
+/******************************************************************************/
+/*                                U n p a r k                                 */
+/******************************************************************************/
+
+bool XrdScheduler::Unpark(XrdSchedulerWorker &wkr)
+{
+   XrdSchedulerQueue &wq = WorkQs->Q[wkr.qNum];
+   XrdSchedulerWorker *wP, *pP = 0;
+
+// Remove the worker from the idle list unless it was already taken off it,
+// in which case a wakeup is or will be posted to it.
+//
+   wq.qMutex.Lock();
+   if (!wkr.isIdle) {wq.qMutex.UnLock(); return false;}
+   wP = wq.Idle;
+   while(wP != &wkr) {pP = wP; wP = wP->next;}
+   if (pP) pP->next = wkr.next;
+      else wq.Idle  = wkr.next;
+   wkr.isIdle = false;
+   AtomicBeg(DispatchMutex);
+   AtomicDec(idl_Workers);
+   AtomicEnd(DispatchMutex);
+   wq.qMutex.UnLock();
+   return true;
+}
+
+/******************************************************************************/
+/*                               W a k e O n e                                */
+/******************************************************************************/
+
+bool XrdScheduler::WakeOne(int qNum)
+{
+   XrdSchedulerWorker *wP;
+   int i;
+
+// Quickly check if anyone is idle at all
+//
+   AtomicBeg(DispatchMutex);
+   i = AtomicGet(idl_Workers);
+   AtomicEnd(DispatchMutex);
+   if (i <= 0) return false;
+
+// Wake up the first idle worker starting with the given queue
+//
+   for (i = 0; i < WorkQs->numQ; i++)
+       {XrdSchedulerQueue &wq = WorkQs->Q[(qNum+i) % WorkQs->numQ];
+        if (!wq.Idle) continue;
+        wq.qMutex.Lock();
+        if ((wP = wq.Idle))
+           {wq.Idle = wP->next;
+            wP->isIdle = false;
+            AtomicBeg(DispatchMutex);
+            AtomicDec(idl_Workers);
+            AtomicEnd(DispatchMutex);
+            wq.qMutex.UnLock();
+            wP->wakeUp.Post();
+            return true;
+           }
+        wq.qMutex.UnLock();
+       }
+   return false;
+}
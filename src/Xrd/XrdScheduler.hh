@@ -37,6 +37,8 @@
 
 class XrdOucTrace;
 class XrdSchedulerPID;
+class XrdSchedulerWorker;
+class XrdSchedulerWorkQ;
 class XrdSysError;
 
 #define MAX_SCHED_PROCS 30000
@@ -66,6 +68,10 @@ void          Schedule(XrdJob *jp, time_t atime);
 
 void          setParms(int minw, int maxw, int avlt, int maxi, int once=0);
 
+// Each worker thread calls initFunc with its ordinal before taking work
+//
+void          setWorkerInit(void (*initFunc)(int wNum));
+
 void          Start();
 
 int           Stats(char *buff, int blen, int do_sync=0);
@@ -93,7 +99,7 @@ private:
 XrdSysError *XrdLog;
 XrdOucTrace *XrdTrace;
 
-XrdSysMutex DispatchMutex; // Disp: Protects above area
+XrdSysMutex DispatchMutex; // Disp: Protects above area (no atomics only)
 int        idl_Workers;    // Disp: Number of idle workers
 
 int        min_Workers;   // Sched: Min threads we need to have
@@ -104,9 +110,11 @@ int        stk_Workers;   // Sched: Number of sticky workers we can have
 int        num_JobsinQ;   // Sched: Number of outstanding jobs in the queue
 int        num_Layoffs;   // Sched: Number of threads to terminate
 
-XrdJob                *WorkFirst;  // Pending work
-XrdJob                *WorkLast;
-XrdSysSemaphore        WorkAvail;
+union {XrdJob            *WorkFirst;  // Unused, kept for compatibility
+       XrdSchedulerWorkQ *WorkQs;     // Pending work, one queue per cpu
+      };
+XrdJob                *WorkLast;   // Unused, kept for compatibility
+XrdSysSemaphore        WorkAvail;  // Unused, kept for compatibility
 XrdSysMutex            SchedMutex; // Protects private area
 
 XrdJob                *TimerQueue; // Pending work
@@ -116,9 +124,14 @@ XrdSysMutex            TimerMutex; // Protects scheduler area
 XrdSchedulerPID       *firstPID;
 XrdSysMutex            ReaperMutex;
 
+XrdJob *getJob(int qNum);
 void hireWorker(int dotrace=1);
 void Init(int minw, int maxw, int maxi);
+bool Layoff();
 void Monitor();
+int  myQueue();
+bool Unpark(XrdSchedulerWorker &wkr);
+bool WakeOne(int qNum);
 void traceExit(pid_t pid, int status);
 static const char *TraceID;
 };
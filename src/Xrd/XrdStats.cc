@@ -34,6 +34,7 @@
   
 #include "XrdVersion.hh"
 #include "Xrd/XrdBuffer.hh"
+#include "Xrd/XrdInet.hh"
 #include "Xrd/XrdJob.hh"
 #include "Xrd/XrdLink.hh"
 #include "Xrd/XrdPoll.hh"
@@ -191,6 +192,7 @@ const char *XrdStats::GenStats(int &rsz, int opts) // statsMutex must be locked!
 //
    if (!(bp = buff))
       {blen = InfoStats(0,0) + BuffPool->Stats(0,0) + XrdLink::Stats(0,0)
+            + XrdInet::Stats(0,0)
             + ProcStats(0,0) + XrdSched->Stats(0,0) + XrdPoll::Stats(0,0)
             + XrdProtLoad::Statistics(0,0) + ovrhed + Hlen;
        if (posix_memalign((void **)&buff, getpagesize(), blen+256)) buff = 0;
@@ -222,6 +224,8 @@ const char *XrdStats::GenStats(int &rsz, int opts) // statsMutex must be locked!
    if (opts & XRD_STATS_LINK)
       {sz = XrdLink::Stats(bp, bl, do_sync);
        bp += sz; bl -= sz;
+       sz = XrdInet::Stats(bp, bl, do_sync);
+       bp += sz; bl -= sz;
       }
 
    if (opts & XRD_STATS_POLL)
@@ -70,7 +70,6 @@ virtual    ~XrdCksCalccrc32() {}
 private:
 static const unsigned int CRC32_XINIT = 0;
 static const unsigned int CRC32_XOROT = 0xffffffff;
-static       unsigned int crctable[256];
              unsigned int C32Result;
              unsigned int TheResult;
              long long    TotLen;
@@ -0,0 +1,69 @@
+#ifndef __XRDCKSCALCCRC32C_HH__
+#define __XRDCKSCALCCRC32C_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d C k s C a l c c r c 3 2 c . h h                    */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <netinet/in.h>
+#include <inttypes.h>
+
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+/* The crc32c (Castagnoli) checksum uses the hardware assisted implementation
+   in XrdOucCRC. The value is kept in network byte order, as is adler32.
+*/
+  
+class XrdCksCalccrc32c : public XrdCksCalc
+{
+public:
+
+char *Final() {TheResult = C32CResult;
+#ifndef Xrd_Big_Endian
+               TheResult = htonl(TheResult);
+#endif
+               return (char *)&TheResult;
+              }
+
+void        Init() {C32CResult = 0;}
+
+XrdCksCalc *New() {return (XrdCksCalc *)new XrdCksCalccrc32c;}
+
+void        Update(const char *Buff, int BLen)
+                  {C32CResult = XrdOucCRC::Calc32C(Buff, BLen, C32CResult);}
+
+const char *Type(int &csSz) {csSz = sizeof(TheResult); return "crc32c";}
+
+            XrdCksCalccrc32c() {Init();}
+virtual    ~XrdCksCalccrc32c() {}
+
+private:
+             uint32_t C32CResult;
+             uint32_t TheResult;
+};
+#endif
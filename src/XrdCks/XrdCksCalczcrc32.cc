@@ -33,10 +33,11 @@
 #include "XrdSys/XrdSysError.hh"
 #include "XrdVersion.hh"
 #include <stdint.h>
-#include <zlib.h>
+#include "XrdOuc/XrdOucCRC.hh"
 
 //------------------------------------------------------------------------------
-// CRC32 checkum according to the algorithm implemented in zlib
+// CRC32 checkum according to the algorithm implemented in zlib (computed
+// by XrdOucCRC, which gives identical results without needing zlib)
 //------------------------------------------------------------------------------
 class XrdCksCalczcrc32: public XrdCksCalc
 {
@@ -70,7 +71,7 @@ class XrdCksCalczcrc32: public XrdCksCalc
     //--------------------------------------------------------------------------
     void Init()
     {
-      pCheckSum = crc32( 0L, Z_NULL, 0 );
+      pCheckSum = 0;
     }
 
     //--------------------------------------------------------------------------
@@ -86,7 +87,7 @@ class XrdCksCalczcrc32: public XrdCksCalc
     //--------------------------------------------------------------------------
     void Update( const char *Buff, int BLen )
     {
-      pCheckSum = crc32( pCheckSum, (const Bytef*)Buff, BLen );
+      if( BLen > 0 ) pCheckSum = XrdOucCRC::Calc32( Buff, BLen, pCheckSum );
     }
 
     //--------------------------------------------------------------------------
@@ -0,0 +1,169 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d C k s C o m b i n e . c c                       */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <netinet/in.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "XrdCks/XrdCksCombine.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+// Reflected crc32 combination (derived from zlib's crc32_combine). The crc of
+// the concatenation is the crc of the first segment multiplied by x^(8*len2)
+// modulo the polynomial, added (xor) to the crc of the second segment. The
+// powers x^(2^n) are precomputed so that x^(8*len2) takes at most 64 products.
+//
+class crcComb
+{
+public:
+
+uint32_t Combine(uint32_t crc1, uint32_t crc2, long long len2)
+                {return MultModP(X2nModP(len2, 3), crc1) ^ crc2;}
+
+         crcComb(uint32_t poly) : Poly(poly)
+                {X2nTab[0] = 1U << 30;              // x^1
+                 for (int n = 1; n < 32; n++)
+                     X2nTab[n] = MultModP(X2nTab[n-1], X2nTab[n-1]);
+                }
+        ~crcComb() {}
+
+private:
+
+// Return a(x) * b(x) modulo p(x), where p(x) is the crc polynomial
+//
+uint32_t MultModP(uint32_t a, uint32_t b)
+                 {uint32_t m = 1U << 31, p = 0;
+                  while(true)
+                       {if (a & m)
+                           {p ^= b;
+                            if ((a & (m - 1)) == 0) break;
+                           }
+                        m >>= 1;
+                        b = (b & 1 ? (b >> 1) ^ Poly : b >> 1);
+                       }
+                  return p;
+                 }
+
+// Return x^(n * 2^k) modulo p(x)
+//
+uint32_t X2nModP(long long n, int k)
+                {uint32_t p = 1U << 31;             // x^0 == 1
+                 while(n)
+                      {if (n & 1) p = MultModP(X2nTab[k & 31], p);
+                       n >>= 1;
+                       k++;
+                      }
+                 return p;
+                }
+
+uint32_t Poly;
+uint32_t X2nTab[32];
+};
+
+crcComb crc32cComb(0x82f63b78);   // Castagnoli, reflected
+crcComb zcrc32Comb(0xedb88320);   // ISO-HDLC (zlib), reflected
+
+// Adler32 combination (derived from zlib's adler32_combine)
+//
+uint32_t adlerComb(uint32_t adler1, uint32_t adler2, long long len2)
+{
+   static const uint32_t Base = 65521;
+   uint32_t sum1, sum2, rem;
+
+   rem  = static_cast<uint32_t>(len2 % Base);
+   sum1 = adler1 & 0xffff;
+   sum2 = (rem * sum1) % Base;
+   sum1 += (adler2 & 0xffff) + Base - 1;
+   sum2 += ((adler1 >> 16) & 0xffff) + ((adler2 >> 16) & 0xffff) + Base - rem;
+   if (sum1 >= Base) sum1 -= Base;
+   if (sum1 >= Base) sum1 -= Base;
+   if (sum2 >= (Base << 1)) sum2 -= (Base << 1);
+   if (sum2 >= Base) sum2 -= Base;
+   return sum1 | (sum2 << 16);
+}
+
+// Values are returned by Final() in the byte order below. Adler32 and crc32c
+// are in network order while zcrc32 is simply the host integer.
+//
+enum csType {isNone = 0, isAdler32, isCRC32C, isZCRC32};
+
+csType getType(const char *csName)
+{
+        if (!strcmp(csName, "adler32")) return isAdler32;
+   else if (!strcmp(csName, "crc32c"))  return isCRC32C;
+   else if (!strcmp(csName, "zcrc32"))  return isZCRC32;
+   return isNone;
+}
+}
+
+/******************************************************************************/
+/*                               C o m b i n e                                */
+/******************************************************************************/
+  
+bool XrdCksCombine::Combine(const char *csName, char *csVal1,
+                            const char *csVal2, long long csLen2)
+{
+   uint32_t val1, val2;
+   csType   csT = getType(csName);
+
+// Get the two values (they are not necessarily aligned)
+//
+   if (csT == isNone) return false;
+   memcpy(&val1, csVal1, sizeof(val1));
+   memcpy(&val2, csVal2, sizeof(val2));
+   if (csT != isZCRC32) {val1 = ntohl(val1); val2 = ntohl(val2);}
+
+// Combine them
+//
+   switch(csT)
+         {case isAdler32: val1 = adlerComb(val1, val2, csLen2);         break;
+          case isCRC32C:  val1 = crc32cComb.Combine(val1, val2, csLen2); break;
+          default:        val1 = zcrc32Comb.Combine(val1, val2, csLen2); break;
+         }
+
+// Return the result in the original byte order
+//
+   if (csT != isZCRC32) val1 = htonl(val1);
+   memcpy(csVal1, &val1, sizeof(val1));
+   return true;
+}
+
+/******************************************************************************/
+/*                            C o m b i n a b l e                             */
+/******************************************************************************/
+
+bool XrdCksCombine::Combinable(const char *csName)
+{
+   return getType(csName) != isNone;
+}
@@ -0,0 +1,76 @@
+#ifndef __XRDCKSCOMBINE_HH__
+#define __XRDCKSCOMBINE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d C k s C o m b i n e . h h                       */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+//------------------------------------------------------------------------------
+//! The XrdCksCombine class combines the checksums of two adjacent segments of
+//! data into the checksum of the concatenated data, as if it had been computed
+//! in one pass. This allows a file to be checksummed in pieces, in parallel.
+//! Only algorithms whose final value retains all of their state can be
+//! combined. These are adler32, crc32c (Castagnoli) and zcrc32 (the zlib and
+//! ISO-HDLC crc32). The crc32 checksum, which is the POSIX cksum, appends the
+//! data length before producing the final value and cannot be combined. Nor
+//! can any cryptographic digest, such as md5.
+//------------------------------------------------------------------------------
+
+class XrdCksCombine
+{
+public:
+
+//------------------------------------------------------------------------------
+//! Check whether or not the checksums of an algorithm can be combined.
+//!
+//! @param  csName  The name of the checksum algorithm.
+//!
+//! @return True if it can be combined and false otherwise.
+//------------------------------------------------------------------------------
+
+static bool Combinable(const char *csName);
+
+//------------------------------------------------------------------------------
+//! Combine the checksum of a segment with that of the segment that follows it.
+//!
+//! @param  csName  The name of the checksum algorithm.
+//! @param  csVal1  The binary checksum value of the first segment as returned
+//!                 by XrdCksCalc::Final(). Upon success, it is replaced by the
+//!                 checksum of both segments.
+//! @param  csVal2  The binary checksum value of the second segment.
+//! @param  csLen2  The number of bytes in the second segment.
+//!
+//! @return True if the values were combined and false if the algorithm
+//!         cannot be combined.
+//------------------------------------------------------------------------------
+
+static bool Combine(const char *csName, char *csVal1, const char *csVal2,
+                    long long csLen2);
+
+            XrdCksCombine() {}
+           ~XrdCksCombine() {}
+};
+#endif
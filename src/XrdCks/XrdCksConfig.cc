@@ -29,6 +29,7 @@
 /******************************************************************************/
   
 #include <errno.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <unistd.h>
@@ -70,7 +71,8 @@ XrdCksConfig::XrdCksConfig(const char *cFN, XrdSysError *Eroute, int &aOK,
 /*                             C o n f i g u r e                              */
 /******************************************************************************/
   
-XrdCks *XrdCksConfig::Configure(const char *dfltCalc, int rdsz, XrdOss *ossP)
+XrdCks *XrdCksConfig::Configure(const char *dfltCalc, int rdsz, XrdOss *ossP,
+                                const char *calcParms)
 {
    XrdCks *myCks = getCks(ossP, rdsz);
    XrdOucTList *tP = CksList;
@@ -84,6 +86,17 @@ XrdCks *XrdCksConfig::Configure(const char *dfltCalc, int rdsz, XrdOss *ossP)
 //
    while(tP) {NoGo |= myCks->Config("ckslib", tP->text); tP = tP->next;}
 
+// Pass along any calculation parameters. Only our own manager knows of them.
+//
+   if (calcParms)
+      {if (CksLib) eDest->Say("Config warning: ckscalc ignored; not supported "
+                              "by ckslib manager ", CksLib);
+          else {char *parms = strdup(calcParms);
+                NoGo |= myCks->Config("ckscalc", parms);
+                free(parms);
+               }
+      }
+
 // Configure if all went well
 //
    if (!NoGo) NoGo = !myCks->Init(cfgFN, dfltCalc);
@@ -43,7 +43,8 @@ class XrdCksConfig
 {
 public:
 
-XrdCks *Configure(const char *dfltCalc=0, int rdsz=0, XrdOss *ossP=0);
+XrdCks *Configure(const char *dfltCalc=0, int rdsz=0, XrdOss *ossP=0,
+                  const char *calcParms=0);
 
 int     Manager() {return CksLib != 0;}
 
@@ -89,6 +89,7 @@ XrdCksManOss::XrdCksManOss(XrdOss *ossX, XrdSysError *erP, int iosz,
                  else rdSz = ((rdSz/65536) + (rdSz%65536 != 0)) * 65536;
               eDest = erP;
               ossP  = ossX;
+              SetParIO(ParCalc, ParStat);
              }
 
 /******************************************************************************/
@@ -232,6 +233,77 @@ int XrdCksManOss::ModTime(const char *Pfn, time_t &MTime)
    return (rc > 0 ? -rc : 0);
 }
 
+/******************************************************************************/
+/* Private:                      P a r C a l c                                */
+/******************************************************************************/
+  
+int XrdCksManOss::ParCalc(XrdCksManager *mP, const char *Pfn, off_t Offset,
+                          off_t Length, XrdCksCalc *csP)
+{
+   class inFile
+        {public:
+         XrdOssDF *fP;
+             inFile() {fP = ossP->newFile("ckscalc");}
+            ~inFile() {if (fP) delete fP;}
+        } In;
+   XrdOucEnv openEnv;
+   const char *Lfn = Pfn2Lfn(Pfn);
+   char  *buffP;
+   size_t ioSize, calcSize = Length;
+   int    rc;
+
+// Open the input file
+//
+   if ((rc = In.fP->Open(Lfn,O_RDONLY,0,openEnv))) return (rc > 0 ? -rc : rc);
+
+// Compute read size and allocate a buffer
+//
+   ioSize = (Length < (off_t)rdSz ? Length : rdSz); rc = 0;
+   buffP  = (char *)malloc(ioSize);
+   if (!buffP) return -ENOMEM;
+
+// Checksum the segment one buffer at a time
+//
+   while(calcSize)
+        {if ((rc= In.fP->Read(buffP, Offset, ioSize)) != (ssize_t)ioSize)
+            {if (rc >= 0) rc = -EIO;
+             break;
+            }
+         csP->Update(buffP, ioSize);
+         calcSize -= ioSize; Offset += ioSize;
+         if (calcSize < (size_t)ioSize) ioSize = calcSize;
+        }
+   free(buffP);
+
+// Issue error message if we have an error
+//
+   if (rc < 0) static_cast<XrdCksManOss *>(mP)->eDest->Emsg("Cks", rc,
+                                                            "read", Pfn);
+
+// Return
+//
+   return (rc < 0 ? rc : 0);
+}
+
+/******************************************************************************/
+/* Private:                      P a r S t a t                                */
+/******************************************************************************/
+  
+int XrdCksManOss::ParStat(XrdCksManager *mP, const char *Pfn, off_t &Size,
+                          time_t &MTime)
+{
+   const char *Lfn = Pfn2Lfn(Pfn);
+   struct stat Stat;
+   int rc;
+
+   if ((rc = ossP->Stat(Lfn, &Stat))) return (rc > 0 ? -rc : rc);
+   if (!(Stat.st_mode & S_IFREG)) return -EPERM;
+
+   Size  = Stat.st_size;
+   MTime = Stat.st_mtime;
+   return 0;
+}
+
 /******************************************************************************/
 /*                                   S e t                                    */
 /******************************************************************************/
@@ -65,6 +65,11 @@ virtual int         Calc(const char *Lfn, time_t &MTime, XrdCksCalc *CksObj);
 virtual int         ModTime(const char *Pfn, time_t &MTime);
 
 private:
+static int          ParCalc(XrdCksManager *mP, const char *Pfn, off_t Offset,
+                            off_t Length, XrdCksCalc *CksObj);
+static int          ParStat(XrdCksManager *mP, const char *Pfn, off_t &Size,
+                            time_t &MTime);
+
 
 int buffSZ;
 };
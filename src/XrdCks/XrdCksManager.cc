@@ -29,6 +29,7 @@
 /******************************************************************************/
 
 #include <errno.h>
+#include <stdlib.h>
 #include <fcntl.h>
 #include <string.h>
 #include <time.h>
@@ -37,14 +38,20 @@
 #include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+
+#include <map>
+#include <typeinfo>
   
 #include "XrdCks/XrdCksCalc.hh"
 #include "XrdCks/XrdCksCalcadler32.hh"
 #include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCalccrc32c.hh"
 #include "XrdCks/XrdCksCalcmd5.hh"
+#include "XrdCks/XrdCksCombine.hh"
 #include "XrdCks/XrdCksLoader.hh"
 #include "XrdCks/XrdCksManager.hh"
 #include "XrdCks/XrdCksXAttr.hh"
+#include "XrdOuc/XrdOuca2x.hh"
 #include "XrdOuc/XrdOucPinLoader.hh"
 #include "XrdOuc/XrdOucTokenizer.hh"
 #include "XrdOuc/XrdOucUtils.hh"
@@ -77,12 +84,14 @@ XrdCksManager::XrdCksManager(XrdSysError *erP, int rdsz, XrdVersionInfo &vInfo,
    strcpy(csTab[0].Name, "adler32");
    strcpy(csTab[1].Name, "crc32");
    strcpy(csTab[2].Name, "md5");
-   csLast = 2;
+   strcpy(csTab[3].Name, "crc32c");
+   csLast = 3;
 
 // Compute the i/o size
 //
    if (rdsz <= 65536) segSize = 67108864;
       else segSize = ((rdsz/65536) + (rdsz%65536 != 0)) * 65536;
+
 }
 
 /******************************************************************************/
@@ -99,50 +108,174 @@ XrdCksManager::~XrdCksManager()
         if (csTab[i].Plugin) delete csTab[i].Plugin;
        }
    if (cksLoader) delete cksLoader;
+   Par(true);
 }
 
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+// The parallel calculation settings. By default checksums are computed
+// sequentially, one at a time.
+//
+struct XrdCksManager::parInfo
+      {int       Threads;
+       int       AlsoN;
+       long long SegSz;
+       char      Also[csMax-1][XrdCksData::NameSize];
+       const std::type_info *ioType;   // Object type allowed parallel I/O
+       ParCalc_t             ioCalc;
+       ParStat_t             ioStat;
+
+                 parInfo() : Threads(1), AlsoN(0), SegSz(134217728),
+                             ioType(&typeid(XrdCksManager)),
+                             ioCalc(XrdCksManager::ParCalc),
+                             ioStat(XrdCksManager::ParStat) {}
+      };
+
+namespace
+{
+// This object feeds the same data to several checksums so that all of them are
+// computed in a single pass over the file.
+//
+class csMulti : public XrdCksCalc
+{
+public:
+
+char       *Final() {return csP[0]->Final();}
+
+void        Init() {for (int i = 0; i < csN; i++) csP[i]->Init();}
+
+XrdCksCalc *New() {return 0;}
+
+void        Recycle() {}
+
+const char *Type(int &csSize) {return csP[0]->Type(csSize);}
+
+void        Update(const char *Buff, int BLen)
+                  {for (int i = 0; i < csN; i++) csP[i]->Update(Buff, BLen);}
+
+            csMulti(XrdCksCalc **calcP, int calcN) : csP(calcP), csN(calcN) {}
+           ~csMulti() {}
+
+private:
+XrdCksCalc **csP;
+int          csN;
+};
+}
+
+/******************************************************************************/
+/*                        C l a s s   p a r J o b                             */
+/******************************************************************************/
+
+// This object describes a parallel calculation. Segments are handed out in
+// order to whichever thread asks next and each segment's checksums are kept
+// so that they can be combined, in segment order, once all threads are done.
+//
+struct XrdCksManager::parJob
+{
+XrdSysMutex    jMutex;
+XrdCksManager *Mgr;
+ParCalc_t      ioCalc;
+const char    *Pfn;
+csInfo       **csV;
+XrdCksCalc   **csP;
+char          *csVal;
+off_t          fSize;
+off_t          segSz;
+int            csN;
+int            numSeg;
+int            nextSeg;
+int            rc;
+
+char          *Val(int seg, int n)
+                  {return csVal + (seg*csN + n)*XrdCksData::ValuSize;}
+
+off_t          SegLen(int seg)
+                     {off_t left = fSize - segSz*seg;
+                      return (left < segSz ? left : segSz);
+                     }
+
+               parJob(XrdCksManager *mP, ParCalc_t iocalc, const char *pfn,
+                      off_t fsz, off_t ssz, csInfo **csv, XrdCksCalc **csp,
+                      int csn)
+                     : Mgr(mP), ioCalc(iocalc), Pfn(pfn), csV(csv), csP(csp), fSize(fsz),
+                       segSz(ssz), csN(csn), nextSeg(0), rc(0)
+                     {numSeg = static_cast<int>((fsz + ssz - 1) / ssz);
+                      csVal  = (char *)malloc(numSeg*csN*XrdCksData::ValuSize);
+                      if (!csVal) rc = -ENOMEM;
+                     }
+              ~parJob() {if (csVal) free(csVal);}
+};
+
 /******************************************************************************/
 /*                                  C a l c                                   */
 /******************************************************************************/
   
 int XrdCksManager::Calc(const char *Pfn, XrdCksData &Cks, int doSet)
 {
-   XrdCksCalc *csP;
-   csInfo *csIP = &csTab[0];
+   char csVal[csMax][XrdCksData::ValuSize];
+   XrdCksCalc *csP[csMax];
+   csInfo *csV[csMax], *csIP = &csTab[0];
+   parInfo &par = Par();
    time_t MTime;
-   int rc;
+   int i, csN = 1, rc;
 
 // Determine which checksum to get
 //
    if (csLast < 0) return -ENOTSUP;
    if (!(*Cks.Name)) Cks.Set(csIP->Name);
       else if (!(csIP = Find(Cks.Name))) return -ENOTSUP;
+   csV[0] = csIP;
 
-// If we need not set the checksum then see if we can get it from the
-// extended attributes.
-
-// Obtain a new checksum object
+// If the checksum is to be recorded, also compute in the same pass any other
+// checksums that should be recorded along with it.
 //
-   if (!(csP = csIP->Obj->New())) return -ENOMEM;
+   if (doSet)
+      for (i = 0; i < par.AlsoN; i++)
+          if ((csV[csN] = Find(par.Also[i])) && csV[csN] != csIP) csN++;
 
-// Use the calculator to get and possibly set the checksum
+// Obtain new checksum objects
 //
-   if (!(rc = Calc(Pfn, MTime, csP)))
-      {memcpy(Cks.Value, csP->Final(), csIP->Len);
-       Cks.fmTime = static_cast<long long>(MTime);
-       Cks.csTime = static_cast<int>(time(0) - MTime);
-       Cks.Length = csIP->Len;
-       csP->Recycle();
-       if (doSet)
-          {XrdOucXAttr<XrdCksXAttr> xCS;
-           memcpy(&xCS.Attr.Cks, &Cks, sizeof(xCS.Attr.Cks));
-           if ((rc = xCS.Set(Pfn))) return -rc;
+   for (i = 0; i < csN; i++)
+       if (!(csP[i] = csV[i]->Obj->New()))
+          {while(i--) csP[i]->Recycle();
+           return -ENOMEM;
           }
+
+// Use the calculators to get the checksums
+//
+   rc = CalcAll(Pfn, MTime, csV, csP, csN, csVal);
+   for (i = 0; i < csN; i++) csP[i]->Recycle();
+   if (rc) return rc;
+
+// Return the checksum that was asked for
+//
+   memcpy(Cks.Value, csVal[0], csIP->Len);
+   Cks.fmTime = static_cast<long long>(MTime);
+   Cks.csTime = static_cast<int>(time(0) - MTime);
+   Cks.Length = csIP->Len;
+
+// Record the checksums if so wanted. Failing to record an extra checksum only
+// means that it will have to be calculated when it is needed.
+//
+   if (doSet)
+      {XrdOucXAttr<XrdCksXAttr> xCS;
+       memcpy(&xCS.Attr.Cks, &Cks, sizeof(xCS.Attr.Cks));
+       if ((rc = xCS.Set(Pfn))) return -rc;
+       for (i = 1; i < csN; i++)
+           {XrdOucXAttr<XrdCksXAttr> xCX;
+            memcpy(&xCX.Attr.Cks, &Cks, sizeof(xCX.Attr.Cks));
+            xCX.Attr.Cks.Set(csV[i]->Name);
+            xCX.Attr.Cks.Set((const void *)csVal[i], csV[i]->Len);
+            if ((rc = xCX.Set(Pfn)))
+               eDest->Emsg("Cks", rc, "set checksum for", Pfn);
+           }
       }
 
 // All done
 //
-   return rc;
+   return 0;
 }
 
 /******************************************************************************/
@@ -156,10 +289,6 @@ int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
             ~ioFD() {if (FD >= 0) close(FD);}
         } In;
    struct stat Stat;
-   char *inBuff;
-   off_t  Offset=0, fileSize;
-   size_t ioSize, calcSize;
-   int rc;
 
 // Open the input file
 //
@@ -169,31 +298,93 @@ int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
 //
    if (fstat(In.FD, &Stat)) return -errno;
    if (!(Stat.st_mode & S_IFREG)) return -EPERM;
-   calcSize = fileSize = Stat.st_size;
    MTime = Stat.st_mtime;
 
-// We now compute checksum 64MB at a time using mmap I/O
+// Compute the checksum of the whole file
 //
-   ioSize = (fileSize < (off_t)segSize ? fileSize : segSize); rc = 0;
-   while(calcSize)
-        {if ((inBuff = (char *)mmap(0, ioSize, PROT_READ, 
-#if defined(__FreeBSD__)
-                       MAP_RESERVED0040|MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
-#else
-                       MAP_NORESERVE|MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
-#endif
-            {rc = errno; eDest->Emsg("Cks", rc, "memory map", Pfn); break;}
-         madvise(inBuff, ioSize, MADV_SEQUENTIAL);
-         csP->Update(inBuff, ioSize);
-         calcSize -= ioSize; Offset += ioSize;
-         if (munmap(inBuff, ioSize) < 0)
-            {rc = errno; eDest->Emsg("Cks",rc,"unmap memory for",Pfn); break;}
-         if (calcSize < (size_t)segSize) ioSize = calcSize;
-        }
+   return MapCalc(In.FD, Pfn, 0, Stat.st_size, csP);
+}
 
-// Return if we failed
+/******************************************************************************/
+/*                               C a l c A l l                                */
+/******************************************************************************/
+  
+int XrdCksManager::CalcAll(const char *Pfn, time_t &MTime, csInfo **csV,
+                           XrdCksCalc **csP, int csN,
+                           char csVal[][XrdCksData::ValuSize])
+{
+   parInfo &par = Par();
+   off_t fSize;
+   int i, rc;
+
+// A parallel calculation is possible only when every checksum can be combined
+// and the file spans more than one segment. It is never done for a derived
+// class that did not supply the parallel I/O functions as it may read files
+// by other means than ours (i.e. it replaced the whole file Calc()).
 //
-   if (calcSize) return (rc ? -rc : -EIO);
+   if (par.Threads > 1 && typeid(*this) == *par.ioType)
+      {for (i = 0; i < csN && XrdCksCombine::Combinable(csV[i]->Name); i++) {}
+       if (i >= csN)
+          {if ((rc = par.ioStat(this, Pfn, fSize, MTime))) return rc;
+           if (fSize > par.SegSz)
+              return CalcPar(Pfn, fSize, csV, csP, csN, csVal);
+          }
+      }
+
+// Do a sequential calculation
+//
+   if (csN == 1) rc = Calc(Pfn, MTime, csP[0]);
+      else {csMulti multiCalc(csP, csN);
+            rc = Calc(Pfn, MTime, &multiCalc);
+           }
+
+// Return the values
+//
+   if (!rc) for (i = 0; i < csN; i++) memcpy(csVal[i],csP[i]->Final(),csV[i]->Len);
+   return rc;
+}
+
+/******************************************************************************/
+/*                               C a l c P a r                                */
+/******************************************************************************/
+  
+int XrdCksManager::CalcPar(const char *Pfn, off_t fSize, csInfo **csV,
+                           XrdCksCalc **csP, int csN,
+                           char csVal[][XrdCksData::ValuSize])
+{
+   parInfo  &par = Par();
+   parJob    theJob(this, par.ioCalc, Pfn, fSize, par.SegSz, csV, csP, csN);
+   pthread_t tid[parMax];
+   int i, k, rc, numThr, numRun = 0;
+
+// Start the helper threads, this thread will be working as well. We can live
+// with fewer threads than wanted should some not start.
+//
+   if (theJob.rc) return theJob.rc;
+   numThr = (theJob.numSeg < par.Threads ? theJob.numSeg : par.Threads);
+   for (i = 1; i < numThr; i++)
+       {if ((rc = XrdSysThread::Run(&tid[numRun], ParStart, (void *)&theJob,
+                                    XRDSYSTHREAD_HOLD, "cks calc")))
+           {eDest->Emsg("Cks", rc, "start checksum thread for", Pfn);
+            break;
+           }
+        numRun++;
+       }
+
+// Do our share of the work and wait for the helpers to finish
+//
+   ParSegs(theJob);
+   for (i = 0; i < numRun; i++) XrdSysThread::Join(tid[i], 0);
+   if (theJob.rc) return theJob.rc;
+
+// Combine the segment checksums, in order, into the file checksum
+//
+   for (i = 0; i < csN; i++)
+       {memcpy(csVal[i], theJob.Val(0, i), csV[i]->Len);
+        for (k = 1; k < theJob.numSeg; k++)
+            XrdCksCombine::Combine(csV[i]->Name, csVal[i], theJob.Val(k, i),
+                                   static_cast<long long>(theJob.SegLen(k)));
+       }
    return 0;
 }
 
@@ -207,6 +398,8 @@ int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
              <path>    the path of the checksum library to be used.
              <parms>   optional parms to be passed
 
+             The ckscalc directive is handled by ConfigCalc().
+
   Output: 0 upon success or !0 upon failure.
 */
 int XrdCksManager::Config(const char *Token, char *Line)
@@ -215,6 +408,10 @@ int XrdCksManager::Config(const char *Token, char *Line)
    char *val, *path = 0, name[XrdCksData::NameSize], *parms;
    int i;
 
+// Check if these are calculation parameters
+//
+   if (Token && !strcmp(Token, "ckscalc")) return ConfigCalc(Line);
+
 // Get the the checksum name
 //
    Cfg.GetLine();
@@ -258,6 +455,99 @@ int XrdCksManager::Config(const char *Token, char *Line)
    return 0;
 }
 
+/******************************************************************************/
+/*                            C o n f i g C a l c                             */
+/******************************************************************************/
+/*
+   Purpose:  To parse the directive: ckscalc [threads <n>] [segsize <sz>]
+                                             [also <name>[,<name>[...]]]
+
+             threads   the number of threads used to compute a checksum. When
+                       greater than one, a file larger than a segment is split
+                       into segments that are checksummed in parallel and the
+                       results combined. This is only done for checksums that
+                       can be combined (adler32, crc32c, and zcrc32). The
+                       default is 1 (i.e. sequential).
+             segsize   the segment size for parallel checksums. Can be suffixed
+                       by k,m,g. It is at least 1m and is rounded up to be a
+                       multiple of 64k. The default is 128m.
+             also      the checksums to compute in the same pass over the file
+                       whenever a checksum is calculated and recorded. Each is
+                       recorded as well.
+
+  Output: 0 upon success or !0 upon failure.
+*/
+int XrdCksManager::ConfigCalc(char *Line)
+{
+   static const long long minSeg = 1024*1024, maxSeg = 1024LL*1024*1024;
+   XrdOucTokenizer Cfg(Line);
+   parInfo &par = Par();
+   char *val, *name, *save = 0;
+   long long segsz;
+   int i, nthr;
+
+// Process all of the options
+//
+   Cfg.GetLine();
+   if (!(val = Cfg.GetToken()) || !val[0])
+      {eDest->Emsg("Config", "ckscalc parameters not specified"); return 1;}
+
+   while(val)
+        {     if (!strcmp("threads", val))
+                 {if (!(val = Cfg.GetToken()))
+                     {eDest->Emsg("Config", "ckscalc threads not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2i(*eDest, "ckscalc threads", val, &nthr,
+                                     1, parMax)) return 1;
+                  par.Threads = nthr;
+                 }
+         else if (!strcmp("segsize", val))
+                 {if (!(val = Cfg.GetToken()))
+                     {eDest->Emsg("Config", "ckscalc segsize not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2sz(*eDest, "ckscalc segsize", val, &segsz,
+                                      minSeg, maxSeg)) return 1;
+                  par.SegSz = ((segsz/65536) + (segsz%65536 != 0)) * 65536;
+                 }
+         else if (!strcmp("also", val))
+                 {if (!(val = Cfg.GetToken()) || !val[0])
+                     {eDest->Emsg("Config", "ckscalc also list not specified");
+                      return 1;
+                     }
+                  par.AlsoN = 0;
+                  name = strtok_r(val, ",", &save);
+                  while(name)
+                       {if (int(strlen(name)) >= XrdCksData::NameSize)
+                           {eDest->Emsg("Config", "checksum name too long");
+                            return 1;
+                           }
+                        XrdOucUtils::toLower(name);
+                        for (i = 0; i < par.AlsoN; i++)
+                            if (!strcmp(name, par.Also[i])) break;
+                        if (i >= par.AlsoN)
+                           {if (par.AlsoN >= csMax-1)
+                               {eDest->Emsg("Config", "too many ckscalc "
+                                                      "checksums specified");
+                                return 1;
+                               }
+                            strcpy(par.Also[par.AlsoN++], name);
+                           }
+                        name = strtok_r(0, ",", &save);
+                       }
+                 }
+         else {eDest->Emsg("Config", "invalid ckscalc option -", val);
+               return 1;
+              }
+         val = Cfg.GetToken();
+        }
+
+// All done
+//
+   return 0;
+}
+
 /******************************************************************************/
 /*                                  I n i t                                   */
 /******************************************************************************/
@@ -295,6 +585,8 @@ int XrdCksManager::Init(const char *ConfigFN, const char *DfltCalc)
                          csTab[i].Obj = new XrdCksCalccrc32;
                  else if (!strcmp("md5",     csTab[i].Name))
                          csTab[i].Obj = new XrdCksCalcmd5;
+                 else if (!strcmp("crc32c",  csTab[i].Name))
+                         csTab[i].Obj = new XrdCksCalccrc32c;
                  else {eDest->Emsg("Config", "Invalid native checksum -",
                                              csTab[i].Name);
                        return 0;
@@ -303,6 +595,16 @@ int XrdCksManager::Init(const char *ConfigFN, const char *DfltCalc)
                 }
        }
 
+// Make sure that checksums computed along with others can actually be computed
+//
+   parInfo &par = Par();
+   for (i = 0; i < par.AlsoN; i++)
+       if (!Find(par.Also[i]))
+          {eDest->Emsg("Config", par.Also[i], "cannot be computed by ckscalc; "
+                                             "not supported.");
+           return 0;
+          }
+
 // All done
 //
    return 1;
@@ -530,6 +832,42 @@ char *XrdCksManager::List(const char *Pfn, char *Buff, int Blen, char Sep)
    return (bP == Buff ? 0 : Buff);
 }
 
+/******************************************************************************/
+/*                               M a p C a l c                                */
+/******************************************************************************/
+  
+int XrdCksManager::MapCalc(int FD, const char *Pfn, off_t Offset, off_t Length,
+                           XrdCksCalc *csP)
+{
+   char *inBuff;
+   size_t ioSize, calcSize = Length;
+   int rc = 0;
+
+// We now compute checksum 64MB at a time using mmap I/O
+//
+   ioSize = (Length < (off_t)segSize ? Length : segSize);
+   while(calcSize)
+        {if ((inBuff = (char *)mmap(0, ioSize, PROT_READ, 
+#if defined(__FreeBSD__)
+                       MAP_RESERVED0040|MAP_PRIVATE, FD, Offset)) == MAP_FAILED)
+#else
+                       MAP_NORESERVE|MAP_PRIVATE, FD, Offset)) == MAP_FAILED)
+#endif
+            {rc = errno; eDest->Emsg("Cks", rc, "memory map", Pfn); break;}
+         madvise(inBuff, ioSize, MADV_SEQUENTIAL);
+         csP->Update(inBuff, ioSize);
+         calcSize -= ioSize; Offset += ioSize;
+         if (munmap(inBuff, ioSize) < 0)
+            {rc = errno; eDest->Emsg("Cks",rc,"unmap memory for",Pfn); break;}
+         if (calcSize < (size_t)segSize) ioSize = calcSize;
+        }
+
+// Return if we failed
+//
+   if (calcSize) return (rc ? -rc : -EIO);
+   return 0;
+}
+
 /******************************************************************************/
 /*                               M o d T i m e                                */
 /******************************************************************************/
@@ -568,6 +906,129 @@ XrdCksCalc *XrdCksManager::Object(const char *name)
    return csIP->Obj->New();
 }
   
+/******************************************************************************/
+/* Private:                          P a r                                    */
+/******************************************************************************/
+
+// The parallel settings are kept outside of the object so that the object's
+// layout, which plugins derived from this class depend on, stays the same.
+// They are created on first use and discarded when doDel is true. The map is
+// never deleted as managers may be destroyed during static destruction.
+//
+XrdCksManager::parInfo &XrdCksManager::Par(bool doDel)
+{
+   typedef std::map<const XrdCksManager *, parInfo *> parMap_t;
+   static XrdSysMutex *parMutex = new XrdSysMutex;
+   static parMap_t    *parMap   = new parMap_t;
+   static parInfo      parNone;
+   XrdSysMutexHelper mHelp(parMutex);
+   parMap_t::iterator it = parMap->find(this);
+
+   if (doDel)
+      {if (it != parMap->end()) {delete it->second; parMap->erase(it);}
+       return parNone;
+      }
+   if (it != parMap->end()) return *(it->second);
+   return *((*parMap)[this] = new parInfo);
+}
+
+/******************************************************************************/
+/* Private:                      P a r C a l c                                */
+/******************************************************************************/
+  
+int XrdCksManager::ParCalc(XrdCksManager *mP, const char *Pfn, off_t Offset,
+                           off_t Length, XrdCksCalc *csP)
+{
+   int FD, rc;
+
+// Open the input file
+//
+   if ((FD = open(Pfn, O_RDONLY)) < 0) return -errno;
+
+// Compute the checksum of the segment
+//
+   rc = mP->MapCalc(FD, Pfn, Offset, Length, csP);
+   close(FD);
+   return rc;
+}
+
+/******************************************************************************/
+/*                               P a r S e g s                                */
+/******************************************************************************/
+  
+void XrdCksManager::ParSegs(parJob &job)
+{
+   XrdCksCalc *segP[csMax];
+   csMulti     multiCalc(segP, job.csN);
+   off_t       segOffs;
+   int         i, k, rc = 0;
+
+// Each thread needs its own set of checksum objects
+//
+   for (i = 0; i < job.csN; i++)
+       if (!(segP[i] = job.csP[i]->New()))
+          {while(i--) segP[i]->Recycle();
+           job.jMutex.Lock();
+           if (!job.rc) job.rc = -ENOMEM;
+           job.jMutex.UnLock();
+           return;
+          }
+
+// Checksum segments until there are no more or someone failed
+//
+   while(true)
+        {job.jMutex.Lock();
+         if (job.rc || job.nextSeg >= job.numSeg) {job.jMutex.UnLock(); break;}
+         k = job.nextSeg++;
+         job.jMutex.UnLock();
+
+         multiCalc.Init();
+         segOffs = job.segSz * k;
+         if ((rc = job.ioCalc(this, job.Pfn, segOffs, job.SegLen(k),
+                              (job.csN == 1 ? segP[0] : &multiCalc))))
+            {job.jMutex.Lock();
+             if (!job.rc) job.rc = rc;
+             job.jMutex.UnLock();
+             break;
+            }
+         for (i = 0; i < job.csN; i++)
+             memcpy(job.Val(k, i), segP[i]->Final(), job.csV[i]->Len);
+        }
+
+// Get rid of our checksum objects
+//
+   for (i = 0; i < job.csN; i++) segP[i]->Recycle();
+}
+
+/******************************************************************************/
+/*                              P a r S t a r t                               */
+/******************************************************************************/
+  
+void *XrdCksManager::ParStart(void *parg)
+{
+   parJob *jobP = (parJob *)parg;
+
+   jobP->Mgr->ParSegs(*jobP);
+   return (void *)0;
+}
+
+/******************************************************************************/
+/* Private:                      P a r S t a t                                */
+/******************************************************************************/
+  
+int XrdCksManager::ParStat(XrdCksManager *mP, const char *Pfn, off_t &Size,
+                           time_t &MTime)
+{
+   struct stat Stat;
+
+   if (stat(Pfn, &Stat)) return -errno;
+   if (!(Stat.st_mode & S_IFREG)) return -EPERM;
+
+   Size  = Stat.st_size;
+   MTime = Stat.st_mtime;
+   return 0;
+}
+
 /******************************************************************************/
 /*                                  S i z e                                   */
 /******************************************************************************/
@@ -608,6 +1069,21 @@ int XrdCksManager::Set(const char *Pfn, XrdCksData &Cks, int myTime)
    return xCS.Set(Pfn);
 }
 
+/******************************************************************************/
+/* Protected:                   S e t P a r I O                               */
+/******************************************************************************/
+  
+void XrdCksManager::SetParIO(ParCalc_t calcP, ParStat_t statP)
+{
+   parInfo &par = Par();
+
+// Only the object being constructed may use these functions
+//
+   par.ioType = &typeid(*this);
+   par.ioCalc = calcP;
+   par.ioStat = statP;
+}
+
 /******************************************************************************/
 /*                                   V e r                                    */
 /******************************************************************************/
@@ -88,6 +88,24 @@ virtual int         Calc(const char *Pfn, time_t &MTime, XrdCksCalc *CksObj);
 */
 virtual int         ModTime(const char *Pfn, time_t &MTime);
 
+/* SetParIO() supplies the functions used when checksums are computed in
+              parallel by a derived class that reads files by other means
+              than the local file system; it must be called in the derived
+              class' constructor. ParCalc computes the checksum of the Length
+              bytes at Offset using the supplied CksObj and must be thread-
+              safe. ParStat returns the file's size and modification time.
+              Both return 0 upon success and -errno otherwise. Checksums are
+              only computed in parallel when the object is an XrdCksManager or
+              the object whose constructor called SetParIO(); otherwise, the
+              whole file Calc() above is always used.
+*/
+typedef int (*ParCalc_t)(XrdCksManager *mP, const char *Pfn, off_t Offset,
+                         off_t Length, XrdCksCalc *CksObj);
+typedef int (*ParStat_t)(XrdCksManager *mP, const char *Pfn, off_t &Size,
+                         time_t &MTime);
+
+void                SetParIO(ParCalc_t calcP, ParStat_t statP);
+
 private:
 
 struct csInfo
@@ -103,10 +121,31 @@ struct csInfo
                                 {memset(Name, 0, sizeof(Name));}
       };
 
+struct parInfo;
+struct parJob;
+
+int     CalcAll(const char *Pfn, time_t &MTime, csInfo **csV,
+                XrdCksCalc **csP, int csN, char csVal[][XrdCksData::ValuSize]);
+int     CalcPar(const char *Pfn, off_t fSize, csInfo **csV,
+                XrdCksCalc **csP, int csN, char csVal[][XrdCksData::ValuSize]);
 int     Config(const char *cFN, csInfo &Info);
+int     ConfigCalc(char *Line);
 csInfo *Find(const char *Name);
-
-static const int csMax = 8;
+parInfo &Par(bool doDel=false);
+int     MapCalc(int fd, const char *Pfn, off_t Offset, off_t Length,
+                XrdCksCalc *csP);
+static
+int     ParCalc(XrdCksManager *mP, const char *Pfn, off_t Offset,
+                off_t Length, XrdCksCalc *csP);
+void    ParSegs(parJob &job);
+static
+void   *ParStart(void *parg);
+static
+int     ParStat(XrdCksManager *mP, const char *Pfn, off_t &Size,
+                time_t &MTime);
+
+static const int csMax  = 8;
+static const int parMax = 64;
 csInfo           csTab[csMax];
 int              csLast;
 int              segSize;
@@ -45,6 +45,7 @@ namespace XrdCl
   // Environment settings
   //----------------------------------------------------------------------------
   const int DefaultSubStreamsPerChannel    = 1;
+  const int DefaultSubStreamStallTime      = 2;
   const int DefaultConnectionWindow        = 120;
   const int DefaultConnectionRetry         = 5;
   const int DefaultRequestTimeout          = 1800;
@@ -88,6 +89,9 @@ namespace XrdCl
   const int DefaultIPNoShuffle             = 0;
   const int DefaultWantTlsOnNoPgrw         = 0;
   const int DefaultRetryWrtAtLBLimit       = 3;
+  const int DefaultHedgedReads             = 0;
+  const int DefaultHedgePercentile         = 95;
+  const int DefaultHedgeMinDelay           = 10;
 
   const char * const DefaultPollerPreference   = "built-in";
   const char * const DefaultNetworkStack       = "IPAuto";
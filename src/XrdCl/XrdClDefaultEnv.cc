@@ -266,6 +266,7 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "RequestTimeout",          DefaultRequestTimeout          );
     REGISTER_VAR_INT( varsInt, "StreamTimeout",           DefaultStreamTimeout           );
     REGISTER_VAR_INT( varsInt, "SubStreamsPerChannel",    DefaultSubStreamsPerChannel    );
+    REGISTER_VAR_INT( varsInt, "SubStreamStallTime",      DefaultSubStreamStallTime      );
     REGISTER_VAR_INT( varsInt, "TimeoutResolution",       DefaultTimeoutResolution       );
     REGISTER_VAR_INT( varsInt, "StreamErrorWindow",       DefaultStreamErrorWindow       );
     REGISTER_VAR_INT( varsInt, "RunForkHandler",          DefaultRunForkHandler          );
@@ -300,6 +301,9 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "IPNoShuffle",             DefaultIPNoShuffle             );
     REGISTER_VAR_INT( varsInt, "WantTlsOnNoPgrw",         DefaultWantTlsOnNoPgrw         );
     REGISTER_VAR_INT( varsInt, "RetryWrtAtLBLimit",       DefaultRetryWrtAtLBLimit       );
+    REGISTER_VAR_INT( varsInt, "HedgedReads",             DefaultHedgedReads             );
+    REGISTER_VAR_INT( varsInt, "HedgePercentile",         DefaultHedgePercentile         );
+    REGISTER_VAR_INT( varsInt, "HedgeMinDelay",           DefaultHedgeMinDelay           );
 
     REGISTER_VAR_STR( varsStr, "ClientMonitor",           DefaultClientMonitor           );
     REGISTER_VAR_STR( varsStr, "ClientMonitorParam",      DefaultClientMonitorParam      );
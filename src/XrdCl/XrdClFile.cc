@@ -27,6 +27,8 @@
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClFile.hh"
 #include "XrdCl/XrdClFileStateHandler.hh"
+#include "XrdCl/XrdClHedgedRead.hh"
+#include "XrdCl/XrdClURL.hh"
 #include "XrdCl/XrdClMessageUtils.hh"
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClPlugInInterface.hh"
@@ -68,6 +70,7 @@ namespace XrdCl
     // at this point we just give up the hope.
     //--------------------------------------------------------------------------
     if ( DefaultEnv::GetLog() && IsOpen() ) {XRootDStatus status = Close();}
+    if( pStateHandler->pHedge ) pStateHandler->pHedge->Release();
     delete pStateHandler;
     delete pPlugIn;
   }
@@ -105,7 +108,29 @@ namespace XrdCl
     if( pPlugIn )
       return pPlugIn->Open( url, flags, mode, handler, timeout );
 
-    return pStateHandler->Open( url, flags, mode, handler, timeout );
+    XRootDStatus st = pStateHandler->Open( url, flags, mode, handler, timeout );
+    if( !st.IsOK() )
+      return st;
+
+    //--------------------------------------------------------------------------
+    // Reads from a remote file opened for reading may be hedged to a replica
+    //--------------------------------------------------------------------------
+    if( pStateHandler->pHedge )
+    {
+      pStateHandler->pHedge->Release();
+      pStateHandler->pHedge = 0;
+    }
+
+    const OpenFlags::Flags wrFlags = OpenFlags::Delete | OpenFlags::New |
+                                     OpenFlags::Update | OpenFlags::Write;
+    if( pStateHandler->pDoHedge && !( flags & wrFlags ) )
+    {
+      const std::string &proto = URL( url ).GetProtocol();
+      if( proto == "root" || proto == "roots" ||
+          proto == "xroot" || proto == "xroots" )
+        pStateHandler->pHedge = new HedgedReader( pStateHandler, url );
+    }
+    return st;
   }
 
   //----------------------------------------------------------------------------
@@ -133,6 +158,9 @@ namespace XrdCl
     if( pPlugIn )
       return pPlugIn->Close( handler, timeout );
 
+    if( pStateHandler->pHedge )
+      return pStateHandler->pHedge->Close( handler, timeout );
+
     return pStateHandler->Close( handler, timeout );
   }
 
@@ -191,6 +219,9 @@ namespace XrdCl
     if( pPlugIn )
       return pPlugIn->Read( offset, size, buffer, handler, timeout );
 
+    if( pStateHandler->pHedge )
+      return pStateHandler->pHedge->Read( offset, size, buffer, handler, timeout );
+
     return pStateHandler->Read( offset, size, buffer, handler, timeout );
   }
 
@@ -724,6 +755,12 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   bool File::SetProperty( const std::string &name, const std::string &value )
   {
+    if( name == "HedgedReads" )
+    {
+      pStateHandler->pDoHedge = ( value == "true" );
+      return true;
+    }
+
     if( pPlugIn )
       return pPlugIn->SetProperty( name, value );
 
@@ -735,6 +772,19 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   bool File::GetProperty( const std::string &name, std::string &value ) const
   {
+    if( name == "HedgedReads" )
+    {
+      value = ( pStateHandler->pDoHedge ? "true" : "false" );
+      return true;
+    }
+
+    if( name == "HedgeStats" )
+    {
+      if( !pStateHandler->pHedge ) return false;
+      pStateHandler->pHedge->GetStats( value );
+      return true;
+    }
+
     if( pPlugIn )
       return pPlugIn->GetProperty( name, value );
 
@@ -721,6 +721,9 @@ namespace XrdCl
       //! ReadRecovery     [true/false] - enable/disable read recovery
       //! WriteRecovery    [true/false] - enable/disable write recovery
       //! FollowRedirects  [true/false] - enable/disable following redirections
+      //! HedgedReads      [true/false] - enable/disable sending slow reads to
+      //!                                 another replica as well, takes effect
+      //!                                 on the next open for reading
       //------------------------------------------------------------------------
       bool SetProperty( const std::string &name, const std::string &value );
 
@@ -732,6 +735,11 @@ namespace XrdCl
       //! Read-only properties:
       //! DataServer [string] - the data server the file is accessed at
       //! LastURL    [string] - final file URL with all the cgi information
+      //! HedgeStats [string] - "reads=n hedged=n wins=n delay=ms", the number
+      //!                       of reads eligible for hedging, how many were
+      //!                       sent to the replica as well, how many of those
+      //!                       the replica answered first and the current
+      //!                       hedge delay
       //------------------------------------------------------------------------
       bool GetProperty( const std::string &name, std::string &value ) const;
 
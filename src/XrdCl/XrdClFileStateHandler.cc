@@ -705,8 +705,12 @@ namespace XrdCl
     pFollowRedirects( true ),
     pUseVirtRedirector( true ),
     pIsChannelEncrypted( false ),
+    pHedge( 0 ),
     pReOpenHandler( 0 )
   {
+    int hedge = DefaultHedgedReads;
+    DefaultEnv::GetEnv()->GetInt( "HedgedReads", hedge );
+    pDoHedge = hedge != 0;
     pFileHandle = new uint8_t[4];
     ResetMonitoringVars();
     DefaultEnv::GetForkHandler()->RegisterFileObject( this );
@@ -736,8 +740,12 @@ namespace XrdCl
     pDoRecoverWrite( true ),
     pFollowRedirects( true ),
     pUseVirtRedirector( useVirtRedirector ),
+    pHedge( 0 ),
     pReOpenHandler( 0 )
   {
+    int hedge = DefaultHedgedReads;
+    DefaultEnv::GetEnv()->GetInt( "HedgedReads", hedge );
+    pDoHedge = hedge != 0;
     pFileHandle = new uint8_t[4];
     ResetMonitoringVars();
     DefaultEnv::GetForkHandler()->RegisterFileObject( this );
@@ -50,6 +50,8 @@ namespace
 
 namespace XrdCl
 {
+  class File;
+  class HedgedReader;
   class ResponseHandlerHolder;
   class Message;
 
@@ -78,6 +80,7 @@ namespace XrdCl
       friend class ::PgReadHandler;
       friend class ::PgReadRetryHandler;
       friend class ::PgReadSubstitutionHandler;
+      friend class File;
 
     public:
       //------------------------------------------------------------------------
@@ -695,6 +698,12 @@ namespace XrdCl
       bool                    pUseVirtRedirector;
       bool                    pIsChannelEncrypted;
 
+      //------------------------------------------------------------------------
+      // Hedged read state, managed by File
+      //------------------------------------------------------------------------
+      HedgedReader           *pHedge;
+      bool                    pDoHedge;
+
       //------------------------------------------------------------------------
       // Monitoring variables
       //------------------------------------------------------------------------
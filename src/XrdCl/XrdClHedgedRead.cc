@@ -0,0 +1,861 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClHedgedRead.hh"
+#include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClFileStateHandler.hh"
+#include "XrdCl/XrdClFileSystem.hh"
+#include "XrdCl/XrdClLog.hh"
+#include "XrdCl/XrdClURL.hh"
+#include "XrdNet/XrdNetAddr.hh"
+#include "XrdSys/XrdSysE2T.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+#include <unistd.h>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Monotonic time in microseconds
+  //----------------------------------------------------------------------------
+  uint64_t Now()
+  {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(
+             steady_clock::now().time_since_epoch() ).count();
+  }
+
+  //----------------------------------------------------------------------------
+  // Compare two host:port strings, which may name the same server differently
+  //----------------------------------------------------------------------------
+  bool SameHost( const std::string &a, const std::string &b )
+  {
+    XrdNetAddr na, nb;
+    if( !na.Set( a.c_str() ) && !nb.Set( b.c_str() ) )
+      return na.Same( &nb, true );
+
+    XrdCl::URL ua( "root://" + a ), ub( "root://" + b );
+    return ua.GetHostName() == ub.GetHostName() && ua.GetPort() == ub.GetPort();
+  }
+}
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  // A single user read: sent to the primary and, if slow, to the replica
+  //----------------------------------------------------------------------------
+  class HedgedReadReq
+  {
+    public:
+      //------------------------------------------------------------------------
+      // One of the two copies of the request
+      //------------------------------------------------------------------------
+      class Leg: public ResponseHandler
+      {
+        public:
+          Leg(): pReq( 0 ), pBuff( 0 ), pOnReplica( false ) {}
+          virtual ~Leg() { free( pBuff ); }
+
+          virtual void HandleResponseWithHosts( XRootDStatus *status,
+                                                AnyObject    *response,
+                                                HostList     *hostList )
+          {
+            pReq->Done( this, status, response, hostList );
+          }
+
+          HedgedReadReq *pReq;
+          char          *pBuff;
+          bool           pOnReplica;
+      };
+
+      //------------------------------------------------------------------------
+      // Constructor, one reference for the primary leg and one for the timer
+      //------------------------------------------------------------------------
+      HedgedReadReq( HedgedReader *reader, uint64_t offset, uint32_t size,
+                     void *buffer, ResponseHandler *handler, uint16_t timeout ):
+        pReader( reader ), pOffset( offset ), pSize( size ),
+        pBuffer( buffer ), pHandler( handler ), pTimeout( timeout ),
+        pStart( 0 ), pRefs( 2 ), pLegsOut( 0 ), pDelivered( false ),
+        pHedged( false ), pLastErr( 0 )
+      {
+        pPrimary.pReq = this;
+        pReplica.pReq = this;
+        pReplica.pOnReplica = true;
+        pReader->Ref();
+      }
+
+      ~HedgedReadReq()
+      {
+        delete pLastErr;
+        pReader->Unref();
+      }
+
+      XRootDStatus Start( FileStateHandler *primary );
+      void         Done( Leg *leg, XRootDStatus *status, AnyObject *response,
+                         HostList *hostList );
+      void         Hedge();
+      void         Unref();
+
+    private:
+
+      HedgedReader    *pReader;
+      uint64_t         pOffset;
+      uint32_t         pSize;
+      void            *pBuffer;
+      ResponseHandler *pHandler;
+      uint16_t         pTimeout;
+      uint64_t         pStart;
+      XrdSysMutex      pMutex;
+      Leg              pPrimary;
+      Leg              pReplica;
+      int              pRefs;
+      int              pLegsOut;
+      bool             pDelivered;
+      bool             pHedged;
+      XRootDStatus    *pLastErr;
+  };
+
+  //----------------------------------------------------------------------------
+  // The hedge timer. One thread serves all the files; it holds a reference
+  // to every request until its deadline has passed.
+  //----------------------------------------------------------------------------
+  class HedgeTimer
+  {
+    public:
+
+      static void Schedule( HedgedReadReq *req, uint64_t when );
+
+      void Run();
+
+      HedgeTimer(): pCond( 0 ), pPid( 0 ) {}
+
+    private:
+
+      static void *Start( void *arg )
+      {
+        ((HedgeTimer *)arg)->Run();
+        return 0;
+      }
+
+      XrdSysCondVar                            pCond;
+      std::multimap<uint64_t, HedgedReadReq *> pQueue;
+      pid_t                                    pPid;
+  };
+
+  //----------------------------------------------------------------------------
+  // Queue a request, starting the timer thread if it is not running in this
+  // process. The timer is never destroyed as requests may be pending at exit.
+  // In a forked child the queue belongs to the parent and is abandoned.
+  //----------------------------------------------------------------------------
+  void HedgeTimer::Schedule( HedgedReadReq *req, uint64_t when )
+  {
+    static HedgeTimer *timer = new HedgeTimer();
+
+    timer->pCond.Lock();
+    if( timer->pPid != getpid() )
+    {
+      pthread_t tid;
+      if( XrdSysThread::Run( &tid, HedgeTimer::Start, timer, 0,
+                             "Hedged read timer" ) )
+      {
+        timer->pCond.UnLock();
+        Log *log = DefaultEnv::GetLog();
+        log->Error( FileMsg, "Unable to start the hedged read timer; %s",
+                    XrdSysE2T( errno ) );
+        req->Hedge();
+        return;
+      }
+      timer->pPid = getpid();
+      timer->pQueue.clear();
+    }
+
+    bool first = timer->pQueue.empty() || when < timer->pQueue.begin()->first;
+    timer->pQueue.insert( std::make_pair( when, req ) );
+    if( first ) timer->pCond.Signal();
+    timer->pCond.UnLock();
+  }
+
+  //----------------------------------------------------------------------------
+  // Fire the requests whose deadline has passed
+  //----------------------------------------------------------------------------
+  void HedgeTimer::Run()
+  {
+    std::vector<HedgedReadReq *> due;
+
+    while( 1 )
+    {
+      pCond.Lock();
+      while( 1 )
+      {
+        if( pQueue.empty() ) { pCond.Wait(); continue; }
+        uint64_t now = Now(), when = pQueue.begin()->first;
+        if( when <= now ) break;
+        int msec = ( when - now + 999 ) / 1000;
+        pCond.WaitMS( msec );
+      }
+
+      uint64_t now = Now();
+      while( !pQueue.empty() && pQueue.begin()->first <= now )
+      {
+        due.push_back( pQueue.begin()->second );
+        pQueue.erase( pQueue.begin() );
+      }
+      pCond.UnLock();
+
+      for( size_t i = 0; i < due.size(); ++i ) due[i]->Hedge();
+      due.clear();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Send the request to the primary and arm the hedge timer
+  //----------------------------------------------------------------------------
+  XRootDStatus HedgedReadReq::Start( FileStateHandler *primary )
+  {
+    if( !( pPrimary.pBuff = (char *)malloc( pSize ? pSize : 1 ) ) )
+      return XRootDStatus( stError, errOSError, ENOMEM );
+
+    pLegsOut = 1;
+    pStart   = Now();
+    XRootDStatus st = primary->Read( pOffset, pSize, pPrimary.pBuff,
+                                     &pPrimary, pTimeout );
+    if( !st.IsOK() ) return st;
+
+    HedgeTimer::Schedule( this, pStart + pReader->Delay() );
+    return st;
+  }
+
+  //----------------------------------------------------------------------------
+  // A copy of the request came back; the first good response (or the last
+  // error) goes to the user
+  //----------------------------------------------------------------------------
+  void HedgedReadReq::Done( Leg          *leg,
+                            XRootDStatus *status,
+                            AnyObject    *response,
+                            HostList     *hostList )
+  {
+    bool onReplica = leg->pOnReplica, deliver = false;
+
+    if( !onReplica && status->IsOK() )
+      pReader->AddSample( Now() - pStart );
+
+    pMutex.Lock();
+    pLegsOut--;
+    if( !pDelivered )
+    {
+      if( status->IsOK() )
+      {
+        ChunkInfo *chunk = 0;
+        if( response ) response->Get( chunk );
+        if( chunk )
+        {
+          if( chunk->length ) memcpy( pBuffer, leg->pBuff, chunk->length );
+          chunk->buffer = pBuffer;
+        }
+        deliver = true;
+      }
+      else if( !pLegsOut ) deliver = true;
+      else
+      {
+        delete pLastErr;
+        pLastErr = status;
+        status   = 0;
+      }
+      pDelivered = deliver;
+    }
+    pMutex.UnLock();
+
+    //--------------------------------------------------------------------------
+    // Account for the leg before the user sees the response, so that a close
+    // issued from the callback is not needlessly deferred
+    //--------------------------------------------------------------------------
+    if( deliver )
+    {
+      XrdSysMutexHelper scopedLock( pReader->pMutex );
+      pReader->pUserInFly--;
+      if( onReplica ) pReader->pWins++;
+    }
+    pReader->LegDone( onReplica );
+
+    if( deliver ) pHandler->HandleResponseWithHosts( status, response, hostList );
+    else
+    {
+      delete status;
+      delete response;
+      delete hostList;
+    }
+    Unref();
+  }
+
+  //----------------------------------------------------------------------------
+  // The deadline has passed, send a duplicate to the replica if we still have
+  // no response
+  //----------------------------------------------------------------------------
+  void HedgedReadReq::Hedge()
+  {
+    FileStateHandler *replica = 0;
+
+    pMutex.Lock();
+    bool wanted = !pDelivered && !pHedged && pLegsOut;
+    pMutex.UnLock();
+
+    if( wanted && ( replica = pReader->GetReplica() ) )
+    {
+      if( !( pReplica.pBuff = (char *)malloc( pSize ? pSize : 1 ) ) )
+        pReader->LegDone( true );
+      else
+      {
+        pMutex.Lock();
+        pHedged = true;
+        pLegsOut++;
+        pRefs++;
+        pMutex.UnLock();
+
+        XRootDStatus st = replica->Read( pOffset, pSize, pReplica.pBuff,
+                                         &pReplica, pTimeout );
+        if( st.IsOK() )
+        {
+          XrdSysMutexHelper scopedLock( pReader->pMutex );
+          pReader->pHedged++;
+        }
+        else
+        {
+          //--------------------------------------------------------------------
+          // The primary may have failed in the meantime, in which case its
+          // error is waiting for us to deliver
+          //--------------------------------------------------------------------
+          pMutex.Lock();
+          pLegsOut--;
+          pRefs--;
+          XRootDStatus *err = 0;
+          if( !pLegsOut && !pDelivered && pLastErr )
+          {
+            err        = pLastErr;
+            pLastErr   = 0;
+            pDelivered = true;
+          }
+          pMutex.UnLock();
+
+          if( err )
+          {
+            XrdSysMutexHelper scopedLock( pReader->pMutex );
+            pReader->pUserInFly--;
+          }
+          pReader->LegDone( true );
+          if( err ) pHandler->HandleResponse( err, 0 );
+        }
+      }
+    }
+
+    Unref();
+  }
+
+  //----------------------------------------------------------------------------
+  // Drop a reference, deleting the request with the last one
+  //----------------------------------------------------------------------------
+  void HedgedReadReq::Unref()
+  {
+    pMutex.Lock();
+    bool last = !--pRefs;
+    pMutex.UnLock();
+    if( last ) delete this;
+  }
+
+  //----------------------------------------------------------------------------
+  // Handle the replica location
+  //----------------------------------------------------------------------------
+  class HedgedLocateHandler: public ResponseHandler
+  {
+    public:
+      HedgedLocateHandler( HedgedReader *reader, FileSystem *fs ):
+        pReader( reader ), pFS( fs ) {}
+
+      virtual void HandleResponse( XRootDStatus *status, AnyObject *response )
+      {
+        LocationInfo *locations = 0;
+        if( response ) response->Get( locations );
+        pReader->Located( status, locations );
+        pReader->Unref();
+        delete status;
+        delete response;
+        delete pFS;
+        delete this;
+      }
+
+    private:
+      HedgedReader *pReader;
+      FileSystem   *pFS;
+  };
+
+  //----------------------------------------------------------------------------
+  // Handle the replica open
+  //----------------------------------------------------------------------------
+  class HedgedOpenHandler: public ResponseHandler
+  {
+    public:
+      HedgedOpenHandler( HedgedReader *reader ): pReader( reader ) {}
+
+      virtual void HandleResponse( XRootDStatus *status, AnyObject *response )
+      {
+        pReader->Opened( status );
+        pReader->Unref();
+        delete status;
+        delete response;
+        delete this;
+      }
+
+    private:
+      HedgedReader *pReader;
+  };
+
+  //----------------------------------------------------------------------------
+  // Delete the replica once it has been closed
+  //----------------------------------------------------------------------------
+  class HedgedCloseHandler: public ResponseHandler
+  {
+    public:
+      HedgedCloseHandler( FileStateHandler *replica ): pReplica( replica ) {}
+
+      virtual void HandleResponse( XRootDStatus *status, AnyObject *response )
+      {
+        delete status;
+        delete response;
+        delete pReplica;
+        delete this;
+      }
+
+    private:
+      FileStateHandler *pReplica;
+  };
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  HedgedReader::HedgedReader( FileStateHandler  *primary,
+                              const std::string &url ):
+    pPrimary( primary ), pReplica( 0 ), pUrl( url ), pSecState( secNone ),
+    pRefs( 1 ), pUserInFly( 0 ), pPrimLegs( 0 ), pReplLegs( 0 ),
+    pClosing( false ), pCloseHandler( 0 ), pCloseTimeout( 0 ),
+    pNumSamples( 0 ), pNextSample( 0 ), pReads( 0 ), pHedged( 0 ), pWins( 0 )
+  {
+    Env *env = DefaultEnv::GetEnv();
+    int  val;
+
+    val = DefaultHedgePercentile;
+    env->GetInt( "HedgePercentile", val );
+    pPercentile = ( val < 50 ? 50 : ( val > 99 ? 99 : val ) );
+
+    val = DefaultHedgeMinDelay;
+    env->GetInt( "HedgeMinDelay", val );
+    pMinDelay = ( val < 1 ? 1 : val ) * 1000;
+    pDelay    = pMinDelay;
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  HedgedReader::~HedgedReader()
+  {
+    delete pReplica;
+  }
+
+  //----------------------------------------------------------------------------
+  // Reference counting
+  //----------------------------------------------------------------------------
+  void HedgedReader::Ref()
+  {
+    XrdSysMutexHelper scopedLock( pMutex );
+    pRefs++;
+  }
+
+  void HedgedReader::Unref()
+  {
+    pMutex.Lock();
+    bool last = !--pRefs;
+    pMutex.UnLock();
+    if( last ) delete this;
+  }
+
+  //----------------------------------------------------------------------------
+  // Read a data chunk at a given offset
+  //----------------------------------------------------------------------------
+  XRootDStatus HedgedReader::Read( uint64_t         offset,
+                                   uint32_t         size,
+                                   void            *buffer,
+                                   ResponseHandler *handler,
+                                   uint16_t         timeout )
+  {
+    if( size > MaxHedgeSize )
+      return pPrimary->Read( offset, size, buffer, handler, timeout );
+
+    //--------------------------------------------------------------------------
+    // Once it is known that there is no replica to hedge to, the read goes
+    // straight into the user buffer
+    //--------------------------------------------------------------------------
+    pMutex.Lock();
+    if( pSecState == secFailed )
+    {
+      pMutex.UnLock();
+      return pPrimary->Read( offset, size, buffer, handler, timeout );
+    }
+    pUserInFly++;
+    pPrimLegs++;
+    pReads++;
+    pMutex.UnLock();
+
+    HedgedReadReq *req = new HedgedReadReq( this, offset, size, buffer,
+                                            handler, timeout );
+    XRootDStatus st = req->Start( pPrimary );
+    if( !st.IsOK() )
+    {
+      pMutex.Lock();
+      pUserInFly--;
+      pReads--;
+      pMutex.UnLock();
+      LegDone( false );
+      delete req;
+    }
+    return st;
+  }
+
+  //----------------------------------------------------------------------------
+  // Close the primary and the replica
+  //----------------------------------------------------------------------------
+  XRootDStatus HedgedReader::Close( ResponseHandler *handler,
+                                    uint16_t         timeout )
+  {
+    FileStateHandler *replica = 0;
+
+    pMutex.Lock();
+    if( pUserInFly || pClosing )
+    {
+      pMutex.UnLock();
+      return pPrimary->Close( handler, timeout );
+    }
+    pClosing = true;
+
+    if( pSecState == secOpen && !pReplLegs )
+    {
+      replica   = pReplica;
+      pReplica  = 0;
+      pSecState = secFailed;
+    }
+
+    Log *log = DefaultEnv::GetLog();
+    log->Debug( FileMsg, "[0x%x@%s] Hedged reads: %llu, hedged: %llu, won by "
+                "the replica: %llu", pPrimary, pUrl.c_str(),
+                (unsigned long long)pReads, (unsigned long long)pHedged,
+                (unsigned long long)pWins );
+
+    //--------------------------------------------------------------------------
+    // The losers of hedged reads may still be in flight at the primary, which
+    // would refuse to close; close it when they are back
+    //--------------------------------------------------------------------------
+    if( pPrimLegs )
+    {
+      pCloseHandler = handler;
+      pCloseTimeout = timeout;
+      pMutex.UnLock();
+      CloseReplica( replica );
+      return XRootDStatus();
+    }
+    pMutex.UnLock();
+
+    CloseReplica( replica );
+    return pPrimary->Close( handler, timeout );
+  }
+
+  //----------------------------------------------------------------------------
+  // Give up the reference of the File, which may no longer be used
+  //----------------------------------------------------------------------------
+  void HedgedReader::Release()
+  {
+    FileStateHandler *replica = 0;
+
+    pMutex.Lock();
+    pClosing = true;
+    if( pSecState == secOpen && !pReplLegs )
+    {
+      replica   = pReplica;
+      pReplica  = 0;
+      pSecState = secFailed;
+    }
+    pMutex.UnLock();
+
+    CloseReplica( replica );
+    Unref();
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the counters
+  //----------------------------------------------------------------------------
+  void HedgedReader::GetStats( std::string &value )
+  {
+    char buff[256];
+
+    pMutex.Lock();
+    snprintf( buff, sizeof( buff ), "reads=%llu hedged=%llu wins=%llu "
+              "delay=%u", (unsigned long long)pReads,
+              (unsigned long long)pHedged, (unsigned long long)pWins,
+              pDelay / 1000 );
+    pMutex.UnLock();
+    value = buff;
+  }
+
+  //----------------------------------------------------------------------------
+  // Record the latency of a primary read, recomputing the hedge delay every
+  // so often
+  //----------------------------------------------------------------------------
+  void HedgedReader::AddSample( uint32_t usec )
+  {
+    XrdSysMutexHelper scopedLock( pMutex );
+
+    pSamples[pNextSample] = usec;
+    pNextSample = ( pNextSample + 1 ) % NumSamples;
+    if( pNumSamples < NumSamples ) pNumSamples++;
+
+    if( pNumSamples < MinSamples || pNextSample % MinSamples ) return;
+
+    uint32_t sorted[NumSamples];
+    memcpy( sorted, pSamples, pNumSamples * sizeof( uint32_t ) );
+    int n = ( pNumSamples * pPercentile ) / 100;
+    std::nth_element( sorted, sorted + n, sorted + pNumSamples );
+    pDelay = std::max( sorted[n], pMinDelay );
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the current hedge delay in microseconds
+  //----------------------------------------------------------------------------
+  uint32_t HedgedReader::Delay()
+  {
+    XrdSysMutexHelper scopedLock( pMutex );
+    return pDelay;
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the replica to send a hedge to, locating and opening it the first
+  // time around. A non-null return has been accounted for as a replica leg.
+  //----------------------------------------------------------------------------
+  FileStateHandler *HedgedReader::GetReplica()
+  {
+    pMutex.Lock();
+    if( pClosing || pSecState != secNone )
+    {
+      FileStateHandler *replica = 0;
+      if( !pClosing && pSecState == secOpen )
+      {
+        pReplLegs++;
+        replica = pReplica;
+      }
+      pMutex.UnLock();
+      return replica;
+    }
+    pSecState = secLocating;
+    pRefs++;
+    pMutex.UnLock();
+
+    URL         url( pUrl );
+    FileSystem *fs = new FileSystem( url );
+    HedgedLocateHandler *handler = new HedgedLocateHandler( this, fs );
+    XRootDStatus st = fs->DeepLocate( url.GetPath(), OpenFlags::PrefName,
+                                      handler );
+    if( !st.IsOK() )
+    {
+      delete handler;
+      delete fs;
+      pMutex.Lock();
+      pSecState = secFailed;
+      pRefs--;
+      pMutex.UnLock();
+    }
+    return 0;
+  }
+
+  //----------------------------------------------------------------------------
+  // Pick a replica other than the one we are reading from and open it
+  //----------------------------------------------------------------------------
+  void HedgedReader::Located( const XRootDStatus *status,
+                              LocationInfo       *locations )
+  {
+    Log        *log = DefaultEnv::GetLog();
+    std::string dataServer, replica;
+
+    //--------------------------------------------------------------------------
+    // The primary goes away once we are released, so only look at it while
+    // holding the lock
+    //--------------------------------------------------------------------------
+    pMutex.Lock();
+    if( !pClosing ) pPrimary->GetProperty( "DataServer", dataServer );
+    pMutex.UnLock();
+    size_t at = dataServer.rfind( '@' );
+    if( at != std::string::npos ) dataServer.erase( 0, at + 1 );
+
+    if( status->IsOK() && locations )
+    {
+      LocationInfo::Iterator it;
+      for( it = locations->Begin(); it != locations->End(); ++it )
+      {
+        if( !it->IsServer() || it->GetType() != LocationInfo::ServerOnline )
+          continue;
+        if( SameHost( it->GetAddress(), dataServer ) ) continue;
+        replica = it->GetAddress();
+        break;
+      }
+    }
+
+    pMutex.Lock();
+    if( replica.empty() || pClosing )
+    {
+      pSecState = secFailed;
+      pMutex.UnLock();
+      if( replica.empty() )
+        log->Debug( FileMsg, "[0x%x@%s] No replica other than %s to hedge "
+                    "reads to", pPrimary, pUrl.c_str(), dataServer.c_str() );
+      return;
+    }
+    pSecState = secOpening;
+    pRefs++;
+    pMutex.UnLock();
+
+    URL url( pUrl );
+    URL where( "root://" + replica );
+    url.SetHostPort( where.GetHostName(), where.GetPort() );
+
+    log->Debug( FileMsg, "[0x%x@%s] Hedging reads to %s", pPrimary,
+                pUrl.c_str(), replica.c_str() );
+
+    //--------------------------------------------------------------------------
+    // The replica is only published once it is open, so nobody else looks at
+    // it until then
+    //--------------------------------------------------------------------------
+    pReplica = new FileStateHandler();
+    HedgedOpenHandler *handler = new HedgedOpenHandler( this );
+    XRootDStatus st = pReplica->Open( url.GetURL(), OpenFlags::Read,
+                                      Access::None, handler, 0 );
+    if( !st.IsOK() )
+    {
+      delete handler;
+      pMutex.Lock();
+      delete pReplica;
+      pReplica  = 0;
+      pSecState = secFailed;
+      pRefs--;
+      pMutex.UnLock();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // The replica has been opened
+  //----------------------------------------------------------------------------
+  void HedgedReader::Opened( const XRootDStatus *status )
+  {
+    FileStateHandler *replica = 0;
+
+    pMutex.Lock();
+    if( !status->IsOK() )
+    {
+      Log *log = DefaultEnv::GetLog();
+      log->Debug( FileMsg, "[0x%x@%s] Unable to open the replica to hedge "
+                  "reads to: %s", pPrimary, pUrl.c_str(),
+                  status->ToStr().c_str() );
+      pSecState = secFailed;
+    }
+    else if( pClosing )
+    {
+      replica   = pReplica;
+      pReplica  = 0;
+      pSecState = secFailed;
+    }
+    else pSecState = secOpen;
+    pMutex.UnLock();
+
+    CloseReplica( replica );
+  }
+
+  //----------------------------------------------------------------------------
+  // A leg of a request is done, finish a pending close if it was the last one
+  //----------------------------------------------------------------------------
+  void HedgedReader::LegDone( bool onReplica )
+  {
+    FileStateHandler *replica = 0;
+    ResponseHandler  *handler = 0;
+    uint16_t          timeout = 0;
+    bool              doClose = false;
+
+    pMutex.Lock();
+    if( onReplica ) pReplLegs--;
+    else pPrimLegs--;
+
+    if( pClosing )
+    {
+      if( onReplica && !pReplLegs && pSecState == secOpen )
+      {
+        replica   = pReplica;
+        pReplica  = 0;
+        pSecState = secFailed;
+      }
+      if( !onReplica && !pPrimLegs && pCloseHandler )
+      {
+        handler = pCloseHandler;
+        timeout = pCloseTimeout;
+        pCloseHandler = 0;
+        doClose = true;
+      }
+    }
+    pMutex.UnLock();
+
+    CloseReplica( replica );
+
+    if( doClose )
+    {
+      XRootDStatus st = pPrimary->Close( handler, timeout );
+      if( !st.IsOK() && handler )
+        handler->HandleResponse( new XRootDStatus( st ), 0 );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Close the replica in the background and get rid of it
+  //----------------------------------------------------------------------------
+  void HedgedReader::CloseReplica( FileStateHandler *replica )
+  {
+    if( !replica ) return;
+
+    HedgedCloseHandler *handler = new HedgedCloseHandler( replica );
+    XRootDStatus st = replica->Close( handler, 0 );
+    if( !st.IsOK() )
+    {
+      delete handler;
+      delete replica;
+    }
+  }
+}
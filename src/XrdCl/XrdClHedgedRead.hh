@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_HEDGED_READ_HH__
+#define __XRD_CL_HEDGED_READ_HH__
+
+#include "XrdCl/XrdClXRootDResponses.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include <stdint.h>
+#include <string>
+
+namespace XrdCl
+{
+  class FileStateHandler;
+  class HedgedReadReq;
+
+  //----------------------------------------------------------------------------
+  //! Hedged reads for a file opened for reading.
+  //!
+  //! Every read is sent to the data server the file was opened at. When the
+  //! read has not completed within an adaptive delay (a percentile of the
+  //! recently observed read latencies) a duplicate is sent to another replica
+  //! and whichever response arrives first is handed to the user. The replica
+  //! is located and opened lazily, the first time a read needs hedging.
+  //!
+  //! Both copies of a hedged read land in private buffers and the winner is
+  //! copied into the user buffer, as the loser may still be in flight after
+  //! the user has been called back. Once it is known that no replica can be
+  //! used, reads go straight into the user buffer. The object is reference
+  //! counted because outstanding requests outlive the File that created it.
+  //----------------------------------------------------------------------------
+  class HedgedReader
+  {
+      friend class HedgedReadReq;
+      friend class HedgedLocateHandler;
+      friend class HedgedOpenHandler;
+
+    public:
+      //------------------------------------------------------------------------
+      //! Reads larger than this are never hedged
+      //------------------------------------------------------------------------
+      static const uint32_t MaxHedgeSize = 16 * 1024 * 1024;
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param primary the opened (or opening) file
+      //! @param url     the url the file has been opened with
+      //------------------------------------------------------------------------
+      HedgedReader( FileStateHandler *primary, const std::string &url );
+
+      //------------------------------------------------------------------------
+      //! Read a data chunk at a given offset, hedging it if it is slow
+      //!
+      //! @see File::Read
+      //------------------------------------------------------------------------
+      XRootDStatus Read( uint64_t         offset,
+                         uint32_t         size,
+                         void            *buffer,
+                         ResponseHandler *handler,
+                         uint16_t         timeout );
+
+      //------------------------------------------------------------------------
+      //! Close the primary file and the replica. The primary is closed only
+      //! after the losing halves of the hedged reads have come back.
+      //!
+      //! @see File::Close
+      //------------------------------------------------------------------------
+      XRootDStatus Close( ResponseHandler *handler,
+                          uint16_t         timeout );
+
+      //------------------------------------------------------------------------
+      //! Format the counters as "reads=n hedged=n wins=n delay=ms"
+      //------------------------------------------------------------------------
+      void GetStats( std::string &value );
+
+      //------------------------------------------------------------------------
+      //! Drop the reference held by the File, after which the primary file
+      //! must not be touched anymore
+      //------------------------------------------------------------------------
+      void Release();
+
+      //------------------------------------------------------------------------
+      //! Reference counting, the creator holds the first reference
+      //------------------------------------------------------------------------
+      void Ref();
+      void Unref();
+
+    private:
+
+      ~HedgedReader();
+
+      enum SecState { secNone, secLocating, secOpening, secOpen, secFailed };
+
+      void              AddSample( uint32_t usec );
+      FileStateHandler *GetReplica();
+      void              LegDone( bool onReplica );
+      void              Located( const XRootDStatus *status,
+                                 LocationInfo       *locations );
+      void              Opened( const XRootDStatus *status );
+      uint32_t          Delay();
+      void              CloseReplica( FileStateHandler *replica );
+
+      static const int  NumSamples = 256;
+      static const int  MinSamples = 16;
+
+      XrdSysMutex       pMutex;
+      FileStateHandler *pPrimary;
+      FileStateHandler *pReplica;
+      std::string       pUrl;
+      SecState          pSecState;
+      int               pRefs;
+      int               pUserInFly;
+      int               pPrimLegs;
+      int               pReplLegs;
+      bool              pClosing;
+      ResponseHandler  *pCloseHandler;
+      uint16_t          pCloseTimeout;
+
+      uint32_t          pSamples[NumSamples];
+      int               pNumSamples;
+      int               pNextSample;
+      uint32_t          pDelay;       // Current hedge delay in microseconds
+      uint32_t          pMinDelay;
+      int               pPercentile;
+
+      uint64_t          pReads;
+      uint64_t          pHedged;
+      uint64_t          pWins;
+  };
+}
+
+#endif // __XRD_CL_HEDGED_READ_HH__
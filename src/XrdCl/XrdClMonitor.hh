@@ -80,6 +80,20 @@ namespace XrdCl
         uint16_t    streams; //!< Number of streams
       };
 
+      //------------------------------------------------------------------------
+      //! Describe the reads done over a data sub-stream
+      //------------------------------------------------------------------------
+      struct SubStreamInfo
+      {
+        SubStreamInfo(): rBytes(0), rate(0), rCount(0), rtt(0), stalls(0)
+        {}
+        uint64_t    rBytes;  //!< Number of bytes read
+        uint64_t    rate;    //!< Smoothed read throughput in bytes/second
+        uint32_t    rCount;  //!< Number of reads
+        uint32_t    rtt;     //!< Smoothed microseconds to the first response
+        uint32_t    stalls;  //!< Number of times no data arrived for too long
+      };
+
       //------------------------------------------------------------------------
       //! Describe a server logout event
       //------------------------------------------------------------------------
@@ -92,6 +106,7 @@ namespace XrdCl
         uint64_t    sBytes;  //!< Number of bytes sent
         time_t      cTime;   //!< Seconds connected to the server
         Status      status;  //!< Disconnection status
+        std::vector<SubStreamInfo> subStreams; //!< Data sub-stream statistics
       };
 
       //------------------------------------------------------------------------
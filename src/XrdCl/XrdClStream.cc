@@ -999,6 +999,13 @@ namespace XrdCl
       i.sBytes = pBytesSent;
       i.cTime  = ::time(0) - pConnectionDone.tv_sec;
       i.status = status;
+
+      AnyObject                            qryResult;
+      std::vector<Monitor::SubStreamInfo> *qryResponse = 0;
+      pTransport->Query( XRootDQuery::SubStreamStats, qryResult, *pChannelData );
+      qryResult.Get( qryResponse );
+      if( qryResponse ) i.subStreams.swap( *qryResponse );
+      delete qryResponse;
       mon->Event( Monitor::EvDisconnect, &i );
     }
   }
@@ -28,6 +28,7 @@
 #include "XrdCl/XrdClSocket.hh"
 #include "XrdCl/XrdClMessage.hh"
 #include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClMonitor.hh"
 #include "XrdCl/XrdClSIDManager.hh"
 #include "XrdCl/XrdClUtils.hh"
 #include "XrdCl/XrdClTransportManager.hh"
@@ -55,7 +56,9 @@
 #include <sstream>
 #include <iomanip>
 #include <set>
+#include <map>
 #include <limits>
+#include <time.h>
 
 #if __cplusplus >= 201103L
 #include <atomic>
@@ -132,7 +135,12 @@ namespace XrdCl
   };
 
   //----------------------------------------------------------------------------
-  //! Selects less loaded stream for read operation over multiple streams
+  //! Selects the data sub-stream for reads over multiple streams. Each read
+  //! goes to the sub-stream expected to deliver it first, judging by the
+  //! bytes still outstanding on it, its measured throughput and its response
+  //! time. A sub-stream that has data outstanding but did not deliver anything
+  //! for longer than the stall time, plus the time its backlog should take at
+  //! its throughput, is left out until it delivers again.
   //----------------------------------------------------------------------------
   struct StreamSelector
   {
@@ -142,7 +150,10 @@ namespace XrdCl
         // Subtract one because we shouldn't take into account the control
         // stream.
         //----------------------------------------------------------------------
-        strmqueues.resize( size - 1, 0 );
+        strmload.resize( size - 1 );
+        int stall = DefaultSubStreamStallTime;
+        DefaultEnv::GetEnv()->GetInt( "SubStreamStallTime", stall );
+        stallTime = uint64_t( stall > 0 ? stall : 1 ) * 1000000;
       }
 
       //------------------------------------------------------------------------
@@ -150,7 +161,16 @@ namespace XrdCl
       //------------------------------------------------------------------------
       void AdjustQueues( uint16_t size )
       {
-         strmqueues.resize( size - 1, 0);
+         strmload.resize( size - 1 );
+      }
+
+      //------------------------------------------------------------------------
+      // Forget about everything in flight, the streams are being reconnected
+      //------------------------------------------------------------------------
+      void Reset()
+      {
+        pending.clear();
+        strmload.assign( strmload.size(), SubStreamLoad() );
       }
 
       //------------------------------------------------------------------------
@@ -158,38 +178,192 @@ namespace XrdCl
       //
       // @return          : substream number
       //------------------------------------------------------------------------
-      uint16_t Select( const std::vector<bool> &connected )
+      uint16_t Select( const std::vector<bool> &connected, uint64_t size )
       {
-        uint16_t ret    = 0;
-        size_t   minval = std::numeric_limits<size_t>::max();
+        uint64_t now = Now(), rateSum = 0, rateNum = 0;
+        uint16_t ret = 0, stalled = 0;
+        double   minval = std::numeric_limits<double>::max();
+        uint64_t minout = std::numeric_limits<uint64_t>::max();
+        uint16_t n = std::min( connected.size(), strmload.size() );
 
-        for( uint16_t i = 0; i < connected.size() && i < strmqueues.size(); ++i )
+        //----------------------------------------------------------------------
+        // Sub-streams that have not been measured yet are assumed to be as
+        // fast as the average of the others
+        //----------------------------------------------------------------------
+        for( uint16_t i = 0; i < n; ++i )
+          if( connected[i] && strmload[i].rate )
+          {
+            rateSum += strmload[i].rate;
+            ++rateNum;
+          }
+        uint64_t defRate = ( rateNum ? rateSum / rateNum : 1000000 );
+
+        for( uint16_t i = 0; i < n; ++i )
         {
           if( !connected[i] ) continue;
+          SubStreamLoad &sl = strmload[i];
+          uint64_t rate = ( sl.rate ? sl.rate : defRate );
+
+          //--------------------------------------------------------------------
+          // Progress is only seen when a whole response has arrived, so a
+          // large read legitimately takes a while. Allow for the time the
+          // backlog needs at the sub-stream's throughput.
+          //--------------------------------------------------------------------
+          if( sl.outBytes && now - sl.lastRecv > stallTime
+                                 + double( sl.outBytes ) * 1e6 / rate )
+          {
+            if( !sl.stalled ) { sl.stalled = true; ++sl.stalls; }
+            if( sl.outBytes < minout ) { stalled = i; minout = sl.outBytes; }
+            continue;
+          }
 
-          if( strmqueues[i] < minval )
+          double   eta  = sl.rtt + double( sl.outBytes + size ) * 1e6 / rate;
+          if( eta < minval )
           {
             ret = i;
-            minval = strmqueues[i];
+            minval = eta;
           }
         }
 
-        ++strmqueues[ret];
+        //----------------------------------------------------------------------
+        // If every sub-stream is stalled use the one with the least backlog
+        //----------------------------------------------------------------------
+        if( minval == std::numeric_limits<double>::max() ) ret = stalled;
         return ret + 1;
       }
 
-      //--------------------------------------------------------------------------
-      // Update queue for given substream
-      //--------------------------------------------------------------------------
-      void MsgReceived( uint16_t substrm )
+      //------------------------------------------------------------------------
+      // A read of size bytes, identified by sid, was sent expecting its
+      // response on the given substream
+      //------------------------------------------------------------------------
+      void MsgSent( uint16_t substrm, uint16_t sid, uint64_t size )
       {
-        if( substrm > 0 )
-        --strmqueues[substrm - 1];
+        if( substrm == 0 || substrm > strmload.size() ) return;
+        SubStreamLoad &sl = strmload[substrm - 1];
+        uint64_t now = Now();
+
+        ReadInfo &ri = pending[sid];
+        if( ri.substrm ) Done( ri, now );
+        ri.substrm  = substrm;
+        ri.left     = size;
+        ri.start    = now;
+        ri.gotFirst = false;
+
+        if( !sl.outBytes ) sl.lastRecv = now;
+        sl.outBytes += size;
+        ++sl.rCount;
+      }
+
+      //------------------------------------------------------------------------
+      // A response carrying dlen bytes for the request sid has been received
+      //------------------------------------------------------------------------
+      void MsgReceived( uint16_t sid, uint64_t dlen, bool final )
+      {
+        std::map<uint16_t, ReadInfo>::iterator it = pending.find( sid );
+        if( it == pending.end() ) return;
+        ReadInfo      &ri = it->second;
+        SubStreamLoad &sl = strmload[ri.substrm - 1];
+        uint64_t now = Now();
+
+        //----------------------------------------------------------------------
+        // The time to the first response is the sub-stream's response time
+        //----------------------------------------------------------------------
+        if( !ri.gotFirst )
+        {
+          uint64_t rtt = now - ri.start;
+          sl.rtt = ( sl.rtt ? ( 7 * sl.rtt + rtt ) / 8 : rtt );
+          ri.gotFirst = true;
+        }
+
+        //----------------------------------------------------------------------
+        // The throughput is measured over the time the sub-stream was busy
+        //----------------------------------------------------------------------
+        uint64_t got = std::min( dlen, ri.left );
+        ri.left      -= got;
+        sl.outBytes  -= std::min( got, sl.outBytes );
+        sl.rBytes    += got;
+        sl.winBytes  += got;
+        sl.winTime   += now - sl.lastRecv;
+        sl.lastRecv   = now;
+        sl.stalled    = false;
+        if( sl.winTime >= 20000 || sl.winBytes >= 4194304 )
+        {
+          if( sl.winTime )
+          {
+            uint64_t rate = sl.winBytes * 1000000 / sl.winTime;
+            sl.rate = ( sl.rate ? ( 3 * sl.rate + rate ) / 4 : rate );
+          }
+          sl.winBytes = sl.winTime = 0;
+        }
+
+        if( final )
+        {
+          Done( ri, now );
+          pending.erase( it );
+        }
+      }
+
+      //------------------------------------------------------------------------
+      // Get the statistics of each data sub-stream
+      //------------------------------------------------------------------------
+      void GetStats( std::vector<Monitor::SubStreamInfo> &stats )
+      {
+        stats.resize( strmload.size() );
+        for( size_t i = 0; i < strmload.size(); ++i )
+        {
+          stats[i].rBytes = strmload[i].rBytes;
+          stats[i].rCount = strmload[i].rCount;
+          stats[i].rtt    = strmload[i].rtt;
+          stats[i].rate   = strmload[i].rate;
+          stats[i].stalls = strmload[i].stalls;
+        }
       }
 
     private:
 
-      std::vector<size_t> strmqueues;
+      struct SubStreamLoad
+      {
+        SubStreamLoad(): outBytes(0), rBytes(0), rate(0), lastRecv(0),
+                         winBytes(0), winTime(0), rtt(0), rCount(0),
+                         stalls(0), stalled(false) {}
+        uint64_t outBytes;  // Bytes requested but not yet received
+        uint64_t rBytes;    // Bytes received
+        uint64_t rate;      // Smoothed throughput in bytes/second
+        uint64_t lastRecv;  // When data was last received (or became due)
+        uint64_t winBytes;  // Bytes received in the current rate window
+        uint64_t winTime;   // Busy time in the current rate window
+        uint32_t rtt;       // Smoothed response time in microseconds
+        uint32_t rCount;    // Number of reads
+        uint32_t stalls;    // Number of times the sub-stream stalled
+        bool     stalled;
+      };
+
+      struct ReadInfo
+      {
+        ReadInfo(): substrm(0), left(0), start(0), gotFirst(false) {}
+        uint16_t substrm;
+        uint64_t left;
+        uint64_t start;
+        bool     gotFirst;
+      };
+
+      void Done( ReadInfo &ri, uint64_t now )
+      {
+        SubStreamLoad &sl = strmload[ri.substrm - 1];
+        sl.outBytes -= std::min( ri.left, sl.outBytes );
+        if( !sl.outBytes ) sl.lastRecv = now;
+      }
+
+      static uint64_t Now()
+      {
+        timespec ts;
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+        return uint64_t( ts.tv_sec ) * 1000000 + ts.tv_nsec / 1000;
+      }
+
+      std::vector<SubStreamLoad>   strmload;
+      std::map<uint16_t, ReadInfo> pending;
+      uint64_t                     stallTime;
   };
 
   //----------------------------------------------------------------------------
@@ -769,7 +943,33 @@ namespace XrdCl
       return PathID( 0, 0 );
 
     //--------------------------------------------------------------------------
-    // Select the streams
+    // Find out how much data a read will bring back
+    //--------------------------------------------------------------------------
+    UnMarshallRequest( msg );
+    ClientRequestHdr *hdr = (ClientRequestHdr*)msg->GetBuffer();
+    uint64_t rsize  = 0;
+    bool     isRead = true;
+    switch( hdr->requestid )
+    {
+      case kXR_read:
+        rsize = ((ClientReadRequest*)msg->GetBuffer())->rlen;
+        break;
+      case kXR_pgread:
+        rsize = ((ClientPgReadRequest*)msg->GetBuffer())->rlen;
+        break;
+      case kXR_readv:
+      {
+        readahead_list *dataChunk = (readahead_list*)msg->GetBuffer( 24 );
+        for( size_t i = 0; i < hdr->dlen/sizeof(readahead_list); ++i )
+          rsize += dataChunk[i].rlen;
+        break;
+      }
+      default:
+        isRead = false;
+    }
+
+    //--------------------------------------------------------------------------
+    // Select the streams, only reads are worth sending elsewhere
     //--------------------------------------------------------------------------
     Log *log = DefaultEnv::GetLog();
     uint16_t upStream   = 0;
@@ -780,7 +980,7 @@ namespace XrdCl
       upStream   = hint->up;
       downStream = hint->down;
     }
-    else
+    else if( isRead )
     {
       upStream = 0;
       std::vector<bool> connected;
@@ -798,7 +998,7 @@ namespace XrdCl
       if( nbConnected == 0 )
         downStream = 0;
       else
-        downStream = info->strmSelector->Select( connected );
+        downStream = info->strmSelector->Select( connected, rsize );
     }
 
     if( upStream >= info->stream.size() )
@@ -817,11 +1017,19 @@ namespace XrdCl
       downStream = 0;
     }
 
+    //--------------------------------------------------------------------------
+    // When the path is final account for the read on its down stream
+    //--------------------------------------------------------------------------
+    if( hint && isRead )
+    {
+      uint16_t sid;
+      memcpy( &sid, hdr->streamid, sizeof( sid ) );
+      info->strmSelector->MsgSent( downStream, sid, rsize );
+    }
+
     //--------------------------------------------------------------------------
     // Modify the message
     //--------------------------------------------------------------------------
-    UnMarshallRequest( msg );
-    ClientRequestHdr *hdr = (ClientRequestHdr*)msg->GetBuffer();
     switch( hdr->requestid )
     {
       //------------------------------------------------------------------------
@@ -915,6 +1123,11 @@ namespace XrdCl
     channelData.Get( info );
     XrdSysMutexHelper scopedLock( info->mutex );
 
+    //--------------------------------------------------------------------------
+    // We are (re)connecting, nothing is in flight on the sub-streams anymore
+    //--------------------------------------------------------------------------
+    info->strmSelector->Reset();
+
     //--------------------------------------------------------------------------
     // If the connection has been opened in order to orchestrate a TPC or
     // the remote server is a Manager or Metamanager we will need only one
@@ -1351,6 +1564,18 @@ namespace XrdCl
       case XRootDQuery::IsEncrypted:
         result.Set( new bool( info->encrypted ), false );
         return Status();
+
+      //------------------------------------------------------------------------
+      // Data sub-stream statistics
+      //------------------------------------------------------------------------
+      case XRootDQuery::SubStreamStats:
+      {
+        std::vector<Monitor::SubStreamInfo> *stats =
+                                     new std::vector<Monitor::SubStreamInfo>();
+        info->strmSelector->GetStats( *stats );
+        result.Set( stats, false );
+        return Status();
+      }
     };
     return Status( stError, errQueryNotSupported );
   }
@@ -1368,15 +1593,29 @@ namespace XrdCl
     Log *log = DefaultEnv::GetLog();
 
     //--------------------------------------------------------------------------
-    // Update the substream queues
+    // Account for the data a read brought back
     //--------------------------------------------------------------------------
-    info->strmSelector->MsgReceived( subStream );
+    ServerResponse *rsp = (ServerResponse*)msg->GetBuffer();
+    if( rsp->hdr.status != kXR_attn )
+    {
+      uint16_t sid;
+      memcpy( &sid, rsp->hdr.streamid, sizeof( sid ) );
+      if( rsp->hdr.status == kXR_status &&
+          msg->GetSize() >= sizeof( ServerResponseStatus ) )
+      {
+        ServerResponseStatus *rspst = (ServerResponseStatus*)msg->GetBuffer();
+        info->strmSelector->MsgReceived( sid, rspst->bdy.dlen,
+                              rspst->bdy.resptype != XrdProto::kXR_PartialResult );
+      }
+      else
+        info->strmSelector->MsgReceived( sid, rsp->hdr.dlen,
+                                         rsp->hdr.status != kXR_oksofar );
+    }
 
     //--------------------------------------------------------------------------
     // Check whether this message is a response to a request that has
     // timed out, and if so, drop it
     //--------------------------------------------------------------------------
-    ServerResponse *rsp = (ServerResponse*)msg->GetBuffer();
     if( rsp->hdr.status == kXR_attn )
     {
       if( rsp->body.attn.actnum != (int32_t)htonl(kXR_asynresp) )
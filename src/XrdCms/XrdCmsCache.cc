@@ -28,9 +28,17 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
   
+#include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/param.h>
 #include <sys/types.h>
 
+#include <string>
+
 #include "XrdCms/XrdCmsCache.hh"
 #include "XrdCms/XrdCmsRRQ.hh"
 #include "XrdCms/XrdCmsTrace.hh"
@@ -61,21 +69,27 @@ class XrdCmsCacheJob : XrdJob
 {
 public:
 
-void   DoIt() {Cache.Recycle(myList); delete this;}
+void   DoIt() {Cache.Recycle(myShard, myList); delete this;}
 
-       XrdCmsCacheJob(XrdCmsKeyItem *List)
-                     : XrdJob("cache scrubber"), myList(List) {}
+       XrdCmsCacheJob(int sNum, XrdCmsKeyItem *List)
+                     : XrdJob("cache scrubber"), myList(List), myShard(sNum) {}
       ~XrdCmsCacheJob() {}
 
 private:
 
 XrdCmsKeyItem *myList;
+int            myShard;
 };
 
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
 /******************************************************************************/
   
+void *XrdCmsStartSnapshot(void *carg)
+     {XrdCmsCache *myCache = (XrdCmsCache *)carg;
+      return myCache->Snapshot();
+     }
+
 void *XrdCmsStartTickTock(void *carg)
      {XrdCmsCache *myCache = (XrdCmsCache *)carg;
       return myCache->TickTock();
@@ -116,18 +130,19 @@ void *XrdCmsStartTickTock(void *carg)
   
 int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   ShardInfo &sP = Shard4(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t xmask;
    int isrw = (Sel.Opts & XrdCmsSelect::Write), isnew = 0;
 
 // Serialize processing
 //
-   myMutex.Lock();
+   sP.Mutex.Lock();
 
 // Check for fast path processing
 //
    if (  !(iP = Sel.Path.TODRef) || !(iP->Key.Equiv(Sel.Path)))
-      if ((iP = Sel.Path.TODRef = CTable.Find(Sel.Path)))
+      if ((iP = Sel.Path.TODRef = sP.Table.Find(Sel.Path)))
          Sel.Path.Ref = iP->Key.Ref;
 
 // Add/Modify the entry
@@ -138,7 +153,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
            iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
            iP->Loc.hfvec = 0; iP->Loc.pfvec = 0; iP->Loc.qfvec = 0;
            iP->Loc.TOD_B = BClock;
-           iP->Key.TOD = Tock;
+           iP->Key.TOD = sP.Tock;
           } else {
            xmask = iP->Loc.pfvec;
            if (Sel.Opts & XrdCmsSelect::Pending) iP->Loc.pfvec |= mask;
@@ -155,8 +170,8 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
                      }
           }
       } else if (!(Sel.Opts & XrdCmsSelect::Advisory))
-                {Sel.Path.TOD = Tock;
-                 if ((iP = CTable.Add(Sel.Path)))
+                {Sel.Path.TOD = sP.Tock;
+                 if ((iP = sP.Table.Add(Sel.Path)))
                     {iP->Loc.pfvec    = (Sel.Opts&XrdCmsSelect::Pending?mask:0);
                      iP->Loc.hfvec    = mask;
                      iP->Loc.TOD_B    = BClock;
@@ -170,7 +185,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // All done
 //
-   myMutex.UnLock();
+   sP.Mutex.UnLock();
    return isnew;
 }
   
@@ -190,29 +205,30 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   ShardInfo &sP = Shard4(Sel.Path);
    XrdCmsKeyItem *iP;
    int gone4good;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP.Mutex.Lock();
 
 // Look up the entry and remove server
 //
-   if ((iP = CTable.Find(Sel.Path)))
+   if ((iP = sP.Table.Find(Sel.Path)))
       {iP->Loc.hfvec &= ~mask;
        iP->Loc.pfvec &= ~mask;
        if ((gone4good = (iP->Loc.hfvec == 0)))
           {if (nilTMO) iP->Loc.lifeline = nilTMO + time(0);
            if (!(Sel.Opts & XrdCmsSelect::Advisory)
-           &&  XrdCmsKeyItem::Unload(iP) && !CTable.Recycle(iP))
+           &&  sP.Table.Pool.Unload(iP) && !sP.Table.Recycle(iP))
               Say.Emsg("DelFile", "Delete failed for", iP->Key.Val);
           }
       } else gone4good = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   sP.Mutex.UnLock();
    return gone4good;
 }
   
@@ -231,17 +247,18 @@ int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   ShardInfo &sP = Shard4(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t bVec;
    int retc;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP.Mutex.Lock();
 
 // Look up the entry and return location information
 //
-   if ((iP = CTable.Find(Sel.Path)))
+   if ((iP = sP.Table.Find(Sel.Path)))
       {if ((bVec = (iP->Loc.TOD_B < BClock 
                  ? getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
           {iP->Loc.hfvec &= ~bVec; 
@@ -266,7 +283,7 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // All done
 //
-   myMutex.UnLock();
+   sP.Mutex.UnLock();
    Sel.Path.TODRef = iP;
    return retc;
 }
@@ -278,11 +295,12 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    EPNAME("UnkFile");
+   ShardInfo &sP = Shard4(Sel.Path);
    XrdCmsKeyItem *iP;
 
 // Make sure we have the proper information. If so, lock the hash table
 //
-   myMutex.Lock();
+   sP.Mutex.Lock();
 
 // Look up the entry and if valid update the unqueried vector. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -294,7 +312,7 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP.Mutex.UnLock();
    DEBUG("rc=" <<(iP ? 1 : 0) <<" path=" <<Sel.Path.Val);
    return (iP ? 1 : 0);
 }
@@ -313,7 +331,8 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 // Make sure we have the proper information. If so, lock the hash table
 //
    if (!Sel.InfoP) return DLTime;
-   myMutex.Lock();
+   ShardInfo &sP = Shard4(Sel.Path);
+   sP.Mutex.Lock();
 
 // Look up the entry and if valid add it to the callback queue. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -328,7 +347,7 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP.Mutex.UnLock();
    DEBUG("rc=" <<retc <<" path=" <<Sel.Path.Val);
    return retc;
 }
@@ -345,11 +364,51 @@ void XrdCmsCache::Bounce(SMask_t smask, int SNum)
 
 // Simply indicate that this server bounced
 //
-   myMutex.Lock();
+   LockAll();
    Bounced[SNum] = ++BClock;
    okVec |= smask;
    if (SNum > vecHi) vecHi = SNum;
-   myMutex.UnLock();
+   UnLockAll();
+}
+
+/******************************************************************************/
+
+void XrdCmsCache::Bounce(SMask_t smask, int SNum, const char *Host, int Port,
+                         unsigned int cfgID)
+{
+   bool isWarm;
+
+// Lock everything as we will be changing the bounce state
+//
+   LockAll();
+   bMutex.Lock();
+
+// If the snapshot had this very node in this slot, its cached locations are
+// still as good as they were when the snapshot was taken. Any other node that
+// gets the slot invalidates them. Either way, the snapshot slot is consumed.
+//
+   isWarm = Warm[SNum].Host && Warm[SNum].Port == Port
+         && Warm[SNum].cfgID == cfgID && !strcmp(Warm[SNum].Host, Host);
+   if (Warm[SNum].Host) {free(Warm[SNum].Host); Warm[SNum].Host = 0;}
+
+// Record the node so that it can be snapshotted
+//
+   if (Nodes[SNum].Host) free(Nodes[SNum].Host);
+   Nodes[SNum].Host  = strdup(Host);
+   Nodes[SNum].Port  = Port;
+   Nodes[SNum].cfgID = cfgID;
+
+// Now bounce the node unless we can trust the snapshot
+//
+   if (!isWarm) Bounced[SNum] = ++BClock;
+   okVec |= smask;
+   if (SNum > vecHi) vecHi = SNum;
+
+// All done
+//
+   bMutex.UnLock();
+   UnLockAll();
+   if (isWarm) Say.Emsg("Cache", "Using snapshot locations for", Host);
 }
 
 /******************************************************************************/
@@ -366,21 +425,23 @@ void XrdCmsCache::Drop(SMask_t smask, int SNum, int xHi)
 
 // Remove the node from the list of valid nodes
 //
-   myMutex.Lock();
+   LockAll();
    Bounced[SNum] = 0;
    okVec &= nmask;
    vecHi = xHi;
-   myMutex.UnLock();
+   if (Nodes[SNum].Host) {free(Nodes[SNum].Host); Nodes[SNum].Host = 0;}
+   UnLockAll();
 }
 
 /******************************************************************************/
 /* public                           I n i t                                   */
 /******************************************************************************/
   
-int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold)
+int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold,
+                      const char *snPath, int snIntv)
 {
-   XrdCmsKeyItem *iP;
    pthread_t tid;
+   int i;
 
 // Indicate whether we are a shared-everything setup as this changes how we
 // dispatch clients to newly discovered files (see Dispatch()).
@@ -389,7 +450,7 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 
 // Initialize the delay time and the bounce clock tick window
 //
-   DLTime = fxDelay; QDelay = fxQuery;
+   DLTime = fxDelay; QDelay = fxQuery; fxLife = fxHold;
    if (!(Tick = fxHold/XrdCmsKeyItem::TickRate)) Tick = 1;
 
 // Set the timeout for nil entries if one needs to be set. Since this may cause
@@ -401,6 +462,19 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
        nilTMO = static_cast<unsigned int>(nxHold);
       }
 
+// Get the first reserve of cache items
+//
+   for (i = 0; i < ShardNum; i++) Shard[i].Table.Pool.Replenish();
+
+// Warm up the cache from the last snapshot, if we have one. This is done
+// before any node can log in so no locking is needed.
+//
+   if (snPath)
+      {snapPath = strdup(snPath);
+       snapIntv = (snIntv > 0 ? snIntv : 300);
+       Load();
+      }
+
 // Start the clock thread
 //
    if (XrdSysThread::Run(&tid, XrdCmsStartTickTock, (void *)this,
@@ -409,17 +483,55 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
        return 0;
       }
 
-// Get the first reserve of cache items
+// Start the snapshot thread if need be
 //
-   iP = XrdCmsKeyItem::Alloc(0);
-   XrdCmsKeyItem::Unload((unsigned int)0);
-   iP->Recycle();
+   if (snPath && XrdSysThread::Run(&tid, XrdCmsStartSnapshot, (void *)this,
+                                   0, "Cache Snapshot"))
+      {Say.Emsg("Init", errno, "start cache snapshot");
+       return 0;
+      }
 
 // All done
 //
    return 1;
 }
 
+/******************************************************************************/
+/* public                          S l o t 4                                  */
+/******************************************************************************/
+
+int XrdCmsCache::Slot4(const char *Host, int Port)
+{
+   int i;
+
+// Find the slot the node had when the snapshot was taken
+//
+   bMutex.Lock();
+   for (i = 0; i < STMax; i++)
+       if (Warm[i].Host && Warm[i].Port == Port && !strcmp(Warm[i].Host, Host))
+          break;
+   bMutex.UnLock();
+   return (i < STMax ? i : -1);
+}
+
+/******************************************************************************/
+/* public                       S n a p s h o t                               */
+/******************************************************************************/
+
+void *XrdCmsCache::Snapshot()
+{
+
+// Periodically write out the cache
+//
+   do {XrdSysTimer::Snooze(snapIntv);
+       Save();
+      } while(1);
+
+// Keep compiler happy
+//
+   return (void *)0;
+}
+
 /******************************************************************************/
 /* public                       T i c k T o c k                               */
 /******************************************************************************/
@@ -427,16 +539,23 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 void *XrdCmsCache::TickTock()
 {
    XrdCmsKeyItem *iP;
+   unsigned int Tock = 0;
+   int i;
 
-// Simply adjust the clock and trim old entries
+// Simply adjust the clock and trim old entries, one shard at a time
 //
    do {XrdSysTimer::Snooze(Tick);
-       myMutex.Lock();
        Tock = (Tock+1) & XrdCmsKeyItem::TickMask;
+       bMutex.Lock();
        Bhistory[Tock].Start = Bhistory[Tock].End = 0;
-       iP = XrdCmsKeyItem::Unload(Tock);
-       myMutex.UnLock();
-       if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
+       bMutex.UnLock();
+       for (i = 0; i < ShardNum; i++)
+           {Shard[i].Mutex.Lock();
+            Shard[i].Tock = Tock;
+            iP = Shard[i].Table.Pool.Unload(Tock);
+            Shard[i].Mutex.UnLock();
+            if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(i, iP));
+           }
       } while(1);
 
 // Keep compiler happy
@@ -505,6 +624,7 @@ void XrdCmsCache::Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *iP,
 SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 {
    EPNAME("getBVec");
+   XrdSysMutexHelper bHelp(bMutex);
    SMask_t BVec(0);
    long long i;
 
@@ -516,7 +636,7 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 // Calculate the new vector
 //
    for (i = 0; i <= vecHi; i++)
-       if (TODb < Bounced[i]) BVec |= 1ULL << i;
+       if (TODb < Bounced[i]) BVec.Set(i);
 
    Bhistory[TODa].Vec   = BVec;
    Bhistory[TODa].Start = TODb;
@@ -527,12 +647,101 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
    return BVec;
 }
 
+/******************************************************************************/
+/*                                  L o a d                                   */
+/******************************************************************************/
+
+int XrdCmsCache::Load()
+{
+   XrdCmsKeyItem *iP;
+   FILE     *fP;
+   char      lBuff[MAXPATHLEN+XrdCmsSMask::nWords*32+8], hBuff[256], *cP;
+   long long sTime;
+   SMask_t   hfVec, pfVec, warmVec;
+   unsigned int cfgID;
+   int       sNum, Port, len, numLoaded = 0, numNodes = 0;
+
+// Open the snapshot, it need not exist
+//
+   if (!(fP = fopen(snapPath, "r")))
+      {if (errno != ENOENT) Say.Emsg("Cache", errno, "open snapshot", snapPath);
+       return 0;
+      }
+
+// Verify the header and make sure the snapshot is still relevant. Anything
+// older than the cache lifetime would have been discarded by now anyway.
+//
+   if (!fgets(lBuff, sizeof(lBuff), fP)
+   ||  sscanf(lBuff, "xrdcms-cache 1 %lld", &sTime) != 1)
+      {Say.Emsg("Cache", "Invalid snapshot", snapPath, "ignored.");
+       fclose(fP); return 0;
+      }
+   if (time(0) - sTime > fxLife)
+      {Say.Emsg("Cache", "Snapshot", snapPath, "is too old; ignored.");
+       fclose(fP); return 0;
+      }
+
+// Load the nodes and the locations. Locations are only retained for nodes
+// we know about; they become visible as those nodes log in again.
+//
+   while(fgets(lBuff, sizeof(lBuff), fP))
+        {len = strlen(lBuff);
+         if (!len || lBuff[len-1] != '\n') break;
+         lBuff[--len] = 0;
+         if (*lBuff == 'n')
+            {if (sscanf(lBuff, "n %d %u %d %255s", &sNum, &cfgID, &Port,
+                        hBuff) != 4 || sNum < 0 || sNum >= STMax) continue;
+             if (Warm[sNum].Host) free(Warm[sNum].Host);
+                else numNodes++;
+             Warm[sNum].Host  = strdup(hBuff);
+             Warm[sNum].Port  = Port;
+             Warm[sNum].cfgID = cfgID;
+             warmVec.Set(sNum);
+             continue;
+            }
+         if (lBuff[0] != 'f' || lBuff[1] != ' '
+         ||  !(cP = (char *)hfVec.Parse(lBuff+2)) || *cP++ != ' '
+         ||  !(cP = (char *)pfVec.Parse(cP))      || *cP++ != ' '
+         ||  *cP != '/' || !(hfVec &= warmVec)) continue;
+         XrdCmsKey  Key(cP, len - (cP - lBuff));
+         ShardInfo &sP = Shard4(Key);
+         Key.TOD = sP.Tock;
+         if (sP.Table.Find(Key) || !(iP = sP.Table.Add(Key))) continue;
+         iP->Loc.hfvec    = hfVec;
+         iP->Loc.pfvec    = pfVec & hfVec;
+         iP->Loc.qfvec    = 0;
+         iP->Loc.TOD_B    = BClock;
+         iP->Loc.deadline = 0;
+         iP->Loc.lifeline = 0;
+         numLoaded++;
+        }
+
+// Report what happened
+//
+   if (ferror(fP)) Say.Emsg("Cache", errno, "read snapshot", snapPath);
+   fclose(fP);
+   sprintf(lBuff, "%d cached locations for %d nodes loaded from",
+           numLoaded, numNodes);
+   Say.Emsg("Cache", lBuff, snapPath);
+   return numLoaded;
+}
+
+/******************************************************************************/
+/*                               L o c k A l l                                */
+/******************************************************************************/
+
+void XrdCmsCache::LockAll()
+{
+   for (int i = 0; i < ShardNum; i++) Shard[i].Mutex.Lock();
+}
+
 /******************************************************************************/
 /*                               R e c y c l e                                */
 /******************************************************************************/
   
-void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
+void XrdCmsCache::Recycle(int sNum, XrdCmsKeyItem *theList)
 {
+   ShardInfo &sP = Shard[sNum];
    XrdCmsKeyItem *iP;
    char msgBuff[100];
    int numNull, numHave, numFree, numRecycled = 0;
@@ -543,24 +752,24 @@ void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
         {theList = iP->Key.TODRef;
          if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
          if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
-         myMutex.Lock(); CTable.Recycle(iP); myMutex.UnLock();
+         sP.Mutex.Lock(); sP.Table.Recycle(iP); sP.Mutex.UnLock();
          numRecycled++;
         }
 
 // See if we have enough items in reserve
 //
-   myMutex.Lock();
-   XrdCmsKeyItem::Stats(numHave, numFree, numNull);
+   sP.Mutex.Lock();
+   sP.Table.Pool.Stats(numHave, numFree, numNull);
    if (numFree < XrdCmsKeyItem::minFree)
-      {myMutex.UnLock();
+      {sP.Mutex.UnLock();
        if (!(numNull /= 4)) numNull = 1;
        numHave += XrdCmsKeyItem::minAlloc * numNull;
        while(numNull--)
-            {myMutex.Lock();
-             numFree = XrdCmsKeyItem::Replenish();
-             myMutex.UnLock();
+            {sP.Mutex.Lock();
+             numFree = sP.Table.Pool.Replenish();
+             sP.Mutex.UnLock();
             }
-      } else myMutex.UnLock();
+      } else sP.Mutex.UnLock();
 
 // Log the stats
 //
@@ -568,3 +777,130 @@ void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
            numRecycled, numHave, numFree);
    Say.Emsg("Recycle", msgBuff);
 }
+
+/******************************************************************************/
+/*                                  S a v e                                   */
+/******************************************************************************/
+
+namespace
+{
+struct SaveInfo
+      {std::string   Buff;
+       SMask_t       Valid;
+       unsigned int  BClock;
+       unsigned int *Bounced;
+       int           vecHi;
+       int           numSaved;
+      };
+}
+
+int XrdCmsCache::Save()
+{
+   SaveInfo  sInfo;
+   FILE     *fP;
+   char      lBuff[512], tmpPath[MAXPATHLEN+8];
+   unsigned int hdrBounced[STMax];
+   SMask_t   hdrValid = 0;
+   int       i, rc = 0;
+
+// Create a temporary file that we will rename once it is complete
+//
+   snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", snapPath);
+   if (!(fP = fopen(tmpPath, "w")))
+      {Say.Emsg("Cache", errno, "create snapshot", tmpPath);
+       return 0;
+      }
+
+// Record the nodes. Any shard lock keeps the bounce state constant. We also
+// record when each node was bounced so that we can later exclude locations
+// for nodes that were replaced while we were writing the snapshot.
+//
+   snprintf(lBuff, sizeof(lBuff), "xrdcms-cache 1 %lld\n",
+            static_cast<long long>(time(0)));
+   sInfo.Buff = lBuff;
+   Shard[0].Mutex.Lock();
+   for (i = 0; i < STMax; i++)
+       {hdrBounced[i] = Bounced[i];
+        if (!Nodes[i].Host || !okVec.Test(i)) continue;
+        hdrValid.Set(i);
+        snprintf(lBuff, sizeof(lBuff), "n %d %u %d %s\n", i,
+                 Nodes[i].cfgID, Nodes[i].Port, Nodes[i].Host);
+        sInfo.Buff += lBuff;
+       }
+   Shard[0].Mutex.UnLock();
+   sInfo.numSaved = 0;
+
+// Copy out each shard in turn holding only its lock and write it out
+//
+   for (i = 0; i < ShardNum && !rc; i++)
+       {Shard[i].Mutex.Lock();
+        sInfo.Valid = hdrValid & okVec;
+        for (int j = 0; j <= vecHi; j++)
+            if (Bounced[j] != hdrBounced[j]) sInfo.Valid.Clr(j);
+        sInfo.BClock  = BClock;
+        sInfo.Bounced = Bounced;
+        sInfo.vecHi   = vecHi;
+        if (sInfo.Valid) Shard[i].Table.Apply(SaveItem, (void *)&sInfo);
+        Shard[i].Mutex.UnLock();
+        if (sInfo.Buff.size()
+        &&  fwrite(sInfo.Buff.data(), sInfo.Buff.size(), 1, fP) != 1)
+           rc = (errno ? errno : EIO);
+        sInfo.Buff.clear();
+       }
+
+// Close the file and put it in place
+//
+   if (fclose(fP) && !rc) rc = (errno ? errno : EIO);
+   if (!rc && rename(tmpPath, snapPath)) rc = errno;
+   if (rc)
+      {Say.Emsg("Cache", rc, "write snapshot", snapPath);
+       unlink(tmpPath);
+       return 0;
+      }
+   return sInfo.numSaved;
+}
+
+/******************************************************************************/
+/*                              S a v e I t e m                               */
+/******************************************************************************/
+
+int XrdCmsCache::SaveItem(XrdCmsKeyItem *iP, void *Arg)
+{
+   SaveInfo *sP = (SaveInfo *)Arg;
+   SMask_t hfVec;
+   char lBuff[XrdCmsSMask::nWords*32+8];
+   int n;
+
+// Skip unloaded items and items without a usable location
+//
+   if (!iP->Key.Hash || !(hfVec = iP->Loc.hfvec & sP->Valid)) return 0;
+
+// Remove any locations for nodes that bounced since the item was updated
+//
+   if (iP->Loc.TOD_B < sP->BClock)
+      for (int i = 0; i <= sP->vecHi; i++)
+          if (iP->Loc.TOD_B < sP->Bounced[i]) hfVec.Clr(i);
+   if (!hfVec) return 0;
+
+// Add the item
+//
+   lBuff[0] = 'f'; lBuff[1] = ' ';
+   n = 2 + hfVec.Format(lBuff+2);
+   lBuff[n++] = ' ';
+   n += (iP->Loc.pfvec & hfVec).Format(lBuff+n);
+   lBuff[n++] = ' ';
+   sP->Buff.append(lBuff, n);
+   sP->Buff.append(iP->Key.Val, iP->Key.Len);
+   sP->Buff += '\n';
+   sP->numSaved++;
+   return 0;
+}
+
+/******************************************************************************/
+/*                             U n L o c k A l l                              */
+/******************************************************************************/
+
+void XrdCmsCache::UnLockAll()
+{
+   for (int i = ShardNum-1; i >= 0; i--) Shard[i].Mutex.UnLock();
+}
@@ -72,42 +72,99 @@ int         WT4File(XrdCmsSelect &Sel, SMask_t mask);
 
 void        Bounce(SMask_t smask, int SNum);
 
+// This Bounce() is used when a node logs in. It records who the node is for
+// the cache snapshot. The node is not bounced when the cache was loaded from
+// a snapshot that had this very node, with the same configuration, in SNum.
+//
+void        Bounce(SMask_t smask, int SNum, const char *Host, int Port,
+                   unsigned int cfgID);
+
 void        Drop(SMask_t mask, int SNum, int xHi);
 
-int         Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold);
+int         Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold,
+                 const char *snPath=0, int snIntv=0);
+
+// Slot4() returns the slot the node had in the loaded snapshot or -1. Giving
+//         the node the same slot allows its cached locations to be used.
+//
+int         Slot4(const char *Host, int Port);
+
+// Save() writes a snapshot of the cache and returns the number of locations
+//        that were saved. It is periodically called when snapshots are on.
+//
+int         Save();
+
+void       *Snapshot();
 
 void       *TickTock();
 
 static const int min_nxTime = 60;
+static const int ShardNum   = 16;    // Must be a power of two
+static const int ShardMask  = ShardNum-1;
 
-            XrdCmsCache() : okVec(0), Tick(8*60*60), Tock(0), BClock(0), 
-                            nilTMO(0),
+            XrdCmsCache() : okVec(0), Tick(8*60*60), BClock(0), nilTMO(0),
                             DLTime(5), QDelay(5), Bhits(0), Bmiss(0), vecHi(-1),
-                            isDFS(0)
+                            isDFS(0), fxLife(8*60*60), snapPath(0),
+                            snapIntv(0)
                           {memset(Bounced,  0, sizeof(Bounced));
-                           memset(Bhistory, 0, sizeof(Bhistory));
+                           for (unsigned int i = 0; i < XrdCmsKeyItem::TickRate; i++)
+                               Bhistory[i].Start = Bhistory[i].End = 0;
+                           memset(Nodes,    0, sizeof(Nodes));
+                           memset(Warm,     0, sizeof(Warm));
                           }
            ~XrdCmsCache() {}   // Never gets deleted
 
 private:
 
+// The cache is partitioned by key hash into independently locked shards. Each
+// shard has its own table, item pool, and expiration clock. The bounce state
+// (Bounced, BClock, okVec, vecHi, Nodes) is only changed while holding every
+// shard lock so that holding any one of them is enough to read it. Bhistory
+// and its counters as well as Warm are serialized by bMutex, which is always
+// obtained after the shard locks, never before.
+//
+struct ShardInfo
+      {XrdSysMutex   Mutex;
+       XrdCmsNash    Table;
+       unsigned int  Tock;
+
+                     ShardInfo() : Table(1597, 2584), Tock(0) {}
+      };
+
+struct NodeInfo
+      {char         *Host;
+       int           Port;
+       unsigned int  cfgID;
+      };
+
 void          Add2Q(XrdCmsRRQInfo *Info, XrdCmsKeyItem *cp, int selOpts);
 void          Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *cinfo,
                        short roQ, short rwQ);
 SMask_t       getBVec(unsigned int todA, unsigned int &todB);
-void          Recycle(XrdCmsKeyItem *theList);
+int           Load();
+void          LockAll();
+void          Recycle(int sNum, XrdCmsKeyItem *theList);
+static int    SaveItem(XrdCmsKeyItem *iP, void *Arg);
+void          UnLockAll();
+
+inline
+ShardInfo    &Shard4(XrdCmsKey &Key)
+                    {if (!Key.Hash) Key.setHash();
+                     return Shard[(Key.Hash ^ (Key.Hash >> 16)) & ShardMask];
+                    }
 
 struct  {SMask_t      Vec;
          unsigned int Start;
          unsigned int End;
         }             Bhistory[XrdCmsKeyItem::TickRate];
 
-XrdSysMutex   myMutex;
-XrdCmsNash    CTable;
+ShardInfo     Shard[ShardNum];
+XrdSysMutex   bMutex;
+NodeInfo      Nodes[STMax];
+NodeInfo      Warm[STMax];
 unsigned int  Bounced[STMax];
 SMask_t       okVec;
 unsigned int  Tick;
-unsigned int  Tock;
 unsigned int  BClock;
          int  nilTMO;
          int  DLTime;
@@ -116,6 +173,9 @@ unsigned int  BClock;
          int  Bmiss;
          int  vecHi;
          int  isDFS;
+         int  fxLife;
+         char *snapPath;
+         int  snapIntv;
 };
 
 namespace XrdCms
@@ -420,12 +420,12 @@ int XrdCmsConfig::Configure2()
    sprintf(buff, " phase 2 %s initialization started.", myRole);
    Say.Say("++++++ ", myInstance, buff);
 
-// Fix up the QryMinum (we hard code 64 as the max) and P_gshr values.
+// Fix up the QryMinum (STMax is the max) and P_gshr values.
 // The QryMinum only applies to a metamanager and is set as 1 minus the min.
 //
         if (!isMeta)       QryMinum =  0;
    else if (QryMinum <  2) QryMinum =  0;
-   else if (QryMinum > 64) QryMinum = 64;
+   else if (QryMinum > STMax) QryMinum = STMax;
    if (P_gshr < 0) P_gshr = 0;
       else if (P_gshr > 100) P_gshr = 100;
 
@@ -434,7 +434,8 @@ int XrdCmsConfig::Configure2()
 //
    if (QryDelay < 0) QryDelay = LUPDelay;
    if (isManager) 
-      NoGo = !Cache.Init(cachelife,LUPDelay,QryDelay,baseFS.isDFS(),emptylife);
+      NoGo = !Cache.Init(cachelife,LUPDelay,QryDelay,baseFS.isDFS(),emptylife,
+                         cachesnap, cachesnapint);
 
 // Issue warning if the adminpath resides in /tmp
 //
@@ -555,6 +556,7 @@ int XrdCmsConfig::ConfigXeq(char *var, XrdOucStream &CFile, XrdSysError *eDest)
    TS_Xeq("dfs",           xdfs);    // Any,     non-dynamic
    TS_Xeq("export",        xexpo);   // Any,     non-dynamic
    TS_Xeq("fsxeq",         xfsxq);   // Server,  non-dynamic
+   TS_Xeq("fxsnap",        xfxsnp);  // Manager, non-dynamic
    TS_Xeq("localroot",     xlclrt);  // Any,     non-dynamic
    TS_Xeq("manager",       xmang);   // Server,  non-dynamic
    TS_Lib("namelib", N2N_Lib, &N2N_Parms);
@@ -791,6 +793,8 @@ void XrdCmsConfig::ConfigDefaults(void)
    Police   = 0;
    cachelife= 8*60*60;
    emptylife= 0;
+   cachesnap= 0;
+   cachesnapint = 5*60;
    pendplife=   60*60*24*7;
    DiskLinger=0;
    ProgCH   = 0;
@@ -1927,6 +1931,50 @@ int XrdCmsConfig::xfxhld(XrdSysError *eDest, XrdOucStream &CFile)
     return 0;
 }
 
+/******************************************************************************/
+/*                                x f x s n p                                 */
+/******************************************************************************/
+
+/* Function: xfxsnp
+
+   Purpose:  To parse the directive: fxsnap <path> [every <sec>]
+
+             <path> the file where the file location cache is periodically
+                    saved and from which it is reloaded at start-up so that
+                    a restarted manager need not query for every file again.
+             <sec>  number of seconds (or M, H, etc) between snapshots. The
+                    default is 5 minutes.
+
+   Type: Manager only, non-dynamic.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdCmsConfig::xfxsnp(XrdSysError *eDest, XrdOucStream &CFile)
+{
+    char *val;
+    int ct;
+
+    if (!isManager) return CFile.noEcho();
+
+    if (!(val = CFile.GetWord()))
+       {eDest->Emsg("Config", "fxsnap path not specified."); return 1;}
+    if (*val != '/')
+       {eDest->Emsg("Config", "fxsnap path is not absolute."); return 1;}
+    if (cachesnap) free(cachesnap);
+    cachesnap = strdup(val);
+
+    if (!(val = CFile.GetWord())) return 0;
+    if (strcmp(val, "every"))
+       {eDest->Emsg("Config", "invalid fxsnap option -", val); return 1;}
+    if (!(val = CFile.GetWord()))
+       {eDest->Emsg("Config", "fxsnap interval not specified."); return 1;}
+    if (XrdOuca2x::a2tm(*eDest, "fxsnap interval", val, &ct, 10)) return 1;
+
+    cachesnapint = ct;
+    return 0;
+}
+
 /******************************************************************************/
 /*                                x l c l r t                                 */
 /******************************************************************************/
@@ -228,6 +228,7 @@ int  xdfs(XrdSysError *edest, XrdOucStream &CFile);
 int  xexpo(XrdSysError *edest, XrdOucStream &CFile);
 int  xfsxq(XrdSysError *edest, XrdOucStream &CFile);
 int  xfxhld(XrdSysError *edest, XrdOucStream &CFile);
+int  xfxsnp(XrdSysError *edest, XrdOucStream &CFile);
 int  xlclrt(XrdSysError *edest, XrdOucStream &CFile);
 int  xmang(XrdSysError *edest, XrdOucStream &CFile);
 int  xnbsq(XrdSysError *edest, XrdOucStream &CFile);
@@ -268,6 +269,8 @@ char             *perfpgm;
 int               perfint;
 int               cachelife;
 int               emptylife;
+char             *cachesnap;
+int               cachesnapint;
 int               pendplife;
 int               FSlim;
 };
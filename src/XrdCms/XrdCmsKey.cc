@@ -52,23 +52,13 @@ void XrdCmsKey::setHash()
 }
 
 /******************************************************************************/
-/*                   C l a s s   X r d C m s K e y I t e m                    */
+/*                   C l a s s   X r d C m s K e y P o o l                    */
 /******************************************************************************/
 /******************************************************************************/
-/*                           S t a t i c   D a t a                            */
+/* public                          A l l o c                                  */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::TockTable[TickRate] = {0};
-XrdCmsKeyItem *XrdCmsKeyItem::Free    = 0;
-int            XrdCmsKeyItem::numFree = 0;
-int            XrdCmsKeyItem::numHave = 0;
-int            XrdCmsKeyItem::numNull = 0;
-
-/******************************************************************************/
-/* static public                   A l l o c                                  */
-/******************************************************************************/
-  
-XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
+XrdCmsKeyItem *XrdCmsKeyPool::Alloc(unsigned int theTock)
 {
   XrdCmsKeyItem *kP;
 
@@ -77,7 +67,7 @@ XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
    do {if ((kP = Free))
           {Free = kP->Next;
            numFree--;
-           theTock &= TickMask;
+           theTock &= XrdCmsKeyItem::TickMask;
            kP->Key.TOD    = theTock;
            kP->Key.TODRef = TockTable[theTock];
            TockTable[theTock] = kP;
@@ -98,9 +88,10 @@ XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
 /* public                        R e c y c l e                                */
 /******************************************************************************/
   
-void XrdCmsKeyItem::Recycle()
+void XrdCmsKeyPool::Recycle(XrdCmsKeyItem *theItem)
 {
    static char *noKey = (char *)"";
+   XrdCmsKey &Key = theItem->Key;
 
 // Clear up data areas
 //
@@ -109,7 +100,7 @@ void XrdCmsKeyItem::Recycle()
 
 // Put entry on the free list
 //
-   Next = Free; Free = this;
+   theItem->Next = Free; Free = theItem;
    numFree++;
 }
 
@@ -117,22 +108,24 @@ void XrdCmsKeyItem::Recycle()
 /* public                         R e l o a d                                 */
 /******************************************************************************/
   
-void XrdCmsKeyItem::Reload()
+void XrdCmsKeyPool::Reload(XrdCmsKeyItem *theItem)
 {
-   Key.TOD &= static_cast<unsigned char>(TickMask);
+   XrdCmsKey &Key = theItem->Key;
+
+   Key.TOD &= static_cast<unsigned char>(XrdCmsKeyItem::TickMask);
    Key.TODRef = TockTable[Key.TOD];
-   TockTable[Key.TOD] = this;
+   TockTable[Key.TOD] = theItem;
 }
 
 /******************************************************************************/
-/* static public               R e p l e n i s h                              */
+/* public                      R e p l e n i s h                              */
 /******************************************************************************/
 
-int XrdCmsKeyItem::Replenish()
+int XrdCmsKeyPool::Replenish()
 {
    EPNAME("Replenish");
    XrdCmsKeyItem *kP;
-   int i;
+   int i, minAlloc = XrdCmsKeyItem::minAlloc;
 
 // Allocate a quantum of free elements and chain them into the free list
 //
@@ -153,10 +146,10 @@ int XrdCmsKeyItem::Replenish()
 }
 
 /******************************************************************************/
-/* static public                   S t a t s                                  */
+/* public                          S t a t s                                  */
 /******************************************************************************/
 
-void XrdCmsKeyItem::Stats(int &isAlloc, int &isFree, int &wasNull)
+void XrdCmsKeyPool::Stats(int &isAlloc, int &isFree, int &wasNull)
 {
 
    isAlloc  = numHave;
@@ -166,10 +159,10 @@ void XrdCmsKeyItem::Stats(int &isAlloc, int &isFree, int &wasNull)
 }
 
 /******************************************************************************/
-/* static public                  U n l o a d                                 */
+/* public                         U n l o a d                                 */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
+XrdCmsKeyItem *XrdCmsKeyPool::Unload(unsigned int theTock)
 {
    XrdCmsKeyItem myItem, *nP, *pP = &myItem;
 
@@ -178,7 +171,7 @@ XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
 // make the entry unfindable by clearing the hash code. Since item recycling
 // requires knowing the hash code, we save it elsewhere in the object.
 //
-   theTock &= TickMask;
+   theTock &= XrdCmsKeyItem::TickMask;
    myItem.Key.TODRef = TockTable[theTock]; TockTable[theTock] = 0;
    while((nP = pP->Key.TODRef))
          if (nP->Key.TOD == theTock) 
@@ -192,10 +185,10 @@ XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
 
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::Unload(XrdCmsKeyItem *theItem)
+XrdCmsKeyItem *XrdCmsKeyPool::Unload(XrdCmsKeyItem *theItem)
 {
    XrdCmsKeyItem *kP, *pP = 0;
-   unsigned int theTock = theItem->Key.TOD & TickMask;
+   unsigned int theTock = theItem->Key.TOD & XrdCmsKeyItem::TickMask;
 
 // Remove the entry from the right list
 //
@@ -130,34 +130,51 @@ public:
        XrdCmsKey      Key;
        XrdCmsKeyItem *Next;
 
-static XrdCmsKeyItem *Alloc(unsigned int theTock);
+       XrdCmsKeyItem() {}  // Warning see the constructor!
+      ~XrdCmsKeyItem() {}  // These are usually never deleted
 
-       void           Recycle();
+static const unsigned int TickRate =   64;
+static const unsigned int TickMask =   63;
+static const          int minAlloc = 4096;
+static const          int minFree  = 1024;
+};
 
-       void           Reload();
+/******************************************************************************/
+/*                   C l a s s   X r d C m s K e y P o o l                    */
+/******************************************************************************/
 
-static int            Replenish();
+// The XrdCmsKeyPool object holds the free items and the expiration lists for
+// one XrdCmsNash. Items never move from one pool to another so that an item
+// is always protected by the lock that serializes access to its hash table.
+//
+class XrdCmsKeyPool
+{
+public:
 
-static void           Stats(int &isAlloc, int &isFree, int &wasEmpty);
+XrdCmsKeyItem *Alloc(unsigned int theTock);
 
-static XrdCmsKeyItem *Unload(unsigned int   theTock);
+void           Recycle(XrdCmsKeyItem *theItem);
 
-static XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem);
+void           Reload(XrdCmsKeyItem *theItem);
 
-       XrdCmsKeyItem() {}  // Warning see the constructor!
-      ~XrdCmsKeyItem() {}  // These are usually never deleted
+int            Replenish();
 
-static const unsigned int TickRate =   64;
-static const unsigned int TickMask =   63;
-static const          int minAlloc = 4096;
-static const          int minFree  = 1024;
+void           Stats(int &isAlloc, int &isFree, int &wasEmpty);
+
+XrdCmsKeyItem *Unload(unsigned int   theTock);
+
+XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem);
+
+               XrdCmsKeyPool() : Free(0), numFree(0), numHave(0), numNull(0)
+                               {memset(TockTable, 0, sizeof(TockTable));}
+              ~XrdCmsKeyPool() {}  // Never gets deleted
 
 private:
 
-static XrdCmsKeyItem *TockTable[TickRate];
-static XrdCmsKeyItem *Free;
-static int            numFree;
-static int            numHave;
-static int            numNull;
+XrdCmsKeyItem *TockTable[XrdCmsKeyItem::TickRate];
+XrdCmsKeyItem *Free;
+int            numFree;
+int            numHave;
+int            numNull;
 };
 #endif
@@ -58,7 +58,7 @@ XrdCmsKeyItem *XrdCmsNash::Add(XrdCmsKey &Key)
 
 // Allocate the entry
 //
-   if (!(hip = XrdCmsKeyItem::Alloc(Key.TOD))) return (XrdCmsKeyItem *)0;
+   if (!(hip = Pool.Alloc(Key.TOD))) return (XrdCmsKeyItem *)0;
 
 // Check if we should expand the table
 //
@@ -77,6 +77,28 @@ XrdCmsKeyItem *XrdCmsNash::Add(XrdCmsKey &Key)
    return hip;
 }
   
+/******************************************************************************/
+/* public                          A p p l y                                  */
+/******************************************************************************/
+
+XrdCmsKeyItem *XrdCmsNash::Apply(int (*func)(XrdCmsKeyItem *, void *),
+                                 void *Arg)
+{
+   XrdCmsKeyItem *nip;
+   int i;
+
+// Run through the whole table stopping when the function says so
+//
+   for (i = 0; i < nashtablesize; i++)
+       {nip = nashtable[i];
+        while(nip)
+             {if ((*func)(nip, Arg)) return nip;
+              nip = nip->Next;
+             }
+       }
+   return (XrdCmsKeyItem *)0;
+}
+
 /******************************************************************************/
 /* private                        E x p a n d                                 */
 /******************************************************************************/
@@ -172,7 +194,7 @@ int XrdCmsNash::Recycle(XrdCmsKeyItem *rip)
    if (nip)
       {if (pip) pip->Next = nip->Next;
           else nashtable[kent] = nip->Next;
-          rip->Recycle();
+          Pool.Recycle(rip);
           nashnum--;
       }
    return nip != 0;
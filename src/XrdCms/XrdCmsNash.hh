@@ -35,8 +35,14 @@
 class XrdCmsNash
 {
 public:
+XrdCmsKeyPool  Pool;  // Items and expiration lists used by this table
+
 XrdCmsKeyItem *Add(XrdCmsKey &Key);
 
+// Apply() calls func for each item in the table until func returns non-zero
+//
+XrdCmsKeyItem *Apply(int (*func)(XrdCmsKeyItem *, void *), void *Arg);
+
 XrdCmsKeyItem *Find(XrdCmsKey &Key);
 
 int            Recycle(XrdCmsKeyItem *rip);
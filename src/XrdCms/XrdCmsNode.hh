@@ -150,6 +150,8 @@ inline int    isNode(XrdLink *lp, const char *nid, int port)
 
 inline char  *Name()   {return (myName ? myName : (char *)"?");}
 
+inline int    Port()   {return netIF.Port();}
+
 inline SMask_t Mask() {return NodeMask;}
 
 inline void    g2Ref(XrdSysMutex &gMutex) {lkCount++; gMutex.UnLock();}
@@ -930,7 +930,8 @@ void XrdCmsProtocol::ConfigCheck(unsigned char *theConfig)
    if (ConfigID != myNode->ConfigID)
       {if (myNode->ConfigID) Say.Emsg("Protocol",Link->Name(),"reconfigured.");
        Cache.Paths.Remove(myNode->Mask());
-       Cache.Bounce(myNode->Mask(), myNode->ID(tmp));
+       Cache.Bounce(myNode->Mask(), myNode->ID(tmp), myNode->Name(),
+                    myNode->Port(), ConfigID);
        myNode->ConfigID = ConfigID;
       }
 }
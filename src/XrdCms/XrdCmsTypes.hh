@@ -30,13 +30,162 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
   
-typedef unsigned long long SMask_t;
+#include <stdio.h>
+#include <stdlib.h>
 
-#define FULLMASK 0xFFFFFFFFFFFFFFFFULL
+// The following defines our cell size (maximum subscribers). It must be a
+// multiple of 64.
+//
+#define STMax 256
+
+/******************************************************************************/
+/*                     C l a s s   X r d C m s S M a s k                      */
+/******************************************************************************/
+
+// The XrdCmsSMask object is a fixed width bit vector with one bit per node in
+// the cell. It is kept as an array of 64-bit words which is simply iterated
+// so that the compiler can vectorize the operations. A zero-valued mask is
+// false, any other mask is true. An integral value only sets the low word.
+//
+class XrdCmsSMask
+{
+public:
+
+static const int nWords = STMax/64;
+
+inline bool         Any() const
+                       {unsigned long long x = 0;
+                        for (int i = 0; i < nWords; i++) x |= w[i];
+                        return x != 0;
+                       }
+
+static inline
+XrdCmsSMask         Bit(int n) {XrdCmsSMask m; return m.Set(n);}
+
+inline XrdCmsSMask &Clr(int n)
+                       {w[n>>6] &= ~(1ULL << (n & 63)); return *this;}
+
+inline int          Count() const
+                       {int n = 0;
+                        for (int i = 0; i < nWords; i++)
+                            n += __builtin_popcountll(w[i]);
+                        return n;
+                       }
+
+// First() returns the number of the lowest bit that is set or -1 if none are.
+//
+inline int          First() const
+                       {for (int i = 0; i < nWords; i++)
+                            if (w[i]) return (i<<6) + __builtin_ctzll(w[i]);
+                        return -1;
+                       }
+
+// Format() produces the mask as a hex string and returns its length. The
+//          buffer must have at least nWords*16+1 bytes.
+//
+inline int          Format(char *buff) const
+                       {int i = nWords-1, n;
+                        while(i > 0 && !w[i]) i--;
+                        n = sprintf(buff, "%llx", w[i]);
+                        while(i-- > 0) n += sprintf(buff+n, "%016llx", w[i]);
+                        return n;
+                       }
+
+static inline
+XrdCmsSMask         Full() {XrdCmsSMask m; return ~m;}
+
+inline bool         Multiple() const
+                       {bool one = false;
+                        for (int i = 0; i < nWords; i++)
+                            if (w[i])
+                               {if (one || (w[i] & (w[i]-1))) return true;
+                                one = true;
+                               }
+                        return false;
+                       }
+
+// Parse() sets the mask from a hex string and returns a pointer to the first
+//         character that was not used or nil if the string is not valid.
+//
+inline const char  *Parse(const char *str)
+                       {const char *eP = str;
+                        int j;
+                        while((*eP >= '0' && *eP <= '9')
+                           || (*eP >= 'a' && *eP <= 'f')) eP++;
+                        if (eP == str || eP - str > nWords*16) return 0;
+                        for (j = 0; j < nWords; j++) w[j] = 0;
+                        for (j = 0; eP - j > str; j++)
+                            {char c = *(eP-j-1);
+                             unsigned long long d = (c <= '9' ? c-'0' : c-'a'+10);
+                             w[j>>4] |= d << ((j & 15)*4);
+                            }
+                        return eP;
+                       }
 
-// The following defines our cell size (maximum subscribers)
+// Hex() formats the mask into buff, as Format() does, and returns buff.
 //
-#define STMax 64
+inline const char  *Hex(char *buff) const {Format(buff); return buff;}
+
+inline XrdCmsSMask &Set(int n)
+                       {w[n>>6] |= 1ULL << (n & 63); return *this;}
+
+inline bool         Test(int n) const
+                       {return (w[n>>6] & (1ULL << (n & 63))) != 0;}
+
+inline explicit     operator bool() const {return Any();}
+
+inline XrdCmsSMask  operator~() const
+                       {XrdCmsSMask m;
+                        for (int i = 0; i < nWords; i++) m.w[i] = ~w[i];
+                        return m;
+                       }
+
+inline XrdCmsSMask &operator&=(const XrdCmsSMask &rhs)
+                       {for (int i = 0; i < nWords; i++) w[i] &= rhs.w[i];
+                        return *this;
+                       }
+
+inline XrdCmsSMask &operator|=(const XrdCmsSMask &rhs)
+                       {for (int i = 0; i < nWords; i++) w[i] |= rhs.w[i];
+                        return *this;
+                       }
+
+inline XrdCmsSMask &operator^=(const XrdCmsSMask &rhs)
+                       {for (int i = 0; i < nWords; i++) w[i] ^= rhs.w[i];
+                        return *this;
+                       }
+
+inline XrdCmsSMask  operator&(const XrdCmsSMask &rhs) const
+                       {XrdCmsSMask m(*this); return m &= rhs;}
+
+inline XrdCmsSMask  operator|(const XrdCmsSMask &rhs) const
+                       {XrdCmsSMask m(*this); return m |= rhs;}
+
+inline XrdCmsSMask  operator^(const XrdCmsSMask &rhs) const
+                       {XrdCmsSMask m(*this); return m ^= rhs;}
+
+inline bool         operator==(const XrdCmsSMask &rhs) const
+                       {unsigned long long x = 0;
+                        for (int i = 0; i < nWords; i++) x |= w[i] ^ rhs.w[i];
+                        return x == 0;
+                       }
+
+inline bool         operator!=(const XrdCmsSMask &rhs) const
+                       {return !(*this == rhs);}
+
+                    XrdCmsSMask(unsigned long long val=0)
+                               {w[0] = val;
+                                for (int i = 1; i < nWords; i++) w[i] = 0;
+                               }
+
+private:
+
+unsigned long long w[nWords];
+};
+
+typedef XrdCmsSMask SMask_t;
+
+#define FULLMASK XrdCmsSMask::Full()
 
 // The following defines the maximum number of redirectors. It is one greater
 // than the actual maximum as the zeroth is never used.
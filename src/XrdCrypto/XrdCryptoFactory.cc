@@ -118,6 +118,14 @@ bool XrdCryptoFactory::HasPaddingSupport()
    return 0;
 }
 
+//______________________________________________________________________________
+bool XrdCryptoFactory::HasECDHSupport()
+{
+   // Returns true if ECDH key agreement is supported by the implementation
+
+   return 0;
+}
+
 //______________________________________________________________________________
 XrdCryptoCipher *XrdCryptoFactory::Cipher(const char *, int)
 {
@@ -173,6 +181,16 @@ XrdCryptoCipher *XrdCryptoFactory::Cipher(const XrdCryptoCipher &)
    return 0;
 }
 
+//______________________________________________________________________________
+XrdCryptoCipher *XrdCryptoFactory::ECDHCipher()
+{
+   // Return an instance of an implementation of XrdCryptoCipher
+   // ready for an ECDH key agreement.
+
+   ABSTRACTMETHOD("XrdCryptoFactory::ECDHCipher");
+   return 0;
+}
+
 //______________________________________________________________________________
 bool XrdCryptoFactory::SupportedMsgDigest(const char *)
 {
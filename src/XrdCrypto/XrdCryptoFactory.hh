@@ -147,6 +147,7 @@ public:
    // Cipher constructors
    virtual bool SupportedCipher(const char *t);
    virtual bool HasPaddingSupport();
+   virtual bool HasECDHSupport();
    virtual XrdCryptoCipher *Cipher(const char *t, int l = 0);
    virtual XrdCryptoCipher *Cipher(const char *t, int l, const char *k, 
                                    int liv, const char *iv);
@@ -154,6 +155,9 @@ public:
    virtual XrdCryptoCipher *Cipher(int bits, char *pub, int lpub, const char *t = 0);
    virtual XrdCryptoCipher *Cipher(bool padded, int bits, char *pub, int lpub, const char *t);
    virtual XrdCryptoCipher *Cipher(const XrdCryptoCipher &c);
+   // Reference cipher for an ECDH key agreement (see Cipher(bool,int,...)
+   // for the counterpart and Finalize() for completion)
+   virtual XrdCryptoCipher *ECDHCipher();
 
    // MsgDigest constructors
    virtual bool SupportedMsgDigest(const char *dgst);
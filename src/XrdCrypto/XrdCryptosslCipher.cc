@@ -42,6 +42,69 @@
 #include <openssl/pem.h>
 #include <openssl/dh.h>
 
+#if defined(HAVE_ECDH_X25519)
+// Length of a raw X25519 public key
+#define kECPUBLEN 32
+
+//____________________________________________________________________________
+static EVP_PKEY *ECGenerate()
+{
+   // Generate an ephemeral X25519 key pair
+
+   EVP_PKEY *key = 0;
+   EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_X25519, 0);
+   if (pctx && EVP_PKEY_keygen_init(pctx) > 0)
+      EVP_PKEY_keygen(pctx, &key);
+   EVP_PKEY_CTX_free(pctx);
+   return key;
+}
+
+//____________________________________________________________________________
+static EVP_PKEY *ECPeerKey(const char *pub, int lpub)
+{
+   // Extract the X25519 public key of the counterpart from a key agreement
+   // buffer of the form "---BECP---<hex>---EECP---" (see Public()).
+   // Returns 0 if the buffer does not contain one (e.g. DH parameters).
+   static const char *hexdig = "0123456789ABCDEF";
+   unsigned char raw[kECPUBLEN];
+
+   if (!pub || lpub < 2*kECPUBLEN + 19 || strncmp(pub, "---BECP---", 10) ||
+       strncmp(pub + 10 + 2*kECPUBLEN, "---EECP--", 9))
+      return 0;
+   pub += 10;
+   for (int i = 0; i < kECPUBLEN; i++) {
+      const char *hi = strchr(hexdig, pub[2*i]);
+      const char *lo = strchr(hexdig, pub[2*i+1]);
+      if (!hi || !lo || !*hi || !*lo) return 0;
+      raw[i] = (unsigned char)(((hi - hexdig) << 4) | (lo - hexdig));
+   }
+   return EVP_PKEY_new_raw_public_key(EVP_PKEY_X25519, 0, raw, kECPUBLEN);
+}
+
+//____________________________________________________________________________
+static int ECDerive(EVP_PKEY *key, EVP_PKEY *peer, char *&ktmp)
+{
+   // Compute the shared secret into a new buffer at ktmp.
+   // Returns its length or 0 on failure.
+
+   size_t lsec = 0;
+   EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new(key, 0);
+   if (pctx && EVP_PKEY_derive_init(pctx) > 0 &&
+       EVP_PKEY_derive_set_peer(pctx, peer) > 0 &&
+       EVP_PKEY_derive(pctx, 0, &lsec) > 0) {
+      ktmp = new char[lsec];
+      if (EVP_PKEY_derive(pctx, (unsigned char *)ktmp, &lsec) <= 0)
+         lsec = 0;
+   }
+   EVP_PKEY_CTX_free(pctx);
+   return (int)lsec;
+}
+#else
+static EVP_PKEY *ECGenerate() { return 0; }
+static EVP_PKEY *ECPeerKey(const char *, int) { return 0; }
+static int ECDerive(EVP_PKEY *, EVP_PKEY *, char *&) { return 0; }
+#endif
+
 // ---------------------------------------------------------------------------//
 //
 // Cipher interface
@@ -175,6 +238,7 @@ XrdCryptosslCipher::XrdCryptosslCipher(const char *t, int l)
    lIV = 0;
    cipher = 0;
    fDH = 0;
+   fEC = 0;
    deflength = 1;
 
    // Check and set type
@@ -238,6 +302,7 @@ XrdCryptosslCipher::XrdCryptosslCipher(const char *t, int l,
    fIV = 0;
    lIV = 0;
    fDH = 0;
+   fEC = 0;
    cipher = 0;
    deflength = 1;
 
@@ -291,6 +356,7 @@ XrdCryptosslCipher::XrdCryptosslCipher(XrdSutBucket *bck)
    fIV = 0;
    lIV = 0;
    fDH = 0;
+   fEC = 0;
    cipher = 0;
    deflength = 1;
 
@@ -454,14 +520,16 @@ XrdCryptosslCipher::XrdCryptosslCipher(XrdSutBucket *bck)
 
 //____________________________________________________________________________
 XrdCryptosslCipher::XrdCryptosslCipher(bool padded, int bits, char *pub,
-                                       int lpub, const char *t)
+                                       int lpub, const char *t, bool ecdh)
 {
    // Constructor for key agreement.
-   // If pub is not defined, generates a DH full key,
+   // If pub is not defined, generates a DH full key, or an ephemeral
+   // X25519 key if 'ecdh' is true;
    // the public part and parameters can be retrieved using Public().
    // The number of random bits to be used in 'bits'.
    // If pub is defined with the public part and parameters of the
-   // counterpart fully initialize a cipher with that information.
+   // counterpart fully initialize a cipher with that information; the
+   // kind of agreement (DH or ECDH) is the one chosen by the counterpart.
    // Sets also the name to 't', if different from the default one.
    // Used for key agreement.
    EPNAME("sslCipher::XrdCryptosslCipher");
@@ -471,18 +539,39 @@ XrdCryptosslCipher::XrdCryptosslCipher(bool padded, int bits, char *pub,
    fIV = 0;
    lIV = 0;
    fDH = 0;
+   fEC = 0;
    cipher = 0;
    deflength = 1;
 
-   if (!pub) {
+   if (!pub && ecdh) {
+      DEBUG("generate ECDH (X25519) key");
+      //
+      // Generate the key; there are no parameters to agree upon
+      if ((fEC = ECGenerate())) {
+         // Init context
+         ctx = EVP_CIPHER_CTX_new();
+         if (ctx)
+            valid = 1;
+      }
+
+   } else if (!pub) {
       DEBUG("generate DH full key");
       //
       // at least 128 bits
       bits = (bits < kDHMINBITS) ? kDHMINBITS : bits;
+      //
+      // Generating parameters is costly (and refused for small sizes by
+      // recent OpenSSL): use the well-known RFC 7919 group when available
+      fDH = 0;
+#if defined(HAVE_ECDH_X25519)
+      if (bits <= 2048)
+         fDH = DH_new_by_nid(NID_ffdhe2048);
+#endif
       //
       // Generate params for DH object
-      fDH = DH_new();
-      if (fDH && DH_generate_parameters_ex(fDH, bits, DH_GENERATOR_5, NULL)) {
+      bool dhpar = (fDH != 0);
+      if (!fDH) fDH = DH_new();
+      if (fDH && (dhpar || DH_generate_parameters_ex(fDH, bits, DH_GENERATOR_5, NULL))) {
          int prc = 0;
          DH_check(fDH,&prc);
          if (prc == 0) {
@@ -502,10 +591,17 @@ XrdCryptosslCipher::XrdCryptosslCipher(bool padded, int bits, char *pub,
       //
       char *ktmp = 0;
       int ltmp = 0;
+      // ECDH if the counterpart sent an X25519 public key
+      EVP_PKEY *ecpub = ECPeerKey(pub, lpub);
+      if (ecpub) {
+         if ((fEC = ECGenerate()) && (ltmp = ECDerive(fEC, ecpub, ktmp)) > 0)
+            valid = 1;
+         EVP_PKEY_free(ecpub);
+      }
       // Extract string with bignumber
       BIGNUM *bnpub = 0;
-      char *pb = strstr(pub,"---BPUB---");
-      char *pe = strstr(pub,"---EPUB--"); // one less (pub not null-terminated)
+      char *pb = (fEC) ? 0 : strstr(pub,"---BPUB---");
+      char *pe = (fEC) ? 0 : strstr(pub,"---EPUB--"); // one less (pub not null-terminated)
       if (pb && pe) {
          lpub = (int)(pb-pub);
          pb += 10;
@@ -620,6 +716,7 @@ XrdCryptosslCipher::XrdCryptosslCipher(const XrdCryptosslCipher &c)
    SetType(c.Type());
    // DH
    fDH = 0;
+   fEC = 0;
    if (valid && c.fDH) {
       valid = 0;
       if ((fDH = DH_new())) {
@@ -635,6 +732,13 @@ XrdCryptosslCipher::XrdCryptosslCipher(const XrdCryptosslCipher &c)
             valid = 1;
       }
    }
+#if defined(HAVE_ECDH_X25519)
+   // ECDH key (immutable: just share it)
+   if (valid && c.fEC) {
+      EVP_PKEY_up_ref(c.fEC);
+      fEC = c.fEC;
+   }
+#endif
    if (valid) {
       // Init context
       ctx = EVP_CIPHER_CTX_new();
@@ -671,20 +775,25 @@ void XrdCryptosslCipher::Cleanup()
       DH_free(fDH);
       fDH = 0;
    }
+   if (fEC) {
+      EVP_PKEY_free(fEC);
+      fEC = 0;
+   }
 }
 
 //____________________________________________________________________________
 bool XrdCryptosslCipher::Finalize(bool padded,
-                                  char *pub, int /*lpub*/, const char *t)
+                                  char *pub, int lpub, const char *t)
 {
    // Finalize cipher during key agreement. Should be called
-   // for a cipher build with special constructor defining member fDH.
+   // for a cipher build with special constructor defining member fDH
+   // (or fEC for ECDH).
    // The buffer pub should contain the public part of the counterpart.
    // Sets also the name to 't', if different from the default one.
    // Used for key agreement.
    EPNAME("sslCipher::Finalize");
 
-   if (!fDH) {
+   if (!fDH && !fEC) {
       DEBUG("DH undefined: this cipher cannot be finalized"
             " by this method");
       return 0;
@@ -694,11 +803,20 @@ bool XrdCryptosslCipher::Finalize(bool padded,
    int ltmp = 0;
    valid = 0;
    if (pub) {
+      //
+      // ECDH: the counterpart must have sent its X25519 public key
+      if (fEC) {
+         EVP_PKEY *ecpub = ECPeerKey(pub, lpub);
+         if (ecpub) {
+            if ((ltmp = ECDerive(fEC, ecpub, ktmp)) > 0) valid = 1;
+            EVP_PKEY_free(ecpub);
+         }
+      }
       //
       // Extract string with bignumber
       BIGNUM *bnpub = 0;
-      char *pb = strstr(pub,"---BPUB---");
-      char *pe = strstr(pub,"---EPUB--");
+      char *pb = (fDH) ? strstr(pub,"---BPUB---") : 0;
+      char *pe = (fDH) ? strstr(pub,"---EPUB--") : 0;
       if (pb && pe) {
          //lpub = (int)(pb-pub);
          pb += 10;
@@ -793,6 +911,32 @@ char *XrdCryptosslCipher::Public(int &lpub)
    // Buffer should be deleted by the caller.
    static int lhend = strlen("-----END DH PARAMETERS-----");
 
+#if defined(HAVE_ECDH_X25519)
+   // For ECDH there are no parameters: just the hex of the raw public key
+   if (fEC) {
+      static const char *hexdig = "0123456789ABCDEF";
+      unsigned char raw[kECPUBLEN];
+      size_t lraw = kECPUBLEN;
+      if (EVP_PKEY_get_raw_public_key(fEC, raw, &lraw) > 0 &&
+          lraw == kECPUBLEN) {
+         lpub = 2*kECPUBLEN + 20;
+         char *pub = new char[lpub+1];
+         char *p = pub;
+         memcpy(p,"---BECP---",10);
+         p += 10;
+         for (int i = 0; i < kECPUBLEN; i++) {
+            *p++ = hexdig[raw[i] >> 4];
+            *p++ = hexdig[raw[i] & 0xf];
+         }
+         memcpy(p,"---EECP---",10);
+         pub[lpub] = 0;
+         return pub;
+      }
+      lpub = 0;
+      return (char *)0;
+   }
+#endif
+
    if (fDH) {
       //
       // Calculate and write public key hex
@@ -889,14 +1033,18 @@ XrdSutBucket *XrdCryptosslCipher::AsBucket()
       kXR_int32 lbuf = Length();
       kXR_int32 ltyp = Type() ? strlen(Type()) : 0;
       kXR_int32 livc = lIV;
-      const BIGNUM *p, *g;
-      const BIGNUM *pub, *pri;
-      DH_get0_pqg(fDH, &p, NULL, &g);
-      DH_get0_key(fDH, &pub, &pri);
-      char *cp = BN_bn2hex(p);
-      char *cg = BN_bn2hex(g);
-      char *cpub = BN_bn2hex(pub);
-      char *cpri = BN_bn2hex(pri);
+      // DH parameters, if any (the ECDH key is not exported: the
+      // agreed key is all that is needed to use the cipher)
+      const BIGNUM *p = 0, *g = 0;
+      const BIGNUM *pub = 0, *pri = 0;
+      if (fDH) {
+         DH_get0_pqg(fDH, &p, NULL, &g);
+         DH_get0_key(fDH, &pub, &pri);
+      }
+      char *cp = p ? BN_bn2hex(p) : 0;
+      char *cg = g ? BN_bn2hex(g) : 0;
+      char *cpub = pub ? BN_bn2hex(pub) : 0;
+      char *cpri = pri ? BN_bn2hex(pri) : 0;
       kXR_int32 lp = cp ? strlen(cp) : 0;
       kXR_int32 lg = cg ? strlen(cg) : 0;
       kXR_int32 lpub = cpub ? strlen(cpub) : 0;
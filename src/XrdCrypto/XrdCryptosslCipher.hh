@@ -41,6 +41,11 @@
 
 #define kDHMINBITS 128
 
+// X25519 key agreement needs raw key import / export
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+#define HAVE_ECDH_X25519
+#endif
+
 // ---------------------------------------------------------------------------//
 //
 // OpenSSL Cipher Implementation
@@ -54,6 +59,7 @@ private:
    const EVP_CIPHER *cipher;
    EVP_CIPHER_CTX *ctx;
    DH         *fDH;
+   EVP_PKEY   *fEC;
    bool        deflength;
    bool        valid;
 
@@ -67,7 +73,8 @@ public:
    XrdCryptosslCipher(const char *t, int l, const char *k,
                                      int liv, const char *iv);
    XrdCryptosslCipher(XrdSutBucket *b);
-   XrdCryptosslCipher(bool padded, int len, char *pub, int lpub, const char *t);
+   XrdCryptosslCipher(bool padded, int len, char *pub, int lpub, const char *t,
+                      bool ecdh = false);
    XrdCryptosslCipher(const XrdCryptosslCipher &c);
    virtual ~XrdCryptosslCipher();
 
@@ -147,6 +147,17 @@ bool XrdCryptosslFactory::HasPaddingSupport()
 #endif
 }
 
+//______________________________________________________________________________
+bool XrdCryptosslFactory::HasECDHSupport()
+{
+   // Returns true if ECDH (X25519) key agreement is supported
+#if defined(HAVE_ECDH_X25519)
+   return true;
+#else
+   return false;
+#endif
+}
+
 //______________________________________________________________________________
 XrdCryptoCipher *XrdCryptosslFactory::Cipher(const char *t, int l)
 {
@@ -241,6 +252,22 @@ XrdCryptoCipher *XrdCryptosslFactory::Cipher(const XrdCryptoCipher &c)
    return (XrdCryptoCipher *)0;
 }
 
+//______________________________________________________________________________
+XrdCryptoCipher *XrdCryptosslFactory::ECDHCipher()
+{
+   // Return an instance of a Ssl implementation of XrdCryptoCipher
+   // holding an ephemeral X25519 key for key agreement.
+
+   XrdCryptoCipher *cip = new XrdCryptosslCipher(false,0,0,0,0,true);
+   if (cip) {
+      if (cip->IsValid())
+         return cip;
+      else
+         delete cip;
+   }
+   return (XrdCryptoCipher *)0;
+}
+
 //______________________________________________________________________________
 bool XrdCryptosslFactory::SupportedMsgDigest(const char *dgst)
 {
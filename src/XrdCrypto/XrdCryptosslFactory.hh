@@ -61,6 +61,7 @@ public:
    // Cipher constructors
    bool SupportedCipher(const char *t);
    bool HasPaddingSupport();
+   bool HasECDHSupport();
    XrdCryptoCipher *Cipher(const char *t, int l = 0);
    XrdCryptoCipher *Cipher(const char *t, int l, const char *k,
                                           int liv, const char *iv);
@@ -68,6 +69,7 @@ public:
    XrdCryptoCipher *Cipher(int bits, char *pub, int lpub, const char *t = 0);
    XrdCryptoCipher *Cipher(bool padded, int bits, char *pub, int lpub, const char *t = 0);
    XrdCryptoCipher *Cipher(const XrdCryptoCipher &c);
+   XrdCryptoCipher *ECDHCipher();
 
    // MsgDigest constructors
    bool SupportedMsgDigest(const char *dgst);
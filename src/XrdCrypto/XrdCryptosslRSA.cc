@@ -192,6 +192,14 @@ XrdCryptosslRSA::XrdCryptosslRSA(const XrdCryptosslRSA &r) : XrdCryptoRSA()
       return;
    }
 
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+   // Keys are never modified in place: share the given one instead of
+   // re-importing it, which would also re-run the (costly) consistency check
+   if (EVP_PKEY_up_ref(r.fEVP)) {
+      fEVP = r.fEVP;
+      status = r.status;
+   }
+#else
    // If the given key is set, copy it via a bio
    const BIGNUM *d;
    RSA_get0_key(EVP_PKEY_get0_RSA(r.fEVP), NULL, NULL, &d);
@@ -227,6 +235,7 @@ XrdCryptosslRSA::XrdCryptosslRSA(const XrdCryptosslRSA &r) : XrdCryptoRSA()
       // Cleanup bio
       BIO_free(bcpy);
    }
+#endif
 }
 
 //_____________________________________________________________________________
@@ -313,8 +322,13 @@ int XrdCryptosslRSA::ImportPrivate(const char *pri, int lpri)
    // Write key from private export to BIO
    BIO_write(bpri,(void *)pri,lpri);
 
-   // Read private key from BIO
-   if (PEM_read_bio_PrivateKey(bpri, &fEVP, 0, 0)) {
+   // Read private key from BIO into a new key, as the current one may be
+   // shared with copies of this object
+   EVP_PKEY *keytmp = PEM_read_bio_PrivateKey(bpri, 0, 0, 0);
+   BIO_free(bpri);
+   if (keytmp) {
+      EVP_PKEY_free(fEVP);
+      fEVP = keytmp;
       // Update status
       status = kComplete;
       return 0;
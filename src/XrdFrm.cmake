@@ -17,6 +17,7 @@ add_library(
   XrdFrm/XrdFrmReqBoss.cc       XrdFrm/XrdFrmReqBoss.hh
   XrdFrm/XrdFrmTransfer.cc      XrdFrm/XrdFrmTransfer.hh
   XrdFrm/XrdFrmXfrAgent.cc      XrdFrm/XrdFrmXfrAgent.hh
+  XrdFrm/XrdFrmXfrCopy.cc       XrdFrm/XrdFrmXfrCopy.hh
   XrdFrm/XrdFrmXfrDaemon.cc     XrdFrm/XrdFrmXfrDaemon.hh
                                 XrdFrm/XrdFrmXfrJob.hh
   XrdFrm/XrdFrmXfrQueue.cc      XrdFrm/XrdFrmXfrQueue.hh
@@ -74,6 +75,7 @@ target_link_libraries(
   frm_xfrd
   XrdFrm
   XrdServer
+  XrdCl
   XrdUtils
   pthread
   ${EXTRA_LIBS}
@@ -90,6 +92,7 @@ target_link_libraries(
   frm_xfragent
   XrdFrm
   XrdServer
+  XrdCl
   XrdUtils
   pthread
   ${EXTRA_LIBS}
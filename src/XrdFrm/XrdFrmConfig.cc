@@ -157,6 +157,7 @@ XrdFrmConfig::XrdFrmConfig(SubSys ss, const char *vopts, const char *uinfo)
    WaitMigr = 60*60;
    WaitPurge= 600;
    WaitQChk = 300;
+   ScanThreads = 1;
    MSSCmd   = 0;
    memset(&xfrCmd, 0, sizeof(xfrCmd));
    xfrCmd[0].Desc = "copycmd in";     xfrCmd[1].Desc = "copycmd out";
@@ -1009,6 +1010,7 @@ int XrdFrmConfig::ConfigXeq(char *var, int mbok)
    if (!strcmp(var, "all.pidpath"   )) return Grab(var, &PidPath, 0);
    if (!strcmp(var, "all.manager"   )) {haveCMS = 1; return 0;}
    if (!strcmp(var, "frm.all.cnsd"  )) return xcnsd();
+   if (!strcmp(var, "frm.all.scanthreads")) return xscan();
 
 // Process directives specific to each subsystem
 //
@@ -1103,6 +1105,7 @@ int XrdFrmConfig::ConfigXfr()
                ioOK[i%2]  = 1;
                else isBad = 1;
            }
+        if (xfrCmd[i].theBin) ioOK[i%2] = 1;
        }
 
 // Verify that we can actually do something
@@ -1400,7 +1403,7 @@ int XrdFrmConfig::xcnsd()
 
 /* Function: copycmd
 
-   Purpose:  To parse the directive: copycmd [Options] cmd [args]
+   Purpose:  To parse the directive: copycmd [Options] {cmd [args] | builtin [bargs]}
 
    Options:  [in] [noalloc] [out] [rmerr] [stats] [timeout <sec>] [url] [xpd]
 
@@ -1413,12 +1416,17 @@ int XrdFrmConfig::xcnsd()
              timeout   how long the cmd can run before it is killed.
              url       use command for url-based transfers.
              xpd       extend monitoring with program data.
+             builtin   copy in-process using the xrootd client instead of
+                       running a command. When a command is also specified
+                       for the same copies, it is used should the builtin
+                       copy fail. See xcopyBin() for the builtin args.
 
    Output: 0 upon success or !0 upon failure.
 */
 int XrdFrmConfig::xcopy()
 {  int cmdIO[2] = {0,0}, TLim=0, Stats=0, hasMDP=0, cmdUrl=0, noAlo=0, rmErr=0;
-   int monPD = 0;
+   int monPD = 0, isBin = 0;
+   XrdFrmXfrCopy::Parms *binP = 0;
    char *val, *theCmd = 0;
    struct copyopts {const char *opname; int *oploc;} cpopts[] =
          {
@@ -1437,7 +1445,8 @@ int XrdFrmConfig::xcopy()
 //
    val = cFile->GetWord();
    while(val && *val != '/')
-        {for (i = 0; i < numopts; i++)
+        {if (!strcmp(val, "builtin")) {isBin = 1; break;}
+         for (i = 0; i < numopts; i++)
              {if (!strcmp(val,cpopts[i].opname))
                  {if (strcmp("timeout", val)) {*cpopts[i].oploc = 1; break;}
                      else if (!xcopy(TLim)) return 1;
@@ -1448,24 +1457,34 @@ int XrdFrmConfig::xcopy()
          val = cFile->GetWord();
         }
 
-// Pick up the program
+// Pick up the builtin copy parameters or the program
 //
-   if (!val || !*val)
-      {Say.Emsg("Config", "copy command not specified"); return 1;}
-   if (Grab(val, &theCmd, -1)) return 1;
+   if (isBin)
+      {binP = new XrdFrmXfrCopy::Parms;
+       if (xcopyBin(*binP)) {delete binP; return 1;}
+      } else {
+       if (!val || !*val)
+          {Say.Emsg("Config", "copy command not specified"); return 1;}
+       if (Grab(val, &theCmd, -1)) return 1;
+      }
 
 // Find if $MDP is present here
 //
    if (!cmdIO[0] && !cmdIO[1]) cmdIO[0] = cmdIO[1] = 1;
-   if (cmdIO[1]) hasMDP = (strstr(theCmd, "$MDP") != 0);
+   if (cmdIO[1] && theCmd) hasMDP = (strstr(theCmd, "$MDP") != 0);
 
 // Initialzie the appropriate command structures
 //
    n = (cmdUrl ? 3 : 1);
    i = 1;
    do {if (cmdIO[i])
-          {if (xfrCmd[n].theCmd) free(xfrCmd[n].theCmd);
-           xfrCmd[n].theCmd = strdup(theCmd);
+          {if (binP)
+              {if (xfrCmd[n].theBin) delete xfrCmd[n].theBin;
+               xfrCmd[n].theBin = new XrdFrmXfrCopy::Parms(*binP);
+              }
+              else {if (xfrCmd[n].theCmd) free(xfrCmd[n].theCmd);
+                    xfrCmd[n].theCmd = strdup(theCmd);
+                   }
            if (Stats)  xfrCmd[n].Opts  |= cmdStats;
            if (monPD)  xfrCmd[n].Opts  |= cmdXPD;
            if (hasMDP) xfrCmd[n].Opts  |= cmdMDP;
@@ -1479,7 +1498,8 @@ int XrdFrmConfig::xcopy()
 
 // All done
 //
-   free(theCmd);
+   if (theCmd) free(theCmd);
+   if (binP) delete binP;
    return 0;
 }
 
@@ -1495,6 +1515,76 @@ int XrdFrmConfig::xcopy(int &TLim)
    return 1;
 }
 
+/******************************************************************************/
+/* Private:                     x c o p y B i n                               */
+/******************************************************************************/
+
+/* Function: xcopyBin
+
+   Purpose:  To parse the builtin copycmd arguments:
+
+             [cksum {none | <type>}] [retry <num> [<sec>]] [streams <num>]
+             [chunk <sz>]
+
+             cksum     the checksum verified end-to-end, i.e. the checksum of
+                       the copied file is compared against the one at the
+                       source when the copy completes.
+             retry     number of times a failed copy is retried and the number
+                       of seconds to wait between attempts (default 10).
+             streams   number of chunks kept in flight for each file.
+             chunk     size of each chunk.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+int XrdFrmConfig::xcopyBin(XrdFrmXfrCopy::Parms &Parms)
+{
+   long long csz;
+   char *val;
+
+   while((val = cFile->GetWord()))
+        {if (!strcmp(val, "cksum"))
+            {if (!(val = cFile->GetWord()))
+                {Say.Emsg("Config", "copycmd cksum type not specified");
+                 return 1;
+                }
+             if (Parms.cksType) free(Parms.cksType);
+             Parms.cksType = (strcmp(val, "none") ? strdup(val) : 0);
+            }
+         else if (!strcmp(val, "retry"))
+            {if (!(val = cFile->GetWord()))
+                {Say.Emsg("Config", "copycmd retry count not specified");
+                 return 1;
+                }
+             if (XrdOuca2x::a2i(Say, "copycmd retry count", val,
+                                &Parms.Retries, 0, 100)) return 1;
+             if ((val = cFile->GetWord()) && isdigit(*val))
+                {if (XrdOuca2x::a2tm(Say, "copycmd retry wait", val,
+                                     &Parms.RetryWait, 0)) return 1;
+                } else if (val) cFile->RetToken();
+            }
+         else if (!strcmp(val, "streams"))
+            {if (!(val = cFile->GetWord()))
+                {Say.Emsg("Config", "copycmd streams not specified");
+                 return 1;
+                }
+             if (XrdOuca2x::a2i(Say, "copycmd streams", val,
+                                &Parms.Streams, 1, 32)) return 1;
+            }
+         else if (!strcmp(val, "chunk"))
+            {if (!(val = cFile->GetWord()))
+                {Say.Emsg("Config", "copycmd chunk size not specified");
+                 return 1;
+                }
+             if (XrdOuca2x::a2sz(Say, "copycmd chunk size", val, &csz,
+                                 4096, 256*1024*1024)) return 1;
+             Parms.ChunkSz = static_cast<int>(csz);
+            }
+         else Say.Say("Config warning: ignoring invalid copycmd builtin "
+                      "option '", val, "'.");
+        }
+   return 0;
+}
+
 /******************************************************************************/
 /* Private:                        x c m a x                                  */
 /******************************************************************************/
@@ -1957,6 +2047,31 @@ int XrdFrmConfig::xqchk()
    return 0;
 }
 
+/******************************************************************************/
+/* Private:                        x s c a n                                  */
+/******************************************************************************/
+
+/* Function: xscan
+
+   Purpose:  To parse the directive: scanthreads <num>
+
+             <num>     number of threads used to index directories when
+                       recursively scanning a space for migration, purging,
+                       or administrative commands. The default is 1 (i.e.
+                       directories are indexed serially).
+
+   Output: 0 upon success or !0 upon failure.
+*/
+int XrdFrmConfig::xscan()
+{   char *val;
+
+    if (!(val = cFile->GetWord()))
+       {Say.Emsg("Config", "scanthreads value not specified"); return 1;}
+    if (XrdOuca2x::a2i(Say, "scanthreads", val, &ScanThreads, 1, 256))
+       return 1;
+    return 0;
+}
+
 /******************************************************************************/
 /*                                  x s i t                                   */
 /******************************************************************************/
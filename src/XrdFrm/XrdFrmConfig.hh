@@ -32,6 +32,7 @@
 #include <string.h>
 #include <unistd.h>
 
+#include "XrdFrm/XrdFrmXfrCopy.hh"
 #include "XrdOss/XrdOssSpace.hh"
 
 class XrdCks;
@@ -73,6 +74,7 @@ struct Cmd
       {const char  *Desc;
        char        *theCmd;
        XrdOucMsubs *theVec;
+       XrdFrmXfrCopy::Parms *theBin;   // Builtin copy parameters, if any
        int          TLimit;
        int          Opts;
       }             xfrCmd[4];
@@ -104,6 +106,7 @@ int                 IdleHold;
 int                 WaitQChk;
 int                 WaitPurge;
 int                 WaitMigr;
+int                 ScanThreads;
 int                 haveCMS;
 int                 isOTO;
 int                 Fix;
@@ -200,6 +203,7 @@ int          xcks();
 int          xcnsd();
 int          xcopy();
 int          xcopy(int &TLim);
+int          xcopyBin(XrdFrmXfrCopy::Parms &Parms);
 int          xcmax();
 int          xdpol();
 int          xitm(const char *What, int &tDest);
@@ -208,6 +212,7 @@ int          xmon();
 int          xpol();
 int          xpolprog();
 int          xqchk();
+int          xscan();
 int          xsit();
 int          xspace(int isPrg=0, int isXA=1);
 void         xspaceBuild(char *grp, char *fn, int isxa);
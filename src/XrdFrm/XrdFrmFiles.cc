@@ -316,6 +316,11 @@ XrdFrmFiles::XrdFrmFiles(const char *dname, int opts,
 // Set Call Back method
 //
    nsObj.setCallBack(cbP);
+
+// Index directories in parallel if so wanted
+//
+   if ((opts & Recursive) && Config.ScanThreads > 1)
+      nsObj.setThreads(Config.ScanThreads);
 }
 
 /******************************************************************************/
@@ -46,6 +46,7 @@
 #include "XrdFrm/XrdFrmConfig.hh"
 #include "XrdFrm/XrdFrmMonitor.hh"
 #include "XrdFrm/XrdFrmTransfer.hh"
+#include "XrdFrm/XrdFrmXfrCopy.hh"
 #include "XrdFrm/XrdFrmXfrJob.hh"
 #include "XrdFrm/XrdFrmXfrQueue.hh"
 #include "XrdNet/XrdNetCmsNotify.hh"
@@ -171,10 +172,10 @@ const char *XrdFrmTransfer::Fetch()
 // Check if we can actually handle this transfer
 //
    if (isURL)
-      {if (xfrCmd[2]) iXfr = 2;
+      {if (xfrCmd[2] || Config.xfrCmd[2].theBin) iXfr = 2;
           else return "url copies not configured";
       } else {
-       if (xfrCmd[0]) iXfr = 0;
+       if (xfrCmd[0] || Config.xfrCmd[0].theBin) iXfr = 0;
           else return "non-url copies not configured";
       }
 
@@ -207,7 +208,8 @@ const char *XrdFrmTransfer::Fetch()
    cmdArg.theSrc = theSrc;
    cmdArg.theDst = xfrP->PFN;
    cmdArg.theINS = xfrP->reqData.iName;
-   if (!SetupCmd(&cmdArg)) return "incoming transfer setup failed";
+   if (cmdArg.theCmd && !SetupCmd(&cmdArg))
+      return "incoming transfer setup failed";
 
 // If the copycmd needs a placeholder in the filesystem for this transfer, we
 // must create one. We first remove any existing "anew" file because we will
@@ -227,13 +229,14 @@ const char *XrdFrmTransfer::Fetch()
 // Setup program monitoring data
 //
    pdSZ = (Config.xfrCmd[iXfr].Opts & Config.cmdXPD ? sizeof(pdBuff) : 0);
+   *pdBuff = 0;
 
 // Now run the command to get the file and make sure the file is there
 // If it is, make sure that if a lock file exists its date/time is greater than
 // the file we just fetched; then rename it to be the correct name.
 //
    xfrET = time(0);
-   if (!(rc = cmdArg.theCmd->Run(pdBuff, pdSZ)))
+   if (!(rc = RunCmd(iXfr, &cmdArg, pdBuff, pdSZ)))
       {if ((rc = Config.Stat(lfnpath, xfrP->PFN, &pfnStat)))
           {Say.Emsg("Fetch", lfnpath, "fetched but not resident!"); fSize = 0;}
           else {fSize  = pfnStat.st_size;
@@ -443,6 +446,31 @@ int XrdFrmTransfer::Init()
    return 1;
 }
 
+/******************************************************************************/
+/* Private:                       R u n C m d                                 */
+/******************************************************************************/
+  
+int XrdFrmTransfer::RunCmd(int iXfr, XrdFrmTranArg *argP, char *pdBuff, int pdSZ)
+{
+   int rc;
+
+// Use the builtin copy if we have one. Should it fail for any reason other
+// than a missing source, fall back to the copy command if we have one.
+//
+   if (Config.xfrCmd[iXfr].theBin)
+      {rc = XrdFrmXfrCopy::Copy(*Config.xfrCmd[iXfr].theBin, argP->theSrc,
+                                argP->theDst, Config.xfrCmd[iXfr].TLimit,
+                                pdBuff, pdSZ);
+       if (!rc || rc == -2 || !argP->theCmd) return rc;
+       Say.Emsg("Transfer", "Builtin copy failed; using copy command for",
+                xfrP->reqData.LFN);
+      }
+
+// Run the copy command
+//
+   return argP->theCmd->Run(pdBuff, pdSZ);
+}
+
 /******************************************************************************/
 /* Private:                     S e t u p C m d                               */
 /******************************************************************************/
@@ -623,10 +651,10 @@ const char *XrdFrmTransfer::Throw()
 // Check if we can actually handle this transfer
 //
    if (isURL)
-      {if (xfrCmd[3]) iXfr = 3;
+      {if (xfrCmd[3] || Config.xfrCmd[3].theBin) iXfr = 3;
           else return "url copies not configured";
       } else {
-       if (xfrCmd[1]) iXfr = 1;
+       if (xfrCmd[1] || Config.xfrCmd[1].theBin) iXfr = 1;
           else return "non-url copies not configured";
       }
 
@@ -658,19 +686,22 @@ const char *XrdFrmTransfer::Throw()
    cmdArg.theDst = theDest;
    cmdArg.theSrc = xfrP->PFN;
    cmdArg.theINS = xfrP->reqData.iName;
-   if (Config.xfrCmd[iXfr].Opts & Config.cmdMDP)
-      mDP = TrackDC(lfnpath+xfrP->reqData.LFO, cmdArg.theMDP, Rfn);
-   if (!SetupCmd(&cmdArg)) return "outgoing transfer setup failed";
+   if (cmdArg.theCmd)
+      {if (Config.xfrCmd[iXfr].Opts & Config.cmdMDP)
+          mDP = TrackDC(lfnpath+xfrP->reqData.LFO, cmdArg.theMDP, Rfn);
+       if (!SetupCmd(&cmdArg)) return "outgoing transfer setup failed";
+      }
 
 // Setup program monitoring data
 //
    pdSZ = (Config.xfrCmd[iXfr].Opts & Config.cmdXPD ? sizeof(pdBuff) : 0);
+   *pdBuff = 0;
 
 // Now run the command to put the file. If the command fails and this is a
 // migration request, cretae a fail file if one does not exist.
 //
    xfrET = time(0);
-   if ((rc = cmdArg.theCmd->Run(pdBuff, pdSZ)))
+   if ((rc = RunCmd(iXfr, &cmdArg, pdBuff, pdSZ)))
       {if (isMigr) ffMake(rc == -2);
        retMsg = "copy failed";
       }
@@ -57,6 +57,7 @@ const char *Fetch();
 const char *FetchDone(char *lfnpath, struct stat &Stat, int &rc);
 const char *ffCheck();
       void  ffMake(int nofile=0);
+      int   RunCmd(int iXfr, XrdFrmTranArg *aP, char *pdBuff, int pdSZ);
       int   SetupCmd(XrdFrmTranArg *aP);
       int   TrackDC(char *Lfn, char *Mdp, char *Rfn);
       int   TrackDC(char *Rfn);
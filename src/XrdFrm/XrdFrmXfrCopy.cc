@@ -0,0 +1,136 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d F r m X f r C o p y . c c                       */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "XProtocol/XProtocol.hh"
+#include "XrdCl/XrdClCopyProcess.hh"
+#include "XrdCl/XrdClPropertyList.hh"
+#include "XrdCl/XrdClXRootDResponses.hh"
+#include "XrdFrc/XrdFrcTrace.hh"
+#include "XrdFrm/XrdFrmXfrCopy.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+using namespace XrdFrc;
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+class XfrMonitor : public XrdCl::CopyProgressHandler
+{
+public:
+
+bool  ShouldCancel(uint16_t jobNum)
+                  {return Deadline && time(0) >= Deadline;}
+
+      XfrMonitor(time_t endT) : Deadline(endT) {}
+     ~XfrMonitor() {}
+
+time_t Deadline;
+};
+}
+
+/******************************************************************************/
+/*                                  C o p y                                   */
+/******************************************************************************/
+  
+int XrdFrmXfrCopy::Copy(const Parms &Opts, const char *Src, const char *Dst,
+                        int tLim, char *cksBuff, int cksBsz)
+{
+   EPNAME("XfrCopy");
+   XrdCl::XRootDStatus xStat;
+   std::string cksVal;
+   time_t endT = (tLim > 0 ? time(0)+tLim : 0);
+   int rc, tries = 0;
+
+// Clear the checksum in case we fail
+//
+   if (cksBuff && cksBsz > 0) *cksBuff = 0;
+
+// Perform the copy, retrying as needed. A missing source is never retried.
+// The time limit applies to all of the tries taken together.
+//
+do{XrdCl::CopyProcess  cpProc;
+   XrdCl::PropertyList cpProps, cpResult;
+   XfrMonitor          cpMon(endT);
+
+   cpProps.Set("source",         Src);
+   cpProps.Set("target",         Dst);
+   cpProps.Set("force",          true);
+   cpProps.Set("makeDir",        true);
+   cpProps.Set("parallelChunks", Opts.Streams);
+   cpProps.Set("chunkSize",      Opts.ChunkSz);
+   if (Opts.cksType)
+      {cpProps.Set("checkSumMode", "end2end");
+       cpProps.Set("checkSumType", Opts.cksType);
+       cpProps.Set("rmOnBadCksum", true);
+      }
+
+   if ((xStat = cpProc.AddJob(cpProps, &cpResult)).IsOK()
+   &&  (xStat = cpProc.Prepare()).IsOK())
+      {xStat = cpProc.Run(&cpMon);
+       if (xStat.IsOK() && cpResult.HasProperty("status"))
+          cpResult.Get("status", xStat);
+      }
+
+   if (xStat.IsOK())
+      {if (cksBuff && cksBsz > 0)
+          {if (cpResult.Get("targetCheckSum", cksVal))
+              strlcpy(cksBuff, cksVal.c_str(), cksBsz);
+              else *cksBuff = 0;
+          }
+       DEBUG("copied " <<Src <<" to " <<Dst <<" try " <<tries+1);
+       return 0;
+      }
+
+   if (xStat.errNo == kXR_NotFound || xStat.errNo == ENOENT
+   ||  xStat.code  == XrdCl::errNotFound) rc = -2;
+      else rc = (xStat.errNo ? xStat.errNo : EIO);
+
+   Say.Emsg("XfrCopy", "Unable to copy", Src, xStat.ToString().c_str());
+   if (rc == -2 || tries >= Opts.Retries) break;
+   if (endT && time(0) + Opts.RetryWait >= endT)
+      {Say.Emsg("XfrCopy", "Time limit reached; not retrying copy of", Src);
+       break;
+      }
+   if (Opts.RetryWait > 0) sleep(Opts.RetryWait);
+  } while(tries++ < Opts.Retries);
+
+// All done
+//
+   return rc;
+}
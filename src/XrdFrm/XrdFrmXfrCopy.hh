@@ -0,0 +1,74 @@
+#ifndef __FRMXFRCOPY__
+#define __FRMXFRCOPY__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d F r m X f r C o p y . h h                       */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+// The XrdFrmXfrCopy class implements the builtin transfer engine. Instead of
+// forking a copy program for each file, the copy is done in-process via the
+// XrdCl copy machinery on the transfer thread. This avoids the fork/exec
+// overhead of each transfer; the number of concurrent transfers is still
+// bounded by copymax. The parameters are set by the "builtin" form of the
+// copycmd directive.
+
+class XrdFrmXfrCopy
+{
+public:
+
+struct Parms
+      {char *cksType;    // Checksum to verify end-to-end (0 -> none), it is
+                         // computed on the fly for the local file
+       int   Retries;    // Number of times a failed copy is retried
+       int   RetryWait;  // Seconds to wait between retries
+       int   Streams;    // Number of chunks in flight per file
+       int   ChunkSz;    // Size of each chunk
+
+       Parms() : cksType(0), Retries(0), RetryWait(10), Streams(4),
+                 ChunkSz(8*1024*1024) {}
+       Parms(const Parms &rhs)
+            : cksType(rhs.cksType ? strdup(rhs.cksType) : 0),
+              Retries(rhs.Retries), RetryWait(rhs.RetryWait),
+              Streams(rhs.Streams), ChunkSz(rhs.ChunkSz) {}
+      ~Parms() {if (cksType) free(cksType);}
+private:
+       Parms &operator=(const Parms &rhs);
+      };
+
+// Copy() copies Src to Dst where either may be a url or an absolute path. The
+// copy, including all retries, is abandoned after tLim seconds unless tLim is
+// zero. The return value
+// follows XrdOucProg::Run() conventions: 0 upon success, -2 if the source
+// does not exist, and a positive value otherwise. Upon success, if a checksum
+// was verified, it is placed in cksBuff as "type:value".
+//
+static int   Copy(const Parms &Opts, const char *Src, const char *Dst,
+                  int tLim, char *cksBuff=0, int cksBsz=0);
+};
+#endif
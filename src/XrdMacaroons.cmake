@@ -18,6 +18,7 @@ if( BUILD_MACAROONS )
     XrdMacaroons/XrdMacaroons.cc
     XrdMacaroons/XrdMacaroonsHandler.cc     XrdMacaroons/XrdMacaroonsHandler.hh
     XrdMacaroons/XrdMacaroonsAuthz.cc       XrdMacaroons/XrdMacaroonsAuthz.hh
+    XrdMacaroons/XrdMacaroonsTokenCache.cc  XrdMacaroons/XrdMacaroonsTokenCache.hh
     XrdMacaroons/XrdMacaroonsConfigure.cc)
 
   target_link_libraries(
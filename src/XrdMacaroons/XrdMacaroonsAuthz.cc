@@ -24,6 +24,13 @@ public:
 
     const std::string &GetSecName() const {return m_sec_name;}
 
+    // Check a single, already authenticated, caveat against the request.
+    bool Satisfies(const std::string &caveat);
+
+    static int record_caveat_s(void *caveats_ptr,
+                               const unsigned char *pred,
+                               size_t pred_sz);
+
     static int verify_before_s(void *authz_ptr,
                                const unsigned char *pred,
                                size_t pred_sz);
@@ -102,6 +109,19 @@ static XrdAccPrivs AddPriv(Access_Operation op, XrdAccPrivs privs)
     return static_cast<XrdAccPrivs>(new_privs);
 }
 
+
+// Returns the time given by a "before:" caveat or -1 if there is none.
+static time_t CaveatExpiry(const std::string &caveat)
+{
+    if (strncmp("before:", caveat.c_str(), 7)) {return -1;}
+
+    struct tm caveat_tm;
+    if (strptime(&caveat[7], "%Y-%m-%dT%H:%M:%SZ", &caveat_tm) == nullptr) {return -1;}
+    caveat_tm.tm_isdst = -1;
+
+    return timegm(&caveat_tm);
+}
+
 }
 
 
@@ -112,12 +132,14 @@ Authz::Authz(XrdSysLogger *log, char const *config, XrdAccAuthorize *chain)
     m_authz_behavior(static_cast<int>(Handler::AuthzBehavior::PASSTHROUGH))
 {
     Handler::AuthzBehavior behavior(Handler::AuthzBehavior::PASSTHROUGH);
+    size_t token_cache_size;
     XrdOucEnv env;
-    if (!Handler::Config(config, &env, &m_log, m_location, m_secret, m_max_duration, behavior))
+    if (!Handler::Config(config, &env, &m_log, m_location, m_secret, m_max_duration, behavior, token_cache_size))
     {
         throw std::runtime_error("Macaroon authorization config failed.");
     }
     m_authz_behavior = static_cast<int>(behavior);
+    if (token_cache_size) {m_token_cache.reset(new TokenCache(token_cache_size));}
 }
 
 
@@ -155,40 +177,89 @@ Authz::Access(const XrdSecEntity *Entity, const char *path,
     }
     authz += 9;
 
+    // The signature chain of a token does not depend on the request; only
+    // verify it once and keep the caveats around for subsequent requests.
+    TokenCache::Entry entry;
+    if (!m_token_cache || !m_token_cache->Get(authz, entry))
+    {
+        switch (VerifyMacaroon(authz, entry))
+        {
+            case VERIFIED:
+                break;
+            case NOT_MACAROON:
+                return OnMissing(Entity, path, oper, env);
+            case REJECTED:
+                return m_chain ? m_chain->Access(Entity, path, oper, env) : XrdAccPriv_None;
+            case FAILED:
+                return XrdAccPriv_None;
+        }
+        if (m_token_cache) {m_token_cache->Put(authz, entry);}
+    }
+    if (m_token_cache) {m_token_cache->Report(m_log);}
+
+    if (!path)
+    {
+        m_log.Emsg("Access", "Request with no provided path.");
+        return XrdAccPriv_None;
+    }
+
+    AuthzCheck check_helper(path, oper, m_max_duration, m_log);
+
+    for (const auto &caveat : entry.caveats)
+    {
+        if (!check_helper.Satisfies(caveat))
+        {
+            m_log.Log(LogMask::Debug, "Access", "Macaroon verification failed");
+            return m_chain ? m_chain->Access(Entity, path, oper, env) : XrdAccPriv_None;
+        }
+    }
+
+    m_log.Log(LogMask::Info, "Access", "Macaroon verification successful; ID", entry.id.c_str());
+
+    // Copy the name, if present into the macaroon, into the credential object.
+    if (Entity && check_helper.GetSecName().size()) {
+        m_log.Log(LogMask::Debug, "Access", "Setting the security name to", check_helper.GetSecName().c_str());
+        XrdSecEntity &myEntity = *const_cast<XrdSecEntity *>(Entity);
+        if (myEntity.name) {free(myEntity.name);}
+        myEntity.name = strdup(check_helper.GetSecName().c_str());
+    }
+
+    // We passed verification - give the correct privilege.
+    return AddPriv(oper, XrdAccPriv_None);
+}
+
+
+Authz::VerifyResult
+Authz::VerifyMacaroon(const char *token, TokenCache::Entry &entry)
+{
     macaroon_returncode mac_err = MACAROON_SUCCESS;
     struct macaroon* macaroon = macaroon_deserialize(
-        authz,
+        token,
         &mac_err);
     if (!macaroon)
     {
         // Do not log - might be other token type!
         //m_log.Emsg("Access", "Failed to parse the macaroon");
-        return OnMissing(Entity, path, oper, env);
+        return NOT_MACAROON;
     }
 
     struct macaroon_verifier *verifier = macaroon_verifier_create();
     if (!verifier)
     {
         m_log.Emsg("Access", "Failed to create a new macaroon verifier");
-        return XrdAccPriv_None;
-    }
-    if (!path)
-    {
-        m_log.Emsg("Access", "Request with no provided path.");
-        macaroon_verifier_destroy(verifier);
-        return XrdAccPriv_None;
+        macaroon_destroy(macaroon);
+        return FAILED;
     }
 
-    AuthzCheck check_helper(path, oper, m_max_duration, m_log);
-
-    if (macaroon_verifier_satisfy_general(verifier, AuthzCheck::verify_before_s, &check_helper, &mac_err) ||
-        macaroon_verifier_satisfy_general(verifier, AuthzCheck::verify_activity_s, &check_helper, &mac_err) ||
-        macaroon_verifier_satisfy_general(verifier, AuthzCheck::verify_name_s, &check_helper, &mac_err) ||
-        macaroon_verifier_satisfy_general(verifier, AuthzCheck::verify_path_s, &check_helper, &mac_err))
+    // Accept every first-party caveat while checking the signature chain;
+    // they are checked against each request separately.
+    entry.caveats.clear();
+    if (macaroon_verifier_satisfy_general(verifier, AuthzCheck::record_caveat_s, &entry.caveats, &mac_err))
     {
         m_log.Emsg("Access", "Failed to configure caveat verifier:");
         macaroon_verifier_destroy(verifier);
-        return XrdAccPriv_None;
+        macaroon_destroy(macaroon);
+        return FAILED;
     }
 
     const unsigned char *macaroon_loc;
@@ -200,7 +271,7 @@ Authz::Access(const XrdSecEntity *Entity, const char *path,
         m_log.Emsg("Access", "Macaroon is for incorrect location", location_str.c_str());
         macaroon_verifier_destroy(verifier);
         macaroon_destroy(macaroon);
-        return m_chain ? m_chain->Access(Entity, path, oper, env) : XrdAccPriv_None;
+        return REJECTED;
     }
 
     if (macaroon_verify(verifier, macaroon,
@@ -212,28 +283,27 @@ Authz::Access(const XrdSecEntity *Entity, const char *path,
         m_log.Log(LogMask::Debug, "Access", "Macaroon verification failed");
         macaroon_verifier_destroy(verifier);
         macaroon_destroy(macaroon);
-        return m_chain ? m_chain->Access(Entity, path, oper, env) : XrdAccPriv_None;
+        return REJECTED;
     }
     macaroon_verifier_destroy(verifier);
 
     const unsigned char *macaroon_id;
     size_t id_sz;
     macaroon_identifier(macaroon, &macaroon_id, &id_sz);
-
-    std::string macaroon_id_str(reinterpret_cast<const char *>(macaroon_id), id_sz);
-    m_log.Log(LogMask::Info, "Access", "Macaroon verification successful; ID", macaroon_id_str.c_str());
+    entry.id.assign(reinterpret_cast<const char *>(macaroon_id), id_sz);
     macaroon_destroy(macaroon);
 
-    // Copy the name, if present into the macaroon, into the credential object.
-    if (Entity && check_helper.GetSecName().size()) {
-        m_log.Log(LogMask::Debug, "Access", "Setting the security name to", check_helper.GetSecName().c_str());
-        XrdSecEntity &myEntity = *const_cast<XrdSecEntity *>(Entity);
-        if (myEntity.name) {free(myEntity.name);}
-        myEntity.name = strdup(check_helper.GetSecName().c_str());
+    // Keep the entry no longer than the token is valid, nor longer than the
+    // maximum token lifetime.
+    time_t now = time(NULL);
+    entry.expiry = now + (m_max_duration > 0 ? m_max_duration : 86400);
+    for (const auto &caveat : entry.caveats)
+    {
+        time_t caveat_time = CaveatExpiry(caveat);
+        if (caveat_time != -1 && caveat_time < entry.expiry) {entry.expiry = caveat_time;}
     }
 
-    // We passed verification - give the correct privilege.
-    return AddPriv(oper, XrdAccPriv_None);
+    return VERIFIED;
 }
 
 
@@ -277,6 +347,29 @@ AuthzCheck::AuthzCheck(const char *req_path, const Access_Operation req_oper, ss
 }
 
 
+bool
+AuthzCheck::Satisfies(const std::string &caveat)
+{
+    const unsigned char *pred = reinterpret_cast<const unsigned char *>(caveat.c_str());
+    size_t pred_sz = caveat.size();
+
+    return !verify_before(pred, pred_sz) ||
+           !verify_activity(pred, pred_sz) ||
+           !verify_name(pred, pred_sz) ||
+           !verify_path(pred, pred_sz);
+}
+
+
+int
+AuthzCheck::record_caveat_s(void *caveats_ptr,
+                            const unsigned char *pred,
+                            size_t pred_sz)
+{
+    static_cast<std::vector<std::string>*>(caveats_ptr)->emplace_back(reinterpret_cast<const char *>(pred), pred_sz);
+    return 0;
+}
+
+
 int
 AuthzCheck::verify_before_s(void *authz_ptr,
                             const unsigned char *pred,
@@ -1,7 +1,11 @@
 
+#include <memory>
+
 #include "XrdAcc/XrdAccAuthorize.hh"
 #include "XrdSys/XrdSysError.hh"
 
+#include "XrdMacaroonsTokenCache.hh"
+
 
 class XrdSysError;
 
@@ -34,6 +38,15 @@ public:
     }
 
 private:
+    enum VerifyResult {
+        VERIFIED,
+        NOT_MACAROON,
+        REJECTED,
+        FAILED
+    };
+
+    VerifyResult VerifyMacaroon(const char *token, TokenCache::Entry &entry);
+
     XrdAccPrivs OnMissing(const XrdSecEntity     *Entity,
                           const char             *path,
                           const Access_Operation  oper,
@@ -45,6 +58,7 @@ private:
     std::string m_secret;
     std::string m_location;
     int m_authz_behavior;
+    std::unique_ptr<TokenCache> m_token_cache;
 };
 
 }
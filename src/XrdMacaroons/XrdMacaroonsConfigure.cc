@@ -37,7 +37,7 @@ static bool xonmissing(XrdOucStream &config_obj, XrdSysError *log, Handler::Auth
 
 bool Handler::Config(const char *config, XrdOucEnv *env, XrdSysError *log,
     std::string &location, std::string &secret, ssize_t &max_duration,
-    AuthzBehavior &behavior)
+    AuthzBehavior &behavior, size_t &token_cache_size)
 {
   XrdOucStream config_obj(log, getenv("XRDINSTANCE"), env, "=====> ");
 
@@ -57,6 +57,9 @@ bool Handler::Config(const char *config, XrdOucEnv *env, XrdSysError *log,
   // Set default maximum duration (24 hours).
   max_duration = 24*3600;
 
+  // Set default size of the verified token cache.
+  token_cache_size = 4096;
+
   // Process items
   //
   char *orig_var, *var;
@@ -75,6 +78,7 @@ bool Handler::Config(const char *config, XrdOucEnv *env, XrdSysError *log,
     else if (!strcmp("trace", var)) {success = xtrace(config_obj, log);}
     else if (!strcmp("maxduration", var)) {success = xmaxduration(config_obj, log, max_duration);}
     else if (!strcmp("onmissing", var)) {success = xonmissing(config_obj, log, behavior);}
+    else if (!strcmp("tokencache", var)) {success = xtokencache(config_obj, log, token_cache_size);}
     else {
         log->Say("Config warning: ignoring unknown directive '", orig_var, "'.");
         config_obj.Echo();
@@ -168,6 +172,26 @@ bool Handler::xmaxduration(XrdOucStream &config_obj, XrdSysError *log, ssize_t &
   return true;
 }
 
+bool Handler::xtokencache(XrdOucStream &config_obj, XrdSysError *log, size_t &token_cache_size)
+{
+  char *val = config_obj.GetWord();
+  if (!val || !val[0])
+  {
+    log->Emsg("Config", "macaroons.tokencache requires a value");
+    return false;
+  }
+  char *endptr = NULL;
+  long long token_cache_parsed = strtoll(val, &endptr, 10);
+  if (endptr == val || *endptr || token_cache_parsed < 0)
+  {
+    log->Emsg("Config", "Unable to parse macaroons.tokencache as a non-negative integer", val);
+    return false;
+  }
+  token_cache_size = token_cache_parsed;
+
+  return true;
+}
+
 bool Handler::xsitename(XrdOucStream &config_obj, XrdSysError *log, std::string &location)
 {
   char *val = config_obj.GetWord();
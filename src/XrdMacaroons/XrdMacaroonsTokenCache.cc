@@ -0,0 +1,129 @@
+#include <cstdio>
+#include <cstring>
+
+#include <openssl/evp.h>
+
+#include "XrdSys/XrdSysError.hh"
+
+#include "XrdMacaroonsHandler.hh"
+#include "XrdMacaroonsTokenCache.hh"
+
+using namespace Macaroons;
+
+
+TokenCache::TokenCache(size_t max_entries)
+    : m_max_per_shard(max_entries / m_shard_count ? max_entries / m_shard_count : 1),
+    m_hits(0),
+    m_misses(0),
+    m_evictions(0),
+    m_next_report(time(NULL) + m_report_interval)
+{
+}
+
+
+std::string
+TokenCache::Digest(const char *token)
+{
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned int md_len = 0;
+    if (!EVP_Digest(token, strlen(token), md, &md_len, EVP_sha256(), NULL))
+    {
+        // Fall back to the token itself; still a unique key.
+        return token;
+    }
+    return std::string(reinterpret_cast<const char *>(md), md_len);
+}
+
+
+TokenCache::Shard &
+TokenCache::GetShard(const std::string &digest)
+{
+    return m_shards[static_cast<unsigned char>(digest[0]) % m_shard_count];
+}
+
+
+bool
+TokenCache::Get(const char *token, Entry &entry)
+{
+    std::string digest = Digest(token);
+    Shard &shard = GetShard(digest);
+
+    std::lock_guard<std::mutex> guard(shard.m_mutex);
+    auto iter = shard.m_map.find(digest);
+    if (iter == shard.m_map.end())
+    {
+        m_misses++;
+        return false;
+    }
+    if (iter->second.expiry <= time(NULL))
+    {
+        shard.m_map.erase(iter);
+        m_evictions++;
+        m_misses++;
+        return false;
+    }
+    entry = iter->second;
+    m_hits++;
+    return true;
+}
+
+
+void
+TokenCache::Put(const char *token, const Entry &entry)
+{
+    std::string digest = Digest(token);
+    Shard &shard = GetShard(digest);
+    time_t now = time(NULL);
+
+    std::lock_guard<std::mutex> guard(shard.m_mutex);
+    if (shard.m_map.size() >= m_max_per_shard && !shard.m_map.count(digest))
+    {
+        // Drop expired tokens first; if none, the one closest to expiry.
+        for (auto iter = shard.m_map.begin(); iter != shard.m_map.end(); )
+        {
+            if (iter->second.expiry <= now)
+            {
+                iter = shard.m_map.erase(iter);
+                m_evictions++;
+            }
+            else {++iter;}
+        }
+        if (shard.m_map.size() >= m_max_per_shard)
+        {
+            auto victim = shard.m_map.begin();
+            for (auto iter = shard.m_map.begin(); iter != shard.m_map.end(); ++iter)
+            {
+                if (iter->second.expiry < victim->second.expiry) {victim = iter;}
+            }
+            shard.m_map.erase(victim);
+            m_evictions++;
+        }
+    }
+    shard.m_map[digest] = entry;
+}
+
+
+void
+TokenCache::Report(XrdSysError &log)
+{
+    time_t now = time(NULL);
+    time_t next = m_next_report;
+    if (now < next || !m_next_report.compare_exchange_strong(next, now + m_report_interval))
+    {
+        return;
+    }
+
+    size_t entries = 0;
+    for (int idx = 0; idx < m_shard_count; idx++)
+    {
+        std::lock_guard<std::mutex> guard(m_shards[idx].m_mutex);
+        entries += m_shards[idx].m_map.size();
+    }
+
+    unsigned long long hits = m_hits, misses = m_misses;
+    char buff[256];
+    snprintf(buff, sizeof(buff), "hits=%llu misses=%llu hit_rate=%.1f%% entries=%zu evictions=%llu",
+             hits, misses, hits + misses ? 100.0 * hits / (hits + misses) : 0.0,
+             entries, static_cast<unsigned long long>(m_evictions));
+    log.Log(LogMask::Info, "TokenCache", "Verified token cache statistics:", buff);
+}
@@ -0,0 +1,64 @@
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <time.h>
+
+class XrdSysError;
+
+namespace Macaroons
+{
+
+// Cache of macaroons whose signature chain has already been verified.
+// Entries are keyed by the SHA-256 digest of the serialized token and hold
+// the first-party caveats, so a request with a cached token only has to
+// check those caveats against the requested path and operation.  The cache
+// is split into independently locked shards, each holding a bounded number
+// of entries; an entry is dropped once its token expires.
+class TokenCache
+{
+public:
+    struct Entry
+    {
+        Entry() : expiry(0) {}
+
+        std::vector<std::string> caveats;
+        std::string id;
+        time_t expiry;
+    };
+
+    TokenCache(size_t max_entries);
+
+    // Returns true and fills in `entry` if the token is cached and not expired.
+    bool Get(const char *token, Entry &entry);
+
+    void Put(const char *token, const Entry &entry);
+
+    // Periodically log the hit rate and occupancy of the cache.
+    void Report(XrdSysError &log);
+
+private:
+    static const int m_shard_count = 16;
+    static const int m_report_interval = 600;
+
+    struct Shard
+    {
+        std::mutex m_mutex;
+        std::unordered_map<std::string, Entry> m_map;
+    };
+
+    static std::string Digest(const char *token);
+    Shard &GetShard(const std::string &digest);
+
+    Shard m_shards[m_shard_count];
+    size_t m_max_per_shard;
+
+    std::atomic<unsigned long long> m_hits;
+    std::atomic<unsigned long long> m_misses;
+    std::atomic<unsigned long long> m_evictions;
+    std::atomic<time_t> m_next_report;
+};
+
+}
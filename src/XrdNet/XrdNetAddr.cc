@@ -496,13 +496,23 @@ const char *XrdNetAddr::Set(struct addrinfo *rP, int Port, bool mapit)
 /******************************************************************************/
   
 void XrdNetAddr::SetCache(int keeptime)
+{
+   SetCache(keeptime, -1, -1);
+}
+
+/******************************************************************************/
+
+void XrdNetAddr::SetCache(int keeptime, int failtime, int dnrthrds)
 {
    static XrdNetCache theCache;
+   static int         keepTime = 0;
 
-// Set the cache keep time
+// Set the cache keep times and the number of resolver threads
 //
-   theCache.SetKT(keeptime);
-   dnsCache = (keeptime > 0 ? &theCache : 0);
+   if (keeptime >= 0) {theCache.SetKT(keeptime); keepTime = keeptime;}
+   if (failtime >= 0)  theCache.SetNT(failtime);
+   if (dnrthrds >= 0)  theCache.SetDNR(dnrthrds);
+   dnsCache = (keepTime > 0 ? &theCache : 0);
 }
 
 /******************************************************************************/
@@ -196,6 +196,19 @@ const char *Set(struct addrinfo *rP, int port, bool mapit=false);
 
 static void SetCache(int keeptime);
 
+//------------------------------------------------------------------------------
+//! Set the cache parameters for address to name resolutions. This method
+//! should only be called during initialization time.
+//!
+//! @param  keeptime  seconds to keep a resolution in the cache, 0 disables it.
+//! @param  failtime  seconds to keep a failed resolution in the cache.
+//! @param  dnrthrds  number of threads resolving names in the background when
+//!                   the cache is used, 0 resolves them inline.
+//!                   A negative value leaves the setting unchanged.
+//------------------------------------------------------------------------------
+
+static void SetCache(int keeptime, int failtime, int dnrthrds);
+
 //------------------------------------------------------------------------------
 //! Set the dialect being spoken on this network link.
 //!
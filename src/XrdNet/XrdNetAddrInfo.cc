@@ -89,11 +89,12 @@ int XrdNetAddrInfo::Format(char *bAddr, int bLen, fmtUse theFmt, int fmtOpts)
 //
    pNum = ntohs(IP.v4.sin_port);
 
-// Resolve address if need be and return result if possible
+// Resolve address if need be and return result if possible. When the address
+// is resolved in the background we use the address for now.
 //
    if (theFmt == fmtName || theFmt == fmtAuto)
       {if (!hostName && dnsCache && !(hostName = dnsCache->Find(this))
-       &&  theFmt == fmtName) Resolve();
+       &&  theFmt == fmtName && !dnsCache->Queue(this)) Resolve();
        if (hostName)
           {n = (omitP ? snprintf(bAddr, bLen, "%s",    hostName)
                       : snprintf(bAddr, bLen, "%s:%d", hostName, pNum));
@@ -312,6 +313,15 @@ const char *XrdNetAddrInfo::Name(const char *eName, const char **eText)
    if (hostName || (dnsCache && (hostName = dnsCache->Find(this))))
       return hostName;
 
+// If the address is being resolved in the background, use the address as our
+// name. The name will be in the cache for whoever asks after it is resolved.
+//
+   if (dnsCache && dnsCache->Queue(this))
+      {char hBuff[NI_MAXHOST];
+       if (Format(hBuff, sizeof(hBuff), fmtAddr, noPort))
+          {hostName = strdup(hBuff); return hostName;}
+      }
+
 // Try to resolve this address
 //
    if (!(rc = Resolve())) return hostName;
@@ -379,12 +389,19 @@ int XrdNetAddrInfo::Resolve()
    else return EAI_FAMILY;
 
 // Do lookup of canonical name. If an error is returned we simply assume that
-// the name is not resolvable and return the address as the host name.
+// the name is not resolvable and return the address as the host name. This is
+// cached as a failure so that we do not ask again for a while. We require a
+// name as otherwise getnameinfo() quietly returns the numeric address when
+// there is no PTR record or the lookup timed out, which is also a failure.
 //
-   if ((rc = getnameinfo(&IP.Addr, n, hBuff+1, sizeof(hBuff)-2, 0, 0, 0)))
+   if ((rc = getnameinfo(&IP.Addr, n, hBuff+1, sizeof(hBuff)-2, 0, 0,
+                         NI_NAMEREQD)))
       {int ec = errno;
        if (Format(hBuff, sizeof(hBuff), fmtAddr, noPort))
-          {hostName = strdup(hBuff); return 0;}
+          {hostName = strdup(hBuff);
+           if (dnsCache) dnsCache->Add(this, hostName, true);
+           return 0;
+          }
        errno = ec;
        return rc;
       }
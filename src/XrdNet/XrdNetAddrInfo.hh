@@ -52,6 +52,8 @@ class  XrdNetCache;
 
 class XrdNetAddrInfo
 {
+friend class XrdNetCache;
+
 public:
 
 //------------------------------------------------------------------------------
@@ -218,6 +220,9 @@ LocInfo    *Location() {return (addrLoc.Country[0] ? &addrLoc : 0);}
 //! @return Success: Pointer to the name or ip address with eText, if supplied,
 //!                  set to zero. The memory is owned by the object and is
 //!                  deleted when the object is deleted or Set() is called.
+//!                  When names are resolved in the background and the name is
+//!                  not yet known, the ip address is returned and remains the
+//!                  name of this object.
 //!         Failure: eName param and if eText is not zero, returns a pointer
 //!                  to a message describing the reason for the failure. The
 //!                  message is in persistent storage and cannot be modified.
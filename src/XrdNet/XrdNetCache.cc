@@ -33,20 +33,34 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 
-#include "XrdNet/XrdNetAddrInfo.hh"
+#include "XrdNet/XrdNetAddr.hh"
 #include "XrdNet/XrdNetCache.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 /******************************************************************************/
 /*                        S t a t i c   M e m b e r s                         */
 /******************************************************************************/
   
 int XrdNetCache::keepTime = 0;
+int XrdNetCache::negTime  = 0;
+
+/******************************************************************************/
+/*                     T h r e a d   I n t e r f a c e s                      */
+/******************************************************************************/
+
+void *XrdNetCacheDNR(void *carg)
+{
+   XrdNetCache *cP = (XrdNetCache *)carg;
+   return cP->Resolver();
+}
 
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
   
 XrdNetCache::XrdNetCache(int psize, int csize)
+                        : dnrSem(0), dnrFirst(0), dnrLast(0), dnrNum(0),
+                          dnrRun(0), dnrPend(0)
 {
      prevtablesize = psize;
      nashtablesize = csize;
@@ -60,22 +74,28 @@ XrdNetCache::XrdNetCache(int psize, int csize)
 /* public                            A d d                                    */
 /******************************************************************************/
   
-void XrdNetCache::Add(XrdNetAddrInfo *hAddr, const char *hName)
+void XrdNetCache::Add(XrdNetAddrInfo *hAddr, const char *hName, bool isNeg)
 {
    anItem Item, *hip;
-   int    kent;
+   int    kent, kTime = (isNeg ? negTime : keepTime);
 
 // Get the key and make sure this is a valid address (should be)
 //
    if (!GenKey(Item, hAddr)) return;
 
-// We may be in a race condition, check we have this item
+// If we are not to keep this entry, simply make sure any pending resolution
+// is removed as this may be its completion.
+//
+   if (kTime <= 0) {Drop(Item); return;}
+
+// We may be in a race condition or completing a background resolution, check
+// if we have this item.
 //
    myMutex.Lock();
    if ((hip = Locate(Item)))
       {if (hip->hName) free(hip->hName);
        hip->hName = strdup(hName);
-       hip->expTime = time(0) + keepTime;
+       hip->expTime = time(0) + kTime;
        myMutex.UnLock();
        return;
       }
@@ -86,7 +106,7 @@ void XrdNetCache::Add(XrdNetAddrInfo *hAddr, const char *hName)
 
 // Allocate a new entry
 //
-   hip = new anItem(Item, hName, keepTime);
+   hip = new anItem(Item, hName, kTime);
 
 // Add the entry to the table
 //
@@ -96,6 +116,30 @@ void XrdNetCache::Add(XrdNetAddrInfo *hAddr, const char *hName)
    myMutex.UnLock();
 }
   
+/******************************************************************************/
+/* Private:                         D r o p                                   */
+/******************************************************************************/
+  
+void XrdNetCache::Drop(XrdNetCache::anItem &Item)
+{
+   anItem *nip, *pip = 0;
+   int kent;
+
+// Find the entry and remove it, if it exists
+//
+   myMutex.Lock();
+   kent = Item.aHash%nashtablesize;
+   nip = nashtable[kent];
+   while(nip && *nip != Item) {pip = nip; nip = nip->Next;}
+   if (nip)
+      {if (pip) pip->Next       = nip->Next;
+          else  nashtable[kent] = nip->Next;
+       nashnum--;
+      }
+   myMutex.UnLock();
+   if (nip) delete nip;
+}
+
 /******************************************************************************/
 /* private                        E x p a n d                                 */
 /******************************************************************************/
@@ -163,9 +207,9 @@ char *XrdNetCache::Find(XrdNetAddrInfo *hAddr)
 //
    nip = nashtable[kent];
    while(nip && *nip != Item) {pip = nip; nip = nip->Next;}
-   if (!nip) {myMutex.UnLock(); return 0;}
+   if (!nip || !nip->hName) {myMutex.UnLock(); return 0;}
 
-// Make sure entry has not expired
+// Make sure entry has not expired (pending resolutions never expire)
 //
    if (nip->expTime > time(0))
       {char *hName = strdup(nip->hName);
@@ -177,6 +221,7 @@ char *XrdNetCache::Find(XrdNetAddrInfo *hAddr)
 //
    if (pip) pip->Next       = nip->Next;
       else  nashtable[kent] = nip->Next;
+   nashnum--;
    myMutex.UnLock();
    delete nip;
    return 0;
@@ -233,3 +278,102 @@ XrdNetCache::anItem *XrdNetCache::Locate(XrdNetCache::anItem &Item)
    while(nip && *nip != Item) nip = nip->Next;
    return nip;
 }
+
+/******************************************************************************/
+/* public                          Q u e u e                                  */
+/******************************************************************************/
+  
+bool XrdNetCache::Queue(XrdNetAddrInfo *hAddr)
+{
+   anItem Item, *hip;
+   dnrReq *rP;
+   pthread_t tid;
+   int kent;
+
+// Make sure this is a valid address
+//
+   if (!GenKey(Item, hAddr)) return false;
+
+// Make sure we are doing background resolutions. If the address is already
+// being resolved (or just was) there is nothing more to do. Should too many
+// addresses be waiting for a resolver, this one is resolved inline. Otherwise,
+// add a pending entry so that others don't queue it.
+//
+   myMutex.Lock();
+   if (dnrNum <= 0)         {myMutex.UnLock(); return false;}
+   if (Locate(Item))        {myMutex.UnLock(); return true;}
+   if (dnrPend >= dnrMaxQ)  {myMutex.UnLock(); return false;}
+   if (++nashnum > Threshold) Expand();
+   hip = new anItem(Item, 0, 0);
+   kent = hip->aHash % nashtablesize;
+   hip->Next = nashtable[kent];
+   nashtable[kent] = hip;
+
+// Start the resolver threads if this is the first request
+//
+   while(dnrRun < dnrNum)
+        {if (XrdSysThread::Run(&tid, XrdNetCacheDNR, (void *)this, 0,
+                               "DNS resolver")) break;
+         dnrRun++;
+        }
+
+// If we have no threads then we must do this inline
+//
+   if (!dnrRun)
+      {dnrNum = 0;
+       myMutex.UnLock();
+       Drop(Item);
+       return false;
+      }
+
+// Queue the request for the resolver
+//
+   rP = new dnrReq;
+   rP->Next = 0;
+   memcpy(rP->Item.aVal, Item.aVal, sizeof(Item.aVal));
+   rP->Item.aHash = Item.aHash;
+   rP->Item.aLen  = Item.aLen;
+   if (dnrLast) dnrLast->Next = rP;
+      else      dnrFirst       = rP;
+   dnrLast = rP;
+   dnrPend++;
+   myMutex.UnLock();
+   dnrSem.Post();
+   return true;
+}
+
+/******************************************************************************/
+/* public                       R e s o l v e r                               */
+/******************************************************************************/
+  
+void *XrdNetCache::Resolver()
+{
+   XrdNetAddr     tAddr;
+   XrdNetSockAddr sAddr;
+   dnrReq *rP;
+
+// Process requests as they arrive. Resolve() adds the result to the cache,
+// replacing the pending entry.
+//
+   while(1)
+        {dnrSem.Wait();
+         myMutex.Lock();
+         if (!(rP = dnrFirst)) {myMutex.UnLock(); continue;}
+         if (!(dnrFirst = rP->Next)) dnrLast = 0;
+         dnrPend--;
+         myMutex.UnLock();
+
+         memset(&sAddr, 0, sizeof(sAddr));
+         if (rP->Item.aLen == 4)
+            {sAddr.v4.sin_family = AF_INET;
+             memcpy(&sAddr.v4.sin_addr, rP->Item.aVal, 4);
+            } else {
+             sAddr.v6.sin6_family = AF_INET6;
+             memcpy(&sAddr.v6.sin6_addr, rP->Item.aVal, 16);
+            }
+
+         if (tAddr.Set(&sAddr.Addr) || tAddr.Resolve()) Drop(rP->Item);
+         delete rP;
+        }
+   return (void *)0;
+}
\ No newline at end of file
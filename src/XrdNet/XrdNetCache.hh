@@ -48,9 +48,12 @@ public:
 //!
 //! @param  hAddr  points to the address of the name.
 //! @param  hName  points to the name to be associated with the address.
+//! @param  isNeg  when true, the address could not be resolved and hName is
+//!                the address itself. The entry is kept for the failure keep
+//!                time, if any, instead of the normal keep time.
 //------------------------------------------------------------------------------
 
-void   Add(XrdNetAddrInfo *hAddr, const char *hName);
+void   Add(XrdNetAddrInfo *hAddr, const char *hName, bool isNeg=false);
 
 //------------------------------------------------------------------------------
 //! Locate an address-hostname association in the cache.
@@ -63,6 +66,33 @@ void   Add(XrdNetAddrInfo *hAddr, const char *hName);
 
 char  *Find(XrdNetAddrInfo *hAddr);
 
+//------------------------------------------------------------------------------
+//! Queue an address for asynchronous resolution. The name, or the failure,
+//! is added to the cache once the lookup completes. Concurrent requests for the
+//! same address result in a single lookup. At most dnrMaxQ addresses may wait
+//! for a resolver; beyond that the address must be resolved inline.
+//!
+//! @param  hAddr  points to the address to be resolved.
+//!
+//! @return True:  the address is being resolved in the background.
+//!         False: asynchronous resolution is not enabled or the queue is
+//!                full, resolve it inline.
+//------------------------------------------------------------------------------
+
+bool   Queue(XrdNetAddrInfo *hAddr);
+
+//------------------------------------------------------------------------------
+//! Set the number of threads to use for asynchronous resolution. The threads
+//! are started when the first address is queued. This method should only be
+//! called during initialization.
+//!
+//! @param  nthreads  the number of threads, zero disables asynchronous lookups.
+//------------------------------------------------------------------------------
+
+void   SetDNR(int nthreads) {myMutex.Lock(); dnrNum = nthreads;
+                            myMutex.UnLock();
+                           }
+
 //------------------------------------------------------------------------------
 //! Set the default keep time for entries in the cache during initialization.
 //!
@@ -71,6 +101,15 @@ char  *Find(XrdNetAddrInfo *hAddr);
 static
 void   SetKT(int ktval) {keepTime = ktval;}
 
+//------------------------------------------------------------------------------
+//! Set the keep time for failed resolutions during initialization. By default,
+//! failures are not cached.
+//!
+//! @param  ntVal  the number of seconds to keep a failure in the cache.
+//------------------------------------------------------------------------------
+static
+void   SetNT(int ntval) {negTime = ntval;}
+
 //------------------------------------------------------------------------------
 //! Constructor. When allocateing a new hash, two adjacent Fibonocci numbers.
 //! The series is simply n[j] = n[j-1] + n[j-2].
@@ -88,9 +127,12 @@ void   SetKT(int ktval) {keepTime = ktval;}
 
       ~XrdNetCache() {} // Never gets deleted
 
+void  *Resolver();
+
 private:
 
 static const int LoadMax = 80;
+static const int dnrMaxQ = 1024;
 
 struct anItem
       {union    {long long aV6[2];
@@ -98,7 +140,7 @@ struct anItem
                  char      aVal[16];  // Enough for IPV4 or IPV6
                 };
        anItem   *Next;
-       char     *hName;
+       char     *hName;     // Nil while the address is being resolved
        time_t    expTime;   // Expiration time
 unsigned int     aHash;     // Hash value
        int       aLen;      // Actual length 4 or 16
@@ -111,19 +153,33 @@ inline int       operator!=(const anItem &oth)
                  anItem() : Next(0), hName(0), aLen(0) {}
 
                  anItem(anItem &Item, const char *hn, int kt)
-                         : Next(0), hName(strdup(hn)), expTime(time(0)+kt),
+                         : Next(0), hName(hn ? strdup(hn) : 0),
+                           expTime(time(0)+kt),
                            aHash(Item.aHash), aLen(Item.aLen)
                          {memcpy(aVal, Item.aVal, Item.aLen);}
                 ~anItem() {if (hName) free(hName);}
       };
 
+struct dnrReq
+      {dnrReq   *Next;
+       anItem    Item;
+      };
+
+void             Drop(anItem &Item);
 void             Expand();
 int              GenKey(anItem &Item, XrdNetAddrInfo *hAddr);
 anItem          *Locate(anItem &Item);
 
 static int       keepTime;
+static int       negTime;
 
 XrdSysMutex      myMutex;
+XrdSysSemaphore  dnrSem;
+dnrReq          *dnrFirst;
+dnrReq          *dnrLast;
+int              dnrNum;
+int              dnrRun;
+int              dnrPend;
 anItem         **nashtable;
 int              prevtablesize;
 int              nashtablesize;
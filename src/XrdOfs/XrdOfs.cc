@@ -54,11 +54,13 @@
 
 #include "XrdOfs/XrdOfs.hh"
 #include "XrdOfs/XrdOfsChkPnt.hh"
+#include "XrdOfs/XrdOfsCksWrite.hh"
 #include "XrdOfs/XrdOfsConfigCP.hh"
 #include "XrdOfs/XrdOfsEvs.hh"
 #include "XrdOfs/XrdOfsHandle.hh"
 #include "XrdOfs/XrdOfsPoscq.hh"
 #include "XrdOfs/XrdOfsPrepare.hh"
+#include "XrdOfs/XrdOfsReadShare.hh"
 #include "XrdOfs/XrdOfsTrace.hh"
 #include "XrdOfs/XrdOfsSecurity.hh"
 #include "XrdOfs/XrdOfsStats.hh"
@@ -175,6 +177,12 @@ XrdOfs::XrdOfs() : tpcRdrHost{}, tpcRdrPort{}
    Cks       = 0;
    CksPfn    = true;
    CksRdr    = true;
+   CksWrt    = 0;
+
+// Read sharing is off by default
+//
+   RdShrNum  = 0;
+   RdShrMsz  = 0;
 
 // Prepare handling
 //
@@ -634,6 +642,7 @@ int XrdOfsFile::open(const char          *path,      // In
       {dorawio = (oh->isCompressed && open_mode & SFS_O_RAWIO ? 1 : 0);
        if (tpcKey && isRW)
           return XrdOfsFS->Emsg(epname, error, EALREADY, "tpc", path);
+       if (isRW && oP.hP->cksWrt) oP.hP->cksWrt->Invalidate();
        XrdOfsFS->ocMutex.Lock(); oh = oP.hP; XrdOfsFS->ocMutex.UnLock();
        FTRACE(open, "attach use=" <<oh->Usage());
        if (oP.poscNum > 0) XrdOfsFS->poscQ->Commit(path, oP.poscNum);
@@ -692,6 +701,11 @@ int XrdOfsFile::open(const char          *path,      // In
        dorawio = (open_mode & SFS_O_RAWIO ? 1 : 0);
       }
    oP.hP->Activate(oP.fP);
+
+// If the file starts out empty we can checksum it as it is being written
+//
+   if ((open_mode & crMask) && XrdOfsCksWrite::Enabled())
+      oP.hP->cksWrt = XrdOfsCksWrite::Alloc();
    oP.hP->UnLock();
 
 // Send an open event if we must
@@ -799,6 +813,20 @@ int XrdOfsFile::close()  // In
        myCKP = 0;
       }
 
+// If this is the final close and the checksums were computed as the file was
+// written, record them now while the file is still open.
+//
+   if (hP->cksWrt && hP->Usage() == 1)
+      {XrdOfsCksWrite *cwP = hP->cksWrt;
+       char pfnbuff[MAXPATHLEN+8];
+       const char *xfn = hP->Name();
+       hP->cksWrt = 0;
+       if (XrdOfsFS->CksPfn
+       &&  !(xfn = XrdOfsOss->Lfn2Pfn(hP->Name(), pfnbuff, MAXPATHLEN, retc)))
+          cwP->Recycle();
+          else cwP->Finish(hP->Select(), xfn);
+      }
+
 // We need to handle the cunudrum that an event may have to be sent upon
 // the final close. However, that would cause the path name to be destroyed.
 // So, we have two modes of logic where we copy out the pathname if a final
@@ -856,6 +884,7 @@ int XrdOfsFile::checkpoint(XrdSfsFile::cpAct act, struct iov *range, int n)
    switch(act)
          {case XrdSfsFile::cpCreate:
                ckpName = "create checkpoint for";
+               if (oh->cksWrt) oh->cksWrt->Invalidate();
                if ((rc = CreateCKP())) return rc;
                if ((rc = myCKP->Create())) {myCKP->Finished(); myCKP = 0;}
                break;
@@ -962,10 +991,12 @@ int            XrdOfsFile::fctl(const int               cmd,
                                 const char             *args,
                                       XrdOucErrInfo    &out_error)
 {
-// See if we can do this
+// See if we can do this. When reads are shared we hide the file descriptor of
+// a read-only file as sendfile() would bypass read sharing.
 //
    if (cmd == SFS_FCTL_GETFD)
-      {out_error.setErrCode(oh->Select().getFD());
+      {if (!(oh->isRW) && XrdOfsReadShare::Enabled()) out_error.setErrCode(-1);
+          else out_error.setErrCode(oh->Select().getFD());
        return SFS_OK;
       }
 
@@ -1079,11 +1110,14 @@ XrdSfsXferSize XrdOfsFile::read(XrdSfsFileOffset  offset,    // In
 
 // Now read the actual number of bytes
 //
-   nbytes = (dorawio ?
-            (XrdSfsXferSize)(oh->Select().ReadRaw((void *)buff,
-                            (off_t)offset, (size_t)blen))
-          : (XrdSfsXferSize)(oh->Select().Read((void *)buff,
-                            (off_t)offset, (size_t)blen)));
+   if (dorawio)
+      nbytes = (XrdSfsXferSize)(oh->Select().ReadRaw((void *)buff,
+                               (off_t)offset, (size_t)blen));
+      else if (!(oh->isRW) && XrdOfsReadShare::Enabled())
+              nbytes = (XrdSfsXferSize)XrdOfsReadShare::Read(oh->Select(),
+                               oh, (void *)buff, (off_t)offset, (size_t)blen);
+      else nbytes = (XrdSfsXferSize)(oh->Select().Read((void *)buff,
+                               (off_t)offset, (size_t)blen));
    if (nbytes < 0)
       return XrdOfsFS->Emsg(epname, error, (int)nbytes, "read", oh->Name());
 
@@ -1139,9 +1173,10 @@ int XrdOfsFile::read(XrdSfsAio *aiop)
    EPNAME("aioread");
    int rc;
 
-// Async mode for compressed files is not supported.
+// Async mode for compressed files is not supported. Neither is it when reads
+// are being shared as the read may need to wait for another one to complete.
 //
-   if (oh->isCompressed)
+   if (oh->isCompressed || (!(oh->isRW) && XrdOfsReadShare::Enabled()))
       {aiop->Result = this->read((XrdSfsFileOffset)aiop->sfsAio.aio_offset,
                                            (char *)aiop->sfsAio.aio_buf,
                                    (XrdSfsXferSize)aiop->sfsAio.aio_nbytes);
@@ -1217,7 +1252,13 @@ XrdSfsXferSize XrdOfsFile::write(XrdSfsFileOffset  offset,    // In
    nbytes = (XrdSfsXferSize)(oh->Select().Write((const void *)buff,
                             (off_t)offset, (size_t)blen));
    if (nbytes < 0)
-      return XrdOfsFS->Emsg(epname, error, (int)nbytes, "write", oh);
+      {if (oh->cksWrt) oh->cksWrt->Invalidate();
+       return XrdOfsFS->Emsg(epname, error, (int)nbytes, "write", oh);
+      }
+
+// Feed the data to the write checksums, if any
+//
+   if (oh->cksWrt) oh->cksWrt->Update(offset, buff, nbytes);
 
 // Return number of bytes written
 //
@@ -1241,8 +1282,10 @@ int XrdOfsFile::write(XrdSfsAio *aiop)
 
 // If this is a POSC file, we must convert the async call to a sync call as we
 // must trap any errors that unpersist the file. We can't do that via aio i/f.
+// The same holds when checksums are computed while writing as only data that
+// was actually written may be fed to them.
 //
-   if (oh->isRW == XrdOfsHandle::opPC)
+   if (oh->isRW == XrdOfsHandle::opPC || oh->cksWrt)
       {aiop->Result = this->write(aiop->sfsAio.aio_offset,
                                   (const char *)aiop->sfsAio.aio_buf,
                                   aiop->sfsAio.aio_nbytes);
@@ -1422,6 +1465,7 @@ int XrdOfsFile::truncate(XrdSfsFileOffset  flen)  // In
 // Perform the function
 //
    oh->isPending = 1;
+   if (oh->cksWrt) oh->cksWrt->Truncate(flen);
    if ((retc = oh->Select().Ftruncate(flen)))
       return XrdOfsFS->Emsg(epname, error, retc, "truncate", oh);
 
@@ -0,0 +1,207 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O f s C k s W r i t e . c c                      */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "XrdCks/XrdCks.hh"
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksData.hh"
+#include "XrdOfs/XrdOfsCksWrite.hh"
+#include "XrdOfs/XrdOfsStats.hh"
+#include "XrdOss/XrdOss.hh"
+#include "XrdSys/XrdSysError.hh"
+
+/******************************************************************************/
+/*                      G l o b a l   V a r i a b l e s                       */
+/******************************************************************************/
+
+extern XrdOfsStats OfsStats;
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+XrdCks      *XrdOfsCksWrite::cksObj = 0;
+XrdSysError *XrdOfsCksWrite::eDest  = 0;
+char        *XrdOfsCksWrite::csName[XrdOfsCksWrite::maxCks] = {0};
+int          XrdOfsCksWrite::numCks = 0;
+
+/******************************************************************************/
+/*                                 A l l o c                                  */
+/******************************************************************************/
+
+XrdOfsCksWrite *XrdOfsCksWrite::Alloc()
+{
+   XrdOfsCksWrite *cwP;
+   int i;
+
+// Do nothing unless we are enabled
+//
+   if (!numCks) return 0;
+
+// Get a calculation object for each checksum. These should never fail as we
+// verified all of them at configuration time.
+//
+   cwP = new XrdOfsCksWrite();
+   for (i = 0; i < numCks; i++)
+       {if (!(cwP->csCalc[i] = cksObj->Object(csName[i])))
+           {while(i--) cwP->csCalc[i]->Recycle();
+            delete cwP;
+            return 0;
+           }
+        cwP->csCalc[i]->Init();
+       }
+   return cwP;
+}
+
+/******************************************************************************/
+/*                                F i n i s h                                 */
+/******************************************************************************/
+
+int XrdOfsCksWrite::Finish(XrdOssDF &ossDF, const char *Xfn)
+{
+   XrdCksData  cksData;
+   struct stat Stat;
+   const char *csVal;
+   int i, csLen, rc, numSet = 0;
+
+// We must have seen every byte of the file. The handle is locked and this is
+// the final close so no one else can be writing at this point.
+//
+   if (!isBad && !ossDF.Fstat(&Stat) && Stat.st_size == nextOffs)
+      {for (i = 0; i < numCks; i++)
+           {csVal = csCalc[i]->Final();
+            csCalc[i]->Type(csLen);
+            cksData.Set(csName[i]);
+            cksData.Set((const void *)csVal, csLen);
+            if ((rc = cksObj->Set(Xfn, cksData)))
+               eDest->Emsg("CksWrite", rc, "set checksum for", Xfn);
+               else numSet++;
+           }
+      }
+
+// Update statistics (we have no lock here so use the global stats lock)
+//
+   OfsStats.sdMutex.Lock();
+   if (numSet) OfsStats.Data.numCksWrt++;
+      else OfsStats.Data.numCksWrx++;
+   OfsStats.sdMutex.UnLock();
+
+// All done
+//
+   Recycle();
+   return numSet;
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+bool XrdOfsCksWrite::Init(XrdCks *cksP, const char *names, XrdSysError &eMsg)
+{
+   XrdCksCalc *calcP;
+   char *nBuff, *name, *save = 0;
+   int i;
+
+// Record the message object, we will need it later
+//
+   eDest = &eMsg;
+
+// We need a checksum manager
+//
+   if (!cksP)
+      {eMsg.Say("Config warning: ckswrite ignored; checksums not configured.");
+       return true;
+      }
+   cksObj = cksP;
+
+// Each checksum must exist and be computable on the fly
+//
+   nBuff = strdup(names);
+   name  = strtok_r(nBuff, " ", &save);
+   while(name)
+        {for (i = 0; i < numCks && strcmp(name, csName[i]); i++) {}
+         if (i < numCks) {name = strtok_r(0, " ", &save); continue;}
+         if (numCks >= maxCks)
+            {eMsg.Emsg("Config", "too many ckswrite checksums specified");
+             free(nBuff); numCks = 0; return false;
+            }
+         if (!cksP->Size(name) || !(calcP = cksP->Object(name)))
+            {eMsg.Emsg("Config", name, "checksum cannot be computed as files "
+                                       "are written.");
+             free(nBuff); numCks = 0; return false;
+            }
+         calcP->Recycle();
+         csName[numCks++] = strdup(name);
+         name = strtok_r(0, " ", &save);
+        }
+   free(nBuff);
+   return true;
+}
+
+/******************************************************************************/
+/*                               R e c y c l e                                */
+/******************************************************************************/
+
+void XrdOfsCksWrite::Recycle()
+{
+   for (int i = 0; i < numCks; i++) csCalc[i]->Recycle();
+   delete this;
+}
+
+/******************************************************************************/
+/*                              T r u n c a t e                               */
+/******************************************************************************/
+
+void XrdOfsCksWrite::Truncate(long long flen)
+{
+   csMutex.Lock();
+   if (flen != nextOffs) isBad = true;
+   csMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                                U p d a t e                                 */
+/******************************************************************************/
+
+void XrdOfsCksWrite::Update(long long offs, const char *buff, int blen)
+{
+   XrdSysMutexHelper csHelp(csMutex);
+
+// Once we have a hole or an overwrite there is no going back
+//
+   if (isBad) return;
+   if (offs != nextOffs) {isBad = true; return;}
+
+// Run the data through each checksum
+//
+   for (int i = 0; i < numCks; i++) csCalc[i]->Update(buff, blen);
+   nextOffs += blen;
+}
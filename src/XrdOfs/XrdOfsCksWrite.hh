@@ -0,0 +1,138 @@
+#ifndef __XRDOFSCKSWRITE_HH__
+#define __XRDOFSCKSWRITE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O f s C k s W r i t e . h h                      */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdSys/XrdSysPthread.hh"
+
+//-----------------------------------------------------------------------------
+//! The XrdOfsCksWrite class computes the checksums of a file as it is being
+//! written. It is attached to the handle of a file that was created or
+//! truncated at open time and is fed every write. As long as the writes arrive
+//! strictly in offset order the checksums are complete when the file is
+//! finally closed and are then recorded as if they had been calculated. Any
+//! other write pattern simply turns the computation off; the checksum is then
+//! calculated on demand, as usual.
+//-----------------------------------------------------------------------------
+
+class XrdCks;
+class XrdCksCalc;
+class XrdOssDF;
+class XrdSysError;
+
+class XrdOfsCksWrite
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! Get a new object for a file about to be written.
+//!
+//! @return Pointer to the object or nil if write checksums are not enabled.
+//-----------------------------------------------------------------------------
+
+static XrdOfsCksWrite *Alloc();
+
+//-----------------------------------------------------------------------------
+//! Check whether or not checksums are computed while writing.
+//-----------------------------------------------------------------------------
+
+static bool            Enabled() {return numCks > 0;}
+
+//-----------------------------------------------------------------------------
+//! Record the checksums, if they are valid, and delete this object.
+//!
+//! @param  ossDF  The file, used to verify that all of it was seen.
+//! @param  Xfn    The logical or physical file name as needed by XrdCks.
+//!
+//! @return The number of checksums that were recorded.
+//-----------------------------------------------------------------------------
+
+        int            Finish(XrdOssDF &ossDF, const char *Xfn);
+
+//-----------------------------------------------------------------------------
+//! Initialize write checksums (one time call at configuration time).
+//!
+//! @param  cksP   The checksum manager.
+//! @param  names  Space separated list of checksum names.
+//! @param  eDest  The message object.
+//!
+//! @return True upon success and false otherwise.
+//-----------------------------------------------------------------------------
+
+static bool            Init(XrdCks *cksP, const char *names,
+                            XrdSysError &eDest);
+
+//-----------------------------------------------------------------------------
+//! Turn off the computation, the checksums will not be recorded.
+//-----------------------------------------------------------------------------
+
+        void           Invalidate() {csMutex.Lock(); isBad = true;
+                                     csMutex.UnLock();
+                                    }
+
+//-----------------------------------------------------------------------------
+//! Delete this object without recording anything.
+//-----------------------------------------------------------------------------
+
+        void           Recycle();
+
+//-----------------------------------------------------------------------------
+//! Account for a truncate. Only a truncate to the current end is harmless.
+//!
+//! @param  flen   The new length of the file.
+//-----------------------------------------------------------------------------
+
+        void           Truncate(long long flen);
+
+//-----------------------------------------------------------------------------
+//! Feed a write that was successfully done.
+//!
+//! @param  offs   The offset of the write.
+//! @param  buff   The data written.
+//! @param  blen   The number of bytes written.
+//-----------------------------------------------------------------------------
+
+        void           Update(long long offs, const char *buff, int blen);
+
+static const int       maxCks = 4;
+
+private:
+                       XrdOfsCksWrite() : nextOffs(0), isBad(false) {}
+                      ~XrdOfsCksWrite() {}
+
+static XrdCks         *cksObj;
+static XrdSysError    *eDest;
+static char           *csName[maxCks];
+static int             numCks;
+
+XrdSysMutex            csMutex;
+XrdCksCalc            *csCalc[maxCks];
+long long              nextOffs;
+bool                   isBad;
+};
+#endif
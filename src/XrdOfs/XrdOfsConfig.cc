@@ -39,6 +39,7 @@
 #include <netinet/in.h>
 #include <sys/param.h>
 #include <sys/stat.h>
+#include <string>
 
 #include "XrdVersion.hh"
 #include "XProtocol/XProtocol.hh"
@@ -50,10 +51,12 @@
 #include "XrdSfs/XrdSfsFlags.hh"
 
 #include "XrdOfs/XrdOfs.hh"
+#include "XrdOfs/XrdOfsCksWrite.hh"
 #include "XrdOfs/XrdOfsConfigCP.hh"
 #include "XrdOfs/XrdOfsConfigPI.hh"
 #include "XrdOfs/XrdOfsEvs.hh"
 #include "XrdOfs/XrdOfsPoscq.hh"
+#include "XrdOfs/XrdOfsReadShare.hh"
 #include "XrdOfs/XrdOfsStats.hh"
 #include "XrdOfs/XrdOfsTPC.hh"
 #include "XrdOfs/XrdOfsTrace.hh"
@@ -337,6 +340,18 @@ int XrdOfs::Configure(XrdSysError &Eroute, XrdOucEnv *EnvInfo) {
        FeatureSet |= XrdSfs::hasPRXY;
       } else if (!(Options & isManager) && !XrdOfsConfigCP::Init()) NoGo = 1;
 
+// If checksums are to be computed as files are written, initialize that. This
+// makes no sense for a proxy or a manager as no data is written here.
+//
+   if (CksWrt && !NoGo && !OssIsProxy && !(Options & isManager)
+   &&  !XrdOfsCksWrite::Init(Cks, CksWrt, Eroute)) NoGo = 1;
+
+// If concurrent reads of the same file are to be shared, initialize that. A
+// manager has no data and a proxy may already do this in its cache.
+//
+   if (RdShrNum && !NoGo && !OssIsProxy && !(Options & isManager)
+   &&  !XrdOfsReadShare::Init(RdShrNum, RdShrMsz, Eroute)) NoGo = 1;
+
 // If POSC processing is enabled (as by default) do it. Warning! This must be
 // the last item in the configuration list as we need a working filesystem.
 // Note that in proxy mode we always disable posc!
@@ -724,7 +739,9 @@ int XrdOfs::ConfigXeq(char *var, XrdOucStream &Config,
     TS_Bit("authorize",     Options, Authorize);
     TS_XPI("authlib",       theAutLib);
     TS_XPI("ckslib",        theCksLib);
+    TS_Xeq("ckscalc",       xckcl);
     TS_Xeq("cksrdsz",       xcrds);
+    TS_Xeq("ckswrite",      xckwr);
     TS_XPI("cmslib",        theCmsLib);
     TS_XPI("ctllib",        theCtlLib);
     TS_Xeq("dirlist",       xdirl);
@@ -735,6 +752,7 @@ int XrdOfs::ConfigXeq(char *var, XrdOucStream &Config,
     TS_XPI("osslib",        theOssLib);
     TS_Xeq("persist",       xpers);
     TS_XPI("preplib",       thePrpLib);
+    TS_Xeq("readshare",     xrdshr);
     TS_Xeq("role",          xrole);
     TS_Xeq("tpc",           xtpc);
     TS_Xeq("trace",         xtrace);
@@ -762,6 +780,86 @@ int XrdOfs::ConfigXeq(char *var, XrdOucStream &Config,
     return 0;
 }
 
+/******************************************************************************/
+/*                                 x c k c l                                  */
+/******************************************************************************/
+  
+/* Function: xckcl
+
+   Purpose:  To parse the directive: ckscalc <parms>
+
+             <parms> how checksums are to be calculated. These are passed to
+                     the checksum manager (see XrdCksManager::ConfigCalc()):
+                     [threads <n>] [segsize <sz>] [also <name>[,<name>]]
+
+  Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOfs::xckcl(XrdOucStream &Config, XrdSysError &Eroute)
+{
+   char parms[1024];
+
+// Get the parameters, they are verified by the checksum manager
+//
+   if (!Config.GetRest(parms, sizeof(parms)))
+      {Eroute.Emsg("Config", "ckscalc parameters too long"); return 1;}
+   if (!*parms)
+      {Eroute.Emsg("Config", "ckscalc parameters not specified"); return 1;}
+
+// Record the parameters
+//
+   ofsConfig->SetCksCalc(parms);
+   return 0;
+}
+
+/******************************************************************************/
+/*                                 x c k w r                                  */
+/******************************************************************************/
+  
+/* Function: xckwr
+
+   Purpose:  To parse the directive: ckswrite {off | <name> [<name> [...]]}
+
+             off     does not compute checksums as files are written (default).
+             <name>  the name of a configured checksum to compute as a newly
+                     created or truncated file is written. When the file is
+                     written sequentially, the checksum is recorded upon close
+                     and need not be calculated later. Up to four checksums
+                     may be specified.
+
+  Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOfs::xckwr(XrdOucStream &Config, XrdSysError &Eroute)
+{
+   std::string csList;
+   char *val;
+
+// Get the first checksum name
+//
+   if (!(val = Config.GetWord()) || !val[0])
+      {Eroute.Emsg("Config", "ckswrite checksum not specified"); return 1;}
+
+// Handle turning this off
+//
+   if (!strcmp(val, "off"))
+      {if (CksWrt) {free(CksWrt); CksWrt = 0;}
+       return 0;
+      }
+
+// Collect all of the names
+//
+   do {if (csList.size()) csList += ' ';
+       csList += val;
+      } while((val = Config.GetWord()) && val[0]);
+
+// Record the list
+//
+   if (CksWrt) free(CksWrt);
+   CksWrt = strdup(csList.c_str());
+   return 0;
+}
+
 /******************************************************************************/
 /*                                 x c r d s                                  */
 /******************************************************************************/
@@ -1271,6 +1369,76 @@ int XrdOfs::xpers(XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
 
+/******************************************************************************/
+/*                                x r d s h r                                 */
+/******************************************************************************/
+  
+/* Function: xrdshr
+
+   Purpose:  To parse the directive: readshare {off | on} [maxreads <n>]
+                                               [maxsize <sz>]
+
+             off       each read goes to the storage system (default).
+             on        a read that falls entirely within a read of the same
+                       file already in progress waits for it and uses its data.
+                       Only files opened for reading are eligible and such
+                       files are not sent using sendfile().
+             <n>       The maximum number of reads that may be in progress at
+                       any one time and may be shared (default 256).
+             <sz>      The largest read that may be shared (default 2m).
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOfs::xrdshr(XrdOucStream &Config, XrdSysError &Eroute)
+{
+   long long msz = -1;
+   int rnum = -1;
+   char *val;
+   bool isOn;
+
+// Get the first option
+//
+   if (!(val = Config.GetWord()) || !val[0])
+      {Eroute.Emsg("Config", "readshare option not specified"); return 1;}
+
+// Check for on or off
+//
+        if (!strcmp(val, "on" )) isOn = true;
+   else if (!strcmp(val, "off")) isOn = false;
+   else {Eroute.Emsg("Config", "invalid readshare option -", val); return 1;}
+
+// Process the remaining options
+//
+   while((val = Config.GetWord()))
+        {     if (!strcmp(val, "maxreads"))
+                 {if (!(val = Config.GetWord()))
+                     {Eroute.Emsg("Config","readshare maxreads not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2i(Eroute, "readshare maxreads", val,
+                                     &rnum, 1, 65536)) return 1;
+                 }
+         else if (!strcmp(val, "maxsize"))
+                 {if (!(val = Config.GetWord()))
+                     {Eroute.Emsg("Config","readshare maxsize not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2sz(Eroute, "readshare maxsize", val,
+                                      &msz, 4096, 1024*1024*1024)) return 1;
+                 }
+         else Eroute.Say("Config warning: ignoring invalid readshare option '",
+                         val, "'.");
+        }
+
+// Set values as needed
+//
+   if (!isOn) {RdShrNum = 0; return 0;}
+   RdShrNum = (rnum > 0 ? rnum : 256);
+   RdShrMsz = (msz  > 0 ? static_cast<int>(msz) : 2*1024*1024);
+   return 0;
+}
+
 /******************************************************************************/
 /*                                 x r o l e                                  */
 /******************************************************************************/
@@ -33,6 +33,7 @@
 #include <sys/errno.h>
 #include <sys/types.h>
 
+#include "XrdOfs/XrdOfsCksWrite.hh"
 #include "XrdOfs/XrdOfsHandle.hh"
 #include "XrdOfs/XrdOfsStats.hh"
 #include "XrdOss/XrdOss.hh"
@@ -332,6 +333,7 @@ int XrdOfsHandle::Alloc(XrdOfsHanKey theKey, int Opts, XrdOfsHandle **Handle)
        hP->isRW         = (Opts & opPC);           // File mode
        hP->ssi          = ossDF;                   // No storage system yet
        hP->Posc         = 0;                       // No creator
+       hP->cksWrt       = 0;                       // No write checksums
        hP->Lock();                                 // Wait is not possible
        *Handle = hP;
        return 0;
@@ -468,6 +470,7 @@ int XrdOfsHandle::Retire(int &retc, long long *retsz, char *buff, int blen)
        numLeft = 0; OfsStats.Dec(OfsStats.Data.numHandles);
        if ( (isRW ? rwTable.Remove(this) : roTable.Remove(this)) )
          {if (Posc) {Posc->Recycle(); Posc = 0;}
+          if (cksWrt) {cksWrt->Recycle(); cksWrt = 0;}
           if (Path.Val) {free((void *)Path.Val); Path.Val = (char *)"";}
           Path.Len = 0; mySSI = ssi; ssi = ossDF;
           Next = Free; Free = this; UnLock(); myMutex.UnLock();
@@ -119,6 +119,7 @@ int              Threshold;
 /******************************************************************************/
   
 class XrdOssDF;
+class XrdOfsCksWrite;
 class XrdOfsHanCB;
 class XrdOfsHanPsc;
 
@@ -132,6 +133,7 @@ char                isPending;    // 1-> File  is pending sync()
 char                isChanged;    // 1-> File was modified
 char                isCompressed; // 1-> File  is compressed
 char                isRW;         // T-> File  is open in r/w mode
+XrdOfsCksWrite     *cksWrt;       // -> Checksums computed while writing
 
 void                Activate(XrdOssDF *ssP) {ssi = ssP;}
 
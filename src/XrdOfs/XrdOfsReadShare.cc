@@ -0,0 +1,203 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O f s R e a d S h a r e . c c                     */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "XrdOfs/XrdOfsReadShare.hh"
+#include "XrdOss/XrdOss.hh"
+#include "XrdOuc/XrdOucBuffer.hh"
+#include "XrdSys/XrdSysAtomics.hh"
+#include "XrdSys/XrdSysError.hh"
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+XrdOfsReadShare::rsBucket XrdOfsReadShare::Bucket[XrdOfsReadShare::numBuckets];
+XrdOucBuffPool           *XrdOfsReadShare::bPool     = 0;
+XrdSysMutex               XrdOfsReadShare::fcMutex;
+int                       XrdOfsReadShare::maxFlight = 0;
+int                       XrdOfsReadShare::numFlight = 0;
+size_t                    XrdOfsReadShare::maxRdSz   = 0;
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+bool XrdOfsReadShare::Init(int maxRds, int maxRsz, XrdSysError &eDest)
+{
+   static const int minBsz = 65536;
+
+// Validate the arguments
+//
+   if (maxRds <= 0 || maxRsz <= 0)
+      {eDest.Emsg("Config", "invalid readshare limits specified");
+       return false;
+      }
+
+// Allocate the buffer pool used to hand data to waiting readers. The pool is
+// made a bit larger than needed as it cannot allocate its largest size.
+//
+   bPool     = new XrdOucBuffPool(minBsz, maxRsz + minBsz, 1, 16);
+   maxRdSz   = maxRsz;
+   maxFlight = maxRds;
+   return true;
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+ssize_t XrdOfsReadShare::Read(XrdOssDF &ossDF, const void *hKey,
+                              void *buff, off_t offs, size_t blen)
+{
+   uintptr_t hVal = (uintptr_t)hKey;
+   rsBucket &rsB  = Bucket[((hVal >> 6) ^ (hVal >> 12)) % numBuckets];
+   rsEntry *eP, **pP;
+   ssize_t rc;
+   int n;
+
+// Large reads are never shared
+//
+   if (!blen || blen > maxRdSz) return ossDF.Read(buff, offs, blen);
+
+// See if this read falls entirely within a read that is in progress
+//
+   rsB.rsMutex.Lock();
+   rsB.numRds++;
+   eP = rsB.inFlight;
+   while(eP && (eP->hKey != hKey || offs < eP->offs
+            ||  offs + (off_t)blen > eP->offs + (off_t)eP->blen)) eP = eP->next;
+
+// If so, wait for it to complete and copy whatever data applies to us. The
+// entry is off the in-flight list by the time we are posted and the last one
+// to reference it recycles it. Should the read have failed we do our own.
+//
+   if (eP)
+      {eP->refs++;
+       rsB.rsMutex.UnLock();
+       eP->rsSem.Wait();
+       if ((rc = eP->rc) >= 0)
+          {rc -= offs - eP->offs;
+           if (rc < 0) rc = 0;
+              else if (rc > (ssize_t)blen) rc = blen;
+           if (rc) memcpy(buff, eP->bP->Buffer() + (offs - eP->offs), rc);
+          }
+       rsB.rsMutex.Lock();
+       if (rc >= 0) {rsB.numHit++; rsB.numByt += rc;}
+       if (!(--eP->refs)) Recycle(rsB, eP);
+       rsB.rsMutex.UnLock();
+       return (rc >= 0 ? rc : ossDF.Read(buff, offs, blen));
+      }
+
+// We will be doing the read. Make sure we don't exceed the in-flight limit.
+//
+   AtomicBeg(fcMutex);
+   n = AtomicInc(numFlight);
+   if (n >= maxFlight) AtomicDec(numFlight);
+   AtomicEnd(fcMutex);
+   if (n >= maxFlight)
+      {rsB.rsMutex.UnLock();
+       return ossDF.Read(buff, offs, blen);
+      }
+
+// Place the read on the in-flight list so others can find it
+//
+   if ((eP = rsB.rsFree)) rsB.rsFree = eP->next;
+      else eP = new rsEntry;
+   eP->hKey = hKey; eP->offs = offs; eP->blen = blen;
+   eP->rc   = -1;   eP->refs = 0;    eP->bP   = 0;
+   eP->next = rsB.inFlight;
+   rsB.inFlight = eP;
+   rsB.rsMutex.UnLock();
+
+// Do the actual read
+//
+   rc = ossDF.Read(buff, offs, blen);
+
+// Take the read off the in-flight list. After this no one else can wait on it
+// so the number of waiters is now fixed.
+//
+   rsB.rsMutex.Lock();
+   pP = &rsB.inFlight;
+   while(*pP != eP) pP = &((*pP)->next);
+   *pP = eP->next;
+   if (!(n = eP->refs)) Recycle(rsB, eP);
+   rsB.rsMutex.UnLock();
+
+   AtomicBeg(fcMutex);
+   AtomicDec(numFlight);
+   AtomicEnd(fcMutex);
+
+// Hand a copy of the data to anyone waiting for it. We can't give them the
+// caller's buffer as it may be reused as soon as we return.
+//
+   if (n)
+      {if (!rc) eP->rc = 0;
+          else if (rc > 0 && (eP->bP = bPool->Alloc(rc)))
+                  {memcpy(eP->bP->Buffer(), buff, rc);
+                   eP->rc = rc;
+                  }
+       while(n--) eP->rsSem.Post();
+      }
+
+// All done
+//
+   return rc;
+}
+
+/******************************************************************************/
+/*                               R e c y c l e                                */
+/******************************************************************************/
+
+// The bucket lock must be held!
+
+void XrdOfsReadShare::Recycle(rsBucket &rsB, rsEntry *eP)
+{
+   if (eP->bP) {eP->bP->Recycle(); eP->bP = 0;}
+   eP->next  = rsB.rsFree;
+   rsB.rsFree = eP;
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+void XrdOfsReadShare::Stats(long long &numRds, long long &numHit,
+                            long long &numByt)
+{
+   numRds = numHit = numByt = 0;
+   for (int i = 0; i < numBuckets; i++)
+       {Bucket[i].rsMutex.Lock();
+        numRds += Bucket[i].numRds;
+        numHit += Bucket[i].numHit;
+        numByt += Bucket[i].numByt;
+        Bucket[i].rsMutex.UnLock();
+       }
+}
@@ -0,0 +1,140 @@
+#ifndef __XRDOFSREADSHARE_HH__
+#define __XRDOFSREADSHARE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O f s R e a d S h a r e . h h                     */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+//-----------------------------------------------------------------------------
+//! The XrdOfsReadShare class coalesces concurrent reads of the same file. When
+//! many clients have the same file open for reading they share a single file
+//! handle. A read that falls entirely within a read that is already in
+//! progress on that handle does not go to the storage system. Instead, it
+//! waits for the read in progress to complete and copies its data. The number
+//! of reads that may be in progress at any one time is bounded; reads beyond
+//! that limit are simply passed through. Only read-only handles participate.
+//-----------------------------------------------------------------------------
+
+class XrdOssDF;
+class XrdOucBuffer;
+class XrdOucBuffPool;
+class XrdSysError;
+
+class XrdOfsReadShare
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! Check whether or not reads are being coalesced.
+//-----------------------------------------------------------------------------
+
+static bool            Enabled() {return maxFlight > 0;}
+
+//-----------------------------------------------------------------------------
+//! Initialize read sharing (one time call at configuration time).
+//!
+//! @param  maxRds  The maximum number of reads that may be in progress.
+//! @param  maxRsz  The largest read that may be shared.
+//! @param  eDest   The message object.
+//!
+//! @return True upon success and false otherwise.
+//-----------------------------------------------------------------------------
+
+static bool            Init(int maxRds, int maxRsz, XrdSysError &eDest);
+
+//-----------------------------------------------------------------------------
+//! Read data, sharing the data of a read already in progress if possible.
+//!
+//! @param  ossDF   The file to read.
+//! @param  hKey    The key identifying the file (i.e. the file handle).
+//! @param  buff    The buffer to receive the data.
+//! @param  offs    The offset at which to read.
+//! @param  blen    The number of bytes to read.
+//!
+//! @return Same as XrdOssDF::Read().
+//-----------------------------------------------------------------------------
+
+static ssize_t         Read(XrdOssDF &ossDF, const void *hKey,
+                            void *buff, off_t offs, size_t blen);
+
+//-----------------------------------------------------------------------------
+//! Return the read sharing statistics.
+//!
+//! @param  numRds  The number of reads that were eligible for sharing.
+//! @param  numHit  The number of reads satisfied by another read. The hit
+//!                 ratio is numHit/numRds.
+//! @param  numByt  The number of bytes that did not have to be read.
+//-----------------------------------------------------------------------------
+
+static void            Stats(long long &numRds, long long &numHit,
+                             long long &numByt);
+
+private:
+
+struct rsEntry
+      {rsEntry        *next;
+       const void     *hKey;
+       off_t           offs;
+       size_t          blen;
+       ssize_t         rc;
+       int             refs;
+       XrdOucBuffer   *bP;
+       XrdSysSemaphore rsSem;
+
+                       rsEntry() : next(0), hKey(0), offs(0), blen(0), rc(0),
+                                   refs(0), bP(0), rsSem(0) {}
+                      ~rsEntry() {}
+      };
+
+struct rsBucket
+      {XrdSysMutex     rsMutex;
+       rsEntry        *inFlight;
+       rsEntry        *rsFree;
+       long long       numRds;
+       long long       numHit;
+       long long       numByt;
+
+                       rsBucket() : inFlight(0), rsFree(0),
+                                    numRds(0), numHit(0), numByt(0) {}
+                      ~rsBucket() {}
+      };
+
+static void            Recycle(rsBucket &rsB, rsEntry *eP);
+
+static const int       numBuckets = 64;
+
+static rsBucket        Bucket[numBuckets];
+static XrdOucBuffPool *bPool;
+static XrdSysMutex     fcMutex;
+static int             maxFlight;
+static int             numFlight;
+static size_t          maxRdSz;
+};
+#endif
@@ -29,6 +29,7 @@
 
 #include <stdio.h>
 
+#include "XrdOfs/XrdOfsReadShare.hh"
 #include "XrdOfs/XrdOfsStats.hh"
 
 /******************************************************************************/
@@ -42,10 +43,13 @@ int XrdOfsStats::Report(char *buff, int blen)
            "<rdr>%d</rdr><bxq>%d</bxq><rep>%d</rep><err>%d</err><dly>%d</dly>"
            "<sok>%d</sok><ser>%d</ser>"
            "<tpc><grnt>%d</grnt><deny>%d</deny><err>%d</err><exp>%d</exp></tpc>"
+           "<ckw><set>%d</set><skp>%d</skp></ckw>"
+           "<rds><rd>%lld</rd><hit>%lld</hit><byt>%lld</byt></rds>"
            "</stats>";
-    static const int  statsz = sizeof(stats1) + (12*10) + 64;
+    static const int  statsz = sizeof(stats1) + (18*10) + (3*20) + 64;
 
     StatsData myData;
+    long long rdsNum, rdsHit, rdsByt;
 
 // If only the size is wanted, return the size
 //
@@ -60,6 +64,7 @@ int XrdOfsStats::Report(char *buff, int blen)
    sdMutex.Lock();
    myData = Data;
    sdMutex.UnLock();
+   XrdOfsReadShare::Stats(rdsNum, rdsHit, rdsByt);
 
 // Format the buffer
 //
@@ -69,5 +74,7 @@ int XrdOfsStats::Report(char *buff, int blen)
                     myData.numErrors,   myData.numDelays,
                     myData.numSeventOK, myData.numSeventER,
                     myData.numTPCgrant, myData.numTPCdeny,
-                    myData.numTPCerrs,  myData.numTPCexpr);
+                    myData.numTPCerrs,  myData.numTPCexpr,
+                    myData.numCksWrt,   myData.numCksWrx,
+                    rdsNum,             rdsHit,             rdsByt);
 }
@@ -55,6 +55,8 @@ int         numTPCgrant;
 int         numTPCdeny;
 int         numTPCerrs;
 int         numTPCexpr;
+int         numCksWrt;  // Checksums recorded as files were written
+int         numCksWrx;  // Checksums abandoned (written out of order)
 }           Data;
 
 XrdSysMutex sdMutex;
@@ -41,6 +41,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/param.h>
+#include <sys/uio.h>
 #ifdef __solaris__
 #include <sys/vnode.h>
 #endif
@@ -1018,6 +1019,56 @@ ssize_t XrdOssFile::Write(const void *buff, off_t offset, size_t blen)
      return retval;
 }
 
+/******************************************************************************/
+/*                                W r i t e V                                 */
+/******************************************************************************/
+
+/*
+  Function: Write a vector of segments to the associated file. Segments that
+            are adjacent in the file are written with a single system call.
+
+  Input:    writeV    - The write vector, each element describes a segment.
+            n         - The number of elements in writeV.
+
+  Output:   Returns the number of bytes written upon success and -errno o/w.
+            If fewer bytes than requested are written, it is considered
+            an error.
+*/
+
+ssize_t XrdOssFile::WriteV(XrdOucIOVec *writeV, int n)
+{
+#if defined(__linux__) || defined(__FreeBSD__)
+   static const int maxIOV = 64;
+   struct iovec iov[maxIOV];
+   ssize_t wrsz, runsz, totBytes = 0;
+   long long runOff;
+   int i, k;
+
+   if (fd < 0) return (ssize_t)-XRDOSS_E8004;
+
+// Gather each run of adjacent segments and write it out in one go
+//
+   for (i = 0; i < n; i = k)
+       {runOff = writeV[i].offset; runsz = 0;
+        for (k = i; k < n && k-i < maxIOV
+                    && writeV[k].offset == runOff+runsz; k++)
+            {iov[k-i].iov_base = (void *)writeV[k].data;
+             iov[k-i].iov_len  = writeV[k].size;
+             runsz += writeV[k].size;
+            }
+        if (XrdOssSS->MaxSize && runOff+runsz > XrdOssSS->MaxSize)
+           return (ssize_t)-XRDOSS_E8007;
+        do {wrsz = pwritev(fd, iov, k-i, runOff);}
+           while(wrsz < 0 && errno == EINTR);
+        if (wrsz != runsz) return (wrsz < 0 ? (ssize_t)-errno : -ESPIPE);
+        totBytes += wrsz;
+       }
+   return totBytes;
+#else
+   return XrdOssDF::WriteV(writeV, n);
+#endif
+}
+
 /******************************************************************************/
 /*                                F c h m o d                                 */
 /******************************************************************************/
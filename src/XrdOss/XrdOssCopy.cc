@@ -30,6 +30,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <stdio.h>
@@ -102,6 +103,12 @@ off_t XrdOssCopy::Copy(const char *inFn, const char *outFn, int outFD)
        return fileSize;
       }
 
+// Copy only the data when the filesystem can tell us where the holes are so
+// that a sparse file (e.g. one in a disk cache) stays sparse in its new home.
+//
+   if ((rc = Sparse(inFn, In.FD, outFn, Out.FD, fileSize)) < 0) return rc;
+   if (!rc) copySize = 0;
+
 // We now copy 1MB segments using direct I/O
 //
    ioSize = (fileSize < (off_t)segSize ? fileSize : segSize);
@@ -160,6 +167,65 @@ off_t XrdOssCopy::Copy(const char *inFn, const char *outFn, int outFD)
    return fileSize;
 }
 
+/******************************************************************************/
+/* private:                       S p a r s e                                 */
+/******************************************************************************/
+
+// Returns 0 if the data was copied, 1 if the filesystem cannot locate holes
+// (nothing was copied), and -errno upon failure.
+//
+int XrdOssCopy::Sparse(const char *inFn, int inFD, const char *outFn, int outFD,
+                       off_t fileSize)
+{
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+   static const size_t segSize = 1024*1024;
+   class ioBuff
+        {public:
+         char *Data;
+               ioBuff() : Data(0) {}
+              ~ioBuff() {if (Data) free(Data);}
+        } Buff;
+   off_t   dOff, hOff = 0;
+   size_t  ioSize;
+   ssize_t rLen;
+   int rc;
+
+// Copy each data extent, skipping holes. A trailing hole is restored by
+// setting the file size at the end.
+//
+   while(hOff < fileSize)
+        {if ((dOff = lseek(inFD, hOff, SEEK_DATA)) < 0)
+            {if (errno == ENXIO) break;
+             if (!hOff && errno == EINVAL) return 1;
+             return -OssEroute.Emsg("Copy", errno, "seek data in", inFn);
+            }
+         if ((hOff = lseek(inFD, dOff, SEEK_HOLE)) < 0)
+            return -OssEroute.Emsg("Copy", errno, "seek hole in", inFn);
+         if (hOff > fileSize) hOff = fileSize;
+         if (!Buff.Data && !(Buff.Data = (char *)malloc(segSize)))
+            return -OssEroute.Emsg("Copy", ENOMEM, "copy", inFn);
+         while(dOff < hOff)
+              {ioSize = (hOff - dOff < (off_t)segSize ? hOff - dOff : segSize);
+               do {rLen = pread(inFD, Buff.Data, ioSize, dOff);}
+                  while(rLen < 0 && errno == EINTR);
+               if (rLen <= 0) return -OssEroute.Emsg("Copy",
+                                     rLen ? errno : ECANCELED, "read", inFn);
+               if ((rc = Write(outFn, outFD, Buff.Data, rLen, dOff)) < 0)
+                  return rc;
+               dOff += rLen;
+              }
+        }
+
+// Set the size of the file, which also creates any trailing hole
+//
+   if (ftruncate(outFD, fileSize))
+      return -OssEroute.Emsg("Copy", errno, "truncate", outFn);
+   return 0;
+#else
+   return 1;
+#endif
+}
+
 /******************************************************************************/
 /* private:                        W r i t e                                  */
 /******************************************************************************/
@@ -40,6 +40,7 @@ static off_t Copy(const char *inFn, const char *outFn, int outFD);
             ~XrdOssCopy() {}
 
 private:
+static int   Sparse(const char *, int, const char *, int, off_t);
 static int   Write(const char *, int, char *, size_t, off_t);
 };
 #endif
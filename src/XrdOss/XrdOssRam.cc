@@ -0,0 +1,596 @@
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d O s s R a m . c c                           */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "XrdVersion.hh"
+
+#include "XrdOss/XrdOssRam.hh"
+#include "XrdOss/XrdOssRamCache.hh"
+#include "XrdOuc/XrdOuca2x.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucStream.hh"
+#include "XrdSfs/XrdSfsAio.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysFD.hh"
+#include "XrdSys/XrdSysHeaders.hh"
+
+#ifndef O_DIRECT
+#define O_DIRECT 0
+#endif
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+namespace
+{
+XrdSysError eDest(0, "ossram_");
+}
+
+/******************************************************************************/
+/*                 X r d O s s A d d S t o r a g e S y s t e m 2              */
+/******************************************************************************/
+
+XrdVERSIONINFO(XrdOssAddStorageSystem2,XrdOssRam);
+
+// This function is called by the OFS layer to stack us on top of the storage
+// system configured so far.
+//
+extern "C"
+{
+XrdOss *XrdOssAddStorageSystem2(XrdOss       *curr_oss,
+                                XrdSysLogger *Logger,
+                                const char   *config_fn,
+                                const char   *parms,
+                                XrdOucEnv    *envP)
+{
+   XrdOssRam *ramP = new XrdOssRam(*curr_oss);
+
+   if (!ramP->Configure(Logger, config_fn, parms)) {delete ramP; return 0;}
+   return ramP;
+}
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*                    C l a s s   X r d O s s R a m F i l e                   */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdOssRamFile::~XrdOssRamFile()
+{
+   if (dFD >= 0) close(dFD);
+}
+
+/******************************************************************************/
+/*                                 C l o s e                                  */
+/******************************************************************************/
+
+int XrdOssRamFile::Close(long long *retsz)
+{
+   int rc = wrapDF.Close(retsz);
+
+// If the file was written, whatever we may still have of it is suspect
+//
+   if (isWritten) ossRam.ramCache->Drop(devNum, inoNum);
+   if (dFD >= 0) {close(dFD); dFD = -1;}
+   isCached = isWritten = canWrite = false;
+   return rc;
+}
+
+/******************************************************************************/
+/* Private:                         F i l l                                   */
+/******************************************************************************/
+
+ssize_t XrdOssRamFile::Fill(int64_t ext, char *buff, int offs, int blen)
+{
+   XrdOssRamCache::Key key = {devNum, inoNum, ext};
+   int extSz = ossRam.ramCache->ExtSize();
+   off_t extOffs = (off_t)ext * extSz;
+   ssize_t rdsz = -1;
+   char *eBuff;
+   int slot, n;
+
+// If the extent is not admitted, simply read what the caller wants
+//
+   if (!(eBuff = ossRam.ramCache->Reserve(key, slot)))
+      return wrapDF.Read(buff, extOffs+offs, blen);
+
+// Read the whole extent, preferably bypassing the page cache. Should direct
+// I/O fail, we stop using it for this file; the descriptor is kept until close
+// as other threads may be using it.
+//
+   if (dFD >= 0 && !noDirect)
+      {do {rdsz = pread(dFD, eBuff, extSz, extOffs);}
+          while(rdsz < 0 && errno == EINTR);
+       if (rdsz < 0) noDirect = true;
+      }
+   if (rdsz < 0) rdsz = wrapDF.Read(eBuff, extOffs, extSz);
+
+// Hand the caller its portion and make the extent available to everyone
+//
+   if (rdsz < 0) n = (int)rdsz;
+      else {n = (int)rdsz - offs;
+            if (n < 0) n = 0;
+               else if (n > blen) n = blen;
+            if (n) memcpy(buff, eBuff+offs, n);
+           }
+   ossRam.ramCache->Commit(key, slot, fGen, (rdsz < 0 ? -1 : (int)rdsz));
+   return n;
+}
+
+/******************************************************************************/
+/*                             F t r u n c a t e                              */
+/******************************************************************************/
+
+int XrdOssRamFile::Ftruncate(unsigned long long flen)
+{
+   int rc = wrapDF.Ftruncate(flen);
+
+   Modified((long long)flen, -1);
+   return rc;
+}
+
+/******************************************************************************/
+/*                                 g e t F D                                  */
+/******************************************************************************/
+
+// Cached files must not be read via sendfile() as that would bypass us.
+
+int XrdOssRamFile::getFD()
+{
+   return (isCached ? -1 : wrapDF.getFD());
+}
+
+/******************************************************************************/
+/* Private:                     M o d i f i e d                               */
+/******************************************************************************/
+
+// This must be called after the underlying file was modified. Otherwise, a
+// concurrent fill could cache the old data after we dropped it and handles
+// opened earlier would keep serving it as their generation still matches.
+
+void XrdOssRamFile::Modified(long long offs, long long blen)
+{
+   if (canWrite)
+      {isWritten = true;
+       ossRam.ramCache->Drop(devNum, inoNum, offs, blen);
+      }
+}
+
+/******************************************************************************/
+/*                                  O p e n                                   */
+/******************************************************************************/
+
+int XrdOssRamFile::Open(const char *path, int Oflag, mode_t Mode,
+                        XrdOucEnv &env)
+{
+   struct stat Stat;
+   char pBuff[2048];
+   const char *pfn;
+   int rc;
+
+// Open the file first
+//
+   if ((rc = wrapDF.Open(path, Oflag, Mode, env))) return rc;
+
+// We need to know which file this really is
+//
+   if (wrapDF.Fstat(&Stat)) return 0;
+   devNum = (uint64_t)Stat.st_dev;
+   inoNum = (uint64_t)Stat.st_ino;
+
+// A file that may be written is never cached but whatever we have of it
+// must be dropped as it is written.
+//
+   if ((Oflag & O_ACCMODE) != O_RDONLY || (Oflag & O_TRUNC))
+      {canWrite = true;
+       if (Oflag & O_TRUNC) Modified(0, -1);
+       return 0;
+      }
+   if (!ossRam.Cacheable(path)) return 0;
+
+// The generation identifies this version of the file. Extents cached for an
+// earlier version will not match it.
+//
+#if defined(__APPLE__)
+   fGen = (uint64_t)Stat.st_mtimespec.tv_sec * 1000000000ULL
+        + (uint64_t)Stat.st_mtimespec.tv_nsec;
+#else
+   fGen = (uint64_t)Stat.st_mtim.tv_sec * 1000000000ULL
+        + (uint64_t)Stat.st_mtim.tv_nsec;
+#endif
+   fGen ^= (uint64_t)Stat.st_size << 20;
+   isCached = true;
+
+// Open a descriptor for direct I/O if so wanted. This only makes sense if the
+// underlying storage is local.
+//
+   if (ossRam.useDirect && O_DIRECT && !(wrapDF.DFType() & DF_isProxy)
+   &&  (pfn = ossRam.wrapPI.Lfn2Pfn(path, pBuff, sizeof(pBuff), rc)))
+      dFD = XrdSysFD_Open(pfn, O_RDONLY | O_DIRECT);
+   return 0;
+}
+
+/******************************************************************************/
+/*                                p g R e a d                                 */
+/******************************************************************************/
+
+// For cached files the default implementations do what we want by calling
+// our Read() and computing the checksums.
+
+ssize_t XrdOssRamFile::pgRead(void* buffer, off_t offset, size_t rdlen,
+                              uint32_t* csvec, uint64_t opts)
+{
+   if (!isCached) return wrapDF.pgRead(buffer, offset, rdlen, csvec, opts);
+   return XrdOssDF::pgRead(buffer, offset, rdlen, csvec, opts);
+}
+
+/******************************************************************************/
+
+int XrdOssRamFile::pgRead(XrdSfsAio* aioparm, uint64_t opts)
+{
+   if (!isCached) return wrapDF.pgRead(aioparm, opts);
+   return XrdOssDF::pgRead(aioparm, opts);
+}
+
+/******************************************************************************/
+/*                               p g W r i t e                                */
+/******************************************************************************/
+
+ssize_t XrdOssRamFile::pgWrite(void* buffer, off_t offset, size_t wrlen,
+                               uint32_t* csvec, uint64_t opts)
+{
+   ssize_t retval = wrapDF.pgWrite(buffer, offset, wrlen, csvec, opts);
+
+   Modified(offset, wrlen);
+   return retval;
+}
+
+/******************************************************************************/
+
+// Cached extents can only be dropped once the write completed, so this is done
+// synchronously via our pgWrite() above.
+
+int XrdOssRamFile::pgWrite(XrdSfsAio* aioparm, uint64_t opts)
+{
+   if (!canWrite) return wrapDF.pgWrite(aioparm, opts);
+   return XrdOssDF::pgWrite(aioparm, opts);
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+ssize_t XrdOssRamFile::Read(void *buffer, off_t offset, size_t size)
+{
+   char *buff = (char *)buffer;
+   size_t done = 0;
+   ssize_t n;
+   int extSz, eOffs, want;
+   int64_t ext;
+
+// Pass through anything we don't cache
+//
+   if (!isCached) return wrapDF.Read(buffer, offset, size);
+   extSz = ossRam.ramCache->ExtSize();
+
+// Satisfy the read extent by extent, filling missing extents as we go
+//
+   while(done < size)
+        {ext   = (int64_t)((offset + done) / extSz);
+         eOffs = (int)((offset + done) % extSz);
+         want  = extSz - eOffs;
+         if ((size_t)want > size - done) want = (int)(size - done);
+         XrdOssRamCache::Key key = {devNum, inoNum, ext};
+         if ((n = ossRam.ramCache->Get(key, fGen, buff+done, eOffs, want)) < 0
+         &&  (n = Fill(ext, buff+done, eOffs, want)) < 0)
+            return (done ? (ssize_t)done : n);
+         done += n;
+         if (n < want) break;
+        }
+   return (ssize_t)done;
+}
+
+/******************************************************************************/
+
+int XrdOssRamFile::Read(XrdSfsAio *aiop)
+{
+// Cached data is at hand so there is no point in doing this asynchronously
+//
+   if (!isCached) return wrapDF.Read(aiop);
+   aiop->Result = Read((void *)aiop->sfsAio.aio_buf,
+                       (off_t) aiop->sfsAio.aio_offset,
+                       (size_t)aiop->sfsAio.aio_nbytes);
+   aiop->doneRead();
+   return 0;
+}
+
+/******************************************************************************/
+/*                                 R e a d V                                  */
+/******************************************************************************/
+
+ssize_t XrdOssRamFile::ReadV(XrdOucIOVec *readV, int rdvcnt)
+{
+   if (!isCached) return wrapDF.ReadV(readV, rdvcnt);
+   return XrdOssDF::ReadV(readV, rdvcnt);
+}
+
+/******************************************************************************/
+/*                                 W r i t e                                  */
+/******************************************************************************/
+
+ssize_t XrdOssRamFile::Write(const void *buffer, off_t offset, size_t size)
+{
+   ssize_t retval = wrapDF.Write(buffer, offset, size);
+
+   Modified(offset, size);
+   return retval;
+}
+
+/******************************************************************************/
+
+int XrdOssRamFile::Write(XrdSfsAio *aiop)
+{
+// Cached extents can only be dropped once the write completed, so do it now
+//
+   if (!canWrite) return wrapDF.Write(aiop);
+   aiop->Result = Write((const void *)aiop->sfsAio.aio_buf,
+                        (off_t)       aiop->sfsAio.aio_offset,
+                        (size_t)      aiop->sfsAio.aio_nbytes);
+   aiop->doneWrite();
+   return 0;
+}
+
+/******************************************************************************/
+/*                                W r i t e V                                 */
+/******************************************************************************/
+
+ssize_t XrdOssRamFile::WriteV(XrdOucIOVec *writeV, int wrvcnt)
+{
+   ssize_t retval = wrapDF.WriteV(writeV, wrvcnt);
+
+   for (int i = 0; i < wrvcnt; i++) Modified(writeV[i].offset, writeV[i].size);
+   return retval;
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*                        C l a s s   X r d O s s R a m                       */
+/*                                                                            */
+/******************************************************************************/
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdOssRam::~XrdOssRam()
+{
+   if (ramCache) delete ramCache;
+}
+
+/******************************************************************************/
+/* Private:                    C a c h e a b l e                              */
+/******************************************************************************/
+
+bool XrdOssRam::Cacheable(const char *path)
+{
+   int n = ramPaths.size();
+
+// Without a path list every file is eligible
+//
+   if (!n) return true;
+   for (int i = 0; i < n; i++)
+       if (!strncmp(path, ramPaths[i].c_str(), ramPaths[i].size())) return true;
+   return false;
+}
+
+/******************************************************************************/
+/*                             C o n f i g u r e                              */
+/******************************************************************************/
+
+bool XrdOssRam::Configure(XrdSysLogger *lP, const char *cfn, const char *parms)
+{
+   XrdOucEnv myEnv;
+   XrdOucStream Config(&eDest, getenv("XRDINSTANCE"), &myEnv, "=====> ");
+   char *var;
+   int  cfgFD, retc, NoGo = 0;
+
+// Establish the message route and say hello
+//
+   eDest.logger(lP);
+   eDest.Say("++++++ Oss ram tier initialization started.");
+
+// Process the config file
+//
+   if (!cfn || !*cfn)
+      {eDest.Emsg("Config", "Configuration file not specified.");
+       NoGo = 1;
+      } else {
+       if ((cfgFD = open(cfn, O_RDONLY, 0)) < 0)
+          {eDest.Emsg("Config", errno, "open config file", cfn);
+           return false;
+          }
+       Config.Attach(cfgFD);
+       static const char *cvec[] = {"*** ossram plugin config:", 0};
+       Config.Capture(cvec);
+
+       while((var = Config.GetMyFirstWord()))
+            {if (!strncmp(var, "ossram.", 7))
+                {var += 7;
+                      if (!strcmp(var, "cache")) retc = xcache(Config, eDest);
+                 else if (!strcmp(var, "path"))  retc = xpath (Config, eDest);
+                 else {eDest.Say("Config warning: ignoring unknown directive '",
+                                 var, "'.");
+                       Config.Echo();
+                       continue;
+                      }
+                 if (retc) {Config.Echo(); NoGo = 1;}
+                }
+            }
+
+       if ((retc = Config.LastError()))
+          NoGo = eDest.Emsg("Config", -retc, "read config file", cfn);
+       Config.Close();
+      }
+
+// We need to know how much memory we can use
+//
+   if (!NoGo && memSize <= 0)
+      {eDest.Emsg("Config", "ossram.cache size not specified."); NoGo = 1;}
+
+// Allocate the cache
+//
+   if (!NoGo) ramCache = new XrdOssRamCache(memSize, extSize);
+
+// All done
+//
+   eDest.Say("------ Oss ram tier initialization ",
+             (NoGo ? "failed." : "completed."));
+   return !NoGo;
+}
+
+/******************************************************************************/
+/*                               n e w F i l e                                */
+/******************************************************************************/
+
+XrdOssDF *XrdOssRam::newFile(const char *tident)
+{
+   XrdOssDF *dfP = wrapPI.newFile(tident);
+
+   return (dfP ? new XrdOssRamFile(*dfP, *this) : 0);
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdOssRam::Stats(char *buff, int blen)
+{
+   int n;
+
+// If only the size is wanted, return the size
+//
+   if (!buff) return wrapPI.Stats(0, 0) + ramCache->Stats(0, 0);
+
+// Report the underlying statistics followed by ours
+//
+   n = wrapPI.Stats(buff, blen);
+   return n + ramCache->Stats(buff+n, blen-n);
+}
+
+/******************************************************************************/
+/*                                x c a c h e                                 */
+/******************************************************************************/
+
+/* Function: xcache
+
+   Purpose:  To parse the directive: cache size <sz> [extent <esz>]
+                                           [direct | nodirect]
+
+             <sz>      the maximum amount of memory to use for file extents.
+             <esz>     the extent size, a power of two between 4k and 64m
+                       (default 1m). Extents are the unit of caching.
+             direct    fill extents using direct I/O (default).
+             nodirect  fill extents using normal I/O.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssRam::xcache(XrdOucStream &Config, XrdSysError &Eroute)
+{
+   long long vsz;
+   char *val;
+
+   if (!(val = Config.GetWord()))
+      {Eroute.Emsg("Config", "cache parameters not specified"); return 1;}
+
+   while(val)
+        {     if (!strcmp(val, "size"))
+                 {if (!(val = Config.GetWord()))
+                     {Eroute.Emsg("Config", "cache size not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2sz(Eroute, "cache size", val, &vsz,
+                                      1024*1024)) return 1;
+                  memSize = vsz;
+                 }
+         else if (!strcmp(val, "extent"))
+                 {if (!(val = Config.GetWord()))
+                     {Eroute.Emsg("Config", "cache extent not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2sz(Eroute, "cache extent", val, &vsz,
+                                      4096, 64*1024*1024)) return 1;
+                  if (vsz & (vsz-1))
+                     {Eroute.Emsg("Config", "cache extent", val,
+                                  "is not a power of two");
+                      return 1;
+                     }
+                  extSize = (int)vsz;
+                 }
+         else if (!strcmp(val, "direct"))   useDirect = true;
+         else if (!strcmp(val, "nodirect")) useDirect = false;
+         else {Eroute.Emsg("Config", "invalid cache option -", val); return 1;}
+         val = Config.GetWord();
+        }
+   return 0;
+}
+
+/******************************************************************************/
+/*                                 x p a t h                                  */
+/******************************************************************************/
+
+/* Function: xpath
+
+   Purpose:  To parse the directive: path <lfn>
+
+             <lfn>     only files whose logical name starts with <lfn> are
+                       cached. The directive may be repeated. When no path
+                       is specified, all files opened for reading are cached.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssRam::xpath(XrdOucStream &Config, XrdSysError &Eroute)
+{
+   char *val;
+
+   if (!(val = Config.GetWord()) || *val != '/')
+      {Eroute.Emsg("Config", "absolute path not specified"); return 1;}
+   ramPaths.push_back(std::string(val));
+   return 0;
+}
@@ -0,0 +1,152 @@
+#ifndef __XRDOSSRAM_HH__
+#define __XRDOSSRAM_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d O s s R a m . h h                           */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "XrdOss/XrdOssWrapper.hh"
+
+//-----------------------------------------------------------------------------
+//! XrdOssRam is a storage system plugin that keeps the hot extents of files
+//! in memory. It is stacked on top of another storage system using
+//!
+//!        ofs.osslib ++ libXrdOssRam.so
+//!
+//! and caches extents of files that are opened read-only; see XrdOssRamCache
+//! for the admission and replacement policy. Extents are filled using direct
+//! I/O, when possible, so that the data is not also held in the page cache.
+//! Writes through this plugin drop the extents they overlap.
+//-----------------------------------------------------------------------------
+
+class XrdOssRam;
+class XrdOssRamCache;
+class XrdOucStream;
+class XrdSysError;
+
+/******************************************************************************/
+/*                    C l a s s   X r d O s s R a m F i l e                   */
+/******************************************************************************/
+  
+class XrdOssRamFile : public XrdOssWrapDF
+{
+public:
+
+virtual int     Close(long long *retsz=0);
+
+virtual int     Ftruncate(unsigned long long flen);
+
+virtual int     getFD();
+
+virtual int     Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &env);
+
+virtual ssize_t pgRead (void* buffer, off_t offset, size_t rdlen,
+                        uint32_t* csvec, uint64_t opts);
+
+virtual int     pgRead (XrdSfsAio* aioparm, uint64_t opts);
+
+virtual ssize_t pgWrite(void* buffer, off_t offset, size_t wrlen,
+                        uint32_t* csvec, uint64_t opts);
+
+virtual int     pgWrite(XrdSfsAio* aioparm, uint64_t opts);
+
+virtual ssize_t Read(off_t offset, size_t size)
+                    {return wrapDF.Read(offset, size);}
+
+virtual ssize_t Read(void *buffer, off_t offset, size_t size);
+
+virtual int     Read(XrdSfsAio *aiop);
+
+virtual ssize_t ReadV(XrdOucIOVec *readV, int rdvcnt);
+
+virtual ssize_t Write(const void *buffer, off_t offset, size_t size);
+
+virtual int     Write(XrdSfsAio *aiop);
+
+virtual ssize_t WriteV(XrdOucIOVec *writeV, int wrvcnt);
+
+                XrdOssRamFile(XrdOssDF &df2Wrap, XrdOssRam &ramSys)
+                             : XrdOssWrapDF(df2Wrap), ossRam(ramSys),
+                               devNum(0), inoNum(0), fGen(0), dFD(-1),
+                               isCached(false), isWritten(false),
+                               canWrite(false), noDirect(false) {}
+
+virtual        ~XrdOssRamFile();
+
+private:
+
+ssize_t         Fill(int64_t ext, char *buff, int offs, int blen);
+void            Modified(long long offs, long long blen);
+
+XrdOssRam      &ossRam;
+uint64_t        devNum;
+uint64_t        inoNum;
+uint64_t        fGen;       // Identifies the file's contents
+int             dFD;        // File descriptor for direct I/O or -1
+bool            isCached;
+bool            isWritten;
+bool            canWrite;
+bool            noDirect;
+};
+
+/******************************************************************************/
+/*                        C l a s s   X r d O s s R a m                       */
+/******************************************************************************/
+  
+class XrdOssRam : public XrdOssWrapper
+{
+friend class XrdOssRamFile;
+
+public:
+
+virtual XrdOssDF *newFile(const char *tident);
+
+virtual int       Stats(char *buff, int blen);
+
+        bool      Configure(XrdSysLogger *lP, const char *cfn,
+                            const char *parms);
+
+                  XrdOssRam(XrdOss &ss2Wrap)
+                           : XrdOssWrapper(ss2Wrap), ramCache(0),
+                             memSize(0), extSize(1024*1024), useDirect(true) {}
+virtual          ~XrdOssRam();
+
+private:
+
+bool              Cacheable(const char *path);
+int               xcache(XrdOucStream &Config, XrdSysError &Eroute);
+int               xpath(XrdOucStream &Config, XrdSysError &Eroute);
+
+XrdOssRamCache          *ramCache;
+std::vector<std::string> ramPaths;
+long long                memSize;
+int                      extSize;
+bool                     useDirect;
+};
+#endif
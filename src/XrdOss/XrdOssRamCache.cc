@@ -0,0 +1,385 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O s s R a m C a c h e . c c                      */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "XrdOss/XrdOssRamCache.hh"
+
+/******************************************************************************/
+/*                         L o c a l   S t a t i c s                          */
+/******************************************************************************/
+
+namespace
+{
+// Multipliers that derive an independent sketch column for each row
+//
+static const uint64_t rowSeed[] = {0x9ae16a3b2f90404fULL, 0xc3a5c85c97cb3127ULL,
+                                   0xb492b66fbe98f273ULL, 0x9ddfea08eb382d69ULL};
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdOssRamCache::XrdOssRamCache(long long maxMem, int extsz)
+               : extSz(extsz), memMax(maxMem)
+{
+   long long totSlots = maxMem / extsz;
+   int i, j, perStripe, sketchSz;
+
+// Figure out how to spread the slots across the stripes. Each stripe needs a
+// reasonable number of slots for its replacement policy to be meaningful.
+//
+   if (totSlots < 1) totSlots = 1;
+   numStripes = (totSlots/minStripeSlots < numStripesMax
+              ?  (int)(totSlots/minStripeSlots) : numStripesMax);
+   if (numStripes < 1) numStripes = 1;
+   perStripe  = (int)(totSlots / numStripes);
+
+// The sketch needs a few counters per slot to keep collisions down and is
+// aged after the number of accesses is ten times the number of slots.
+//
+   sketchSz = 64;
+   while(sketchSz < perStripe*4) sketchSz <<= 1;
+   sketchMask = sketchSz - 1;
+   sketchAge  = (perStripe*10 < 64 ? 64 : perStripe*10);
+
+// Initialize each stripe. Buffers are allocated as slots are first used.
+//
+   stripes = new Stripe[numStripes];
+   for (i = 0; i < numStripes; i++)
+       {Stripe &sP = stripes[i];
+        sP.slots    = new Slot[perStripe];
+        memset(sP.slots, 0, sizeof(Slot)*perStripe);
+        sP.sketch   = new uint8_t[sketchSz*sketchRows];
+        memset(sP.sketch, 0, sketchSz*sketchRows);
+        sP.numSlots = perStripe;
+        sP.hand     = 0;
+        sP.sketchOps= 0;
+        sP.numHits  = sP.numMiss = sP.numAdmit = 0;
+        sP.numReject= sP.numEvict = sP.bytesHit = 0;
+        sP.freeSlots.reserve(perStripe);
+        for (j = perStripe-1; j >= 0; j--) sP.freeSlots.push_back(j);
+       }
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdOssRamCache::~XrdOssRamCache()
+{
+   for (int i = 0; i < numStripes; i++)
+       {for (int j = 0; j < stripes[i].numSlots; j++)
+            if (stripes[i].slots[j].data) free(stripes[i].slots[j].data);
+        delete [] stripes[i].slots;
+        delete [] stripes[i].sketch;
+       }
+   delete [] stripes;
+}
+
+/******************************************************************************/
+/*                                C o m m i t                                 */
+/******************************************************************************/
+
+void XrdOssRamCache::Commit(const Key &key, int slot, uint64_t gen, int dlen)
+{
+   Stripe &sP = stripes[(Hash(key) >> 48) % numStripes];
+   XrdSysMutexHelper mHelp(sP.sMutex);
+   Slot &theSlot = sP.slots[slot];
+
+// If the fill failed or the extent was dropped while being filled, discard it
+//
+   theSlot.busy = false;
+   if (dlen < 0 || theSlot.stale)
+      {sP.index.erase(key);
+       Free(sP, slot);
+       return;
+      }
+
+// The extent is now usable
+//
+   theSlot.gen  = gen;
+   theSlot.dlen = dlen;
+   theSlot.ref  = true;
+}
+
+/******************************************************************************/
+/*                                  D r o p                                   */
+/******************************************************************************/
+
+void XrdOssRamCache::Drop(uint64_t dev, uint64_t ino, long long offs,
+                          long long blen)
+{
+   Key key = {dev, ino, offs / extSz};
+   std::unordered_map<Key, int, KeyHash>::iterator it;
+
+// If a range was given, look up each extent in the range
+//
+   if (blen >= 0)
+      {int64_t lastExt = (offs + blen - 1) / extSz;
+       for (; blen && key.ext <= lastExt; key.ext++)
+           {Stripe &sP = stripes[(Hash(key) >> 48) % numStripes];
+            XrdSysMutexHelper mHelp(sP.sMutex);
+            if ((it = sP.index.find(key)) == sP.index.end()) continue;
+            if (sP.slots[it->second].busy) sP.slots[it->second].stale = true;
+               else {Free(sP, it->second); sP.index.erase(it);}
+           }
+       return;
+      }
+
+// Otherwise we must scan everything for extents at or beyond the offset
+//
+   for (int i = 0; i < numStripes; i++)
+       {Stripe &sP = stripes[i];
+        XrdSysMutexHelper mHelp(sP.sMutex);
+        for (int j = 0; j < sP.numSlots; j++)
+            {Slot &theSlot = sP.slots[j];
+             if (!theSlot.inUse || theSlot.key.ino != ino
+             ||  theSlot.key.dev != dev || theSlot.key.ext < key.ext) continue;
+             if (theSlot.busy) theSlot.stale = true;
+                else {sP.index.erase(theSlot.key); Free(sP, j);}
+            }
+       }
+}
+
+/******************************************************************************/
+/* Private:                     E s t i m a t e                               */
+/******************************************************************************/
+
+// The stripe lock must be held!
+
+int XrdOssRamCache::Estimate(Stripe &sP, uint64_t hval)
+{
+   int i, k, n = 255;
+
+   for (i = 0; i < sketchRows; i++)
+       {k = (int)((hval * rowSeed[i]) >> 32) & sketchMask;
+        if (sP.sketch[i*(sketchMask+1)+k] < n) n = sP.sketch[i*(sketchMask+1)+k];
+       }
+   return n;
+}
+
+/******************************************************************************/
+/* Private:                         F r e e                                   */
+/******************************************************************************/
+
+// The stripe lock must be held! The buffer is kept for the next user.
+
+void XrdOssRamCache::Free(Stripe &sP, int slot)
+{
+   sP.slots[slot].inUse = false;
+   sP.slots[slot].busy  = false;
+   sP.slots[slot].ref   = false;
+   sP.freeSlots.push_back(slot);
+}
+
+/******************************************************************************/
+/*                                   G e t                                    */
+/******************************************************************************/
+
+int XrdOssRamCache::Get(const Key &key, uint64_t gen, char *buff,
+                        int offs, int blen)
+{
+   uint64_t hval = Hash(key);
+   Stripe &sP = stripes[(hval >> 48) % numStripes];
+   XrdSysMutexHelper mHelp(sP.sMutex);
+   std::unordered_map<Key, int, KeyHash>::iterator it;
+   int n;
+
+// Count this access
+//
+   Touch(sP, hval);
+
+// Copy the data if we have it. An extent for another generation of the file
+// is useless and freed right away. One being filled counts as a miss.
+//
+   if ((it = sP.index.find(key)) != sP.index.end())
+      {Slot &theSlot = sP.slots[it->second];
+       if (!theSlot.busy)
+          {if (theSlot.gen == gen)
+              {n = theSlot.dlen - offs;
+               if (n < 0) n = 0;
+                  else if (n > blen) n = blen;
+               if (n) memcpy(buff, theSlot.data + offs, n);
+               theSlot.ref = true;
+               sP.numHits++;
+               sP.bytesHit += n;
+               return n;
+              }
+           Free(sP, it->second);
+           sP.index.erase(it);
+          }
+      }
+
+// This is a miss
+//
+   sP.numMiss++;
+   return -1;
+}
+
+/******************************************************************************/
+/* Private:                         H a s h                                   */
+/******************************************************************************/
+
+uint64_t XrdOssRamCache::Hash(const Key &k)
+{
+   uint64_t h = (k.dev * 0x9e3779b97f4a7c15ULL) ^ k.ino
+              ^ ((uint64_t)k.ext * 0xc2b2ae3d27d4eb4fULL);
+
+   h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+   h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= h >> 33;
+   return h;
+}
+
+/******************************************************************************/
+/*                               R e s e r v e                                */
+/******************************************************************************/
+
+char *XrdOssRamCache::Reserve(const Key &key, int &slot)
+{
+   uint64_t hval = Hash(key);
+   Stripe &sP = stripes[(hval >> 48) % numStripes];
+   XrdSysMutexHelper mHelp(sP.sMutex);
+   int n;
+
+// If someone is already filling this extent, let them do it
+//
+   if (sP.index.find(key) != sP.index.end()) return 0;
+
+// Use a free slot if we have one. Otherwise, run the clock to find a victim
+// that has not been referenced since the hand last passed it. The newcomer is
+// only admitted if it has been used more frequently than the victim.
+//
+   if (!sP.freeSlots.empty())
+      {slot = sP.freeSlots.back();
+       sP.freeSlots.pop_back();
+      } else {
+       for (n = sP.numSlots*2; n > 0; n--)
+           {Slot &theSlot = sP.slots[sP.hand];
+            if (!theSlot.busy && !theSlot.ref) break;
+            theSlot.ref = false;
+            sP.hand = (sP.hand + 1) % sP.numSlots;
+           }
+       if (!n || Estimate(sP, hval) <= Estimate(sP, Hash(sP.slots[sP.hand].key)))
+          {sP.numReject++;
+           return 0;
+          }
+       slot = sP.hand;
+       sP.index.erase(sP.slots[slot].key);
+       sP.hand = (sP.hand + 1) % sP.numSlots;
+       sP.numEvict++;
+      }
+
+// Make sure the slot has a buffer, it is aligned so it can be used for
+// direct I/O.
+//
+   Slot &theSlot = sP.slots[slot];
+   if (!theSlot.data && posix_memalign((void **)&theSlot.data, 4096, extSz))
+      {theSlot.data = 0;
+       Free(sP, slot);
+       sP.numReject++;
+       return 0;
+      }
+
+// Mark the slot as being filled and make it findable
+//
+   theSlot.key   = key;
+   theSlot.dlen  = 0;
+   theSlot.ref   = false;
+   theSlot.busy  = true;
+   theSlot.stale = false;
+   theSlot.inUse = true;
+   sP.index[key] = slot;
+   sP.numAdmit++;
+   return theSlot.data;
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdOssRamCache::Stats(char *buff, int blen)
+{
+   static const char statfmt[] = "<stats id=\"ossram\"><mem>%lld</mem>"
+          "<used>%lld</used><hit>%lld</hit><miss>%lld</miss><byt>%lld</byt>"
+          "<adm>%lld</adm><rej>%lld</rej><evict>%lld</evict></stats>";
+   static const int statsz = sizeof(statfmt) + (8*20);
+   long long used = 0, hits = 0, miss = 0, bhit = 0, adm = 0, rej = 0, evi = 0;
+   int n;
+
+// If only the size is wanted, return it
+//
+   if (!buff) return statsz;
+   if (blen < statsz) return 0;
+
+// Sum up the stripes
+//
+   for (int i = 0; i < numStripes; i++)
+       {Stripe &sP = stripes[i];
+        sP.sMutex.Lock();
+        used += sP.numSlots - (int)sP.freeSlots.size();
+        hits += sP.numHits;   miss += sP.numMiss;   bhit += sP.bytesHit;
+        adm  += sP.numAdmit;  rej  += sP.numReject; evi  += sP.numEvict;
+        sP.sMutex.UnLock();
+       }
+
+// Format the statistics
+//
+   n = snprintf(buff, blen, statfmt, memMax, used*extSz, hits, miss, bhit,
+                adm, rej, evi);
+   return (n < blen ? n : blen-1);
+}
+
+/******************************************************************************/
+/* Private:                        T o u c h                                  */
+/******************************************************************************/
+
+// The stripe lock must be held!
+
+void XrdOssRamCache::Touch(Stripe &sP, uint64_t hval)
+{
+   int i, k, sketchSz = sketchMask+1;
+
+// Bump each counter, they saturate at 15
+//
+   for (i = 0; i < sketchRows; i++)
+       {k = (int)((hval * rowSeed[i]) >> 32) & sketchMask;
+        if (sP.sketch[i*sketchSz+k] < 15) sP.sketch[i*sketchSz+k]++;
+       }
+
+// Periodically halve all of the counters so that old popularity fades
+//
+   if (++sP.sketchOps >= sketchAge)
+      {for (i = 0; i < sketchSz*sketchRows; i++) sP.sketch[i] >>= 1;
+       sP.sketchOps /= 2;
+      }
+}
@@ -0,0 +1,194 @@
+#ifndef __XRDOSSRAMCACHE_HH__
+#define __XRDOSSRAMCACHE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O s s R a m C a c h e . h h                      */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+//-----------------------------------------------------------------------------
+//! The XrdOssRamCache class holds fixed-size extents of files in memory. The
+//! extent index is split into stripes, each with its own lock, slots and
+//! replacement state, so that unrelated reads rarely contend. An extent is
+//! admitted only when it is read more often than the extent it would replace;
+//! access frequencies are estimated by an aging count-min sketch (TinyLFU).
+//! Extents that are admitted are replaced using the CLOCK algorithm.
+//-----------------------------------------------------------------------------
+
+class XrdOssRamCache
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! Identifies an extent of a file.
+//-----------------------------------------------------------------------------
+
+struct Key
+      {uint64_t dev;
+       uint64_t ino;
+       int64_t  ext;
+
+       bool operator==(const Key &k) const
+                      {return ext == k.ext && ino == k.ino && dev == k.dev;}
+      };
+
+//-----------------------------------------------------------------------------
+//! Commit an extent that was filled or abandon it.
+//!
+//! @param  key   The extent key passed to Reserve().
+//! @param  slot  The slot number returned by Reserve().
+//! @param  gen   The file generation the data belongs to.
+//! @param  dlen  The number of valid bytes in the extent or -1 if it could
+//!               not be read, in which case the slot is freed.
+//-----------------------------------------------------------------------------
+
+void    Commit(const Key &key, int slot, uint64_t gen, int dlen);
+
+//-----------------------------------------------------------------------------
+//! Drop cached extents of a file.
+//!
+//! @param  dev   The file's device number.
+//! @param  ino   The file's inode number.
+//! @param  offs  The offset of the modified region.
+//! @param  blen  The length of the modified region; negative means to the end
+//!               of the file, which requires a scan of the whole cache.
+//-----------------------------------------------------------------------------
+
+void    Drop(uint64_t dev, uint64_t ino, long long offs=0, long long blen=-1);
+
+//-----------------------------------------------------------------------------
+//! Obtain the extent size.
+//-----------------------------------------------------------------------------
+
+int     ExtSize() const {return extSz;}
+
+//-----------------------------------------------------------------------------
+//! Copy data from a cached extent. Every call, hit or miss, counts as an
+//! access for the admission policy.
+//!
+//! @param  key   The extent key.
+//! @param  gen   The current file generation; stale extents are dropped.
+//! @param  buff  Where the data is to be placed.
+//! @param  offs  The offset within the extent.
+//! @param  blen  The number of bytes wanted.
+//!
+//! @return >= 0 the number of bytes copied (less than blen at end of file).
+//!         <  0 the extent is not cached.
+//-----------------------------------------------------------------------------
+
+int     Get(const Key &key, uint64_t gen, char *buff, int offs, int blen);
+
+//-----------------------------------------------------------------------------
+//! Reserve a slot for an extent that was not found, if it should be admitted.
+//!
+//! @param  key   The extent key.
+//! @param  slot  Where the slot number is placed.
+//!
+//! @return Pointer to the extent buffer to be filled followed by a call to
+//!         Commit() or nil if the extent should not be cached. The buffer is
+//!         suitably aligned for direct I/O.
+//-----------------------------------------------------------------------------
+
+char   *Reserve(const Key &key, int &slot);
+
+//-----------------------------------------------------------------------------
+//! Produce statistics.
+//!
+//! @param  buff  The buffer to hold the statistics; if nil the maximum length
+//!               of the statistics is returned.
+//! @param  blen  The length of the buffer.
+//!
+//! @return The number of bytes placed in the buffer.
+//-----------------------------------------------------------------------------
+
+int     Stats(char *buff, int blen);
+
+//-----------------------------------------------------------------------------
+//! Constructor and destructor.
+//!
+//! @param  maxMem  The maximum amount of memory to use for extents.
+//! @param  extsz   The extent size, a power of two.
+//-----------------------------------------------------------------------------
+
+        XrdOssRamCache(long long maxMem, int extsz);
+       ~XrdOssRamCache();
+
+private:
+
+struct KeyHash
+      {size_t operator()(const Key &k) const {return (size_t)Hash(k);}};
+
+struct Slot
+      {Key      key;
+       uint64_t gen;
+       char    *data;
+       int      dlen;
+       bool     ref;      // Referenced since the clock hand last passed
+       bool     busy;     // Being filled
+       bool     stale;    // Dropped while being filled
+       bool     inUse;
+      };
+
+struct Stripe
+      {XrdSysMutex                          sMutex;
+       std::unordered_map<Key, int, KeyHash> index;
+       std::vector<int>                     freeSlots;
+       Slot                                *slots;
+       uint8_t                             *sketch;
+       int                                  numSlots;
+       int                                  hand;
+       int                                  sketchOps;
+       long long                            numHits;
+       long long                            numMiss;
+       long long                            numAdmit;
+       long long                            numReject;
+       long long                            numEvict;
+       long long                            bytesHit;
+      };
+
+static uint64_t Hash(const Key &k);
+int             Estimate(Stripe &sP, uint64_t hval);
+void            Free(Stripe &sP, int slot);
+void            Touch(Stripe &sP, uint64_t hval);
+
+static const int sketchRows = 4;
+static const int numStripesMax = 64;
+static const int minStripeSlots = 16;
+
+Stripe  *stripes;
+int      numStripes;
+int      extSz;
+int      sketchMask;
+int      sketchAge;
+long long memMax;
+};
+#endif
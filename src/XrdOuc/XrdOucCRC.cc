@@ -46,6 +46,7 @@
 */
 
 #include "XrdOuc/XrdOucCRC.hh"
+#include "XrdOuc/XrdOucCRC32.hh"
 #include "XrdOuc/XrdOucCRC32C.hh"
 
 /*****************************************************************/
@@ -183,6 +184,30 @@ uint32_t XrdOucCRC::CRC32(const unsigned char *p, int reclen)
    return crc ^ CRC32_XOROT;
 }
 
+/******************************************************************************/
+/*                                C a l c 3 2                                 */
+/******************************************************************************/
+  
+uint32_t XrdOucCRC::Calc32(const void* data, size_t count, uint32_t prevcs)
+{
+
+// Return the checksum
+//
+   return crc32z(prevcs, data, count);
+}
+
+/******************************************************************************/
+/*                               C a l c 3 2 P                                */
+/******************************************************************************/
+  
+uint32_t XrdOucCRC::Calc32P(const void* data, size_t count, uint32_t crcreg)
+{
+
+// Return the updated register
+//
+   return crc32p(crcreg, data, count);
+}
+
 /******************************************************************************/
 /*                                C R C 3 2 C                                 */
 /******************************************************************************/
@@ -53,6 +53,35 @@ public:
 
 static uint32_t CRC32(const unsigned char *data, int count);
 
+//------------------------------------------------------------------------------
+//! Compute a CRC32 checksum (as used by zlib and gzip) using hardware assist if
+//! available. The result is the same as that of CRC32() but this is much
+//! faster for all but the shortest buffers.
+//!
+//! @param  data   Pointer to the data whose checksum it to be computed.
+//! @param  count  The number of bytes pointed to by data.
+//! @param  prevcs The previous checksum value. The initial checksum of
+//!                checksum sequence should be zero, the default.
+//!
+//! @return The CRC32 checksum.
+//------------------------------------------------------------------------------
+
+static uint32_t Calc32(const void* data, size_t count, uint32_t prevcs=0);
+
+//------------------------------------------------------------------------------
+//! Update the CRC32 register of the POSIX checksum (as used by cksum) using
+//! hardware assist if available. The register is neither reflected nor
+//! inverted; the length suffix and final inversion are up to the caller.
+//!
+//! @param  data   Pointer to the data whose checksum it to be computed.
+//! @param  count  The number of bytes pointed to by data.
+//! @param  crcreg The current register value, initially zero.
+//!
+//! @return The updated register value.
+//------------------------------------------------------------------------------
+
+static uint32_t Calc32P(const void* data, size_t count, uint32_t crcreg);
+
 //------------------------------------------------------------------------------
 //! Compute a CRC32C checksum using hardware assist if available.
 //!
@@ -0,0 +1,338 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O u c C R C 3 2 . c c                         */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "XrdOuc/XrdOucCRC32.hh"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define XRDOUC_CRC32_PCLMUL 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+/*                         L o c a l   S t a t i c s                          */
+/******************************************************************************/
+
+namespace
+{
+const uint32_t PolyZ = 0xedb88320;  // 0x04c11db7 reflected
+const uint32_t PolyP = 0x04c11db7;
+
+pthread_once_t crcOnce = PTHREAD_ONCE_INIT;
+uint32_t       TabZ[8][256];        // TabZ[k][n] is byte n followed by k zeroes
+uint32_t       TabP[8][256];        // Likewise, but not reflected
+bool           hwFold = false;
+
+/******************************************************************************/
+/*                              C r c I n i t                                 */
+/******************************************************************************/
+
+void CrcInit()
+{
+   uint32_t cZ, cP;
+   int k, n;
+
+// Generate the byte-at-a-time tables
+//
+   for (n = 0; n < 256; n++)
+       {cZ = n; cP = static_cast<uint32_t>(n) << 24;
+        for (k = 0; k < 8; k++)
+            {cZ = (cZ & 1 ? (cZ >> 1) ^ PolyZ : cZ >> 1);
+             cP = (cP & 0x80000000 ? (cP << 1) ^ PolyP : cP << 1);
+            }
+        TabZ[0][n] = cZ; TabP[0][n] = cP;
+       }
+
+// Generate the tables for slicing-by-8
+//
+   for (n = 0; n < 256; n++)
+       for (k = 1; k < 8; k++)
+           {cZ = TabZ[k-1][n]; TabZ[k][n] = TabZ[0][cZ & 0xff] ^ (cZ >> 8);
+            cP = TabP[k-1][n]; TabP[k][n] = TabP[0][cP >> 24] ^ (cP << 8);
+           }
+
+// Determine whether we can fold using carry-less multiplication
+//
+#ifdef XRDOUC_CRC32_PCLMUL
+   unsigned int eax, ebx, ecx, edx;
+   if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+      hwFold = (ecx & bit_PCLMUL) && (ecx & bit_SSE4_1) && (ecx & bit_SSSE3);
+#endif
+}
+
+/******************************************************************************/
+/*                               S l i c e Z                                  */
+/******************************************************************************/
+
+// Update the (inverted) reflected register, 8 bytes at a time. The bytes are
+// assembled individually so that this works with any byte order; compilers
+// turn this into a single load on little endian machines.
+//
+uint32_t SliceZ(uint32_t crc, const unsigned char *p, size_t len)
+{
+   while(len >= 8)
+        {crc ^= static_cast<uint32_t>(p[0])       | static_cast<uint32_t>(p[1]) << 8
+             |  static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+         crc  = TabZ[7][crc & 0xff]         ^ TabZ[6][(crc >> 8) & 0xff]
+              ^ TabZ[5][(crc >> 16) & 0xff] ^ TabZ[4][crc >> 24]
+              ^ TabZ[3][p[4]] ^ TabZ[2][p[5]] ^ TabZ[1][p[6]] ^ TabZ[0][p[7]];
+         p += 8; len -= 8;
+        }
+
+   while(len--) crc = TabZ[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+   return crc;
+}
+
+/******************************************************************************/
+/*                               S l i c e P                                  */
+/******************************************************************************/
+
+// Update the non-reflected register, 8 bytes at a time.
+//
+uint32_t SliceP(uint32_t crc, const unsigned char *p, size_t len)
+{
+   while(len >= 8)
+        {crc ^= static_cast<uint32_t>(p[0]) << 24 | static_cast<uint32_t>(p[1]) << 16
+             |  static_cast<uint32_t>(p[2]) << 8  | static_cast<uint32_t>(p[3]);
+         crc  = TabP[7][crc >> 24]         ^ TabP[6][(crc >> 16) & 0xff]
+              ^ TabP[5][(crc >> 8) & 0xff] ^ TabP[4][crc & 0xff]
+              ^ TabP[3][p[4]] ^ TabP[2][p[5]] ^ TabP[1][p[6]] ^ TabP[0][p[7]];
+         p += 8; len -= 8;
+        }
+
+   while(len--) crc = TabP[0][(crc >> 24) ^ *p++] ^ (crc << 8);
+   return crc;
+}
+
+#ifdef XRDOUC_CRC32_PCLMUL
+/******************************************************************************/
+/*                               B i t R e v                                  */
+/******************************************************************************/
+
+uint32_t BitRev(uint32_t x)
+{
+   x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+   x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+   x = ((x >> 4) & 0x0f0f0f0f) | ((x & 0x0f0f0f0f) << 4);
+   return __builtin_bswap32(x);
+}
+
+/******************************************************************************/
+/*                                 L o a d                                    */
+/******************************************************************************/
+
+// Load 16 bytes, optionally reversing the bits in each byte. A non-reflected
+// CRC of some bytes is the bit reversal of the reflected CRC of the same bytes
+// each of which is bit reversed. This lets one folding routine do both.
+//
+template<bool bitRev>
+__attribute__((target("pclmul,ssse3,sse4.1")))
+inline __m128i Load(const unsigned char *p)
+{
+   __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+   if (bitRev)
+      {const __m128i revTab = _mm_setr_epi8(0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6,
+                                            0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb,
+                                            0x7, 0xf);
+       const __m128i lo4 = _mm_set1_epi8(0x0f);
+       __m128i lo = _mm_shuffle_epi8(revTab, _mm_and_si128(x, lo4));
+       __m128i hi = _mm_shuffle_epi8(revTab,
+                                     _mm_and_si128(_mm_srli_epi16(x, 4), lo4));
+       x = _mm_or_si128(_mm_slli_epi16(lo, 4), hi);
+      }
+   return x;
+}
+
+/******************************************************************************/
+/*                                 F o l d                                    */
+/******************************************************************************/
+
+// Update the reflected register over len bytes, which must be a multiple of 16
+// and at least 64, using carry-less multiplication. This is the method in
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction"
+// (Intel, 2009) with the constants for the reflected 0x04c11db7 polynomial.
+// Four 128-bit lanes are folded forward 64 bytes at a time, then folded into
+// one lane, reduced to 64 bits and finally Barrett reduced to 32 bits.
+//
+template<bool bitRev>
+__attribute__((target("pclmul,ssse3,sse4.1")))
+uint32_t Fold(uint32_t crc, const unsigned char *p, size_t len)
+{
+   static const uint64_t k1k2[2] __attribute__((aligned(16)))
+                                = {0x0154442bd4ULL, 0x01c6e41596ULL};
+   static const uint64_t k3k4[2] __attribute__((aligned(16)))
+                                = {0x01751997d0ULL, 0x00ccaa009eULL};
+   static const uint64_t k5k0[2] __attribute__((aligned(16)))
+                                = {0x0163cd6124ULL, 0x0000000000ULL};
+   static const uint64_t poly[2] __attribute__((aligned(16)))
+                                = {0x01db710641ULL, 0x01f7011641ULL};
+   __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, mask32;
+
+// Load the first 64 bytes and fold in the initial register value
+//
+   x1 = Load<bitRev>(p);      x2 = Load<bitRev>(p + 16);
+   x3 = Load<bitRev>(p + 32); x4 = Load<bitRev>(p + 48);
+   x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+   x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+   p += 64; len -= 64;
+
+// Fold 64 bytes at a time
+//
+   while(len >= 64)
+        {x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+         x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+         x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+         x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+         x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+         x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+         x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+         x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+         x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), Load<bitRev>(p));
+         x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), Load<bitRev>(p + 16));
+         x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), Load<bitRev>(p + 32));
+         x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), Load<bitRev>(p + 48));
+         p += 64; len -= 64;
+        }
+
+// Fold the four lanes into one
+//
+   x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+   x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+   x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+   x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+   x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+   x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+   x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+   x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+   x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+   x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+// Fold any remaining 16 byte blocks
+//
+   while(len >= 16)
+        {x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+         x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+         x1 = _mm_xor_si128(_mm_xor_si128(x1, Load<bitRev>(p)), x5);
+         p += 16; len -= 16;
+        }
+
+// Reduce 128 bits to 64 bits
+//
+   mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+   x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+   x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+   x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+   x2 = _mm_srli_si128(x1, 4);
+   x1 = _mm_and_si128(x1, mask32);
+   x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+   x1 = _mm_xor_si128(x1, x2);
+
+// Barrett reduce to 32 bits
+//
+   x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+   x2 = _mm_and_si128(x1, mask32);
+   x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+   x2 = _mm_and_si128(x2, mask32);
+   x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+   x1 = _mm_xor_si128(x1, x2);
+   return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+#endif
+}
+
+/******************************************************************************/
+/*                                c r c 3 2 z                                 */
+/******************************************************************************/
+
+uint32_t crc32z(uint32_t crc, void const *buf, size_t len)
+{
+   const unsigned char *p = static_cast<const unsigned char *>(buf);
+
+   pthread_once(&crcOnce, CrcInit);
+   crc = ~crc;
+
+#ifdef XRDOUC_CRC32_PCLMUL
+   if (hwFold && len >= 64)
+      {size_t n = len & ~static_cast<size_t>(15);
+       crc = Fold<false>(crc, p, n);
+       p += n; len -= n;
+      }
+#endif
+
+   return ~SliceZ(crc, p, len);
+}
+
+/******************************************************************************/
+
+uint32_t crc32z_sw(uint32_t crc, void const *buf, size_t len)
+{
+   pthread_once(&crcOnce, CrcInit);
+   return ~SliceZ(~crc, static_cast<const unsigned char *>(buf), len);
+}
+
+/******************************************************************************/
+/*                                c r c 3 2 p                                 */
+/******************************************************************************/
+
+uint32_t crc32p(uint32_t crc, void const *buf, size_t len)
+{
+   const unsigned char *p = static_cast<const unsigned char *>(buf);
+
+   pthread_once(&crcOnce, CrcInit);
+
+#ifdef XRDOUC_CRC32_PCLMUL
+   if (hwFold && len >= 64)
+      {size_t n = len & ~static_cast<size_t>(15);
+       crc = BitRev(Fold<true>(BitRev(crc), p, n));
+       p += n; len -= n;
+      }
+#endif
+
+   return SliceP(crc, p, len);
+}
+
+/******************************************************************************/
+
+uint32_t crc32p_sw(uint32_t crc, void const *buf, size_t len)
+{
+   pthread_once(&crcOnce, CrcInit);
+   return SliceP(crc, static_cast<const unsigned char *>(buf), len);
+}
+
+/******************************************************************************/
+/*                              c r c 3 2 _ h w                               */
+/******************************************************************************/
+
+bool crc32_hw()
+{
+   pthread_once(&crcOnce, CrcInit);
+   return hwFold;
+}
@@ -0,0 +1,61 @@
+#ifndef __XRDOUCCRC32_HH__
+#define __XRDOUCCRC32_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O u c C R C 3 2 . h h                         */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Two flavors of the 32-bit CRC based on the 0x04c11db7 polynomial are used.
+// The zlib flavor (also used by gzip and Ethernet) is reflected and is inverted
+// on input and output. The POSIX flavor (used by the cksum command) is not
+// reflected and the functions below only update the raw CRC register; any
+// length suffix and final inversion is left to the caller.
+//
+// Both use PCLMULQDQ folding when the processor supports it, as determined at
+// run time. Otherwise, or for short buffers, a slicing-by-8 table driven
+// method is used. The results are identical either way.
+
+// Return the zlib CRC-32 of buf[0..len-1] given the starting CRC crc. This can
+// be used to calculate the CRC of a sequence of bytes a chunk at a time, using
+// the previously returned crc in the next call. The first call must be with
+// crc == 0. The results are the same as zlib's crc32().
+uint32_t crc32z(uint32_t crc, void const *buf, size_t len);
+
+// Return the POSIX CRC-32 register after running buf[0..len-1] through it,
+// starting with the register value crc (initially 0).
+uint32_t crc32p(uint32_t crc, void const *buf, size_t len);
+
+// crc32z_sw() and crc32p_sw() are the same, but never use the PCLMULQDQ
+// instruction, even if available.
+uint32_t crc32z_sw(uint32_t crc, void const *buf, size_t len);
+uint32_t crc32p_sw(uint32_t crc, void const *buf, size_t len);
+
+// Return true if the PCLMULQDQ implementation is used.
+bool     crc32_hw();
+#endif
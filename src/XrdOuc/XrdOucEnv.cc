@@ -50,14 +50,19 @@ XrdOucEnv::XrdOucEnv(const char *vardata, int varlen,
 //
    if (!varlen) varlen = strlen(vardata);
 
-// We want our env copy to start with a single ampersand
+// We want our env copy to start with a single ampersand. The buffer holds two
+// copies, the second one is cut up in place into names and values which the
+// hash table then simply points to (i.e. they are kept, not duplicated). The
+// hash table still allocates an item for each variable.
 //
    while(*vardata == '&' && varlen) {vardata++; varlen--;}
    if (!varlen) {global_env = 0; global_len = 0; return;}
-   global_env = (char *)malloc(varlen+2);
+   global_env = (char *)malloc(varlen*2+4);
    *global_env = '&'; vdp = global_env+1;
    memcpy((void *)vdp, (const void *)vardata, (size_t)varlen);
    *(vdp+varlen) = '\0'; global_len = varlen+1;
+   vdp = global_env+global_len+1;
+   memcpy((void *)vdp, (const void *)global_env, (size_t)global_len+1);
 
 // scan through the string looking for '&'
 //
@@ -74,10 +79,8 @@ XrdOucEnv::XrdOucEnv(const char *vardata, int varlen,
          while(*vdp && *vdp != '&') vdp++;  // &....=....&
          varsave = *vdp; *vdp = '\0';
 
-         if (*varname && *varvalu)
-            env_Hash.Rep(varname, strdup(varvalu), 0, Hash_dofree);
-
-         *vdp = varsave; *(varvalu-1) = '=';
+         if (*varname && *varvalu) env_Hash.Rep(varname, varvalu, 0, Hash_keep);
+         if (varsave) vdp++;
         }
    return;
 }
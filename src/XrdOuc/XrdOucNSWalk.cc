@@ -32,6 +32,9 @@
 #include <string.h>
 #include <dirent.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 #include "XrdOuc/XrdOucNSWalk.hh"
 #include "XrdOuc/XrdOucTList.hh"
@@ -39,9 +42,394 @@
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysHeaders.hh"
 #include "XrdSys/XrdSysPlatform.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 using namespace std;
 
+/******************************************************************************/
+/*                   L o c a l   C l a s s   N S W a l k D i r                */
+/******************************************************************************/
+
+// On Linux, directories are read in large chunks via getdents64() using the
+// same file descriptor that is used for fstatat(). This avoids a second path
+// lookup per directory and returns the entry type, allowing us to skip stat()
+// for entries that are not returned. Elsewhere we use opendir()/readdir().
+//
+namespace
+{
+#if defined(__linux__) && defined(HAVE_FSTATAT) && defined(SYS_getdents64)
+#define NSWALK_GETDENTS 1
+
+struct linux_dirent64
+      {unsigned long long d_ino;
+       long long          d_off;
+       unsigned short     d_reclen;
+       unsigned char      d_type;
+       char               d_name[1];
+      };
+#endif
+
+class NSWalkDir
+{
+public:
+
+static const int dBsz = 65536;
+
+bool        Open(const char *path, int dfd)
+                {
+#ifdef NSWALK_GETDENTS
+                 if (dfd >= 0) {dFD = dfd; return (dBuff = (char *)malloc(dBsz));}
+#endif
+                 return (dP = opendir(path)) != 0;
+                }
+
+const char *Next(unsigned char &dType);
+
+            NSWalkDir() : dP(0), dBuff(0), dFD(-1), bLen(0), bOff(0) {}
+           ~NSWalkDir() {if (dP) closedir(dP);
+                         if (dBuff) free(dBuff);
+                        }
+private:
+
+bool        isDot(const char *fn)
+                 {return fn[0] == '.'
+                     && (!fn[1] || (fn[1] == '.' && !fn[2]));
+                 }
+
+DIR        *dP;
+char       *dBuff;
+int         dFD;
+long        bLen;
+long        bOff;
+};
+
+// Return the next entry name or nil at the end. If nil is returned, errno is
+// zero upon a normal end or holds the reason for the failure. The entry type
+// is returned in dType and is zero when unknown.
+//
+const char *NSWalkDir::Next(unsigned char &dType)
+{
+#ifdef NSWALK_GETDENTS
+   if (!dP)
+      {struct linux_dirent64 *dent;
+       do {if (bOff >= bLen)
+              {if ((bLen = syscall(SYS_getdents64, dFD, dBuff, dBsz)) <= 0)
+                  {if (bLen < 0) bLen = 0;
+                      else errno = 0;
+                   return 0;
+                  }
+               bOff = 0;
+              }
+           dent  = (struct linux_dirent64 *)(dBuff + bOff);
+           bOff += dent->d_reclen;
+          } while(isDot(dent->d_name));
+       dType = dent->d_type;
+       return dent->d_name;
+      }
+#endif
+
+   struct dirent *dp;
+
+   errno = 0;
+   do {if (!(dp = readdir(dP))) return 0;} while(isDot(dp->d_name));
+#ifdef DT_UNKNOWN
+   dType = dp->d_type;
+#else
+   dType = 0;
+#endif
+   return dp->d_name;
+}
+}
+
+/******************************************************************************/
+/*                 C l a s s   X r d O u c N S W a l k P o o l                */
+/******************************************************************************/
+
+// The pool indexes directories for a recursive walk using multiple threads.
+// Each worker has its own queue of unindexed directories to which it adds
+// the subdirectories it finds and from which it takes the newest one (this
+// keeps a worker on the subtree it is in). A worker with an empty queue steals
+// the oldest directory from another worker's queue. Indexed directories are
+// handed back to XrdOucNSWalk::Index() in batches, one per directory.
+//
+class XrdOucNSWalkPool
+{
+public:
+
+struct Batch
+      {Batch               *Next;
+       XrdOucNSWalk::NSEnt *Ents;
+       char                *Path;
+       struct stat          dStat;
+       int                  rc;
+       int                  isEmpty;
+
+                            Batch() : Next(0), Ents(0), Path(0), rc(0),
+                                      isEmpty(0) {}
+                           ~Batch() {XrdOucNSWalk::NSEnt *eP;
+                                     while((eP = Ents))
+                                          {Ents = eP->Next; delete eP;}
+                                     if (Path) free(Path);
+                                    }
+      };
+
+struct Worker
+      {XrdOucNSWalkPool *Pool;
+       XrdOucNSWalk     *Walk;
+       XrdOucTList      *dqHead;   // Unindexed directories, newest first
+       XrdSysMutex       dqMutex;
+       pthread_t         tid;
+       int               Num;
+       bool              Started;
+
+                         Worker() : Pool(0), Walk(0), dqHead(0), tid(0),
+                                    Num(0), Started(false) {}
+                        ~Worker() {XrdOucTList *tP;
+                                   while((tP = dqHead))
+                                        {dqHead = tP->next; delete tP;}
+                                   if (Walk) delete Walk;
+                                  }
+      };
+
+Batch    *Get();
+
+void      Run(Worker *wP);
+
+bool      Start(XrdOucNSWalk &Parent);
+
+          XrdOucNSWalkPool(int nThr, int maxQ)
+                          : poolCV(0), Workers(new Worker[nThr]), bFirst(0),
+                            bLast(0), nWorkers(nThr), maxBQ(maxQ), numBQ(0),
+                            Pending(0), nWait(0), wGen(0), Ending(false) {}
+
+         ~XrdOucNSWalkPool();
+
+private:
+
+XrdOucTList *Steal(Worker *wP);
+
+XrdSysCondVar poolCV;
+Worker       *Workers;
+Batch        *bFirst;
+Batch        *bLast;
+int           nWorkers;
+int           maxBQ;
+int           numBQ;
+int           Pending;   // Directories found but not yet indexed
+int           nWait;
+unsigned int  wGen;      // Incremented each time directories are queued
+bool          Ending;
+};
+
+/******************************************************************************/
+/*                   X r d O u c N S W a l k P o o l R u n                    */
+/******************************************************************************/
+
+namespace
+{
+void *XrdOucNSWalkPoolRun(void *carg)
+{
+   XrdOucNSWalkPool::Worker *wP = (XrdOucNSWalkPool::Worker *)carg;
+
+   wP->Pool->Run(wP);
+   return (void *)0;
+}
+}
+
+/******************************************************************************/
+/*                X r d O u c N S W a l k P o o l   M e t h o d s             */
+/******************************************************************************/
+  
+XrdOucNSWalkPool::~XrdOucNSWalkPool()
+{
+   Batch *bP;
+   int i;
+
+// Tell all the workers to stop and wait for them to do so
+//
+   poolCV.Lock();
+   Ending = true;
+   poolCV.Broadcast();
+   poolCV.UnLock();
+
+   for (i = 0; i < nWorkers; i++)
+       if (Workers[i].Started) XrdSysThread::Join(Workers[i].tid, 0);
+
+// Delete anything that was never returned
+//
+   while((bP = bFirst)) {bFirst = bP->Next; delete bP;}
+   delete [] Workers;
+}
+
+/******************************************************************************/
+
+XrdOucNSWalkPool::Batch *XrdOucNSWalkPool::Get()
+{
+   Batch *bP;
+
+// Wait for an indexed directory unless there is nothing left to index
+//
+   poolCV.Lock();
+   while(!(bP = bFirst) && Pending) {nWait++; poolCV.Wait(); nWait--;}
+   if (bP)
+      {if (!(bFirst = bP->Next)) bLast = 0;
+       numBQ--;
+       if (nWait) poolCV.Broadcast();
+      }
+   poolCV.UnLock();
+   return bP;
+}
+
+/******************************************************************************/
+  
+void XrdOucNSWalkPool::Run(Worker *wP)
+{
+   XrdOucNSWalk *nsP = wP->Walk;
+   XrdOucTList  *tP, *lP;
+   Batch        *bP;
+   unsigned int  myGen;
+   int           nDirs;
+
+do{poolCV.Lock(); myGen = wGen; poolCV.UnLock();
+
+// Take the newest directory from our queue or steal one from someone else
+//
+   wP->dqMutex.Lock();
+   if ((tP = wP->dqHead)) wP->dqHead = tP->next;
+   wP->dqMutex.UnLock();
+
+   if (!tP && !(tP = Steal(wP)))
+      {poolCV.Lock();
+       if (!Pending || Ending) {poolCV.UnLock(); break;}
+       if (myGen == wGen) {nWait++; poolCV.Wait(); nWait--;}
+       poolCV.UnLock();
+       continue;
+      }
+
+// Index the directory exactly as Index() would do it
+//
+   nsP->setPath(tP->text); delete tP;
+   bP = new Batch;
+   if (!nsP->LKFn || !(bP->rc = nsP->LockFile()))
+      {bP->rc = nsP->Build();
+       if (nsP->LKfd >= 0) {close(nsP->LKfd); nsP->LKfd = -1;}
+      }
+   bP->Ents    = nsP->DEnts; nsP->DEnts = 0;
+   bP->isEmpty = nsP->isEmpty;
+   bP->dStat   = nsP->dStat;
+   *(nsP->File) = '\0';
+   bP->Path    = strdup(nsP->DPath);
+
+// Add any subdirectories we found to our queue. They must be accounted for
+// before they are published as another worker may steal and finish them
+// before we get here again, letting Pending drop to zero too early.
+//
+   nDirs = 0;
+   if ((tP = nsP->DList))
+      {lP = tP; nDirs = 1;
+       while(lP->next) {lP = lP->next; nDirs++;}
+       poolCV.Lock(); Pending += nDirs; poolCV.UnLock();
+       wP->dqMutex.Lock();
+       lP->next = wP->dqHead; wP->dqHead = tP;
+       wP->dqMutex.UnLock();
+       nsP->DList = 0;
+      }
+
+// Discard batches that Index() would simply skip
+//
+   if (!bP->Ents && !bP->isEmpty && (!bP->rc || nsP->errOK))
+      {delete bP; bP = 0;}
+
+// Queue the batch and account for the directories. We wait if the batch
+// queue is full as there is no point in running ahead of our consumer.
+//
+   poolCV.Lock();
+   Pending--;
+   if (nDirs) wGen++;
+   if (bP)
+      {if (bLast) bLast->Next = bP;
+          else    bFirst      = bP;
+       bLast = bP; numBQ++;
+      }
+   if (nWait && (nDirs || bP || !Pending)) poolCV.Broadcast();
+   while(numBQ >= maxBQ && !Ending) {nWait++; poolCV.Wait(); nWait--;}
+   if (Ending) {poolCV.UnLock(); break;}
+   poolCV.UnLock();
+  } while(1);
+}
+
+/******************************************************************************/
+  
+bool XrdOucNSWalkPool::Start(XrdOucNSWalk &Parent)
+{
+   XrdOucTList *tP;
+   int i, nStarted = 0;
+
+// Create a walker for each worker. It inherits the parent's options but has
+// nothing to index until it is handed a directory.
+//
+   for (i = 0; i < nWorkers; i++)
+       {Workers[i].Pool = this;
+        Workers[i].Num  = i;
+        Workers[i].Walk = new XrdOucNSWalk(Parent.eDest, "/", Parent.LKFn,
+                                           Parent.Opts,  Parent.XList);
+        Workers[i].Walk->edCB = Parent.edCB;
+        Workers[i].Walk->mPfx = Parent.mPfx;
+        while((tP = Workers[i].Walk->DList))
+             {Workers[i].Walk->DList = tP->next; delete tP;}
+       }
+
+// Seed the first worker with whatever the parent has left to index
+//
+   Workers[0].dqHead = Parent.DList; Parent.DList = 0;
+   for (tP = Workers[0].dqHead; tP; tP = tP->next) Pending++;
+
+// Start the workers
+//
+   for (i = 0; i < nWorkers; i++)
+       {if (XrdSysThread::Run(&Workers[i].tid, XrdOucNSWalkPoolRun,
+                              (void *)&Workers[i], XRDSYSTHREAD_HOLD,
+                              "NSWalk worker"))
+           {Parent.Emsg("Index", errno, "start namespace walker thread");
+            continue;
+           }
+        Workers[i].Started = true; nStarted++;
+       }
+
+// If no thread could be started, give back the directories to the parent
+//
+   if (!nStarted)
+      {Parent.DList = Workers[0].dqHead; Workers[0].dqHead = 0;
+       return false;
+      }
+   return true;
+}
+
+/******************************************************************************/
+  
+XrdOucTList *XrdOucNSWalkPool::Steal(Worker *wP)
+{
+   XrdOucTList *tP, *pP;
+   int i;
+
+// Take the oldest directory from another worker as it is the one most likely
+// to have the largest subtree below it.
+//
+   for (i = 1; i < nWorkers; i++)
+       {Worker *vP = &Workers[(wP->Num + i) % nWorkers];
+        vP->dqMutex.Lock();
+        if ((tP = vP->dqHead))
+           {pP = 0;
+            while(tP->next) {pP = tP; tP = tP->next;}
+            if (pP) pP->next   = 0;
+               else vP->dqHead = 0;
+           }
+        vP->dqMutex.UnLock();
+        if (tP) return tP;
+       }
+   return 0;
+}
+
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
@@ -54,6 +442,8 @@ XrdOucNSWalk::XrdOucNSWalk(XrdSysError *erp, const char *dpath,
 //
    eDest = erp;
    mPfx  = 0;
+   wPool = 0;
+   wThreads = wMaxQ = 0;
    DList = new XrdOucTList(dpath);
    if (lkfn) LKFn = strdup(lkfn);
       else   LKFn = 0;
@@ -65,8 +455,8 @@ XrdOucNSWalk::XrdOucNSWalk(XrdSysError *erp, const char *dpath,
 
 // Copy the exclude list if one exists
 //
-   if (!xlist) XList = 0;
-      else while(xlist)
+   XList = 0;
+   while(xlist)
                 {XList = new XrdOucTList(xlist->text,xlist->ival,XList);
                  xlist = xlist->next;
                 }
@@ -80,6 +470,8 @@ XrdOucNSWalk::~XrdOucNSWalk()
 {
    XrdOucTList *tP;
 
+   if (wPool) delete wPool;
+
    if (LKFn) free(LKFn);
 
    while((tP = DList)) {DList = tP->next; delete tP;}
@@ -96,6 +488,17 @@ XrdOucNSWalk::NSEnt *XrdOucNSWalk::Index(int &rc, const char **dPath)
    XrdOucTList *tP;
    NSEnt *eP;
 
+// If a parallel walk was requested, start the worker threads the first time
+// through. Should that fail, we simply continue serially.
+//
+   if (wThreads > 1 && (Opts & Recurse))
+      {if (!wPool)
+          {wPool = new XrdOucNSWalkPool(wThreads, wMaxQ);
+           if (!wPool->Start(*this)) {delete wPool; wPool = 0; wThreads = 0;}
+          }
+       if (wPool) return Parallel(rc, dPath);
+      }
+
 // Sequence the directory
 //
    rc = 0; *DPath = '\0';
@@ -119,6 +522,38 @@ XrdOucNSWalk::NSEnt *XrdOucNSWalk::Index(int &rc, const char **dPath)
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
+/******************************************************************************/
+/*                              P a r a l l e l                               */
+/******************************************************************************/
+
+XrdOucNSWalk::NSEnt *XrdOucNSWalk::Parallel(int &rc, const char **dPath)
+{
+   XrdOucNSWalkPool::Batch *bP;
+   NSEnt *eP;
+
+// Return the next directory that has something to report. Empty directory
+// call backs are made here so that they occur on the caller's thread.
+//
+   rc = 0; *DPath = '\0'; File = DPath;
+   while((bP = wPool->Get()))
+        {strcpy(DPath, bP->Path); File = DPath + strlen(DPath);
+         rc = bP->rc;
+         if ((eP = bP->Ents) || (rc && !errOK))
+            {bP->Ents = 0; delete bP;
+             if (dPath) *dPath = DPath;
+             return eP;
+            }
+         if (edCB && bP->isEmpty) edCB->isEmpty(&bP->dStat, DPath, LKFn);
+         delete bP;
+        }
+
+// Nothing left to index
+//
+   rc = 0; *DPath = '\0';
+   if (dPath) *dPath = DPath;
+   return 0;
+}
+
 /******************************************************************************/
 /*                                a d d E n t                                 */
 /******************************************************************************/
@@ -155,15 +590,15 @@ void XrdOucNSWalk::addEnt(XrdOucNSWalk::NSEnt *eP)
 int XrdOucNSWalk::Build()
 {
    struct Helper {XrdOucNSWalk::NSEnt *P;
-                  DIR                 *D;
                   int                  F;
-                                       Helper() : P(0), D(0), F(-1) {}
+                                       Helper() : P(0), F(-1) {}
                                       ~Helper() {if (P)   delete P;
-                                                 if (D)   closedir(D);
                                                  if (F>0) close(F);
                                                 }
                  } theEnt;
-   struct dirent  *dp;
+   NSWalkDir       theDir;
+   const char     *dName;
+   unsigned char   dType;
    int             rc = 0, getLI = Opts & retLink;
    int             nEnt = 0, xLKF = 0, chkED = (edCB != 0) && (LKFn != 0);
 
@@ -182,15 +617,29 @@ int XrdOucNSWalk::Build()
 
 // Open the directory
 //
-   if (!(theEnt.D = opendir(DPath)))
+   if (!theDir.Open(DPath, DPfd))
       return Emsg("Build", errno, "open directory", DPath);
 
 // Process the entries
 //
    errno = 0;
-   while((dp = readdir(theEnt.D)))
-        {if (!strcmp(dp->d_name, ".") || !strcmp(dp->d_name, "..")) continue;
-         strcpy(File, dp->d_name); nEnt++;
+   while((dName = theDir.Next(dType)))
+        {strcpy(File, dName); nEnt++;
+#ifdef DT_DIR
+         // Entries of a known type that are not returned need no stat()
+         //
+         if (dType == DT_DIR && !(Opts & retDir))
+            {if (Opts & Recurse && (!XList || !inXList(File)))
+                DList = new XrdOucTList(DPath, 0, DList);
+             errno = 0;
+             continue;
+            }
+         if (dType == DT_REG && !(Opts & retFile))
+            {if (chkED && !xLKF) xLKF = !strcmp(File, LKFn);
+             errno = 0;
+             continue;
+            }
+#endif
          if (!theEnt.P) theEnt.P = new NSEnt();
          rc = getStat(theEnt.P, getLI);
          switch(theEnt.P->Type)
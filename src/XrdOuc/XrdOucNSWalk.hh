@@ -36,6 +36,7 @@
 #include <sys/stat.h>
   
 
+class XrdOucNSWalkPool;
 class XrdOucTList;
 class XrdSysError;
 
@@ -101,6 +102,19 @@ void         setCallBack(CallBack *cbP=0) {edCB = cbP;}
 //
 void         setMsgOn(const char *pfx) {mPfx = pfx;}
 
+// When opts & Recurse is in effect, directories may be indexed in parallel by
+// calling setThreads() before the first call to Index(). Up to nThr threads
+// index directories concurrently, each stealing unindexed directories from
+// the others when it runs out of work. Each Index() call then returns the
+// entries of a single directory (i.e. a batch) as soon as one is available.
+// Hence, directories are not returned in depth-first order. At most maxQ
+// indexed directories are kept waiting to be returned (0 -> 4 per thread).
+// Call backs are still made on the thread calling Index(). When nThr is less
+// than 2 or Recurse is not in effect, directories are indexed serially.
+//
+void         setThreads(int nThr, int maxQ=0)
+                       {wThreads = nThr; wMaxQ = (maxQ > 0 ? maxQ : 4*nThr);}
+
 // The following are processing options passed to the constructor
 //
 static const int retDir =  0x0001; // Return directories (implies retStat)
@@ -130,6 +144,9 @@ static const int skpErrs=  0x8000; // Skip any entry causing an error
 //       as a directory entry if an empty directory call back has been set.
 
 private:
+friend class XrdOucNSWalkPool;
+
+NSEnt        *Parallel(int &rc, const char **dPath);
 void          addEnt(XrdOucNSWalk::NSEnt *eP);
 int           Build();
 int           Emsg(const char *pfx, int rc, const char *tx1, const char *tx2=0);
@@ -142,6 +159,7 @@ int           LockFile();
 void          setPath(char *newpath);
 
 XrdSysError  *eDest;
+XrdOucNSWalkPool *wPool;
 XrdOucTList  *DList;
 XrdOucTList  *XList;
 struct NSEnt *DEnts;
@@ -156,5 +174,7 @@ int           DPfd;
 int           Opts;
 int           errOK;
 int           isEmpty;
+int           wThreads;
+int           wMaxQ;
 };
 #endif
@@ -29,6 +29,8 @@ add_library(
   XrdPfc/XrdPfcIO.cc            XrdPfc/XrdPfcIO.hh
   XrdPfc/XrdPfcIOEntireFile.cc  XrdPfc/XrdPfcIOEntireFile.hh
   XrdPfc/XrdPfcIOFileBlock.cc   XrdPfc/XrdPfcIOFileBlock.hh
+  XrdPfc/XrdPfcIOPassThrough.cc XrdPfc/XrdPfcIOPassThrough.hh
+  XrdPfc/XrdPfcTinyLFU.cc       XrdPfc/XrdPfcTinyLFU.hh
   XrdPfc/XrdPfcDecision.hh)
 
 target_link_libraries(
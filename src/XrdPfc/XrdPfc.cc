@@ -20,6 +20,7 @@
 #include <sstream>
 #include <algorithm>
 #include <sys/statvfs.h>
+#include <time.h>
 
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClURL.hh"
@@ -40,6 +41,8 @@
 #include "XrdPfcInfo.hh"
 #include "XrdPfcIOEntireFile.hh"
 #include "XrdPfcIOFileBlock.hh"
+#include "XrdPfcIOPassThrough.hh"
+#include "XrdPfcTinyLFU.hh"
 
 using namespace XrdPfc;
 
@@ -72,6 +75,16 @@ void *PrefetchThread(void*)
    return 0;
 }
 
+namespace
+{
+   long long MonotonicUSec()
+   {
+      struct timespec ts;
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+      return (long long) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+   }
+}
+
 //==============================================================================
 
 extern "C"
@@ -143,6 +156,16 @@ void Configuration::calculate_fractional_usages(long long  du,      long long  f
   frac_fu = std::min( std::max( frac_fu, 0.0), 1.0 );
 }
 
+bool Configuration::is_std_bsize(long long bs) const
+{
+  // Block sizes whose buffers are worth keeping for reuse: the configured one
+  // and, with adaptive block size, the powers of two the files can choose from.
+
+  if (bs == m_bufferSize) return true;
+
+  return is_bsize_adaptive() && bs >= m_bufferSizeMin && bs <= m_bufferSizeMax && (bs & (bs - 1)) == 0;
+}
+
 //==============================================================================
 
 Cache &Cache::CreateInstance(XrdSysLogger *logger, XrdOucEnv *env)
@@ -156,9 +179,9 @@ Cache &Cache::CreateInstance(XrdSysLogger *logger, XrdOucEnv *env)
 const Cache&         Cache::TheOne()      { return *m_instance; }
 const Configuration& Cache::Conf()        { return  m_instance->RefConfiguration(); }
 
-bool Cache::Decide(XrdOucCacheIO* io)
+bool Cache::Decide(XrdOucCacheIO* io, bool *admission_rejected)
 {
-   if (! m_decisionpoints.empty())
+   if (! m_decisionpoints.empty() || m_admission)
    {
       XrdCl::URL url(io->Path());
       std::string filename = url.GetPath();
@@ -172,6 +195,24 @@ bool Cache::Decide(XrdOucCacheIO* io)
             return false;
          }
       }
+
+      if (m_admission)
+      {
+         // Files already in the cache only have their access counted, others
+         // must earn their place. Rejected files are read pass-through.
+         struct stat st;
+         std::string i_name = filename + Info::s_infoExtension;
+         if (m_oss->Stat(i_name.c_str(), &st) == XrdOssOK)
+         {
+            m_admission->RecordAccess(filename);
+         }
+         else if ( ! m_admission->Admit(filename))
+         {
+            TRACE(Debug, "Decide() admission rejects " << filename);
+            if (admission_rejected) *admission_rejected = true;
+            return false;
+         }
+      }
    }
 
    return true;
@@ -185,6 +226,7 @@ Cache::Cache(XrdSysLogger *logger, XrdOucEnv *env) :
    m_traceID("Cache"),
    m_oss(0),
    m_gstream(0),
+   m_admission(0),
    m_prefetch_condVar(0),
    m_prefetch_enabled(false),
    m_RAM_used(0),
@@ -207,7 +249,9 @@ XrdOucCacheIO *Cache::Attach(XrdOucCacheIO *io, int Options)
 {
    const char* tpfx = "Attach() ";
 
-   if (Cache::GetInstance().Decide(io))
+   bool admission_rejected = false;
+
+   if (Cache::GetInstance().Decide(io, &admission_rejected))
    {
       TRACE(Info, tpfx << io->Path());
 
@@ -238,6 +282,12 @@ XrdOucCacheIO *Cache::Attach(XrdOucCacheIO *io, int Options)
 
       return cio;
    }
+   else if (admission_rejected)
+   {
+      // Read directly from the origin, counting the bytes as bypassing the cache.
+      TRACE(Info, tpfx << "admission decline " << io->Path());
+      return new IOPassThrough(io, *this);
+   }
    else
    {
       TRACE(Info, tpfx << "decision decline " << io->Path());
@@ -254,11 +304,22 @@ void Cache::AddWriteTask(Block* b, bool fromRead)
       m_RAM_write_queue += b->get_size();
    }
 
+   b->m_wq_time = MonotonicUSec();
+
    m_writeQ.condVar.Lock();
+   WriteQ::FileQueues_i fqi = m_writeQ.file_queues.find(b->m_file);
+   if (fqi == m_writeQ.file_queues.end())
+   {
+      fqi = m_writeQ.file_queues.insert(std::make_pair(b->m_file, std::list<Block*>())).first;
+      if (fromRead)
+         m_writeQ.file_order.push_back(b->m_file);
+      else
+         m_writeQ.file_order.push_front(b->m_file);
+   }
    if (fromRead)
-      m_writeQ.queue.push_back(b);
+      fqi->second.push_back(b);
    else
-      m_writeQ.queue.push_front(b);
+      fqi->second.push_front(b);
    m_writeQ.size++;
    m_writeQ.condVar.Signal();
    m_writeQ.condVar.UnLock();
@@ -270,22 +331,18 @@ void Cache::RemoveWriteQEntriesFor(File *file)
    long long         sum_size = 0;
 
    m_writeQ.condVar.Lock();
-   std::list<Block*>::iterator i = m_writeQ.queue.begin();
-   while (i != m_writeQ.queue.end())
+   WriteQ::FileQueues_i fqi = m_writeQ.file_queues.find(file);
+   if (fqi != m_writeQ.file_queues.end())
    {
-      if ((*i)->m_file == file)
+      removed_blocks.swap(fqi->second);
+      for (std::list<Block*>::iterator i = removed_blocks.begin(); i != removed_blocks.end(); ++i)
       {
          TRACE(Dump, "Remove entries for " <<  (void*)(*i) << " path " <<  file->lPath());
-         std::list<Block*>::iterator j = i++;
-         removed_blocks.push_back(*j);
-         sum_size += (*j)->get_size();
-         m_writeQ.queue.erase(j);
-         --m_writeQ.size;
-      }
-      else
-      {
-         ++i;
+         sum_size += (*i)->get_size();
       }
+      m_writeQ.size -= removed_blocks.size();
+      m_writeQ.file_queues.erase(fqi);
+      m_writeQ.file_order.remove(file);
    }
    m_writeQ.condVar.UnLock();
 
@@ -299,7 +356,8 @@ void Cache::RemoveWriteQEntriesFor(File *file)
 
 void Cache::ProcessWriteTasks()
 {
-   std::vector<Block*> blks_to_write(m_configuration.m_wqueue_blocks);
+   std::vector<Block*> blks_to_write;
+   blks_to_write.reserve(m_configuration.m_wqueue_blocks);
 
    while (true)
    {
@@ -309,24 +367,47 @@ void Cache::ProcessWriteTasks()
          m_writeQ.condVar.Wait();
       }
 
-      // MT -- optimize to pop several blocks if they are available (or swap the list).
-      // This makes sense especially for smallish block sizes.
+      // Take a batch of blocks from the file first in line. If some remain,
+      // the file goes to the back so that one file being filled quickly
+      // does not hold up the others.
+
+      File                 *file = m_writeQ.file_order.front();
+      WriteQ::FileQueues_i  fqi  = m_writeQ.file_queues.find(file);
+      std::list<Block*>    &fq   = fqi->second;
+
+      long long now      = MonotonicUSec();
+      long long sum_size = 0, sum_wait = 0, max_wait = 0;
 
-      int       n_pushed = std::min(m_writeQ.size, m_configuration.m_wqueue_blocks);
-      long long sum_size = 0;
+      m_writeQ.file_order.pop_front();
+      blks_to_write.clear();
 
-      for (int bi = 0; bi < n_pushed; ++bi)
+      // Files can have different block sizes so the batch is also limited to
+      // the number of bytes a full batch of standard blocks would hold.
+      const long long max_size = m_configuration.m_wqueue_blocks * m_configuration.m_bufferSize;
+
+      while ( ! fq.empty() && (int) blks_to_write.size() < m_configuration.m_wqueue_blocks &&
+              (blks_to_write.empty() || sum_size + fq.front()->get_size() <= max_size))
       {
-         Block* block = m_writeQ.queue.front();
-         m_writeQ.queue.pop_front();
-         m_writeQ.writes_between_purges += block->get_size();
+         Block* block = fq.front();
+         fq.pop_front();
          sum_size += block->get_size();
 
-         blks_to_write[bi] = block;
+         long long wait = now - block->m_wq_time;
+         sum_wait += wait;
+         if (wait > max_wait) max_wait = wait;
+
+         blks_to_write.push_back(block);
 
-         TRACE(Dump, "ProcessWriteTasks for block " <<  (void*)(block) << " path " << block->m_file->lPath());
+         TRACE(Dump, "ProcessWriteTasks for block " <<  (void*)(block) << " path " << file->lPath());
       }
-      m_writeQ.size -= n_pushed;
+
+      if (fq.empty())
+         m_writeQ.file_queues.erase(fqi);
+      else
+         m_writeQ.file_order.push_back(file);
+
+      m_writeQ.size -= blks_to_write.size();
+      m_writeQ.writes_between_purges += sum_size;
 
       m_writeQ.condVar.UnLock();
 
@@ -335,11 +416,14 @@ void Cache::ProcessWriteTasks()
          m_RAM_write_queue -= sum_size;
       }
 
-      for (int bi = 0; bi < n_pushed; ++bi)
-      {
-         Block* block = blks_to_write[bi];
+      int n_writes = file->WriteBlocksToDisk(blks_to_write);
 
-         block->m_file->WriteBlockToDisk(block);
+      {
+         XrdSysMutexHelper lock(&m_wb_stats_mutex);
+         m_wb_stats.m_NBlocks  += blks_to_write.size();
+         m_wb_stats.m_NWrites  += n_writes;
+         m_wb_stats.m_WaitTime += sum_wait;
+         if (max_wait > m_wb_stats.m_WaitMax) m_wb_stats.m_WaitMax = max_wait;
       }
    }
 }
@@ -350,7 +434,7 @@ char* Cache::RequestRAM(long long size)
 {
    static const size_t s_block_align = sysconf(_SC_PAGESIZE);
 
-   bool  std_size = (size == m_configuration.m_bufferSize);
+   bool  std_size = m_configuration.is_std_bsize(size);
 
    m_RAM_mutex.Lock();
 
@@ -359,11 +443,12 @@ char* Cache::RequestRAM(long long size)
    if (total <= m_configuration.m_RamAbsAvailable)
    {
       m_RAM_used = total;
-      if (std_size && m_RAM_std_size > 0)
+      std::map<long long, std::vector<char*> >::iterator si;
+      if (std_size && (si = m_RAM_std_blocks.find(size)) != m_RAM_std_blocks.end() && ! si->second.empty())
       {
-         char *buf = m_RAM_std_blocks.back();
-         m_RAM_std_blocks.pop_back();
-         --m_RAM_std_size;
+         char *buf = si->second.back();
+         si->second.pop_back();
+         m_RAM_std_size -= size;
 
          m_RAM_mutex.UnLock();
 
@@ -388,16 +473,16 @@ char* Cache::RequestRAM(long long size)
 
 void Cache::ReleaseRAM(char* buf, long long size)
 {
-   bool std_size = (size == m_configuration.m_bufferSize);
+   bool std_size = m_configuration.is_std_bsize(size);
    {
       XrdSysMutexHelper lock(&m_RAM_mutex);
 
       m_RAM_used -= size;
 
-      if (std_size && m_RAM_std_size < m_configuration.m_RamKeepStdBlocks)
+      if (std_size && m_RAM_std_size + size <= m_configuration.m_RamKeepStdBytes)
       {
-         m_RAM_std_blocks.push_back(buf);
-         ++m_RAM_std_size;
+         m_RAM_std_blocks[size].push_back(buf);
+         m_RAM_std_size += size;
          return;
       }
    }
@@ -634,6 +719,30 @@ void Cache::dec_ref_cnt(File* f, bool high_debug)
 
          m_closed_files_stats.insert(std::make_pair(f->GetLocalPath(), f->DeltaStatsFromLastCall()));
 
+         {
+            const Info::AStat *as = f->GetLastAccessStats();
+            XrdOucCacheStats::CacheStats &X = Statistics.X;
+
+            Statistics.Lock();
+            X.BytesGet  += as->BytesHit;
+            X.BytesRead += as->BytesMissed;
+            X.BytesPass += as->BytesBypassed;
+            Statistics.UnLock();
+         }
+
+         if (f->GetTier() >= 0)
+         {
+            const Info::AStat *as = f->GetLastAccessStats();
+            XrdSysMutexHelper tlock(m_tier_mutex);
+
+            TierStats &ts = m_tier_stats[f->GetTier()];
+            ts.m_NOpened++;
+            ts.m_BytesHit += as->BytesHit;
+
+            // Files read from a slower tier are candidates for promotion.
+            if (f->GetTier() > 0) m_tier_hot[f->GetLocalPath()]++;
+         }
+
          if (m_gstream)
          {
             const Info::AStat *as = f->GetLastAccessStats();
@@ -642,12 +751,13 @@ void Cache::dec_ref_cnt(File* f, bool high_debug)
             int  len = snprintf(buf, 4096, "{\"event\":\"file_close\","
                                  "\"lfn\":\"%s\",\"size\":%lld,\"blk_size\":%d,\"n_blks\":%d,\"n_blks_done\":%d,"
                                  "\"access_cnt\":%lu,\"attach_t\":%lld,\"detach_t\":%lld,\"remotes\":%s,"
-                                 "\"b_hit\":%lld,\"b_miss\":%lld,\"b_bypass\":%lld}",
+                                 "\"b_hit\":%lld,\"b_miss\":%lld,\"b_bypass\":%lld,\"read_amp\":%.3f}",
                                  f->GetLocalPath().c_str(), f->GetFileSize(), f->GetBlockSize(),
                                  f->GetNBlocks(), f->GetNDownloadedBlocks(),
                                  (unsigned long) f->GetAccessCnt(), (long long) as->AttachTime, (long long) as->DetachTime,
                                  f->GetRemoteLocations().c_str(),
-                                 as->BytesHit, as->BytesMissed, as->BytesBypassed
+                                 as->BytesHit, as->BytesMissed, as->BytesBypassed,
+                                 f->GetReadAmplification()
             );
             bool suc = false;
             if (len < 4096)
@@ -21,6 +21,7 @@
 #include <list>
 #include <map>
 #include <set>
+#include <vector>
 
 #include "Xrd/XrdScheduler.hh"
 #include "XrdVersion.hh"
@@ -32,6 +33,7 @@
 #include "XrdPfcFile.hh"
 #include "XrdPfcDecision.hh"
 
+class XrdOssVSInfo;
 class XrdOucStream;
 class XrdSysError;
 class XrdSysTrace;
@@ -43,6 +45,8 @@ class File;
 class IO;
 
 class DataFsState;
+class FPurgeState;
+class TinyLFU;
 }
 
 
@@ -61,6 +65,9 @@ struct Configuration
    bool is_uvkeep_purge_in_effect()    const { return m_cs_UVKeep >= 0; }
    bool is_dir_stat_reporting_on()     const { return m_dirStatsMaxDepth >= 0 || ! m_dirStatsDirs.empty() || ! m_dirStatsDirGlobs.empty(); }
    bool is_purge_plugin_set_up()       const { return false; }
+   bool are_tiers_set()                const { return m_tier_spaces.size() > 1; }
+   bool is_bsize_adaptive()            const { return m_bufferSizeMin > 0; }
+   bool is_std_bsize(long long bs)     const;
 
    void calculate_fractional_usages(long long du, long long fu, double &frac_du, double &frac_fu);
 
@@ -81,6 +88,7 @@ struct Configuration
    std::string m_username;              //!< username passed to oss plugin
    std::string m_data_space;            //!< oss space for data files
    std::string m_meta_space;            //!< oss space for metadata files (cinfo)
+   std::vector<std::string> m_tier_spaces; //!< oss spaces of data storage tiers, fastest first
 
    long long m_diskTotalSpace;          //!< total disk space on configured partition or oss space
    long long m_diskUsageLWM;            //!< cache purge - disk usage low water mark
@@ -93,17 +101,25 @@ struct Configuration
    int       m_purgeAgeBasedPeriod;     //!< peform cold file / uvkeep purge every this many purge cycles
    int       m_accHistorySize;          //!< max number of entries in access history part of cinfo file
 
+   double    m_tierUsageLWM;            //!< tier demotion - fraction of tier space to demote down to
+   double    m_tierUsageHWM;            //!< tier demotion - fraction of tier space that triggers demotion
+   int       m_tierDemoteAge;           //!< tier demotion - demote files not accessed for this long, 0 for off
+   int       m_tierPromoteCnt;          //!< tier promotion - opens between passes that make a file hot, 0 for off
+
    std::set<std::string> m_dirStatsDirs;     //!< directories for which stat reporting was requested
    std::set<std::string> m_dirStatsDirGlobs; //!< directory globs for which stat reporting was requested
    int       m_dirStatsMaxDepth;        //!< maximum depth for statistics write out
    int       m_dirStatsStoreDepth;      //!< depth to which statistics should be collected
 
    long long m_bufferSize;              //!< prefetch buffer size, default 1MB
+   long long m_bufferSizeMin;           //!< adaptive block size - smallest, 0 when not adaptive
+   long long m_bufferSizeMax;           //!< adaptive block size - largest
    long long m_RamAbsAvailable;         //!< available from configuration
-   int       m_RamKeepStdBlocks;        //!< number of standard-sized blocks kept after release
+   long long m_RamKeepStdBytes;         //!< bytes in standard-sized blocks kept after release
    int       m_wqueue_blocks;           //!< maximum number of blocks written per write-queue loop
    int       m_wqueue_threads;          //!< number of threads writing blocks to disk
    int       m_prefetch_max_blocks;     //!< maximum number of blocks to prefetch per file
+   int       m_admission_files;         //!< files tracked by tinylfu admission, 0 to admit all
 
    long long m_hdfsbsize;               //!< used with m_hdfsmode, default 128MB
    long long m_flushCnt;                //!< nuber of unsynced blcoks on disk before flush is called
@@ -294,10 +310,12 @@ public:
    //! \brief Makes decision if the original XrdOucCacheIO should be cached.
    //!
    //! @param & URL of file
+   //! @param admission_rejected set to true if the file was not cached
+   //!        because the admission policy rejected it
    //!
    //! @return decision if IO object will be cached.
    //--------------------------------------------------------------------
-   bool Decide(XrdOucCacheIO*);
+   bool Decide(XrdOucCacheIO*, bool *admission_rejected = 0);
 
    //------------------------------------------------------------------------
    //! Reference XrdPfc configuration
@@ -358,7 +376,8 @@ public:
    void RemoveWriteQEntriesFor(File *f);
 
    //---------------------------------------------------------------------
-   //! Separate task which writes blocks from ram to disk.
+   //! Separate task which writes blocks from ram to disk. Each pass takes
+   //! a batch of blocks of a single file, files being served in turn.
    //---------------------------------------------------------------------
    void ProcessWriteTasks();
 
@@ -375,6 +394,16 @@ public:
    XrdOss* GetOss() const { return m_oss; }
 
    bool IsFileActiveOrPurgeProtected(const std::string&);
+
+   //---------------------------------------------------------------------
+   //! Stat the space holding data files, summed over all tiers.
+   //---------------------------------------------------------------------
+   int  StatDataSpace(XrdOssVSInfo &sP);
+
+   //---------------------------------------------------------------------
+   //! Index of the storage tier holding the data file, -1 if unknown.
+   //---------------------------------------------------------------------
+   int  GetFileTier(const std::string&);
    
    File* GetFile(const std::string&, IO*, long long off = 0, long long filesize = 0);
 
@@ -404,6 +433,12 @@ private:
 
    int  UnlinkCommon(const std::string& f_name, bool fail_if_open);
 
+   int  MoveFileToTier(const std::string& f_name, int tier);
+   void BalanceTiers(FPurgeState &purgeState, bool scanned);
+
+   void ReportWriteBackStats();
+   void ReportAdmissionStats();
+
    static Cache     *m_instance;        //!< this object
 
    XrdOucEnv        *m_env;             //!< environment passed in at creation
@@ -417,6 +452,8 @@ private:
 
    std::vector<XrdPfc::Decision*> m_decisionpoints;       //!< decision plugins
 
+   TinyLFU          *m_admission;       //!< frequency based admission, when configured
+
    Configuration m_configuration;           //!< configurable parameters
 
    XrdSysCondVar m_prefetch_condVar;        //!< lock for vector of prefetching files
@@ -425,8 +462,8 @@ private:
    XrdSysMutex m_RAM_mutex;                 //!< lock for allcoation of RAM blocks
    long long   m_RAM_used;
    long long   m_RAM_write_queue;
-   std::list<char*> m_RAM_std_blocks;       //!< A list of blocks of standard size, to be reused.
-   int              m_RAM_std_size;
+   std::map<long long, std::vector<char*> > m_RAM_std_blocks; //!< Blocks of standard sizes, to be reused.
+   long long        m_RAM_std_size;         //!< Bytes held in m_RAM_std_blocks.
 
    bool        m_isClient;                  //!< True if running as client
 
@@ -434,14 +471,31 @@ private:
    {
       WriteQ() : condVar(0), writes_between_purges(0), size(0) {}
 
+      typedef std::map<File*, std::list<Block*> > FileQueues_t;
+      typedef FileQueues_t::iterator               FileQueues_i;
+
       XrdSysCondVar     condVar;      //!< write list condVar
-      std::list<Block*> queue;        //!< container
+      FileQueues_t      file_queues;  //!< blocks waiting to be written, per file
+      std::list<File*>  file_order;   //!< files with queued blocks, in order of service
       long long         writes_between_purges; //!< upper bound on amount of bytes written between two purge passes
       int               size;         //!< current size of write queue
    };
 
    WriteQ m_writeQ;
 
+   struct WriteBackStats
+   {
+      WriteBackStats() : m_NBlocks(0), m_NWrites(0), m_WaitTime(0), m_WaitMax(0) {}
+
+      long long m_NBlocks;                //!< blocks written from RAM to disk
+      long long m_NWrites;                //!< writes issued for those blocks
+      long long m_WaitTime;               //!< total time the blocks waited to be written (usec)
+      long long m_WaitMax;                //!< longest time a block waited to be written (usec)
+   };
+
+   XrdSysMutex      m_wb_stats_mutex;     //!< lock for write-back statistics
+   WriteBackStats   m_wb_stats;
+
    // active map, purge delay set
    typedef std::map<std::string, File*>               ActiveMap_t;
    typedef ActiveMap_t::iterator                      ActiveMap_i;
@@ -478,6 +532,26 @@ private:
    ScanAndPurgeThreadState_e m_spt_state;
 
    void copy_out_active_stats_and_update_data_fs_state();
+
+   //---------------------------------------------------------------------------
+   // Storage tiers
+
+   struct TierStats
+   {
+      TierStats() : m_NOpened(0), m_BytesHit(0), m_NDemoted(0), m_NPromoted(0) {}
+
+      int       m_NOpened;                //!< files closed after being read from this tier
+      long long m_BytesHit;               //!< bytes served from this tier
+      int       m_NDemoted;               //!< files moved from this tier to the next one
+      int       m_NPromoted;              //!< files moved from this tier to the first one
+   };
+
+   typedef std::map<std::string, int>  TierHotMap_t;
+   typedef TierHotMap_t::iterator      TierHotMap_i;
+
+   XrdSysMutex              m_tier_mutex; //!< lock for tier statistics and promotion candidates
+   std::vector<TierStats>   m_tier_stats;
+   TierHotMap_t             m_tier_hot;   //!< opens of files on slower tiers since the last pass
 };
 
 }
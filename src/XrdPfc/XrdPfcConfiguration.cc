@@ -1,6 +1,7 @@
 #include "XrdPfc.hh"
 #include "XrdPfcTrace.hh"
 #include "XrdPfcInfo.hh"
+#include "XrdPfcTinyLFU.hh"
 
 #include "XrdOss/XrdOss.hh"
 
@@ -34,14 +35,21 @@ Configuration::Configuration() :
    m_purgeColdFilesAge(-1),
    m_purgeAgeBasedPeriod(10),
    m_accHistorySize(20),
+   m_tierUsageLWM(0.80),
+   m_tierUsageHWM(0.90),
+   m_tierDemoteAge(0),
+   m_tierPromoteCnt(2),
    m_dirStatsMaxDepth(-1),
    m_dirStatsStoreDepth(0),
    m_bufferSize(1024*1024),
+   m_bufferSizeMin(0),
+   m_bufferSizeMax(0),
    m_RamAbsAvailable(0),
-   m_RamKeepStdBlocks(0),
+   m_RamKeepStdBytes(0),
    m_wqueue_blocks(16),
    m_wqueue_threads(4),
    m_prefetch_max_blocks(10),
+   m_admission_files(0),
    m_hdfsbsize(128*1024*1024),
    m_flushCnt(2000),
    m_cs_UVKeep(-1),
@@ -373,10 +381,17 @@ bool Cache::Config(const char *config_filename, const char *parameters)
       return false;
    }
 
+   // new files are always created on the fastest tier
+   if (m_configuration.are_tiers_set())
+   {
+      m_configuration.m_data_space = m_configuration.m_tier_spaces[0];
+      m_tier_stats.resize(m_configuration.m_tier_spaces.size());
+   }
+
    // sets default value for disk usage
    XrdOssVSInfo sP;
    {
-      if (m_oss->StatVS(&sP, m_configuration.m_data_space.c_str(), 1) < 0)
+      if (StatDataSpace(sP) < 0)
       {
          m_log.Emsg("ConfigParameters()", "error obtaining stat info for data space ", m_configuration.m_data_space.c_str());
          return false;
@@ -449,8 +464,32 @@ bool Cache::Config(const char *config_filename, const char *parameters)
       snprintf(buff, sizeof(buff), "RAM usage pfc.ram is not specified. Default value %s is used.", m_isClient ? "256m" : "1g");
       m_log.Say("Config info: ", buff);
    }
-   // Setup number of standard-size blocks not released back to the system to 5% of total RAM.
-   m_configuration.m_RamKeepStdBlocks = (m_configuration.m_RamAbsAvailable / m_configuration.m_bufferSize + 1) * 5 / 100;
+   // Setup standard-size blocks not released back to the system to 5% of total RAM.
+   m_configuration.m_RamKeepStdBytes = m_configuration.m_RamAbsAvailable * 5 / 100;
+
+   // Adaptive block sizes are powers of two; block-mode files have a fixed size.
+   if (m_configuration.is_bsize_adaptive())
+   {
+      if (m_configuration.m_hdfsmode)
+      {
+         m_log.Emsg("Config", "pfc.blocksize adaptive is not supported in hdfsmode, ignoring it.");
+         m_configuration.m_bufferSizeMin = m_configuration.m_bufferSizeMax = 0;
+      }
+      else
+      {
+         long long bs = m_configuration.m_bufferSizeMin, bsmin = 4 * 1024;
+         while (bsmin < bs) bsmin <<= 1;
+         bs = m_configuration.m_bufferSizeMax;
+         long long bsmax = bsmin;
+         while (bsmax < bs) bsmax <<= 1;
+         if (bsmin != m_configuration.m_bufferSizeMin || bsmax != m_configuration.m_bufferSizeMax)
+         {
+            m_log.Emsg("Config", "pfc.blocksize adaptive limits must be powers of two. Rounded up.");
+         }
+         m_configuration.m_bufferSizeMin = bsmin;
+         m_configuration.m_bufferSizeMax = bsmax;
+      }
+   }
    
 
    // Set tracing to debug if this is set in environment
@@ -468,15 +507,17 @@ bool Cache::Config(const char *config_filename, const char *parameters)
                            "off", "cache nonet", "nocache net tls",
 //                         111
                            "cache net tls"};
-      char buff[8192], uvk[32];
+      char buff[8192], uvk[32], bsa[96] = "";
       if (m_configuration.m_cs_UVKeep < 0)
          strcpy(uvk, "lru");
       else
          sprintf(uvk, "%ld", m_configuration.m_cs_UVKeep);
+      if (m_configuration.is_bsize_adaptive())
+         snprintf(bsa, sizeof(bsa), " adaptive min %lld max %lld", m_configuration.m_bufferSizeMin, m_configuration.m_bufferSizeMax);
       float rg = (m_configuration.m_RamAbsAvailable) / float(1024*1024*1024);
       loff = snprintf(buff, sizeof(buff), "Config effective %s pfc configuration:\n"
                       "       pfc.cschk %s uvkeep %s\n"
-                      "       pfc.blocksize %lld\n"
+                      "       pfc.blocksize %lld%s\n"
                       "       pfc.prefetch %d\n"
                       "       pfc.ram %.fg\n"
                       "       pfc.writequeue %d %d\n"
@@ -488,7 +529,7 @@ bool Cache::Config(const char *config_filename, const char *parameters)
                       "       pfc.acchistorysize %d\n",
                       config_filename,
                       csc[int(m_configuration.m_cs_Chk)], uvk,
-                      m_configuration.m_bufferSize,
+                      m_configuration.m_bufferSize, bsa,
                       m_configuration.m_prefetch_max_blocks,
                       rg,
                       m_configuration.m_wqueue_blocks, m_configuration.m_wqueue_threads,
@@ -521,6 +562,21 @@ bool Cache::Config(const char *config_filename, const char *parameters)
          loff += snprintf(buff + loff, sizeof(buff) - loff, "       pfc.hdfsmode hdfsbsize %lld\n", m_configuration.m_hdfsbsize);
       }
 
+      if (m_configuration.m_admission_files > 0)
+      {
+         loff += snprintf(buff + loff, sizeof(buff) - loff, "       pfc.admission tinylfu files %d\n", m_configuration.m_admission_files);
+      }
+
+      if (m_configuration.are_tiers_set())
+      {
+         loff += snprintf(buff + loff, sizeof(buff) - loff, "       pfc.tiers");
+         for (size_t i = 0; i < m_configuration.m_tier_spaces.size(); ++i)
+            loff += snprintf(buff + loff, sizeof(buff) - loff, " %s", m_configuration.m_tier_spaces[i].c_str());
+         loff += snprintf(buff + loff, sizeof(buff) - loff, " usage %.2f %.2f demoteage %d promote %d\n",
+                          m_configuration.m_tierUsageLWM, m_configuration.m_tierUsageHWM,
+                          m_configuration.m_tierDemoteAge, m_configuration.m_tierPromoteCnt);
+      }
+
       if (m_configuration.m_username.empty())
       {
          char unameBuff[256];
@@ -537,6 +593,8 @@ bool Cache::Config(const char *config_filename, const char *parameters)
 
    // Derived settings
    m_prefetch_enabled   = m_configuration.m_prefetch_max_blocks > 0;
+   if (m_configuration.m_admission_files > 0)
+      m_admission = new TinyLFU(m_configuration.m_admission_files);
    Info::s_maxNumAccess = m_configuration.m_accHistorySize;
 
    m_gstream = (XrdXrootdGStream*) m_env->GetPtr("pfc.gStream*");
@@ -736,6 +794,34 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          m_configuration.m_bufferSize +=  0x1000;
          m_log.Emsg("Config", "pfc.blocksize must be a multiple of 4 kB. Rounded up.");
       }
+      const char *p;
+      while ((p = cwg.GetWord()) && cwg.HasLast())
+      {
+         if (strcmp(p, "adaptive") == 0)
+         {
+            m_configuration.m_bufferSizeMin =        64 * 1024;
+            m_configuration.m_bufferSizeMax = 16 * 1024 * 1024;
+         }
+         else if (strcmp(p, "min") == 0 && m_configuration.is_bsize_adaptive())
+         {
+            if (XrdOuca2x::a2sz(m_log, "Error reading adaptive block-size minimum", cwg.GetWord(), &m_configuration.m_bufferSizeMin, minBSize, maxBSize))
+            {
+               return false;
+            }
+         }
+         else if (strcmp(p, "max") == 0 && m_configuration.is_bsize_adaptive())
+         {
+            if (XrdOuca2x::a2sz(m_log, "Error reading adaptive block-size maximum", cwg.GetWord(), &m_configuration.m_bufferSizeMax, minBSize, maxBSize))
+            {
+               return false;
+            }
+         }
+         else
+         {
+            m_log.Emsg("Config", "Error: pfc.blocksize stanza contains unknown directive", p);
+            return false;
+         }
+      }
    }
    else if ( part == "prefetch" || part == "nramprefetch" )
    {
@@ -785,6 +871,53 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          return false;
       }
    }
+   else if ( part == "tiers" )
+   {
+      m_configuration.m_tier_spaces.clear();
+
+      const char *p = 0;
+      while ((p = cwg.GetWord()) && cwg.HasLast())
+      {
+         if (strcmp(p, "usage") == 0)
+         {
+            const char *lwm = cwg.GetWord();
+            const char *hwm = cwg.GetWord();
+            char       *lend = 0, *hend = 0;
+            double      lw = lwm ? strtod(lwm, &lend) : -1;
+            double      hw = hwm ? strtod(hwm, &hend) : -1;
+            if ( ! lwm || ! hwm || *lend || *hend || lw <= 0 || lw >= hw || hw > 1)
+            {
+               m_log.Emsg("Config", "Error: pfc.tiers usage requires two fractions, 0 < low < high <= 1.");
+               return false;
+            }
+            m_configuration.m_tierUsageLWM = lw;
+            m_configuration.m_tierUsageHWM = hw;
+         }
+         else if (strcmp(p, "demoteage") == 0)
+         {
+            if (XrdOuca2x::a2tm(m_log, "Error getting pfc.tiers demoteage", cwg.GetWord(), &m_configuration.m_tierDemoteAge, 0, 3600*24*360))
+            {
+               return false;
+            }
+         }
+         else if (strcmp(p, "promote") == 0)
+         {
+            if (XrdOuca2x::a2i(m_log, "Error getting pfc.tiers promote", cwg.GetWord(), &m_configuration.m_tierPromoteCnt, 0, 1000))
+            {
+               return false;
+            }
+         }
+         else
+         {
+            m_configuration.m_tier_spaces.push_back(p);
+         }
+      }
+      if (m_configuration.m_tier_spaces.size() < 2 || m_configuration.m_tier_spaces.size() > 8)
+      {
+         m_log.Emsg("Config", "Error: pfc.tiers requires between two and eight oss spaces, fastest first.");
+         return false;
+      }
+   }
    else if ( part == "hdfsmode" || part == "filefragmentmode" )
    {
       if (part == "filefragmentmode")
@@ -812,6 +945,43 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          }
       }
    }
+   else if ( part == "admission" )
+   {
+      const char *p = cwg.GetWord();
+      if ( ! cwg.HasLast())
+      {
+         m_log.Emsg("Config", "Error: pfc.admission requires a parameter.");
+         return false;
+      }
+      if (strcmp(p, "all") == 0)
+      {
+         m_configuration.m_admission_files = 0;
+      }
+      else if (strcmp(p, "tinylfu") == 0)
+      {
+         m_configuration.m_admission_files = 1000000;
+         while ((p = cwg.GetWord()) && cwg.HasLast())
+         {
+            if (strcmp(p, "files") == 0)
+            {
+               if (XrdOuca2x::a2i(m_log, "Error getting pfc.admission files", cwg.GetWord(), &m_configuration.m_admission_files, 1000, 1 << 28))
+               {
+                  return false;
+               }
+            }
+            else
+            {
+               m_log.Emsg("Config", "Error: pfc.admission tinylfu stanza contains unknown directive", p);
+               return false;
+            }
+         }
+      }
+      else
+      {
+         m_log.Emsg("Config", "Error: unknown pfc.admission policy", p);
+         return false;
+      }
+   }
    else if ( part == "flush" )
    {
       tmpc.m_flushRaw = cwg.GetWord();
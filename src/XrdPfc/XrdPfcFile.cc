@@ -24,6 +24,7 @@
 #include <sstream>
 #include <fcntl.h>
 #include <assert.h>
+#include <algorithm>
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClFile.hh"
@@ -60,6 +61,11 @@ File::File(const std::string& path, long long iOffset, long long iFileSize) :
    m_filename(path),
    m_offset(iOffset),
    m_file_size(iFileSize),
+   m_tier(-1),
+   m_bsize_pending(false),
+   m_bsize_reads(0),
+   m_bsize_seq_end(0),
+   m_bsize_max_req(0),
    m_current_io(m_io_map.end()),
    m_ios_in_detach(0),
    m_non_flushed_cnt(0),
@@ -315,7 +321,7 @@ void File::AddIO(IO *io)
 
       insert_remote_location(loc);
 
-      if (m_prefetch_state == kStopped)
+      if (m_prefetch_state == kStopped && ! m_bsize_pending)
       {
          m_prefetch_state = kOn;
          cache()->RegisterPrefetchFile(this);
@@ -420,6 +426,11 @@ bool File::Open()
       return false;
    }
 
+   if (conf.are_tiers_set())
+   {
+      m_tier = Cache::GetInstance().GetFileTier(m_filename);
+   }
+
    myEnv.Put("oss.asize", "64k"); // TODO: Calculate? Get it from configuration? Do not know length of access lists ...
    myEnv.Put("oss.cgroup", conf.m_meta_space.c_str());
    if ((res = myOss.Create(myUser, ifn.c_str(), 0600, myEnv, XRDOSS_mkpath)) != XrdOssOK)
@@ -482,6 +493,11 @@ bool File::Open()
       m_cfi.Write(m_info_file, ifn.c_str());
       m_info_file->Fsync();
       TRACEF(Debug, tpfx << "Creating new file info, data size = " <<  m_file_size << " num blocks = "  << m_cfi.GetNBlocks());
+
+      // With adaptive block size the one above is provisional. The block size
+      // is chosen from the first reads, before any block is requested, and
+      // gets into the info file with the next sync.
+      m_bsize_pending = conf.is_bsize_adaptive();
    }
 
    m_cfi.WriteIOStatAttach();
@@ -682,15 +698,10 @@ int File::ReadBlocksFromDisk(std::list<int>& blocks,
 
 int File::Read(IO *io, char* iUserBuff, long long iUserOff, int iUserSize)
 {
-   const long long BS = m_cfi.GetBufferSize();
-
    Stats loc_stats;
 
    BlockList_t blks;
 
-   const int idx_first = iUserOff / BS;
-   const int idx_last  = (iUserOff + iUserSize - 1) / BS;
-
    BlockSet_t  requested_blocks;
    BlockList_t blks_to_request, blks_to_process, blks_processed;
    IntList_t   blks_on_disk,    blks_direct;
@@ -718,6 +729,25 @@ int File::Read(IO *io, char* iUserBuff, long long iUserOff, int iUserSize)
       return -ENOENT;
    }
 
+   if (m_bsize_pending && ! choose_block_size(io, iUserOff, iUserSize))
+   {
+      m_state_cond.UnLock();
+
+      // Access pattern not clear yet, read directly without caching.
+      int rc = io->GetInput()->Read(iUserBuff, iUserOff, iUserSize);
+      if (rc > 0)
+      {
+         loc_stats.m_BytesBypassed += rc;
+         m_stats.AddReadStats(loc_stats);
+      }
+      return rc;
+   }
+
+   const long long BS = m_cfi.GetBufferSize();
+
+   const int idx_first = iUserOff / BS;
+   const int idx_last  = (iUserOff + iUserSize - 1) / BS;
+
    for (int block_idx = idx_first; block_idx <= idx_last; ++block_idx)
    {
       TRACEF(Dump, "Read() idx " << block_idx);
@@ -942,85 +972,149 @@ int File::Read(IO *io, char* iUserBuff, long long iUserOff, int iUserSize)
 
 //------------------------------------------------------------------------------
 
-void File::WriteBlockToDisk(Block* b)
+namespace
+{
+   bool BlockOffsetLess(const Block *a, const Block *b)
+   {
+      return a->m_offset < b->m_offset;
+   }
+}
+
+int File::WriteBlocksToDisk(std::vector<Block*> &blocks)
 {
-   // write block buffer into disk file
-   long long   offset = b->m_offset - m_offset;
-   long long   size   = b->get_size();
-   ssize_t     retval;
+   const int         n_blks = blocks.size();
+   std::vector<bool> written(n_blks, false);
+   int               n_writes = 0;
 
-   if (m_cfi.IsCkSumCache())
-      if (b->has_cksums())
-         retval = m_data_file->pgWrite(b->get_buff(), offset, size, b->ref_cksum_vec().data(), 0);
-      else
-         retval = m_data_file->pgWrite(b->get_buff(), offset, size, 0, 0);
-   else
-      retval = m_data_file->Write(b->get_buff(), offset, size);
+   // Order the blocks so that the ones adjacent in the file follow each other.
+   std::sort(blocks.begin(), blocks.end(), BlockOffsetLess);
 
-   if (retval < size)
+   if (m_cfi.IsCkSumCache())
    {
-      if (retval < 0)
+      // Page writes carry their checksums and cannot be merged.
+      for (int i = 0; i < n_blks; ++i)
       {
-         GetLog()->Emsg("WriteToDisk()", -retval, "write block to disk", GetLocalPath().c_str());
+         Block     *b      = blocks[i];
+         long long  offset = b->m_offset - m_offset;
+         long long  size   = b->get_size();
+         ssize_t    retval;
+
+         if (b->has_cksums())
+            retval = m_data_file->pgWrite(b->get_buff(), offset, size, b->ref_cksum_vec().data(), 0);
+         else
+            retval = m_data_file->pgWrite(b->get_buff(), offset, size, 0, 0);
+         ++n_writes;
+
+         if (retval < size)
+         {
+            if (retval < 0)
+               GetLog()->Emsg("WriteToDisk()", -retval, "write block to disk", GetLocalPath().c_str());
+            else
+               TRACEF(Error, "WriteToDisk() incomplete block write ret=" << retval << " (should be " << size << ")");
+            continue;
+         }
+         written[i] = true;
       }
-      else
+   }
+   else
+   {
+      // Each run of adjacent blocks is written with a single vectored write.
+      std::vector<XrdOucIOVec> iov(n_blks);
+      int i = 0;
+      while (i < n_blks)
       {
-         TRACEF(Error, "WriteToDisk() incomplete block write ret=" << retval << " (should be " << size << ")");
+         long long run_size = 0;
+         int       k        = i;
+         do
+         {
+            Block *b = blocks[k];
+            iov[k].offset = b->m_offset - m_offset;
+            iov[k].size   = b->get_size();
+            iov[k].info   = 0;
+            iov[k].data   = b->get_buff();
+            run_size += b->get_size();
+            ++k;
+         } while (k < n_blks && blocks[k]->m_offset == blocks[k-1]->m_offset + blocks[k-1]->get_size());
+
+         ssize_t retval = m_data_file->WriteV(&iov[i], k - i);
+         ++n_writes;
+
+         if (retval < run_size)
+         {
+            if (retval < 0)
+               GetLog()->Emsg("WriteToDisk()", -retval, "write blocks to disk", GetLocalPath().c_str());
+            else
+               TRACEF(Error, "WriteToDisk() incomplete write of " << k - i << " blocks ret=" << retval << " (should be " << run_size << ")");
+         }
+         else
+         {
+            while (i < k) written[i++] = true;
+         }
+         i = k;
       }
-
-      XrdSysCondVarHelper _lck(m_state_cond);
-
-      dec_ref_count(b);
-
-      return;
    }
 
-   const int blk_idx =  (b->m_offset - m_offset) / m_cfi.GetBufferSize();
-
-   // Set written bit.
-   TRACEF(Dump, "WriteToDisk() success set bit for block " <<  b->m_offset << " size=" <<  size);
+   // Set written bits for the whole batch.
+   TRACEF(Dump, "WriteToDisk() " << n_blks << " blocks in " << n_writes << " writes");
 
    bool schedule_sync = false;
    {
       XrdSysCondVarHelper _lck(m_state_cond);
 
-      m_cfi.SetBitWritten(blk_idx);
-
-      if (b->m_prefetch)
+      for (int i = 0; i < n_blks; ++i)
       {
-         m_cfi.SetBitPrefetch(blk_idx);
-      }
-      if (b->req_cksum_net() && ! b->has_cksums() && m_cfi.IsCkSumNet())
-      {
-         m_cfi.ResetCkSumNet();
-      }
+         Block *b = blocks[i];
 
-      dec_ref_count(b);
+         if ( ! written[i])
+         {
+            dec_ref_count(b);
+            continue;
+         }
 
-      // Set synced bit or stash block index if in actual sync.
-      // Synced state is only written out to cinfo file when data file is synced.
-      if (m_in_sync)
-      {
-         m_writes_during_sync.push_back(blk_idx);
-      }
-      else
-      {
-         m_cfi.SetBitSynced(blk_idx);
-         ++m_non_flushed_cnt;
-         if (m_non_flushed_cnt >= Cache::GetInstance().RefConfiguration().m_flushCnt &&
-             ! m_in_shutdown)
+         const int blk_idx =  (b->m_offset - m_offset) / m_cfi.GetBufferSize();
+
+         m_cfi.SetBitWritten(blk_idx);
+
+         if (b->m_prefetch)
+         {
+            m_cfi.SetBitPrefetch(blk_idx);
+         }
+         if (b->req_cksum_net() && ! b->has_cksums() && m_cfi.IsCkSumNet())
+         {
+            m_cfi.ResetCkSumNet();
+         }
+
+         dec_ref_count(b);
+
+         // Set synced bit or stash block index if in actual sync.
+         // Synced state is only written out to cinfo file when data file is synced.
+         if (m_in_sync)
+         {
+            m_writes_during_sync.push_back(blk_idx);
+         }
+         else
          {
-            schedule_sync     = true;
-            m_in_sync         = true;
-            m_non_flushed_cnt = 0;
+            m_cfi.SetBitSynced(blk_idx);
+            ++m_non_flushed_cnt;
          }
       }
+
+      if ( ! m_in_sync &&
+           m_non_flushed_cnt >= Cache::GetInstance().RefConfiguration().m_flushCnt &&
+           ! m_in_shutdown)
+      {
+         schedule_sync     = true;
+         m_in_sync         = true;
+         m_non_flushed_cnt = 0;
+      }
    }
 
    if (schedule_sync)
    {
       cache()->ScheduleFileSync(this);
    }
+
+   return n_writes;
 }
 
 //------------------------------------------------------------------------------
@@ -1344,6 +1438,104 @@ void File::Prefetch()
 }
 
 
+//------------------------------------------------------------------------------
+
+bool File::choose_block_size(IO *io, long long req_off, long long req_size)
+{
+   // Called under m_state_cond lock for the first reads of a newly created
+   // file, before any block has been requested. Returns false while the
+   // access pattern is not clear yet; such reads go directly to the remote.
+   //
+   // A pfc.blocksize opaque hint given at open time is taken as is. A few
+   // reads progressing from the start of the file, possibly somewhat out of
+   // order as clients keep several requests in flight, look like a copy and
+   // get the largest block size. A read jumping ahead, or any vector read
+   // (these come with req_off = -1 and the average chunk size), means sparse
+   // access and the largest read seen so far is rounded up.
+
+   static const std::string tag = "pfc.blocksize=";
+   static const int max_reads = 4;
+
+   const Configuration &conf = cache()->RefConfiguration();
+
+   const char *from = "hint";
+   long long   bs   = 0;
+
+   if (m_bsize_reads++ == 0)
+   {
+      std::string path = io->GetInput()->Path();
+      size_t      pos  = path.find('?');
+      if (pos != path.npos && (pos = path.find(tag, pos)) != path.npos)
+      {
+         char *eP;
+         bs = strtoll(path.c_str() + pos + tag.length(), &eP, 10);
+         switch (*eP)
+         {
+            case 'k': bs <<= 10; break;
+            case 'm': bs <<= 20; break;
+            case 'g': bs <<= 30; break;
+         }
+      }
+   }
+   if (bs <= 0)
+   {
+      m_bsize_max_req = std::max(m_bsize_max_req, req_size);
+
+      if (req_off < 0 || req_off > m_bsize_seq_end + max_reads * m_bsize_max_req)
+      {
+         from = "sparse reads";
+         bs   = m_bsize_max_req;
+      }
+      else if (m_bsize_reads >= max_reads)
+      {
+         from = "sequential reads";
+         bs   = conf.m_bufferSizeMax;
+      }
+      else
+      {
+         m_bsize_seq_end = std::max(m_bsize_seq_end, req_off + req_size);
+         return false;
+      }
+   }
+
+   m_bsize_pending = false;
+
+   // Round up to a power of two within the limits. Blocks much larger than
+   // the file only waste RAM and a bitmap of more than a million blocks makes
+   // every sync of the info file expensive.
+   long long abs = conf.m_bufferSizeMin;
+   while (abs < bs && abs < conf.m_bufferSizeMax) abs <<= 1;
+   while (abs > conf.m_bufferSizeMin && (abs >> 1) >= m_file_size) abs >>= 1;
+   while (abs < conf.m_bufferSizeMax && m_file_size / abs > 1024 * 1024) abs <<= 1;
+
+   // While the info file is being written out the provisional size stays.
+   if (abs != m_cfi.GetBufferSize() && ! m_in_sync)
+   {
+      m_cfi.SetBufferSize(abs);
+      m_cfi.SetFileSize(m_file_size);
+   }
+   TRACEF(Debug, "choose_block_size() block size " << abs << " from " << from << ", num blocks = " << m_cfi.GetNBlocks());
+
+   // Prefetching was held back in AddIO() until now.
+   if (m_prefetch_state == kStopped && ! m_io_map.empty())
+   {
+      m_prefetch_state = kOn;
+      cache()->RegisterPrefetchFile(this);
+   }
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+double File::GetReadAmplification()
+{
+   Stats s = m_stats.Clone();
+
+   long long requested = s.m_BytesHit + s.m_BytesMissed + s.m_BytesBypassed;
+
+   return requested > 0 ? double(s.m_BytesWritten + s.m_BytesBypassed) / requested : 0;
+}
+
 //------------------------------------------------------------------------------
 
 float File::GetPrefetchScore() const
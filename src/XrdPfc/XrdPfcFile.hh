@@ -68,6 +68,7 @@ public:
    int                 m_size;
    int                 m_refcnt;
    int                 m_errno;         // stores negative errno
+   long long           m_wq_time;       // when queued for writing (usec, monotonic)
    bool                m_downloaded;
    bool                m_prefetch;
    bool                m_req_cksum_net;
@@ -75,7 +76,7 @@ public:
 
    Block(File *f, IO *io, char *buf, long long off, int size, bool m_prefetch, bool cks_net) :
       m_file(f), m_io(io), m_buff(buf), m_offset(off), m_size(size),
-      m_refcnt(0), m_errno(0), m_downloaded(false), m_prefetch(m_prefetch),
+      m_refcnt(0), m_errno(0), m_wq_time(0), m_downloaded(false), m_prefetch(m_prefetch),
       m_req_cksum_net(cks_net)
    {}
 
@@ -203,7 +204,15 @@ public:
 
 
    void ProcessBlockResponse(BlockResponseHandler* brh, int res);
-   void WriteBlockToDisk(Block* b);
+
+   //----------------------------------------------------------------------
+   //! Write a batch of blocks taken off the write queue to disk. Blocks
+   //! adjacent in the file are merged into a single vectored write and the
+   //! state of all of them is updated under one lock.
+   //!
+   //! @return number of writes issued
+   //----------------------------------------------------------------------
+   int  WriteBlocksToDisk(std::vector<Block*> &blocks);
 
    void Prefetch();
 
@@ -226,12 +235,19 @@ public:
 
    Stats DeltaStatsFromLastCall();
 
+   //----------------------------------------------------------------------
+   //! Bytes fetched from the remote per byte read by the clients, for all
+   //! accesses through this object; zero if nothing was read yet.
+   //----------------------------------------------------------------------
+   double GetReadAmplification();
+
    std::string        GetRemoteLocations()   const;
    const Info::AStat* GetLastAccessStats()   const { return m_cfi.GetLastAccessStats(); }
    size_t             GetAccessCnt()         const { return m_cfi.GetAccessCnt(); }
    int                GetBlockSize()         const { return m_cfi.GetBufferSize(); }
    int                GetNBlocks()           const { return m_cfi.GetNBlocks(); }
    int                GetNDownloadedBlocks() const { return m_cfi.GetNDownloadedBlocks(); }
+   int                GetTier()              const { return m_tier; }
 
    // These three methods are called under Cache's m_active lock
    int get_ref_cnt() { return   m_ref_cnt; }
@@ -256,6 +272,11 @@ private:
    std::string    m_filename;           //!< filename of data file on disk
    long long      m_offset;             //!< offset of cached file for block-based / hdfs operation
    long long      m_file_size;           //!< size of cached disk file for block-based operation
+   int            m_tier;               //!< storage tier holding the data file, -1 if not tiered
+   bool           m_bsize_pending;      //!< adaptive block size still to be chosen
+   int            m_bsize_reads;        //!< reads seen while choosing the block size
+   long long      m_bsize_seq_end;      //!< furthest end of reads seen while choosing the block size
+   long long      m_bsize_max_req;      //!< largest read seen while choosing the block size
 
    // IO objects attached to this file.
 
@@ -363,6 +384,8 @@ private:
 
    bool select_current_io_or_disable_prefetching(bool skip_current);
 
+   bool choose_block_size(IO *io, long long req_off, long long req_size);
+
    int  offsetIdx(int idx);
 };
 
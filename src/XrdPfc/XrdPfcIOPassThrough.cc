@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by the XRootD contributors
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include "XrdPfcIOPassThrough.hh"
+#include "XrdPfcTrace.hh"
+
+#include "XrdOuc/XrdOucCacheStats.hh"
+
+using namespace XrdPfc;
+
+namespace XrdPfc
+{
+//----------------------------------------------------------------------------
+//! Completion of an asynchronous read: counts the bytes read and passes the
+//! result on to the caller's callback.
+//----------------------------------------------------------------------------
+class PassThroughCB : public XrdOucCacheIOCB
+{
+public:
+   PassThroughCB(IOPassThrough *io, XrdOucCacheIOCB &iocb) :
+      m_io(io), m_iocb(iocb)
+   {}
+
+   void Done(int result)
+   {
+      m_io->EndRead(result, true);
+      m_iocb.Done(result);
+      delete this;
+   }
+
+private:
+   IOPassThrough   *m_io;
+   XrdOucCacheIOCB &m_iocb;
+};
+}
+
+//==============================================================================
+
+IOPassThrough::IOPassThrough(XrdOucCacheIO *io, Cache &cache) :
+   IO(io, cache),
+   m_bytes_read(0),
+   m_n_active(0)
+{
+   m_traceID = "IOPassThrough";
+}
+
+//______________________________________________________________________________
+XrdOucCacheIOCB *IOPassThrough::StartRead(XrdOucCacheIOCB &iocb)
+{
+   XrdSysMutexHelper lock(&m_mutex);
+   ++m_n_active;
+   return new PassThroughCB(this, iocb);
+}
+
+void IOPassThrough::EndRead(int result, bool async)
+{
+   XrdSysMutexHelper lock(&m_mutex);
+   if (result > 0) m_bytes_read += result;
+   if (async) --m_n_active;
+}
+
+//______________________________________________________________________________
+int IOPassThrough::Read(char *buff, long long off, int size)
+{
+   int retval = GetInput()->Read(buff, off, size);
+   EndRead(retval, false);
+   return retval;
+}
+
+void IOPassThrough::Read(XrdOucCacheIOCB &iocb, char *buff, long long off, int size)
+{
+   GetInput()->Read(*StartRead(iocb), buff, off, size);
+}
+
+//______________________________________________________________________________
+int IOPassThrough::ReadV(const XrdOucIOVec *readV, int n)
+{
+   int retval = GetInput()->ReadV(readV, n);
+   EndRead(retval, false);
+   return retval;
+}
+
+void IOPassThrough::ReadV(XrdOucCacheIOCB &iocb, const XrdOucIOVec *readV, int n)
+{
+   GetInput()->ReadV(*StartRead(iocb), readV, n);
+}
+
+//______________________________________________________________________________
+int IOPassThrough::pgRead(char *buff, long long off, int size,
+                          std::vector<uint32_t> &csvec, uint64_t opts)
+{
+   int retval = GetInput()->pgRead(buff, off, size, csvec, opts);
+   EndRead(retval, false);
+   return retval;
+}
+
+void IOPassThrough::pgRead(XrdOucCacheIOCB &iocb, char *buff, long long off, int size,
+                           std::vector<uint32_t> &csvec, uint64_t opts)
+{
+   GetInput()->pgRead(*StartRead(iocb), buff, off, size, csvec, opts);
+}
+
+//______________________________________________________________________________
+bool IOPassThrough::ioActive()
+{
+   XrdSysMutexHelper lock(&m_mutex);
+   return m_n_active > 0;
+}
+
+void IOPassThrough::DetachFinalize()
+{
+   // Effectively a destructor.
+
+   TRACEIO(Debug, "DetachFinalize() " << this << " bytes read " << m_bytes_read);
+
+   XrdOucCacheStats &S = m_cache.Statistics;
+
+   S.Lock();
+   S.X.BytesPass += m_bytes_read;
+   S.UnLock();
+
+   delete this;
+}
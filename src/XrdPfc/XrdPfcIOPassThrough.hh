@@ -0,0 +1,90 @@
+#ifndef __XRDPFC_IO_PASS_THROUGH_HH__
+#define __XRDPFC_IO_PASS_THROUGH_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by the XRootD contributors
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdPfcIO.hh"
+
+class XrdOucIOVec;
+
+namespace XrdPfc
+{
+//----------------------------------------------------------------------------
+//! \brief Reads a file that was not admitted into the cache directly from
+//! the original data source. Counts the bytes read so that they are
+//! reported as bypassing the cache when the file is detached.
+//----------------------------------------------------------------------------
+class IOPassThrough : public IO
+{
+   friend class PassThroughCB;
+
+public:
+   IOPassThrough(XrdOucCacheIO *io, Cache &cache);
+
+   virtual const char *Location(bool refresh=false) { return GetInput()->Location(refresh); }
+
+   virtual int       Fstat(struct stat &sbuff) { return GetInput()->Fstat(sbuff); }
+
+   virtual long long FSize() { return GetInput()->FSize(); }
+
+   using XrdOucCacheIO::Read;
+
+   virtual int  Read(char *buff, long long off, int size);
+
+   virtual void Read(XrdOucCacheIOCB &iocb, char *buff, long long off, int size);
+
+   using XrdOucCacheIO::ReadV;
+
+   virtual int  ReadV(const XrdOucIOVec *readV, int n);
+
+   virtual void ReadV(XrdOucCacheIOCB &iocb, const XrdOucIOVec *readV, int n);
+
+   using XrdOucCacheIO::pgRead;
+
+   virtual int  pgRead(char *buff, long long off, int size,
+                       std::vector<uint32_t> &csvec, uint64_t opts=0);
+
+   virtual void pgRead(XrdOucCacheIOCB &iocb, char *buff, long long off, int size,
+                       std::vector<uint32_t> &csvec, uint64_t opts=0);
+
+   virtual int  Sync() { return GetInput()->Sync(); }
+
+   virtual int  Trunc(long long Offset) { return GetInput()->Trunc(Offset); }
+
+   virtual int  Write(char *Buffer, long long Offset, int Length)
+   { return GetInput()->Write(Buffer, Offset, Length); }
+
+   //! \brief Abstract virtual method of XrdPfcIO
+   //! Asynchronous reads may still be in progress on the original source.
+   bool ioActive() /* override */;
+
+   //! \brief Abstract virtual method of XrdPfcIO
+   //! Adds the bytes read to the cache statistics and deletes this object.
+   void DetachFinalize() /* override */;
+
+private:
+   XrdOucCacheIOCB *StartRead(XrdOucCacheIOCB &iocb);
+   void             EndRead(int result, bool async);
+
+   XrdSysMutex  m_mutex;
+   long long    m_bytes_read;   //!< bytes read from the original source
+   int          m_n_active;     //!< asynchronous reads in progress
+};
+
+}
+#endif
@@ -160,7 +160,8 @@ void Info::SetAllBitsSynced()
 
 void Info::SetBufferSize(long long bs)
 {
-   // Needed only info is created first time in File::Open()
+   // Needed only when info is created in File::Open() or, with adaptive
+   // block size, on the first read of the file
    m_store.m_buffer_size = bs;
 }
 
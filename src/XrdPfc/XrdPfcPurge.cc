@@ -1,12 +1,16 @@
 #include "XrdPfc.hh"
 #include "XrdPfcTrace.hh"
+#include "XrdPfcTinyLFU.hh"
 
 #include <fcntl.h>
 #include <sys/time.h>
+#include <algorithm>
 
 #include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOss/XrdOss.hh"
 #include "XrdOss/XrdOssAt.hh"
 #include "XrdSys/XrdSysTrace.hh"
+#include "XrdXrootd/XrdXrootdGStream.hh"
 
 using namespace XrdPfc;
 
@@ -228,9 +232,10 @@ public:
       long long   nBytes;
       time_t      time;
       DirState   *dirState;
+      int         tier;
 
-      FS(const std::string &dname, const char *fname, long long n, time_t t, DirState *ds) :
-         path(dname + fname), nBytes(n), time(t), dirState(ds)
+      FS(const std::string &dname, const char *fname, long long n, time_t t, DirState *ds, int tr = -1) :
+         path(dname + fname), nBytes(n), time(t), dirState(ds), tier(tr)
       {}
    };
 
@@ -244,6 +249,9 @@ public:
 
    list_t  m_flist; // list of files to be removed unconditionally
 
+   map_t   m_tmap;  // map of files on all but the slowest tier, demotion candidates
+   bool    m_collect_tiers;
+
    long long nBytesReq;
    long long nBytesAccum;
    long long nBytesTotal;
@@ -332,6 +340,7 @@ public:
    // ------------------------------------------------------------------------
 
    FPurgeState(long long iNBytesReq, XrdOss &oss) :
+      m_collect_tiers(false),
       nBytesReq(iNBytesReq), nBytesAccum(0), nBytesTotal(0), tMinTimeStamp(0), tMinUVKeepTimeStamp(0),
       // m_oss(oss),
       m_oss_at(oss),
@@ -352,6 +361,7 @@ public:
    time_t    getMinTime()          const { return tMinTimeStamp; }
    void      setUVKeepMinTime(time_t min_time) { tMinUVKeepTimeStamp = min_time; }
    long long getNBytesTotal()      const { return nBytesTotal; }
+   void      setCollectTiers(bool ct)    { m_collect_tiers = ct; }
 
    void MoveListEntriesToMap()
    {
@@ -406,6 +416,17 @@ public:
 
       m_dir_usage_stack.back() += nbytes;
 
+      if (m_collect_tiers)
+      {
+         std::string dataPath = m_current_path + std::string(fname, strlen(fname) - m_info_ext_len);
+         int         tier     = Cache::GetInstance().GetFileTier(dataPath);
+
+         if (tier >= 0 && tier < (int) Cache::Conf().m_tier_spaces.size() - 1)
+         {
+            m_tmap.insert(std::make_pair(atime, FS(m_current_path, fname, nbytes, atime, m_dir_state, tier)));
+         }
+      }
+
       // XXXX Should remove aged-out files here ... but I have trouble getting
       // the DirState and purge report set up consistently.
       // Need some serious code reorganization here.
@@ -682,6 +703,298 @@ void Cache::ResourceMonitorHeartBeat()
    }
 }
 
+//==============================================================================
+// Storage tiers
+//==============================================================================
+
+int Cache::StatDataSpace(XrdOssVSInfo &sP)
+{
+   if ( ! m_configuration.are_tiers_set())
+   {
+      return m_oss->StatVS(&sP, m_configuration.m_data_space.c_str(), 1);
+   }
+
+   // Tiers are expected to be on separate partitions, their sizes add up.
+   sP.Total = sP.Free = sP.Large = sP.LFree = sP.Usage = 0;
+   sP.Extents = 0;
+   for (size_t i = 0; i < m_configuration.m_tier_spaces.size(); ++i)
+   {
+      XrdOssVSInfo tP;
+      int rc = m_oss->StatVS(&tP, m_configuration.m_tier_spaces[i].c_str(), 1);
+      if (rc < 0) return rc;
+
+      sP.Total   += tP.Total;
+      sP.Free    += tP.Free;
+      sP.Usage   += tP.Usage;
+      sP.Extents += tP.Extents;
+      sP.Large    = std::max(sP.Large, tP.Large);
+      sP.LFree    = std::max(sP.LFree, tP.LFree);
+   }
+   return XrdOssOK;
+}
+
+int Cache::GetFileTier(const std::string &path)
+{
+   char buff[2048];
+   int  blen = sizeof(buff);
+
+   if (m_oss->StatXA(path.c_str(), buff, blen) != XrdOssOK) return -1;
+
+   XrdOucEnv   env(buff, blen);
+   const char *cgroup = env.Get("oss.cgroup");
+   if ( ! cgroup) return -1;
+
+   for (size_t i = 0; i < m_configuration.m_tier_spaces.size(); ++i)
+   {
+      if (m_configuration.m_tier_spaces[i] == cgroup) return i;
+   }
+   return -1;
+}
+
+int Cache::MoveFileToTier(const std::string &f_name, int tier)
+{
+   // Only files that are not open can be moved as the relocation replaces
+   // the data file. A null File* in m_active makes opens wait until done,
+   // as for unlink.
+
+   ActiveMap_i it;
+   {
+      XrdSysCondVarHelper lock(&m_active_cond);
+
+      if (m_active.find(f_name)          != m_active.end() ||
+          m_purge_delay_set.find(f_name) != m_purge_delay_set.end())
+      {
+         return -EBUSY;
+      }
+      it = m_active.insert(std::make_pair(f_name, (File*) 0)).first;
+   }
+
+   int rc = m_oss->Reloc(m_traceID, f_name.c_str(),
+                         m_configuration.m_tier_spaces[tier].c_str());
+
+   {
+      XrdSysCondVarHelper lock(&m_active_cond);
+
+      m_active.erase(it);
+      m_active_cond.Broadcast();
+   }
+
+   return rc;
+}
+
+void Cache::BalanceTiers(FPurgeState &purgeState, bool scanned)
+{
+   static const char *trc_pfx = "BalanceTiers() ";
+
+   const int    n_tiers      = m_configuration.m_tier_spaces.size();
+   const size_t info_ext_len = strlen(Info::s_infoExtension);
+   const double lwm          = m_configuration.m_tierUsageLWM;
+   const double hwm          = m_configuration.m_tierUsageHWM;
+
+   std::vector<long long> total(n_tiers, 0), used(n_tiers, 0);
+   std::vector<int>       demoted(n_tiers, 0), promoted(n_tiers, 0);
+
+   for (int t = 0; t < n_tiers; ++t)
+   {
+      XrdOssVSInfo tP;
+      if (m_oss->StatVS(&tP, m_configuration.m_tier_spaces[t].c_str(), 1) >= 0)
+      {
+         total[t] = tP.Total;
+         used[t]  = tP.Total - tP.Free;
+      }
+   }
+
+   // Demote the coldest files one tier down. Slower tiers go first so that
+   // space below is freed before files from above arrive.
+   if (scanned)
+   {
+      time_t min_time = m_configuration.m_tierDemoteAge > 0 ? time(0) - m_configuration.m_tierDemoteAge : 0;
+
+      for (int t = n_tiers - 2; t >= 0; --t)
+      {
+         long long bytesToMove = used[t] > hwm * total[t] ? used[t] - (long long) (lwm * total[t]) : 0;
+
+         for (FPurgeState::map_i it = purgeState.m_tmap.begin(); it != purgeState.m_tmap.end(); ++it)
+         {
+            if (bytesToMove <= 0 && it->first >= min_time)
+            {
+               break;
+            }
+            if (it->second.tier != t)
+            {
+               continue;
+            }
+
+            std::string &infoPath = it->second.path;
+            std::string  dataPath = infoPath.substr(0, infoPath.size() - info_ext_len);
+
+            int rc = MoveFileToTier(dataPath, t + 1);
+            if (rc == 0)
+            {
+               bytesToMove -= it->second.nBytes;
+               used[t]     -= it->second.nBytes;
+               used[t + 1] += it->second.nBytes;
+               ++demoted[t];
+               TRACE(Dump, trc_pfx << "Demoted file: '" << dataPath << "' to tier " << t + 1 << ", time: " << it->first);
+            }
+            else
+            {
+               TRACE(Debug, trc_pfx << "Could not demote file: '" << dataPath << "' " << ERRNO_AND_ERRSTR(-rc));
+            }
+         }
+      }
+   }
+
+   // Promote files that were opened often enough since the last pass back to
+   // the first tier, hottest first, as long as it stays below its low-watermark.
+   TierHotMap_t hot;
+   {
+      XrdSysMutexHelper lock(m_tier_mutex);
+      hot.swap(m_tier_hot);
+   }
+
+   if (m_configuration.m_tierPromoteCnt > 0)
+   {
+      std::multimap<int, std::string> by_count;
+      for (TierHotMap_i i = hot.begin(); i != hot.end(); ++i)
+      {
+         if (i->second >= m_configuration.m_tierPromoteCnt)
+            by_count.insert(std::make_pair(i->second, i->first));
+      }
+
+      for (std::multimap<int, std::string>::reverse_iterator i = by_count.rbegin(); i != by_count.rend(); ++i)
+      {
+         const std::string &dataPath = i->second;
+         struct stat        fstat;
+
+         int tier = GetFileTier(dataPath);
+         if (tier <= 0 || m_oss->Stat(dataPath.c_str(), &fstat) != XrdOssOK)
+         {
+            continue;
+         }
+         if (used[0] + fstat.st_size > lwm * total[0])
+         {
+            break;
+         }
+
+         int rc = MoveFileToTier(dataPath, 0);
+         if (rc == 0)
+         {
+            used[0]    += fstat.st_size;
+            used[tier] -= fstat.st_size;
+            ++promoted[tier];
+            TRACE(Dump, trc_pfx << "Promoted file: '" << dataPath << "' from tier " << tier << ", opens: " << i->first);
+         }
+         else if (rc == -EBUSY)
+         {
+            // Open again, retry on the next pass.
+            XrdSysMutexHelper lock(m_tier_mutex);
+            m_tier_hot[dataPath] += i->first;
+         }
+         else
+         {
+            TRACE(Debug, trc_pfx << "Could not promote file: '" << dataPath << "' " << ERRNO_AND_ERRSTR(-rc));
+         }
+      }
+   }
+
+   // Report occupancy and accumulated counters of each tier.
+   std::vector<TierStats> stats;
+   {
+      XrdSysMutexHelper lock(m_tier_mutex);
+      for (int t = 0; t < n_tiers; ++t)
+      {
+         m_tier_stats[t].m_NDemoted  += demoted[t];
+         m_tier_stats[t].m_NPromoted += promoted[t];
+      }
+      stats = m_tier_stats;
+   }
+
+   char buf[4096];
+   int  len = snprintf(buf, sizeof(buf), "{\"event\":\"tier_stats\",\"tiers\":[");
+
+   for (int t = 0; t < n_tiers; ++t)
+   {
+      TRACE(Info, trc_pfx << "Tier " << t << " '" << m_configuration.m_tier_spaces[t] << "': total " << total[t] <<
+            ", used " << used[t]);
+      TRACE(Info, trc_pfx << "Tier " << t << ": opened " << stats[t].m_NOpened << ", bytes hit " << stats[t].m_BytesHit <<
+            ", demoted " << stats[t].m_NDemoted << ", promoted " << stats[t].m_NPromoted);
+
+      if (len < (int) sizeof(buf))
+      {
+         len += snprintf(buf + len, sizeof(buf) - len, "%s{\"space\":\"%s\",\"total\":%lld,\"used\":%lld,"
+                         "\"n_opened\":%d,\"b_hit\":%lld,\"n_demoted\":%d,\"n_promoted\":%d}",
+                         t ? "," : "", m_configuration.m_tier_spaces[t].c_str(), total[t], used[t],
+                         stats[t].m_NOpened, stats[t].m_BytesHit, stats[t].m_NDemoted, stats[t].m_NPromoted);
+      }
+   }
+
+   if (m_gstream && len < (int) sizeof(buf))
+   {
+      len += snprintf(buf + len, sizeof(buf) - len, "]}");
+
+      if (len >= (int) sizeof(buf) || ! m_gstream->Insert(buf, len + 1))
+      {
+         TRACE(Error, trc_pfx << "Failed g-stream insertion of tier_stats record, len=" << len);
+      }
+   }
+}
+
+//==============================================================================
+
+void Cache::ReportWriteBackStats()
+{
+   static const char *trc_pfx = "ReportWriteBackStats() ";
+
+   WriteBackStats wbs;
+   {
+      XrdSysMutexHelper lock(&m_wb_stats_mutex);
+      wbs = m_wb_stats;
+   }
+
+   TRACE(Info, trc_pfx << "blocks written " << wbs.m_NBlocks << ", writes " << wbs.m_NWrites <<
+         ", wait time " << wbs.m_WaitTime << " usec, max wait " << wbs.m_WaitMax << " usec");
+
+   if (m_gstream)
+   {
+      char buf[256];
+      int  len = snprintf(buf, sizeof(buf), "{\"event\":\"wb_stats\",\"n_blks\":%lld,\"n_writes\":%lld,"
+                          "\"wait_t\":%lld,\"wait_max\":%lld}",
+                          wbs.m_NBlocks, wbs.m_NWrites, wbs.m_WaitTime, wbs.m_WaitMax);
+
+      if (len >= (int) sizeof(buf) || ! m_gstream->Insert(buf, len + 1))
+      {
+         TRACE(Error, trc_pfx << "Failed g-stream insertion of wb_stats record, len=" << len);
+      }
+   }
+}
+
+//==============================================================================
+
+void Cache::ReportAdmissionStats()
+{
+   static const char *trc_pfx = "ReportAdmissionStats() ";
+
+   long long n_admitted, n_rejected;
+   m_admission->GetCounts(n_admitted, n_rejected);
+
+   TRACE(Info, trc_pfx << "files admitted " << n_admitted << ", rejected " << n_rejected <<
+         ", victim frequency " << m_admission->GetVictimFrequency());
+
+   if (m_gstream)
+   {
+      char buf[256];
+      int  len = snprintf(buf, sizeof(buf), "{\"event\":\"adm_stats\",\"n_admitted\":%lld,\"n_rejected\":%lld,"
+                          "\"victim_freq\":%d}",
+                          n_admitted, n_rejected, m_admission->GetVictimFrequency());
+
+      if (len >= (int) sizeof(buf) || ! m_gstream->Insert(buf, len + 1))
+      {
+         TRACE(Error, trc_pfx << "Failed g-stream insertion of adm_stats record, len=" << len);
+      }
+   }
+}
+
 //==============================================================================
 
 void Cache::Purge()
@@ -703,6 +1016,7 @@ void Cache::Purge()
    // { PathTokenizer p("/f.root", 2, true); p.deboog(); }
 
    int  age_based_purge_countdown = 0; // enforce on first purge loop entry.
+   int  tier_demote_age_countdown = 0;
    bool is_first = true;
 
    while (true)
@@ -722,7 +1036,7 @@ void Cache::Purge()
 
       // get amount of space to potentially erase based on total disk usage
       XrdOssVSInfo sP; // Make sure we start when a clean slate in each loop
-      if (m_oss->StatVS(&sP, m_configuration.m_data_space.c_str(), 1) < 0)
+      if (StatDataSpace(sP) < 0)
       {
          TRACE(Error, trc_pfx << "can't get StatVS for oss space " << m_configuration.m_data_space);
          continue;
@@ -781,6 +1095,27 @@ void Cache::Purge()
       bool enforce_traversal_for_usage_collection = is_first;
       // XXX Other conditions? Periodic checks?
 
+      // Faster tiers need a scan for demotion candidates when they are over
+      // their high-watermark or, periodically, when age based demotion is on.
+      bool enforce_tier_scan = false;
+      if (m_configuration.are_tiers_set())
+      {
+         if (m_configuration.m_tierDemoteAge > 0 && --tier_demote_age_countdown <= 0)
+         {
+            enforce_tier_scan         = true;
+            tier_demote_age_countdown = m_configuration.m_purgeAgeBasedPeriod;
+         }
+         for (int i = 0; i < (int) m_configuration.m_tier_spaces.size() - 1 && ! enforce_tier_scan; ++i)
+         {
+            XrdOssVSInfo tP;
+            if (m_oss->StatVS(&tP, m_configuration.m_tier_spaces[i].c_str(), 1) >= 0 &&
+                tP.Total - tP.Free > m_configuration.m_tierUsageHWM * tP.Total)
+            {
+               enforce_tier_scan = true;
+            }
+         }
+      }
+
       copy_out_active_stats_and_update_data_fs_state();
 
       TRACE(Debug, trc_pfx << "Precheck:");
@@ -788,6 +1123,7 @@ void Cache::Purge()
       TRACE(Debug, "\tbytes_to remove_files   = " << bytesToRemove_f << " B (" << (is_first ? "max possible for initial run" : "estimated") << ")");
       TRACE(Debug, "\tbytes_to_remove         = " << bytesToRemove   << " B");
       TRACE(Debug, "\tenforce_age_based_purge = " << enforce_age_based_purge);
+      TRACE(Debug, "\tenforce_tier_scan       = " << enforce_tier_scan);
       is_first = false;
 
       long long bytesToRemove_at_start = 0; // set after file scan
@@ -799,10 +1135,12 @@ void Cache::Purge()
       // the traversal more often than really needed.
       FPurgeState purgeState(2 * bytesToRemove, *m_oss); // prepare twice more volume than required
 
-      if (purge_required || enforce_traversal_for_usage_collection)
+      if (purge_required || enforce_traversal_for_usage_collection || enforce_tier_scan)
       {
          // Make a sorted map of file paths sorted by access time.
 
+         purgeState.setCollectTiers(enforce_tier_scan);
+
          if (m_configuration.is_age_based_purge_in_effect())
          {
             purgeState.setMinTime(time(0) - m_configuration.m_purgeColdFilesAge);
@@ -881,6 +1219,7 @@ void Cache::Purge()
          size_t      info_ext_len  =  strlen(Info::s_infoExtension);
          int         protected_cnt = 0;
          long long   protected_sum = 0;
+         long long   victim_freq_sum = 0;
          for (FPurgeState::map_i it = purgeState.m_fmap.begin(); it != purgeState.m_fmap.end(); ++it)
          {
             // Finish when enough space has been freed but not while age-based purging is in progress.
@@ -924,6 +1263,8 @@ void Cache::Purge()
                m_oss->Unlink(dataPath.c_str());
                TRACE(Dump, trc_pfx << "Removed file: '" << dataPath << "' size: " << it->second.nBytes << ", time: " << it->first);
 
+               if (m_admission) victim_freq_sum += m_admission->Estimate(dataPath);
+
                if (it->second.dirState != 0) // XXXX This should now always be true.
                   it->second.dirState->add_usage_purged(it->second.nBytes);
                else
@@ -936,6 +1277,24 @@ void Cache::Purge()
          }
 
          m_fs_state->upward_propagate_usage_purged();
+
+         // New files now have to beat the average frequency of the evicted ones.
+         if (m_admission && deleted_file_count > 0)
+         {
+            int victim_freq = (victim_freq_sum + deleted_file_count / 2) / deleted_file_count;
+            m_admission->SetVictimFrequency(victim_freq);
+            TRACE(Info, trc_pfx << "Admission victim frequency set to " << victim_freq);
+         }
+      }
+      else if (m_admission)
+      {
+         // No pressure, admit everything until the next purge.
+         m_admission->SetVictimFrequency(0);
+      }
+
+      if (m_admission)
+      {
+         ReportAdmissionStats();
       }
 
       {
@@ -945,6 +1304,13 @@ void Cache::Purge()
          m_in_purge = false;
       }
 
+      if (m_configuration.are_tiers_set())
+      {
+         BalanceTiers(purgeState, enforce_tier_scan);
+      }
+
+      ReportWriteBackStats();
+
       int purge_duration = time(0) - purge_start;
 
       TRACE(Info, trc_pfx << "Finished, removed " << deleted_file_count << " data files, total size " <<
@@ -0,0 +1,177 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by the XRootD contributors
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include "XrdPfcTinyLFU.hh"
+
+#include <algorithm>
+
+using namespace XrdPfc;
+
+TinyLFU::TinyLFU(int n_files) :
+   m_additions(0),
+   m_victim_freq(0),
+   m_n_admitted(0),
+   m_n_rejected(0)
+{
+   uint64_t width = 64;
+   while (width < (uint64_t) n_files) width <<= 1;
+
+   m_width_mask  = width - 1;
+   m_counters.resize(s_depth * width, 0);
+
+   // Eight doorkeeper bits per tracked file, probed twice.
+   m_door.resize(width / 8, 0);
+   m_door_mask   = width * 8 - 1;
+
+   m_sample_size = 10 * width;
+}
+
+//------------------------------------------------------------------------------
+
+void TinyLFU::hash(const std::string &lfn, uint64_t &h1, uint64_t &h2) const
+{
+   // FNV-1a, then a splitmix64 finalizer for the second, odd, hash.
+   uint64_t h = 14695981039346656037ull;
+   for (std::string::const_iterator i = lfn.begin(); i != lfn.end(); ++i)
+   {
+      h ^= (unsigned char) *i;
+      h *= 1099511628211ull;
+   }
+   h1 = h;
+
+   h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ull;
+   h ^= h >> 27; h *= 0x94d049bb133111ebull;
+   h ^= h >> 31;
+   h2 = h | 1;
+}
+
+int TinyLFU::estimate(uint64_t h1, uint64_t h2) const
+{
+   int freq = s_max_count;
+   for (int r = 0; r < s_depth; ++r)
+   {
+      freq = std::min(freq, (int) m_counters[r * (m_width_mask + 1) + row_index(r, h1, h2)]);
+   }
+
+   uint64_t b1 = h1 & m_door_mask, b2 = h2 & m_door_mask;
+   if ((m_door[b1 >> 6] >> (b1 & 63) & 1) && (m_door[b2 >> 6] >> (b2 & 63) & 1))
+   {
+      ++freq;
+   }
+   return freq;
+}
+
+void TinyLFU::increment(uint64_t h1, uint64_t h2)
+{
+   // The first access only goes into the doorkeeper.
+   uint64_t b1 = h1 & m_door_mask, b2 = h2 & m_door_mask;
+   uint64_t m1 = 1ull << (b1 & 63),  m2 = 1ull << (b2 & 63);
+   if ( ! (m_door[b1 >> 6] & m1) || ! (m_door[b2 >> 6] & m2))
+   {
+      m_door[b1 >> 6] |= m1;
+      m_door[b2 >> 6] |= m2;
+   }
+   else
+   {
+      // Conservative update: only raise the counters holding the minimum.
+      unsigned char *c[s_depth];
+      int            min = s_max_count;
+      for (int r = 0; r < s_depth; ++r)
+      {
+         c[r] = &m_counters[r * (m_width_mask + 1) + row_index(r, h1, h2)];
+         min  = std::min(min, (int) *c[r]);
+      }
+      if (min < s_max_count)
+      {
+         for (int r = 0; r < s_depth; ++r)
+         {
+            if (*c[r] == min) ++*c[r];
+         }
+      }
+   }
+
+   if (++m_additions >= m_sample_size)
+   {
+      age();
+   }
+}
+
+void TinyLFU::age()
+{
+   for (std::vector<unsigned char>::iterator i = m_counters.begin(); i != m_counters.end(); ++i)
+   {
+      *i >>= 1;
+   }
+   std::fill(m_door.begin(), m_door.end(), 0);
+   m_additions /= 2;
+}
+
+//------------------------------------------------------------------------------
+
+int TinyLFU::RecordAccess(const std::string &lfn)
+{
+   uint64_t h1, h2;
+   hash(lfn, h1, h2);
+
+   XrdSysMutexHelper lock(&m_mutex);
+   increment(h1, h2);
+   return estimate(h1, h2);
+}
+
+bool TinyLFU::Admit(const std::string &lfn)
+{
+   uint64_t h1, h2;
+   hash(lfn, h1, h2);
+
+   XrdSysMutexHelper lock(&m_mutex);
+   increment(h1, h2);
+   if (estimate(h1, h2) > m_victim_freq)
+   {
+      ++m_n_admitted;
+      return true;
+   }
+   ++m_n_rejected;
+   return false;
+}
+
+int TinyLFU::Estimate(const std::string &lfn)
+{
+   uint64_t h1, h2;
+   hash(lfn, h1, h2);
+
+   XrdSysMutexHelper lock(&m_mutex);
+   return estimate(h1, h2);
+}
+
+void TinyLFU::SetVictimFrequency(int freq)
+{
+   XrdSysMutexHelper lock(&m_mutex);
+   m_victim_freq = freq;
+}
+
+int TinyLFU::GetVictimFrequency()
+{
+   XrdSysMutexHelper lock(&m_mutex);
+   return m_victim_freq;
+}
+
+void TinyLFU::GetCounts(long long &n_admitted, long long &n_rejected)
+{
+   XrdSysMutexHelper lock(&m_mutex);
+   n_admitted = m_n_admitted;
+   n_rejected = m_n_rejected;
+}
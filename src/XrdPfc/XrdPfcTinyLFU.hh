@@ -0,0 +1,108 @@
+#ifndef __XRDPFC_TINYLFU_HH__
+#define __XRDPFC_TINYLFU_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by the XRootD contributors
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+namespace XrdPfc
+{
+
+//----------------------------------------------------------------------------
+//! Frequency based cache admission (TinyLFU).
+//!
+//! Accesses to files are counted in a count-min sketch of small saturating
+//! counters fronted by a doorkeeper bloom filter, so that files seen only once never
+//! reach the sketch. Counters are halved after every sample of accesses so
+//! the estimates follow the recent working set.
+//!
+//! A file not yet in the cache is admitted only when its estimated frequency
+//! beats that of the files the purge had to evict in its last pass. Without
+//! disk pressure the victim frequency is zero and every file is admitted.
+//----------------------------------------------------------------------------
+class TinyLFU
+{
+public:
+   //---------------------------------------------------------------------
+   //! Constructor
+   //!
+   //! @param n_files  number of distinct files the sketch should track
+   //---------------------------------------------------------------------
+   TinyLFU(int n_files);
+
+   //---------------------------------------------------------------------
+   //! Record an access to a file.
+   //!
+   //! @return estimated access frequency including this access
+   //---------------------------------------------------------------------
+   int RecordAccess(const std::string &lfn);
+
+   //---------------------------------------------------------------------
+   //! Record an access to a file not in the cache and decide if it should
+   //! be admitted.
+   //---------------------------------------------------------------------
+   bool Admit(const std::string &lfn);
+
+   //---------------------------------------------------------------------
+   //! Estimated access frequency of a file.
+   //---------------------------------------------------------------------
+   int Estimate(const std::string &lfn);
+
+   //---------------------------------------------------------------------
+   //! Set the frequency that candidates must beat, as determined from the
+   //! files removed by the last purge pass (0 when none had to be removed).
+   //---------------------------------------------------------------------
+   void SetVictimFrequency(int freq);
+
+   int  GetVictimFrequency();
+
+   //---------------------------------------------------------------------
+   //! Number of files Admit() has admitted and rejected so far.
+   //---------------------------------------------------------------------
+   void GetCounts(long long &n_admitted, long long &n_rejected);
+
+private:
+   static const int s_depth     = 4;    //!< number of sketch rows
+   static const int s_max_count = 15;   //!< counters saturate at this value
+
+   void hash(const std::string &lfn, uint64_t &h1, uint64_t &h2) const;
+   int  estimate(uint64_t h1, uint64_t h2) const;
+   void increment(uint64_t h1, uint64_t h2);
+   void age();
+
+   uint64_t row_index(int row, uint64_t h1, uint64_t h2) const
+   { return (h1 + row * h2) & m_width_mask; }
+
+   XrdSysMutex                m_mutex;
+   std::vector<unsigned char> m_counters;     //!< s_depth rows of m_width_mask + 1 counters
+   std::vector<uint64_t>      m_door;         //!< doorkeeper bloom filter
+   uint64_t                   m_width_mask;
+   uint64_t                   m_door_mask;
+   long long                  m_additions;    //!< accesses recorded since last aging
+   long long                  m_sample_size;  //!< accesses between two agings
+   int                        m_victim_freq;
+   long long                  m_n_admitted;   //!< files admitted by Admit()
+   long long                  m_n_rejected;   //!< files rejected by Admit()
+};
+
+}
+
+#endif
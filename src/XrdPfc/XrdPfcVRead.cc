@@ -113,6 +113,13 @@ int File::ReadV(IO *io, const XrdOucIOVec *readV, int n)
       return -ENOENT;
    }
 
+   if (m_bsize_pending)
+   {
+      long long sum = 0;
+      for (int i = 0; i < n; ++i) sum += readV[i].size;
+      choose_block_size(io, -1, n > 0 ? sum / n : 0);
+   }
+
    VReadPreProcess(io, readV, n, blks_to_request, blocks_to_process, blocks_on_disk, chunkVec);
 
    m_state_cond.UnLock();
@@ -9,6 +9,7 @@ set( LIB_XRD_N2NO2P     XrdN2No2p-${PLUGIN_VERSION} )
 set( LIB_XRD_PSS        XrdPss-${PLUGIN_VERSION} )
 set( LIB_XRD_CMSREDIRL  XrdCmsRedirectLocal-${PLUGIN_VERSION} )
 set( LIB_XRD_GPFS       XrdOssSIgpfsT-${PLUGIN_VERSION} )
+set( LIB_XRD_OSSRAM     XrdOssRam-${PLUGIN_VERSION} )
 set( LIB_XRD_ZCRC32     XrdCksCalczcrc32-${PLUGIN_VERSION} )
 set( LIB_XRD_THROTTLE   XrdThrottle-${PLUGIN_VERSION} )
 
@@ -27,6 +28,7 @@ add_library(
   XrdPss/XrdPss.cc           XrdPss/XrdPss.hh
   XrdPss/XrdPssCks.cc        XrdPss/XrdPssCks.hh
   XrdPss/XrdPssConfig.cc
+  XrdPss/XrdPssMDCache.cc    XrdPss/XrdPssMDCache.hh
                              XrdPss/XrdPssTrace.hh
   XrdPss/XrdPssUrlInfo.cc    XrdPss/XrdPssUrlInfo.hh
   XrdPss/XrdPssUtils.cc      XrdPss/XrdPssUtils.hh )
@@ -105,6 +107,28 @@ set_target_properties(
   INTERFACE_LINK_LIBRARIES ""
   LINK_INTERFACE_LIBRARIES "" )
 
+#-------------------------------------------------------------------------------
+# The OSS RAM tier plugin library
+#-------------------------------------------------------------------------------
+add_library(
+  ${LIB_XRD_OSSRAM}
+  MODULE
+  XrdOss/XrdOssRam.cc          XrdOss/XrdOssRam.hh
+  XrdOss/XrdOssRamCache.cc     XrdOss/XrdOssRamCache.hh
+                               XrdOss/XrdOssWrapper.hh )
+
+target_link_libraries(
+  ${LIB_XRD_OSSRAM}
+  XrdServer
+  XrdUtils
+  pthread )
+
+set_target_properties(
+  ${LIB_XRD_OSSRAM}
+  PROPERTIES
+  INTERFACE_LINK_LIBRARIES ""
+  LINK_INTERFACE_LIBRARIES "" )
+
 #-------------------------------------------------------------------------------
 # libz compatible CRC32 plugin
 #-------------------------------------------------------------------------------
@@ -116,8 +140,7 @@ add_library(
 
 target_link_libraries(
   ${LIB_XRD_ZCRC32}
-  XrdUtils
-  ${ZLIB_LIBRARY} )
+  XrdUtils )
 
 set_target_properties(
   ${LIB_XRD_ZCRC32}
@@ -173,5 +196,5 @@ set_target_properties(
 # Install
 #-------------------------------------------------------------------------------
 install(
-  TARGETS ${LIB_XRD_PSS} ${LIB_XRD_BWM} ${LIB_XRD_GPFS} ${LIB_XRD_ZCRC32} ${LIB_XRD_THROTTLE} ${LIB_XRD_N2NO2P} ${LIB_XRD_CMSREDIRL}
+  TARGETS ${LIB_XRD_PSS} ${LIB_XRD_BWM} ${LIB_XRD_GPFS} ${LIB_XRD_OSSRAM} ${LIB_XRD_ZCRC32} ${LIB_XRD_THROTTLE} ${LIB_XRD_N2NO2P} ${LIB_XRD_CMSREDIRL}
   LIBRARY DESTINATION ${CMAKE_INSTALL_LIBDIR} )
@@ -97,6 +97,8 @@ static XrdPssSys   XrdProxySS;
 
        XrdSecsssID  *idMapper = 0;    // -> Auth ID mapper
 
+       XrdPssMDCache *mdCache = 0;    // -> Metadata cache, if any
+
 static const char   *ofslclCGI = "ofs.lcl=1";
 
 static const char   *osslclCGI = "oss.lcl=1";
@@ -110,6 +112,18 @@ static const int     PBsz = 4096;
        bool          xrdProxy = false; // True means dest using xroot protocol
 
        XrdSysTrace SysTrace("Pss",0);
+
+// The metadata cache scope of a request: the client identity when it is used
+// at the origin and the client cgi, which may carry authorization tokens.
+//
+std::string mdcScope(XrdPssUrlInfo &uInfo)
+{
+   std::string scope(uInfo.isMapped() ? uInfo.getID() : "");
+
+   scope += '?';
+   scope += uInfo.usrCGI();
+   return scope;
+}
 }
 
 using namespace XrdProxy;
@@ -344,9 +358,11 @@ int XrdPssSys::Mkdir(const char *path, mode_t mode, int mkpath, XrdOucEnv *eP)
 //
    DEBUG(uInfo.Tident(),"url="<<pbuff);
 
-// Simply return the proxied result here
+// Issue the mkdir and discard any cached information about the path
 //
-   return (XrdPosixXrootd::Mkdir(pbuff, mode) ? -errno : XrdOssOK);
+   rc = (XrdPosixXrootd::Mkdir(pbuff, mode) ? -errno : XrdOssOK);
+   if (mdCache) mdCache->Invalidate(path);
+   return rc;
 }
   
 /******************************************************************************/
@@ -388,9 +404,11 @@ int XrdPssSys::Remdir(const char *path, int Opts, XrdOucEnv *eP)
 //
    DEBUG(uInfo.Tident(),"url="<<pbuff);
 
-// Issue unlink and return result
+// Issue rmdir and discard any cached information about the path
 //
-   return (XrdPosixXrootd::Rmdir(pbuff) ? -errno : XrdOssOK);
+   rc = (XrdPosixXrootd::Rmdir(pbuff) ? -errno : XrdOssOK);
+   if (mdCache) mdCache->Invalidate(path);
+   return rc;
 }
 
 /******************************************************************************/
@@ -432,9 +450,11 @@ int XrdPssSys::Rename(const char *oldname, const char *newname,
 //
    DEBUG(uInfoOld.Tident(),"old url="<<oldName <<" new url=" <<newName);
 
-// Execute the rename and return result
+// Execute the rename and discard any cached information about either path
 //
-   return (XrdPosixXrootd::Rename(oldName, newName) ? -errno : XrdOssOK);
+   rc = (XrdPosixXrootd::Rename(oldName, newName) ? -errno : XrdOssOK);
+   if (mdCache) {mdCache->Invalidate(oldname); mdCache->Invalidate(newname);}
+   return rc;
 }
 
 /******************************************************************************/
@@ -485,8 +505,11 @@ int XrdPssSys::Stat(const char *path, struct stat *buff, int Opts, XrdOucEnv *eP
 //
    DEBUG(uInfo.Tident(),"url="<<pbuff);
 
-// Return proxied stat
+// Return proxied stat, possibly from the metadata cache. Resident-only stat
+// requests are always sent through as they ask a different question.
 //
+   if (mdCache && !(Opts & XRDOSS_resonly))
+      return mdCache->GetStat(path, mdcScope(uInfo), pbuff, buff);
    return (XrdPosixXrootd::Stat(pbuff, buff) ? -errno : XrdOssOK);
 }
 
@@ -505,7 +528,15 @@ int XrdPssSys::Stat(const char *path, struct stat *buff, int Opts, XrdOucEnv *eP
 */
 int XrdPssSys::Stats(char *bp, int bl)
 {
-   return XrdPosixConfig::Stats("pss", bp, bl);
+   int n = XrdPosixConfig::Stats("pss", bp, bl);
+
+// Add the metadata cache statistics, if we have a cache
+//
+   if (!mdCache) return n;
+   if (!bl) return n + mdCache->Stats(0, 0);
+   if (!n || n >= bl) return 0;
+   int k = mdCache->Stats(bp+n, bl-n);
+   return (k ? n+k : 0);
 }
 
 /******************************************************************************/
@@ -544,7 +575,9 @@ int XrdPssSys::Truncate(const char *path, unsigned long long flen,
 // Return proxied truncate. We only do this on a single machine because the
 // redirector will forbid the trunc() if multiple copies exist.
 //
-   return (XrdPosixXrootd::Truncate(pbuff, flen) ? -errno : XrdOssOK);
+   rc = (XrdPosixXrootd::Truncate(pbuff, flen) ? -errno : XrdOssOK);
+   if (mdCache) mdCache->Invalidate(path);
+   return rc;
 }
   
 /******************************************************************************/
@@ -586,9 +619,11 @@ int XrdPssSys::Unlink(const char *path, int Opts, XrdOucEnv *envP)
 //
    DEBUG(uInfo.Tident(),"url="<<pbuff);
 
-// Unlink the file and return result.
+// Unlink the file, discard any cached information, and return result.
 //
-   return (XrdPosixXrootd::Unlink(pbuff) ? -errno : XrdOssOK);
+   rc = (XrdPosixXrootd::Unlink(pbuff) ? -errno : XrdOssOK);
+   if (mdCache) mdCache->Invalidate(path);
+   return rc;
 }
 
 /******************************************************************************/
@@ -614,7 +649,7 @@ int XrdPssDir::Opendir(const char *dir_path, XrdOucEnv &Env)
 
 // Return an error if this object is already open
 //
-   if (myDir) return -XRDOSS_E8001;
+   if (myDir || dirList) return -XRDOSS_E8001;
 
 // Open directories are not supported for object id's
 //
@@ -634,6 +669,15 @@ int XrdPssDir::Opendir(const char *dir_path, XrdOucEnv &Env)
 //
    DEBUG(uInfo.Tident(),"url="<<pbuff);
 
+// If we have a metadata cache, the listing comes from there
+//
+   if (mdCache)
+      {if (!(dirList = mdCache->GetDir(dir_path, mdcScope(uInfo), pbuff, rc)))
+          return rc;
+       dirNext = 0;
+       return XrdOssOK;
+      }
+
 // Open the directory
 //
    myDir = XrdPosixXrootd::Opendir(pbuff);
@@ -673,6 +717,14 @@ int XrdPssDir::Readdir(char *buff, int blen)
        return XrdOssOK;
       }
 
+// Check if we are reading a cached listing
+//
+   if (dirList)
+      {if (dirNext >= (int)dirList->Names.size()) *buff = 0;
+          else strlcpy(buff, dirList->Names[dirNext++].c_str(), blen);
+       return XrdOssOK;
+      }
+
 // The directory is not open
 //
    return -XRDOSS_E8002;
@@ -702,6 +754,14 @@ int XrdPssDir::Close(long long *retsz)
        return XrdOssOK;
       }
 
+// Release any cached listing
+//
+   if (dirList)
+      {mdCache->Release(dirList);
+       dirList = 0;
+       return XrdOssOK;
+      }
+
 // Directory is not open
 //
    return -XRDOSS_E8002;
@@ -791,6 +851,12 @@ int XrdPssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
 //
    DEBUG(uInfo.Tident(),"url="<<pbuff);
 
+// If the file is known not to exist there is no need to ask the origin. If
+// the file may be modified, its cached information must be discarded.
+//
+   if (mdCache && !rwMode && !(Oflag & O_CREAT)
+   &&  mdCache->Missing(path, mdcScope(uInfo))) return -ENOENT;
+
 // Try to open and if we failed, return an error
 //
    if (!XrdPssSys::dcaCheck || !ioCache)
@@ -806,6 +872,14 @@ int XrdPssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
        if (fd < 0) return -errno;
       }
 
+// Discard any cached information for files opened for modification and make
+// sure we do so again when the file is closed.
+//
+   if (mdCache && (rwMode || (Oflag & O_CREAT)))
+      {mdCache->Invalidate(path);
+       mdcPath = strdup(path);
+      }
+
 // All done
 //
    return XrdOssOK;
@@ -842,7 +916,16 @@ int XrdPssFile::Close(long long *retsz)
 //
     rc = XrdPosixXrootd::Close(fd);
     fd = -1;
-    return (rc == 0 ? XrdOssOK : -errno);
+    if (rc) rc = -errno;
+
+// If the file was opened for modification, discard cached information
+//
+    if (mdcPath)
+       {mdCache->Invalidate(mdcPath);
+        free(mdcPath);
+        mdcPath = 0;
+       }
+    return (rc == 0 ? XrdOssOK : rc);
 }
 
 /******************************************************************************/
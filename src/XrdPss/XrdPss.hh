@@ -40,6 +40,7 @@
 #include "XrdOuc/XrdOucPList.hh"
 #include "XrdOuc/XrdOucSid.hh"
 #include "XrdOss/XrdOss.hh"
+#include "XrdPss/XrdPssMDCache.hh"
 
 /******************************************************************************/
 /*                             X r d P s s D i r                              */
@@ -55,11 +56,13 @@ int     Readdir(char *buff, int blen);
         // Constructor and destructor
         XrdPssDir(const char *tid)
                  : XrdOssDF(tid, XrdOssDF::DF_isDir|XrdOssDF::DF_isProxy),
-                   myDir(0) {}
+                   myDir(0), dirList(0), dirNext(0) {}
 
-       ~XrdPssDir() {if (myDir) Close();}
+       ~XrdPssDir() {if (myDir || dirList) Close();}
 private:
          DIR       *myDir;
+XrdPssMDCache::DirList *dirList; // Cached listing when myDir is nil
+         int        dirNext;
 };
   
 /******************************************************************************/
@@ -96,15 +99,17 @@ int     Write(XrdSfsAio *aiop);
          // Constructor and destructor
          XrdPssFile(const char *tid)
                    : XrdOssDF(tid, XrdOssDF::DF_isFile|XrdOssDF::DF_isProxy),
-                     tpcPath(0), entity(0) {}
+                     tpcPath(0), mdcPath(0), entity(0) {}
 
 virtual ~XrdPssFile() {if (fd >= 0) Close();
                        if (tpcPath) free(tpcPath);
+                       if (mdcPath) free(mdcPath);
                       }
 
 private:
 
       char *tpcPath;
+      char *mdcPath;  // Path to invalidate in the metadata cache upon close
 
 const XrdSecEntity *entity;
 };
@@ -178,6 +183,11 @@ static int          Streams;
 static int          Workers;
 static int          Trace;
 static int          dcaCTime;
+static int          mdcMax;   // Metadata cache: max entries (0 -> no cache)
+static int          mdcTTL;   // Metadata cache: positive entry lifetime
+static int          mdcNTTL;  // Metadata cache: negative entry lifetime
+static int          mdcDTTL;  // Metadata cache: listing lifetime
+static int          mdcDMax;  // Metadata cache: largest listing kept
 
 static bool         xLfn2Pfn;
 static bool         dcaCheck;
@@ -203,6 +213,7 @@ int    xconf(XrdSysError *Eroute, XrdOucStream &Config);
 int    xdef( XrdSysError *Eroute, XrdOucStream &Config);
 int    xdca( XrdSysError *errp,   XrdOucStream &Config);
 int    xexp( XrdSysError *Eroute, XrdOucStream &Config);
+int    xmdc( XrdSysError *errp,   XrdOucStream &Config);
 int    xperm(XrdSysError *errp,   XrdOucStream &Config);
 int    xpers(XrdSysError *errp,   XrdOucStream &Config);
 int    xorig(XrdSysError *errp,   XrdOucStream &Config);
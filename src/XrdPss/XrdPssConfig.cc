@@ -107,6 +107,11 @@ int          XrdPssSys::Streams   =512;
 int          XrdPssSys::Workers   = 16;
 int          XrdPssSys::Trace     =  0;
 int          XrdPssSys::dcaCTime  =  0;
+int          XrdPssSys::mdcMax    =  0;
+int          XrdPssSys::mdcTTL    = 60;
+int          XrdPssSys::mdcNTTL   = 10;
+int          XrdPssSys::mdcDTTL   = 60;
+int          XrdPssSys::mdcDMax   = 10000;
 
 bool         XrdPssSys::xLfn2Pfn  = false;
 bool         XrdPssSys::dcaCheck  = false;
@@ -125,6 +130,8 @@ extern XrdOucEnv       *envP;
 
 extern XrdSecsssID     *idMapper; // -> Auth ID mapper
 
+extern XrdPssMDCache   *mdCache;  // -> Metadata cache, if any
+
 extern bool             idMapAll;
 
 extern bool             outProxy; // True means outgoing proxy
@@ -211,6 +218,10 @@ int XrdPssSys::Configure(const char *cfn)
 //
    if (sssMap && !ConfigMapID()) return 1;
 
+// Create the metadata cache if one is wanted
+//
+   if (mdcMax) mdCache = new XrdPssMDCache(mdcMax,mdcTTL,mdcNTTL,mdcDTTL,mdcDMax);
+
 // Handle the local root here
 //
    if (LocalRoot) psxConfig->SetRoot(LocalRoot);
@@ -456,6 +467,7 @@ int XrdPssSys::ConfigXeq(char *var, XrdOucStream &Config)
    TS_DBG("debug",         TRACEPSS_Debug);
    TS_Xeq("export",        xexp);
    TS_PSX("inetmode",      ParseINet);
+   TS_Xeq("mdcache",       xmdc);
    TS_Xeq("origin",        xorig);
    TS_Xeq("permit",        xperm);
    TS_Xeq("persona",       xpers);
@@ -631,6 +643,74 @@ int XrdPssSys::xexp(XrdSysError *Eroute, XrdOucStream &Config)
    return 0;
 }
 
+/******************************************************************************/
+/*                                  x m d c                                   */
+/******************************************************************************/
+
+/* Function: xmdc
+
+   Purpose:  To parse the directive: mdcache [off] [max <num>] [ttl <tm>]
+                                             [nttl <tm>] [dirttl <tm>]
+                                             [dirmax <num>]
+
+             off       turns off the metadata cache.
+             max       the maximum number of stat and directory entries to
+                       keep. The default is 16384.
+             ttl       how long stat information remains valid. The default
+                       is 60 seconds.
+             nttl      how long the non-existence of a file remains valid. The
+                       default is 10 seconds.
+             dirttl    how long a directory listing remains valid. The default
+                       is 60 seconds.
+             dirmax    the largest directory listing that will be cached. The
+                       default is 10000 entries.
+
+   Output: 0 upon success or 1 upon failure.
+*/
+
+int XrdPssSys::xmdc(XrdSysError *errp, XrdOucStream &Config)
+{
+   static const int maxsz = 0x7fffffff;
+   struct mdcopts {const char *opname; int *oploc; bool isTime;} mdcopt[] =
+         {{"max",    &mdcMax,  false},
+          {"ttl",    &mdcTTL,  true},
+          {"nttl",   &mdcNTTL, true},
+          {"dirttl", &mdcDTTL, true},
+          {"dirmax", &mdcDMax, false}};
+   int i, numopts = sizeof(mdcopt)/sizeof(struct mdcopts);
+   char *val;
+
+// Preset the defaults
+//
+   mdcMax = 16384;
+
+// Process the options
+//
+   while((val = Config.GetWord()))
+        {if (!strcmp(val, "off")) {mdcMax = 0; continue;}
+         for (i = 0; i < numopts; i++)
+             if (!strcmp(val, mdcopt[i].opname)) break;
+         if (i >= numopts)
+            {errp->Emsg("Config", "invalid mdcache option -", val); return 1;}
+         if (!(val = Config.GetWord()))
+            {errp->Emsg("Config", "mdcache", mdcopt[i].opname,
+                                  "value not specified");
+             return 1;
+            }
+         if (mdcopt[i].isTime)
+            {if (XrdOuca2x::a2tm(*errp, mdcopt[i].opname, val,
+                                 mdcopt[i].oploc, 0, maxsz)) return 1;
+            } else {
+             if (XrdOuca2x::a2i(*errp, mdcopt[i].opname, val,
+                                mdcopt[i].oploc, 1, maxsz)) return 1;
+            }
+        }
+
+// All done
+//
+   return 0;
+}
+
 /******************************************************************************/
 /*                                 x o r i g                                  */
 /******************************************************************************/
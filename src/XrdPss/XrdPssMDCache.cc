@@ -0,0 +1,366 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d P s s M D C a c h e . c c                       */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+
+#include "XrdPss/XrdPssMDCache.hh"
+#include "XrdPosix/XrdPosixXrootd.hh"
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+  
+XrdPssMDCache::XrdPssMDCache(int maxent, int posttl, int negttl, int dirttl,
+                             int dirmax)
+                            : mdcCV(0), lruHead(0), lruTail(0), numEnt(0),
+                              maxEnt(maxent), posTTL(posttl), negTTL(negttl),
+                              dirTTL(dirttl), dirMax(dirmax)
+{
+   memset(&Cnt, 0, sizeof(Cnt));
+}
+
+/******************************************************************************/
+/* Private:                        B e g i n                                  */
+/******************************************************************************/
+
+// Caller must hold mdcCV. Returns a referenced entry; isHit is set to false
+// when the caller must contact the origin and then call Finish().
+//
+XrdPssMDCache::Entry *XrdPssMDCache::Begin(const std::string &key, bool &isHit)
+{
+   std::map<std::string,Entry *>::iterator it = mdcMap.find(key);
+   Entry *eP;
+
+// If we have an entry either wait for its result or use it if still valid
+//
+   if (it != mdcMap.end())
+      {eP = it->second;
+       if (eP->Pending)
+          {eP->Refs++; Cnt.Joins++;
+           do {mdcCV.Wait();} while(eP->Pending);
+           isHit = true;
+           return eP;
+          }
+       if (time(0) < eP->Expires)
+          {if (eP != lruHead)
+              {eP->Prev->Next = eP->Next;
+               if (eP->Next) eP->Next->Prev = eP->Prev;
+                  else lruTail = eP->Prev;
+               eP->Prev = 0; eP->Next = lruHead;
+               lruHead->Prev = eP; lruHead = eP;
+              }
+           eP->Refs++;
+           if (eP->Rc) Cnt.NegHits++;
+              else     Cnt.Hits++;
+           isHit = true;
+           return eP;
+          }
+       Drop(eP);
+      }
+
+// Create a pending entry for this key. The map holds one reference and the
+// caller the other.
+//
+   eP = new Entry(key);
+   eP->Refs++;
+   mdcMap[key] = eP;
+   Cnt.Misses++;
+   isHit = false;
+   return eP;
+}
+
+/******************************************************************************/
+/* Private:                         D r o p                                   */
+/******************************************************************************/
+
+// Caller must hold mdcCV.
+//
+void XrdPssMDCache::Drop(Entry *eP)
+{
+   if (!eP->inMap) return;
+   mdcMap.erase(eP->Key);
+   eP->inMap = false;
+
+   if (!eP->Pending)
+      {if (eP->Prev) eP->Prev->Next = eP->Next;
+          else lruHead = eP->Next;
+       if (eP->Next) eP->Next->Prev = eP->Prev;
+          else lruTail = eP->Prev;
+       eP->Prev = eP->Next = 0;
+       numEnt--;
+      }
+   Unref(eP);
+}
+
+/******************************************************************************/
+/* Private:                       F i n i s h                                 */
+/******************************************************************************/
+
+// Caller must hold mdcCV. The caller's reference is released.
+//
+void XrdPssMDCache::Finish(Entry *eP, int ttl)
+{
+
+// The entry is no longer pending so wake up anyone waiting for it
+//
+   eP->Pending = false;
+   mdcCV.Broadcast();
+
+// If the entry was invalidated while we were waiting or the result should not
+// be cached, simply discard it. Otherwise, make it the most recently used.
+//
+   if (ttl <= 0) Drop(eP);
+      else if (eP->inMap)
+              {eP->Expires = time(0) + ttl;
+               eP->Next = lruHead;
+               if (lruHead) lruHead->Prev = eP;
+                  else lruTail = eP;
+               lruHead = eP;
+               numEnt++;
+               while(numEnt > maxEnt && lruTail)
+                    {Cnt.Evicts++; Drop(lruTail);}
+              }
+   Unref(eP);
+}
+
+/******************************************************************************/
+/*                                G e t D i r                                 */
+/******************************************************************************/
+  
+XrdPssMDCache::DirList *XrdPssMDCache::GetDir(const char *path,
+                                              const std::string &scope,
+                                              const char *url, int &rc)
+{
+   std::string key = MakeKey('d', path, &scope);
+   DirList *dP = 0;
+   Entry   *eP;
+   bool     isHit;
+
+// Find the entry or create one that we will fill in
+//
+   mdcCV.Lock();
+   eP = Begin(key, isHit);
+   if (isHit)
+      {if (!(rc = eP->Rc)) {dP = eP->dList; dP->Refs++;}
+       Unref(eP);
+       mdcCV.UnLock();
+       return dP;
+      }
+   mdcCV.UnLock();
+
+// Read the complete directory from the origin
+//
+   DIR *dirP = XrdPosixXrootd::Opendir(url);
+   if (!dirP) rc = -errno;
+      else {dirent *entP, myEnt;
+            dP = new DirList;
+            while(!(rc = XrdPosixXrootd::Readdir_r(dirP, &myEnt, &entP))
+               && entP) dP->Names.push_back(std::string(myEnt.d_name));
+            if (rc) {rc = -rc; delete dP; dP = 0;}
+            XrdPosixXrootd::Closedir(dirP);
+           }
+
+// Record the result and keep it if it is worth keeping
+//
+   mdcCV.Lock();
+   eP->Rc = rc;
+   if (dP) {eP->dList = dP; dP->Refs++;}
+   Finish(eP, (!rc ? ((int)dP->Names.size() <= dirMax ? dirTTL : 0)
+                   : (rc == -ENOENT ? negTTL : 0)));
+   mdcCV.UnLock();
+   return dP;
+}
+
+/******************************************************************************/
+/*                               G e t S t a t                                */
+/******************************************************************************/
+  
+int XrdPssMDCache::GetStat(const char *path, const std::string &scope,
+                           const char *url, struct stat *buff)
+{
+   std::string key = MakeKey('s', path, &scope);
+   struct stat sBuff;
+   Entry *eP;
+   bool   isHit;
+   int    rc;
+
+// Find the entry or create one that we will fill in
+//
+   mdcCV.Lock();
+   eP = Begin(key, isHit);
+   if (isHit)
+      {if (!(rc = eP->Rc)) *buff = eP->sBuff;
+       Unref(eP);
+       mdcCV.UnLock();
+       return rc;
+      }
+   mdcCV.UnLock();
+
+// Get the information from the origin
+//
+   rc = (XrdPosixXrootd::Stat(url, &sBuff) ? -errno : 0);
+
+// Record the result, we only keep success and non-existence
+//
+   mdcCV.Lock();
+   eP->Rc = rc;
+   if (!rc) eP->sBuff = sBuff;
+   Finish(eP, (!rc ? posTTL : (rc == -ENOENT ? negTTL : 0)));
+   mdcCV.UnLock();
+
+// Return result
+//
+   if (!rc) *buff = sBuff;
+   return rc;
+}
+  
+/******************************************************************************/
+/*                            I n v a l i d a t e                             */
+/******************************************************************************/
+
+void XrdPssMDCache::Invalidate(const char *path)
+{
+   std::string theKey(path);
+   std::string::size_type pos;
+
+// Remove the stat and listing for the path in every scope
+//
+   mdcCV.Lock();
+   Remove(MakeKey('s', theKey));
+   Remove(MakeKey('d', theKey));
+
+// Remove the listing of the parent directory
+//
+   if ((pos = theKey.rfind('/')) != std::string::npos)
+      Remove(MakeKey('d', theKey.substr(0, (pos ? pos : 1))));
+   mdcCV.UnLock();
+}
+
+/******************************************************************************/
+/* Private:                      M a k e K e y                                */
+/******************************************************************************/
+
+// The key is the item type, the path, a null byte and the scope. Without a
+// scope the result is the prefix shared by the item in all of its scopes.
+//
+std::string XrdPssMDCache::MakeKey(char type, const std::string &path,
+                                   const std::string *scope)
+{
+   std::string key(1, type);
+
+   key += path;
+   key += '\0';
+   if (scope) key += *scope;
+   return key;
+}
+
+/******************************************************************************/
+/*                               M i s s i n g                                */
+/******************************************************************************/
+  
+bool XrdPssMDCache::Missing(const char *path, const std::string &scope)
+{
+   std::string key = MakeKey('s', path, &scope);
+   std::map<std::string,Entry *>::iterator it;
+   bool isMissing;
+
+   mdcCV.Lock();
+   it = mdcMap.find(key);
+   isMissing = it != mdcMap.end() && !it->second->Pending
+            && it->second->Rc == -ENOENT && time(0) < it->second->Expires;
+   if (isMissing) Cnt.NegHits++;
+   mdcCV.UnLock();
+   return isMissing;
+}
+
+/******************************************************************************/
+/*                               R e l e a s e                                */
+/******************************************************************************/
+
+void XrdPssMDCache::Release(DirList *dP)
+{
+   mdcCV.Lock();
+   if (!(--dP->Refs)) delete dP;
+   mdcCV.UnLock();
+}
+
+/******************************************************************************/
+/* Private:                       R e m o v e                                 */
+/******************************************************************************/
+
+// Caller must hold mdcCV. All entries whose key starts with prefix are removed.
+//
+void XrdPssMDCache::Remove(const std::string &prefix)
+{
+   std::map<std::string,Entry *>::iterator it = mdcMap.lower_bound(prefix);
+   Entry *eP;
+
+   while(it != mdcMap.end() && !it->first.compare(0, prefix.size(), prefix))
+        {eP = it->second; ++it;
+         Cnt.Invals++; Drop(eP);
+        }
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+  
+int XrdPssMDCache::Stats(char *buff, int blen)
+{
+   static const char statfmt[] = "<stats id=\"pssmdc\"><num>%d</num>"
+          "<hits>%lld</hits><nhits>%lld</nhits><miss>%lld</miss>"
+          "<join>%lld</join><evict>%lld</evict><inval>%lld</inval></stats>";
+   int n;
+
+// If the caller wants the maximum length, then provide it.
+//
+   if (!blen) return sizeof(statfmt) + 10 + (6*19);
+
+// Format the statistics
+//
+   mdcCV.Lock();
+   n = snprintf(buff, blen, statfmt, numEnt, Cnt.Hits, Cnt.NegHits,
+                Cnt.Misses, Cnt.Joins, Cnt.Evicts, Cnt.Invals);
+   mdcCV.UnLock();
+   return (n < blen ? n : 0);
+}
+
+/******************************************************************************/
+/* Private:                        U n r e f                                  */
+/******************************************************************************/
+
+// Caller must hold mdcCV.
+//
+void XrdPssMDCache::Unref(Entry *eP)
+{
+   if (--eP->Refs) return;
+   if (eP->dList && !(--eP->dList->Refs)) delete eP->dList;
+   delete eP;
+}
@@ -0,0 +1,197 @@
+#ifndef __XRDPSSMDCACHE_HH__
+#define __XRDPSSMDCACHE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d P s s M D C a c h e . h h                       */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+
+#include <map>
+#include <string>
+#include <vector>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+//-----------------------------------------------------------------------------
+//! The XrdPssMDCache object caches stat() results and directory listings
+//! obtained from the origin. Positive and negative (i.e. ENOENT) results are
+//! kept for separate periods of time. Concurrent lookups of the same item are
+//! coalesced so that only one request is sent to the origin while the others
+//! wait for its result. The number of cached items is bounded and the least
+//! recently used item is evicted when the bound is reached. Local changes to
+//! the namespace must be reported via Invalidate().
+//!
+//! The origin's answer may depend on who asks and how, so each item is also
+//! keyed by a scope. The scope holds the client identity, when it is presented
+//! to the origin, and the client's cgi (e.g. an authorization token). Items
+//! are only shared between requests with the same scope.
+//-----------------------------------------------------------------------------
+
+class XrdPssMDCache
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! A directory listing. Listings are shared between the cache and any number
+//! of open directories and must be returned via Release() when no longer used.
+//-----------------------------------------------------------------------------
+
+struct DirList
+      {std::vector<std::string> Names;
+       int                      Refs;
+       DirList() : Refs(1) {}
+      };
+
+//-----------------------------------------------------------------------------
+//! Obtain a directory listing.
+//!
+//! @param  path   the logical path of the directory (i.e. the cache key).
+//! @param  scope  the scope of the request (see above).
+//! @param  url    the url to use should the origin need to be contacted.
+//! @param  rc     upon failure, holds -errno.
+//!
+//! @return Upon success a pointer to the listing is returned. Otherwise, nil
+//!         is returned and rc holds the reason.
+//-----------------------------------------------------------------------------
+
+DirList *GetDir(const char *path, const std::string &scope, const char *url,
+                int &rc);
+
+//-----------------------------------------------------------------------------
+//! Obtain stat() information.
+//!
+//! @param  path   the logical path of the file (i.e. the cache key).
+//! @param  scope  the scope of the request (see above).
+//! @param  url    the url to use should the origin need to be contacted.
+//! @param  buff   the stat structure to receive the information.
+//!
+//! @return 0 upon success and -errno upon failure.
+//-----------------------------------------------------------------------------
+
+int      GetStat(const char *path, const std::string &scope, const char *url,
+                 struct stat *buff);
+
+//-----------------------------------------------------------------------------
+//! Discard anything cached for a path, in any scope, along with its parent's
+//! listing.
+//!
+//! @param  path   the logical path that was locally changed.
+//-----------------------------------------------------------------------------
+
+void     Invalidate(const char *path);
+
+//-----------------------------------------------------------------------------
+//! Check whether a path is known not to exist.
+//!
+//! @param  path   the logical path of the file.
+//! @param  scope  the scope of the request (see above).
+//!
+//! @return true if a valid negative entry exists and false otherwise.
+//-----------------------------------------------------------------------------
+
+bool     Missing(const char *path, const std::string &scope);
+
+//-----------------------------------------------------------------------------
+//! Release a directory listing obtained via GetDir().
+//-----------------------------------------------------------------------------
+
+void     Release(DirList *dP);
+
+//-----------------------------------------------------------------------------
+//! Produce cache statistics.
+//!
+//! @param  buff   pointer to the buffer for the statistics. When blen is zero
+//!                the maximum length needed is returned.
+//! @param  blen   the length of the buffer.
+//!
+//! @return The number of bytes placed in buff or 0 if it was too small.
+//-----------------------------------------------------------------------------
+
+int      Stats(char *buff, int blen);
+
+//-----------------------------------------------------------------------------
+//! Constructor
+//!
+//! @param  maxEnt  maximum number of items to keep.
+//! @param  posTTL  seconds that positive results remain valid.
+//! @param  negTTL  seconds that negative results remain valid.
+//! @param  dirTTL  seconds that directory listings remain valid.
+//! @param  dirMax  largest directory listing that will be cached.
+//-----------------------------------------------------------------------------
+
+         XrdPssMDCache(int maxEnt, int posTTL, int negTTL, int dirTTL,
+                       int dirMax);
+
+        ~XrdPssMDCache() {} // Never deleted
+
+private:
+
+struct Entry
+      {Entry         *Prev;
+       Entry         *Next;
+       std::string    Key;
+       DirList       *dList;
+       time_t         Expires;
+       struct stat    sBuff;
+       int            Refs;
+       int            Rc;
+       bool           inMap;
+       bool           Pending;
+
+       Entry(const std::string &key) : Prev(0), Next(0), Key(key), dList(0),
+                                       Expires(0), Refs(1), Rc(0),
+                                       inMap(true), Pending(true) {}
+      ~Entry() {}
+      };
+
+Entry   *Begin(const std::string &key, bool &isHit);
+void     Drop(Entry *eP);
+void     Finish(Entry *eP, int ttl);
+std::string MakeKey(char type, const std::string &path,
+                    const std::string *scope=0);
+void     Remove(const std::string &prefix);
+void     Unref(Entry *eP);
+
+XrdSysCondVar                 mdcCV;
+std::map<std::string,Entry *> mdcMap;
+Entry                        *lruHead;
+Entry                        *lruTail;
+int                           numEnt;
+int                           maxEnt;
+int                           posTTL;
+int                           negTTL;
+int                           dirTTL;
+int                           dirMax;
+
+struct {long long Hits;       // Valid positive entry found
+        long long NegHits;    // Valid negative entry found
+        long long Misses;     // Origin was contacted
+        long long Joins;      // Waited for someone else's origin request
+        long long Evicts;     // Entries evicted to stay within bounds
+        long long Invals;     // Entries discarded because of local changes
+       } Cnt;
+};
+#endif
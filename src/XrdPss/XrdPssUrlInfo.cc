@@ -109,7 +109,7 @@ int copyCGI(const char *cgi, char *Buff, int Blen)
 XrdPssUrlInfo::XrdPssUrlInfo(XrdOucEnv  *envP, const char *path,
                              const char *xtra, bool addusrcgi, bool addident)
                : Path(path), CgiUsr(""), CgiUsz(0), CgiSsz(0), sidP(0),
-                 eIDvalid(false)
+                 eIDvalid(false), idMapped(false)
 {
    const char *amp1= "", *amp2 = "";
 
@@ -224,8 +224,10 @@ void XrdPssUrlInfo::setID(const char *tid)
    if (MapID && eIDvalid)
       {const char *fmt = (entityID & 0xf0000000 ? "%x@" : "U%x@");
        snprintf(theID,  sizeof(theID), fmt, entityID); // 8+1+nul = 10 bytes
+       idMapped = true;
        return;
       }
+   idMapped = false;
 
 // Use the connection file descriptor number as the id lgnid.pid:fd@host
 //
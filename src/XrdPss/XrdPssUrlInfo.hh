@@ -46,10 +46,13 @@ const char *getID() {return theID;}
 
       bool  hasCGI() {return CgiSsz || CgiUsz;}
 
+      bool  isMapped() {return idMapped;}
+
       void  setID(const char *tid=0);
 
       void  setID(XrdOucSid *sP)
-                 {if (sP != 0 && !(sP->Obtain(&idVal))) return;
+                 {idMapped = false;
+                  if (sP != 0 && !(sP->Obtain(&idVal))) return;
                   sidP = sP;
                   snprintf(theID, sizeof(theID), "p%d@", idVal.sidS);
                  }
@@ -60,6 +63,8 @@ const char *thePath() {return Path;}
 
 const char *Tident() {return tident;}
 
+const char *usrCGI() {return CgiUsr;}
+
       XrdPssUrlInfo(XrdOucEnv *envP, const char *path, const char *xtra="",
                     bool addusrcgi=true, bool addident=true);
 
@@ -78,6 +83,7 @@ const char       *CgiUsr;
 unsigned
       int         entityID;
       bool        eIDvalid;
+      bool        idMapped;
       char        theID[13];
 XrdOucSid::theSid idVal;
       char        CgiSfx[512];
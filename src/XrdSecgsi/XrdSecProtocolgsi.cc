@@ -39,6 +39,7 @@
 #include <fcntl.h>
 #include <dirent.h>
 #include <iostream>
+#include <utility>
 
 #include "XrdVersion.hh"
 
@@ -176,6 +177,8 @@ int    XrdSecProtocolgsi::VOMSCertFmt = -1;
 int    XrdSecProtocolgsi::MonInfoOpt = 0;
 bool   XrdSecProtocolgsi::HashCompatibility = 1;
 bool   XrdSecProtocolgsi::TrustDNS = false;
+int    XrdSecProtocolgsi::ChainCacheSize = 1000;
+bool   XrdSecProtocolgsi::UseECDH = false;
 //
 // Crypto related info
 int  XrdSecProtocolgsi::ncrypt    = 0;                 // Number of factories
@@ -190,6 +193,9 @@ XrdSutCache  XrdSecProtocolgsi::cacheCert(8,13); // Server certificates info cac
 XrdSutCache  XrdSecProtocolgsi::cachePxy(8,13);  // Client proxies cache (Fibonacci-based sizes)
 XrdSutCache  XrdSecProtocolgsi::cacheGMAPFun; // Entries mapped by GMAPFun (default size 144)
 XrdSutCache  XrdSecProtocolgsi::cacheAuthzFun; // Entities filled by AuthzFun (default size 144)
+XrdOucHash<time_t> XrdSecProtocolgsi::cacheChain; // Verified client chains
+XrdSysMutex  XrdSecProtocolgsi::mutexChain;
+int          XrdSecProtocolgsi::CRLGeneration = 0;
 //
 // Services
 XrdOucGMap *XrdSecProtocolgsi::servGMap = 0; // Grid map service
@@ -673,6 +679,22 @@ char *XrdSecProtocolgsi::Init(gsiOptions opt, XrdOucErrInfo *erp)
          }
       }
 
+      //
+      // Cache of verified client chains
+      ChainCacheSize = (opt.chaincache > 0) ? opt.chaincache : 0;
+      DEBUG("verified client chains cache size: "<<ChainCacheSize);
+
+      //
+      // Key agreement: ECDH with the clients supporting it, if requested
+      UseECDH = (opt.ecdh > 0);
+      if (UseECDH) {
+         for (int i = 0; i < ncrypt; i++) {
+            if (!cryptF[i]->HasECDHSupport())
+               PRINT("crypto module "<<cryptName[i]<<" does not support ECDH: DH will be used");
+         }
+         DEBUG("ECDH key agreement enabled");
+      }
+
       //
       // Load server certificate and key
       if (opt.cert) {
@@ -2327,6 +2349,8 @@ void gsiOptions::Print(XrdOucTrace *t)
       POPTS(t, " MonInfo option: "<< moninfo);
       if (!hashcomp)
          POPTS(t, " Name hashing algorithm compatibility OFF");
+      POPTS(t, " Verified client chains cache size: "<< chaincache);
+      POPTS(t, " Key agreement: "<< (ecdh > 0 ? "ECDH (X25519), if supported by the client" : "DH"));
    }
    // Crypto options
    POPTS(t, " Crypto modules: "<< (clist ? clist : XrdSecProtocolgsi::DefCrypto));
@@ -2575,6 +2599,8 @@ char *XrdSecProtocolgsiInit(const char mode,
       //              [-vomsfunparms:<voms_function_init_parameters>]
       //              [-defaulthash]
       //              [-trustdns:<0|1>]
+      //              [-chaincache:<max_verified_chains>]
+      //              [-ecdh:<0|1>]
       //
       int debug = -1;
       String clist = "";
@@ -2606,6 +2632,8 @@ char *XrdSecProtocolgsiInit(const char mode,
       int moninfo = 0;
       int hashcomp = 1;
       int trustdns = false;
+      int chaincache = 1000;
+      int ecdh = 0;
       char *op = 0;
       while (inParms.GetLine()) { 
          while ((op = inParms.GetToken())) {
@@ -2674,6 +2702,10 @@ char *XrdSecProtocolgsiInit(const char mode,
                hashcomp = 0;
             } else if (!strncmp(op, "-trustdns:",10)) {
                trustdns = getOptVal(tdnsOpts, op+10);
+            } else if (!strncmp(op, "-chaincache:",12)) {
+               chaincache = atoi(op+12);
+            } else if (!strncmp(op, "-ecdh:",6)) {
+               ecdh = atoi(op+6);
             } else {
                PRINT("ignoring unknown switch: "<<op);
             }
@@ -2706,6 +2738,8 @@ char *XrdSecProtocolgsiInit(const char mode,
       opts.vomsat = vomsat;
       opts.moninfo = moninfo;
       opts.hashcomp = hashcomp;
+      opts.chaincache = (chaincache > 0) ? chaincache : 0;
+      opts.ecdh = ecdh;
       opts.trustdns = (trustdns <= 0) ? false : true;
       if (clist.length() > 0)
          opts.clist = (char *)clist.c_str();
@@ -3790,13 +3824,47 @@ int XrdSecProtocolgsi::ServerDoCert(XrdSutBuffer *br,  XrdSutBuffer **bm,
       return -1;
    }
    //
+   // Chains already verified since the last CA / CRL reload need not be
+   // verified again: the fingerprint covers the received certificates and
+   // the CA used to check them
+   char chainfp[2*64+1] = {0};
+   bool verified = false;
+   if (ChainCacheSize > 0) {
+      XrdCryptoMsgDigest *md = sessionCF->MsgDigest("sha256");
+      if (md) {
+         const char *cahash = hs->Chain->Begin() ? hs->Chain->Begin()->SubjectHash() : 0;
+         md->Update(bck->buffer, bck->size);
+         if (cahash) md->Update(cahash, strlen(cahash));
+         if (md->Final() == 0 && md->Length() <= 64 &&
+             XrdSutToHex(md->Buffer(), md->Length(), chainfp) == 0 &&
+             ChainCacheGet(chainfp)) {
+            // Put the chain in order, as Verify() would do
+            if (hs->Chain->Reorder() == 0) {
+               verified = true;
+               DEBUG("client chain found in the verified chains cache");
+            }
+         }
+         delete md;
+      }
+   }
+   //
    // Verify the chain
-   x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
-   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
-   if (!(hs->Chain->Verify(ecode, &vopt))) {
-      cmsg = "certificate chain verification failed: ";
-      cmsg += hs->Chain->LastError();
-      return -1;
+   if (!verified) {
+      x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
+      XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
+      if (!(hs->Chain->Verify(ecode, &vopt))) {
+         cmsg = "certificate chain verification failed: ";
+         cmsg += hs->Chain->LastError();
+         return -1;
+      }
+      //
+      // Cache it until the first of its certificates expires
+      if (chainfp[0]) {
+         time_t expiry = 0;
+         for (XrdCryptoX509 *c = hs->Chain->Begin(); c; c = hs->Chain->Next())
+            if (!expiry || c->NotAfter() < expiry) expiry = c->NotAfter();
+         ChainCacheAdd(chainfp, expiry, hs->CRLGen);
+      }
    }
 
    //
@@ -4570,6 +4638,76 @@ static bool GetCACheck(XrdSutCacheEntry *e, void *a) {
    return false;
 }
 
+//______________________________________________________________________________
+int XrdSecProtocolgsi::ChainCacheGen()
+{
+   // Return the current CA / CRL generation. It must be taken before getting
+   // the CA and CRL used to verify a chain, and passed to ChainCacheAdd().
+   XrdSysMutexHelper mh(mutexChain);
+
+   return CRLGeneration;
+}
+
+//______________________________________________________________________________
+bool XrdSecProtocolgsi::ChainCacheGet(const char *fp)
+{
+   // Check if a chain with fingerprint 'fp' has already been verified
+   XrdSysMutexHelper mh(mutexChain);
+
+   return (cacheChain.Find(fp) != 0);
+}
+
+//______________________________________________________________________________
+static int ChainCacheOldest(const char *key, time_t *expiry, void *arg)
+{
+   // Find the entry expiring first
+   std::pair<String, time_t> *oldest = (std::pair<String, time_t> *)arg;
+
+   if (oldest->first.length() <= 0 || *expiry < oldest->second) {
+      oldest->first = key;
+      oldest->second = *expiry;
+   }
+   return 0;
+}
+
+//______________________________________________________________________________
+void XrdSecProtocolgsi::ChainCacheAdd(const char *fp, time_t expiry, int crlgen)
+{
+   // Record that the chain with fingerprint 'fp' has been verified; the entry
+   // is valid until 'expiry'. Nothing is recorded if CA or CRL information
+   // was reloaded after generation 'crlgen'.
+   EPNAME("ChainCacheAdd");
+   XrdSysMutexHelper mh(mutexChain);
+
+   time_t now = time(0);
+   if (crlgen != CRLGeneration || expiry <= now) return;
+
+   // Make room if we are full: expired entries go away as we scan the
+   // table, otherwise the one expiring first is dropped
+   if (cacheChain.Num() >= ChainCacheSize) {
+      std::pair<String, time_t> oldest("", 0);
+      cacheChain.Apply(ChainCacheOldest, (void *)&oldest);
+      if (cacheChain.Num() >= ChainCacheSize && oldest.first.length() > 0)
+         cacheChain.Del(oldest.first.c_str());
+   }
+   cacheChain.Rep(fp, new time_t(expiry), expiry - now);
+   DEBUG("verified chains cached: "<<cacheChain.Num());
+}
+
+//______________________________________________________________________________
+void XrdSecProtocolgsi::ChainCacheFlush()
+{
+   // Drop all the verified chains (CA or CRL information was reloaded)
+   EPNAME("ChainCacheFlush");
+   XrdSysMutexHelper mh(mutexChain);
+
+   CRLGeneration++;
+   if (cacheChain.Num() > 0) {
+      DEBUG("dropping "<<cacheChain.Num()<<" verified chains");
+      cacheChain.Purge();
+   }
+}
+
 //______________________________________________________________________________
 int XrdSecProtocolgsi::GetCA(const char *cahash,
                              XrdCryptoFactory *cf, gsiHSVars *hs)
@@ -4635,6 +4773,7 @@ int XrdSecProtocolgsi::GetCA(const char *cahash,
    }
 
    // Cleanup and remove existing invalid entries
+   bool reload = (chain || crl);
    if (chain) stackCA.Del(chain);
    if (crl) stackCRL.Del(crl);
 
@@ -4687,6 +4826,8 @@ int XrdSecProtocolgsi::GetCA(const char *cahash,
          }
          //
          if (ok) {
+            // Chains verified with the previous CA / CRL are suspect now
+            if (reload) ChainCacheFlush();
             // Add to the cache
             cent->buf1.buf = (char *)(chain);
             cent->buf1.len = 0;      // Just a flag
@@ -4856,6 +4997,9 @@ int XrdSecProtocolgsi::ParseCAlist(String calist)
    // Load module and define relevant pointers
    hs->Chain = 0;
    String cahash = "";
+   // A chain verified against the CRL we get can only be cached if the CA and
+   // CRL are not reloaded in the meantime: note the generation beforehand
+   hs->CRLGen = ChainCacheGen();
    // Parse list
    if (calist.length()) {
       int from = 0;
@@ -4937,8 +5081,15 @@ int XrdSecProtocolgsi::ParseCrypto(String clist)
                   ncrypt++;
                }
             }
-            // On servers the ref cipher should be defined at this point
-            hs->Rcip = sessionCF->Cipher(hs->HasPad, 0,0,0);
+            // On servers the ref cipher should be defined at this point;
+            // ECDH if enabled and understood by the client
+            if (srvMode && UseECDH && hs->RemVers >= XrdSecgsiVersECDH &&
+                sessionCF->HasECDHSupport()) {
+               hs->Rcip = sessionCF->ECDHCipher();
+               DEBUG("using ECDH key agreement");
+            } else {
+               hs->Rcip = sessionCF->Cipher(hs->HasPad, 0,0,0);
+            }
             // we are done
             return 0;
          }
@@ -63,7 +63,7 @@ typedef XrdCryptogsiX509Chain X509Chain;
   
 #define XrdSecPROTOIDENT    "gsi"
 #define XrdSecPROTOIDLEN    sizeof(XrdSecPROTOIDENT)
-#define XrdSecgsiVERSION    10400
+#define XrdSecgsiVERSION    10500
 #define XrdSecNOIPCHK       0x0001
 #define XrdSecDEBUG         0x1000
 #define XrdCryptoMax        10
@@ -73,6 +73,8 @@ typedef XrdCryptogsiX509Chain X509Chain;
 
 #define XrdSecgsiVersDHsigned  10400  // Version at which started signing
                                       // of server DH parameters 
+#define XrdSecgsiVersECDH      10500  // Version at which clients accept
+                                      // an ECDH (X25519) key agreement
 
 //
 // Message codes either returned by server or included in buffers
@@ -205,6 +207,8 @@ public:
    char  *vomsfunparms;// [s] parameters for the function to fill VOMS [0]
    int    moninfo; // [s] 0 do not look for; 1 use DN as default
    int    hashcomp; // [cs] 1 send hash names with both algorithms; 0 send only the default [1]
+   int    chaincache; // [s] max number of verified client chains to cache; 0 disables [1000]
+   int    ecdh;   // [s] 1 use ECDH key agreement with clients supporting it [0]
 
    bool   trustdns; // [cs] 'true' if DNS is trusted [true]
 
@@ -218,7 +222,8 @@ public:
                   ogmap = 1; dlgpxy = 0; sigpxy = 1; srvnames = 0;
                   exppxy = 0; authzpxy = 0;
                   vomsat = 1; vomsfun = 0; vomsfunparms = 0; moninfo = 0;
-                  hashcomp = 1; trustdns = true;}
+                  hashcomp = 1; chaincache = 1000; ecdh = 0;
+                  trustdns = true;}
    virtual ~gsiOptions() { } // Cleanup inside XrdSecProtocolgsiInit
    void Print(XrdOucTrace *t); // Print summary of gsi option status
 };
@@ -353,6 +358,8 @@ private:
    static int              MonInfoOpt;
    static bool             HashCompatibility;
    static bool             TrustDNS;
+   static int              ChainCacheSize;
+   static bool             UseECDH;
    //
    // Crypto related info
    static int              ncrypt;                  // Number of factories
@@ -368,6 +375,13 @@ private:
    static XrdSutCache   cacheGMAPFun; // Cache for entries mapped by GMAPFun
    static XrdSutCache   cacheAuthzFun; // Cache for entities filled by AuthzFun
    //
+   // Verified client chains, keyed by fingerprint; entries live until
+   // the first certificate in the chain expires and are all dropped
+   // when CA or CRL information is reloaded
+   static XrdOucHash<time_t> cacheChain;
+   static XrdSysMutex      mutexChain;
+   static int              CRLGeneration; // Bumped at each reload
+   //
    // Services
    static XrdOucGMap      *servGMap;  // Grid mapping service 
    //
@@ -441,6 +455,12 @@ private:
                                        XrdCryptoFactory *cf,
                                        time_t timestamp, String &cal);
 
+   // Cache of verified client chains
+   static int     ChainCacheGen();
+   static bool    ChainCacheGet(const char *fp);
+   static void    ChainCacheAdd(const char *fp, time_t expiry, int crlgen);
+   static void    ChainCacheFlush();
+
    // Load CRLs
    static XrdCryptoX509Crl *LoadCRL(XrdCryptoX509 *xca, const char *sjhash,
                                     XrdCryptoFactory *CF, int dwld, int &err);
@@ -503,6 +523,7 @@ public:
    XrdSutPFEntry    *Pent;          // Pointer to relevant file entry 
    X509Chain        *Chain;         // Chain to be eventually verified 
    XrdCryptoX509Crl *Crl;           // Pointer to CRL, if required 
+   int               CRLGen;        // CA / CRL generation before getting Crl
    X509Chain        *PxyChain;      // Proxy Chain on clients
    bool              RtagOK;        // Rndm tag checked / not checked
    bool              Tty;           // Terminal attached / not attached
@@ -514,7 +535,7 @@ public:
    gsiHSVars() { Iter = 0; TimeStamp = -1; CryptoMod = "";
                  RemVers = -1; Rcip = 0; HasPad = 0;
                  Cbck = 0;
-                 ID = ""; Cref = 0; Pent = 0; Chain = 0; Crl = 0; PxyChain = 0;
+                 ID = ""; Cref = 0; Pent = 0; Chain = 0; Crl = 0; CRLGen = 0; PxyChain = 0;
                  RtagOK = 0; Tty = 0; LastStep = 0; Options = 0; HashAlg = 0; Parms = 0;}
 
    ~gsiHSVars() { SafeDelete(Cref);
@@ -61,6 +61,7 @@ add_library(
 #-------------------------------------------------------------------------------
   XrdOfs/XrdOfs.cc              XrdOfs/XrdOfs.hh
   XrdOfs/XrdOfsChkPnt.cc        XrdOfs/XrdOfsChkPnt.hh
+  XrdOfs/XrdOfsCksWrite.cc      XrdOfs/XrdOfsCksWrite.hh
   XrdOfs/XrdOfsConfig.cc
   XrdOfs/XrdOfsConfigCP.cc      XrdOfs/XrdOfsConfigCP.hh
   XrdOfs/XrdOfsConfigPI.cc      XrdOfs/XrdOfsConfigPI.hh
@@ -73,6 +74,7 @@ add_library(
                                 XrdOfs/XrdOfsFSctl_PI.hh
   XrdOfs/XrdOfsHandle.cc        XrdOfs/XrdOfsHandle.hh
   XrdOfs/XrdOfsPoscq.cc         XrdOfs/XrdOfsPoscq.hh
+  XrdOfs/XrdOfsReadShare.cc     XrdOfs/XrdOfsReadShare.hh
                                 XrdOfs/XrdOfsSecurity.hh
   XrdOfs/XrdOfsStats.cc         XrdOfs/XrdOfsStats.hh
   XrdOfs/XrdOfsTPC.cc           XrdOfs/XrdOfsTPC.hh
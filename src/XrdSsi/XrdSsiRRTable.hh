@@ -29,10 +29,22 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
-#include <map>
 #include <stdint.h>
 
 #include "XrdSsi/XrdSsiAtomics.hh"
+
+//-----------------------------------------------------------------------------
+//! The request table is an open-addressed (linear probing) hash table keyed
+//! by request ID. Lookups, which are by far the most frequent operation, do
+//! not take a lock. Instead, all updates are serialized by a mutex and are
+//! bracketed by a sequence counter (i.e. a seqlock). A lookup that overlaps an
+//! update simply retries and, should that keep happening, falls back to the
+//! mutex. Deletions use backward shifting so there are no tombstones. When the
+//! table needs to grow a new one is built and published; the old one remains
+//! readable by in-flight lookups and is only freed when the table is deleted.
+//! Since tables only double in size the memory held this way is bounded by
+//! the size of the current table.
+//-----------------------------------------------------------------------------
   
 template<class T>
 class XrdSsiRRTable
@@ -40,61 +52,166 @@ class XrdSsiRRTable
 public:
 
 void  Add(T *item, uint64_t itemID)
-         {rrtMutex.Lock();
-          if (baseItem != 0) theMap[itemID] = item;
-             else {baseKey  = itemID;
-                   baseItem = item;
-                  }
-          rrtMutex.UnLock();
+         {XrdSsiMutexMon lck(rrtMutex);
+          rrTab *tP = Atomic_GET(curTab);
+          int n;
+          if ((n = Find(tP, itemID)) >= 0)
+             {Begin();
+              Atomic_SET(tP->slot[n].item, item);
+              End();
+              return;
+             }
+          Begin();
+          if ((Atomic_GET(numItems)+1)*4 > (tP->mask+1)*3) tP = Grow(tP);
+          n = Hash(itemID) & tP->mask;
+          while(Atomic_GET(tP->slot[n].item)) n = (n+1) & tP->mask;
+          Atomic_SET(tP->slot[n].key,  itemID);
+          Atomic_SET(tP->slot[n].item, item);
+          End();
+          Atomic_INC(numItems);
          }
 
-void  Clear() {rrtMutex.Lock(); theMap.clear(); rrtMutex.UnLock();}
+void  Clear() {XrdSsiMutexMon lck(rrtMutex); Zap(false);}
 
 void  Del(uint64_t itemID, bool finit=false)
          {XrdSsiMutexMon lck(rrtMutex);
-          if (baseItem && baseKey == itemID)
-             {if (finit) baseItem->Finalize();
-              baseItem = 0;
-             } else {
-              if (!finit) theMap.erase(itemID);
-                 else {typename std::map<uint64_t,T*>::iterator it = theMap.find(itemID);
-                       if (it != theMap.end()) it->second->Finalize();
-                       theMap.erase(it);
-                      }
-             }
+          rrTab *tP = Atomic_GET(curTab);
+          int n;
+          if ((n = Find(tP, itemID)) < 0) return;
+          if (finit) Atomic_GET(tP->slot[n].item)->Finalize();
+          Begin();
+          Remove(tP, n);
+          End();
+          Atomic_DEC(numItems);
          }
 
 T    *LookUp(uint64_t itemID)
-            {XrdSsiMutexMon lck(rrtMutex);
-             if (baseItem && baseKey == itemID) return baseItem;
-             typename std::map<uint64_t,T*>::iterator it = theMap.find(itemID);
-             return (it == theMap.end() ? 0 : it->second);
+            {rrTab *tP;
+             T     *item;
+             int    n;
+#ifndef NEED_ATOMIC_MUTEX
+             uint64_t seqNum;
+             int      k;
+             for (int i = 0; i < maxTries; i++)
+                 {seqNum = Atomic_GET_STRICT(updSeq);
+                  if (seqNum & 1) continue;
+                  tP = Atomic_GET_STRICT(curTab);
+                  n  = Hash(itemID) & tP->mask;
+                  for (k = 0; k <= tP->mask; k++)
+                      {if (!(item = Atomic_GET(tP->slot[n].item))) break;
+                       if (Atomic_GET(tP->slot[n].key) == itemID) break;
+                       n = (n+1) & tP->mask;
+                      }
+                  if (k > tP->mask) item = 0;
+                  Atomic_FENCE_ACQ();
+                  if (Atomic_GET(updSeq) == seqNum) return item;
+                 }
+#endif
+             XrdSsiMutexMon lck(rrtMutex);
+             tP = Atomic_GET(curTab);
+             item = ((n = Find(tP, itemID)) < 0 ? 0 : Atomic_GET(tP->slot[n].item));
+             return item;
             }
 
-int   Num() {return theMap.size() + (baseItem ? 1 : 0);}
+int   Num() {return Atomic_GET(numItems);}
 
-void  Reset()
-           {XrdSsiMutexMon lck(rrtMutex);
-            typename std::map<uint64_t, T*>::iterator it = theMap.begin();
-            while(it != theMap.end())
-                 {it->second->Finalize();
-                  it++;
-                 }
-            theMap.clear();
-            if (baseItem)
-               {baseItem->Finalize();
-                baseItem = 0;
-               }
-           }
+void  Reset() {XrdSsiMutexMon lck(rrtMutex); Zap(true);}
 
-      XrdSsiRRTable() : baseItem(0), baseKey(0) {}
+      XrdSsiRRTable() : curTab(new rrTab(minSlots)), updSeq(0), numItems(0) {}
 
-     ~XrdSsiRRTable() {Reset();}
+     ~XrdSsiRRTable() {Reset();
+                       rrTab *tP = Atomic_GET(curTab), *pP;
+                       while(tP) {pP = tP->prev; delete tP; tP = pP;}
+                      }
 
 private:
+
+static const int maxTries = 8;
+static const int minSlots = 16;  // Must be a power of two
+
+struct rrSlot {Atomic(uint64_t) key;
+               Atomic(T *)      item;
+               rrSlot() {Atomic_SET(key, 0); Atomic_SET(item, (T *)0);}
+              };
+
+struct rrTab  {rrTab  *prev;
+               rrSlot *slot;
+               int     mask;
+               rrTab(int n) : prev(0), slot(new rrSlot[n]), mask(n-1) {}
+              ~rrTab() {delete [] slot;}
+              };
+
+// All of the following methods must be called with rrtMutex held. Every
+// change to the table, including publishing a grown one, must be bracketed
+// by Begin() and End(). Only the fence macros are used here as these are
+// defined (as no-ops) even when atomics are emulated via a mutex, in which
+// case LookUp() always takes rrtMutex.
+//
+void  Begin() {Atomic_SET(updSeq, Atomic_GET(updSeq)+1); Atomic_FENCE_REL();}
+
+void  End()   {Atomic_FENCE_REL(); Atomic_SET(updSeq, Atomic_GET(updSeq)+1);}
+
+int   Find(rrTab *tP, uint64_t itemID)
+          {int n = Hash(itemID) & tP->mask;
+           while(Atomic_GET(tP->slot[n].item))
+                {if (Atomic_GET(tP->slot[n].key) == itemID) return n;
+                 n = (n+1) & tP->mask;
+                }
+           return -1;
+          }
+
+rrTab *Grow(rrTab *oldP)
+           {rrTab *newP = new rrTab((oldP->mask+1)*2);
+            T *item;
+            int n;
+            for (int i = 0; i <= oldP->mask; i++)
+                {if (!(item = Atomic_GET(oldP->slot[i].item))) continue;
+                 uint64_t key = Atomic_GET(oldP->slot[i].key);
+                 n = Hash(key) & newP->mask;
+                 while(Atomic_GET(newP->slot[n].item)) n = (n+1) & newP->mask;
+                 Atomic_SET(newP->slot[n].key,  key);
+                 Atomic_SET(newP->slot[n].item, item);
+                }
+            newP->prev = oldP;
+            Atomic_SET(curTab, newP);
+            return newP;
+           }
+
+static
+uint32_t Hash(uint64_t key)
+             {return static_cast<uint32_t>((key*0x9E3779B97F4A7C15ULL)>>32);}
+
+void  Remove(rrTab *tP, int i)
+            {int j = i, k;
+             while(1)
+                  {j = (j+1) & tP->mask;
+                   if (!Atomic_GET(tP->slot[j].item)) break;
+                   k = Hash(Atomic_GET(tP->slot[j].key)) & tP->mask;
+                   if (i <= j ? (i < k && k <= j) : (i < k || k <= j)) continue;
+                   Atomic_SET(tP->slot[i].key,  Atomic_GET(tP->slot[j].key));
+                   Atomic_SET(tP->slot[i].item, Atomic_GET(tP->slot[j].item));
+                   i = j;
+                  }
+             Atomic_SET(tP->slot[i].item, (T *)0);
+            }
+
+void  Zap(bool finit)
+         {rrTab *tP = Atomic_GET(curTab);
+          T *item;
+          Begin();
+          for (int i = 0; i <= tP->mask; i++)
+              {if ((item = Atomic_GET(tP->slot[i].item)))
+                  {if (finit) item->Finalize();
+                   Atomic_SET(tP->slot[i].item, (T *)0);
+                  }
+              }
+          End();
+          Atomic_ZAP(numItems);
+         }
+
 XrdSsiMutex              rrtMutex;
-T                       *baseItem;
-uint64_t                 baseKey;
-std::map<uint64_t, T*>   theMap;
+Atomic(rrTab *)          curTab;
+Atomic(uint64_t)         updSeq;
+Atomic(int)              numItems;
 };
 #endif
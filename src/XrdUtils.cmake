@@ -80,6 +80,7 @@ add_library(
   XrdOuc/XrdOucCallBack.cc      XrdOuc/XrdOucCallBack.hh
                                 XrdOuc/XrdOucChkPnt.hh
   XrdOuc/XrdOucCRC.cc           XrdOuc/XrdOucCRC.hh
+  XrdOuc/XrdOucCRC32.cc         XrdOuc/XrdOucCRC32.hh
   XrdOuc/XrdOucCRC32C.cc        XrdOuc/XrdOucCRC32C.hh
   XrdOuc/XrdOucEnv.cc           XrdOuc/XrdOucEnv.hh
                                 XrdOuc/XrdOucHash.hh
@@ -194,11 +195,13 @@ add_library(
   XrdCks/XrdCksAssist.cc           XrdCks/XrdCksAssist.hh
   XrdCks/XrdCksCalccrc32.cc        XrdCks/XrdCksCalccrc32.hh
   XrdCks/XrdCksCalcmd5.cc          XrdCks/XrdCksCalcmd5.hh
+  XrdCks/XrdCksCombine.cc          XrdCks/XrdCksCombine.hh
   XrdCks/XrdCksConfig.cc           XrdCks/XrdCksConfig.hh
   XrdCks/XrdCksLoader.cc           XrdCks/XrdCksLoader.hh
   XrdCks/XrdCksManager.cc          XrdCks/XrdCksManager.hh
   XrdCks/XrdCksManOss.cc           XrdCks/XrdCksManOss.hh
                                    XrdCks/XrdCksCalcadler32.hh
+                                   XrdCks/XrdCksCalccrc32c.hh
                                    XrdCks/XrdCksCalc.hh
                                    XrdCks/XrdCksData.hh
                                    XrdCks/XrdCks.hh
@@ -183,6 +183,7 @@
          "libXrdHttpTPC.so",         \
          "libXrdMacaroons.so",       \
          "libXrdN2No2p.so",          \
+         "libXrdOssRam.so",          \
          "libXrdOssSIgpfsT.so",      \
          "libXrdPfc.so",             \
          "libXrdPss.so",             \
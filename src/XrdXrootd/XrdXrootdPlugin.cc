@@ -57,11 +57,13 @@ XrdProtocol *XrdgetProtocol(const char *pname, char *parms,
                    kXR_PROTOCOLVSTRING, " version ", XrdVERSION);
    pi->eDest->Say("++++++ xrootd protocol initialization started.");
 
-// Return the protocol object to be used if static init succeeds
+// Return the protocol object to be used if static init succeeds. We implement
+// Inline() so tell the framework that it may call it.
 //
    if (XrdXrootdProtocol::Configure(parms, pi))
-      pp = (XrdProtocol *)new XrdXrootdProtocol();
-      else txt = "failed.";
+      {pp = (XrdProtocol *)new XrdXrootdProtocol();
+       pi->xrdFlags |= XrdProtocol_Config::inlOK;
+      } else txt = "failed.";
     pi->eDest->Say("------ xrootd protocol initialization ", txt);
    return pp;
 }
@@ -174,11 +174,13 @@ XrdProtocol *XrdgetProtocol(const char *pname, char *parms,
                    kXR_PROTOCOLVSTRING, " version ", XrdVERSION);
    pi->eDest->Say("++++++ xrootd protocol initialization started.");
 
-// Return the protocol object to be used if static init succeeds
+// Return the protocol object to be used if static init succeeds. We implement
+// Inline() so tell the framework that it may call it.
 //
    if (XrdXrootdProtocol::Configure(parms, pi))
-      pp = (XrdProtocol *)new XrdXrootdProtocol();
-      else txt = "failed.";
+      {pp = (XrdProtocol *)new XrdXrootdProtocol();
+       pi->xrdFlags |= XrdProtocol_Config::inlOK;
+      } else txt = "failed.";
     pi->eDest->Say("------ xrootd protocol initialization ", txt);
    return pp;
 }
@@ -249,6 +251,31 @@ unsigned int XrdXrootdProtocol::getSID()
    return theSid;
 }
   
+/******************************************************************************/
+/*                                I n l i n e                                 */
+/******************************************************************************/
+
+bool XrdXrootdProtocol::Inline(XrdLink *lp)
+{
+   ClientRequestHdr reqHdr;
+
+// Only a logged in, idle, unsigned clear text session qualifies. Anything else
+// may need to wait for data or do more than we are willing to do on a poller.
+//
+   if (Resume || !(Status & XRD_LOGGEDIN) || (Status & XRD_NEED_AUTH)
+   ||  Protect || sigHere || Link->hasTLS()) return false;
+
+// The whole request header must already be here and carry no argument
+//
+   if (Link->Peek((char *)&reqHdr, sizeof(reqHdr), 0) != (int)sizeof(reqHdr)
+   ||  reqHdr.dlen) return false;
+
+// Only a ping is guaranteed never to block. Even a handle based stat may go
+// to a remote server when the file system is a proxy or a cache.
+//
+   return ntohs(reqHdr.requestid) == kXR_ping;
+}
+
 /******************************************************************************/
 /*                                 M a t c h                                  */
 /******************************************************************************/
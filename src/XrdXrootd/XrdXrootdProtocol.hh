@@ -108,6 +108,8 @@ static int           Configure(char *parms, XrdProtocol_Config *pi);
 
        int           do_WriteSpan();
 
+       bool          Inline(XrdLink *lp);
+
        XrdProtocol  *Match(XrdLink *lp);
 
        int           Process(XrdLink *lp); //  Sync: Job->Link.DoIt->Process
@@ -2291,16 +2291,23 @@ int XrdXrootdProtocol::do_ReadAll(int asyncOK)
        return Response.Send(myFile->mmAddr+myOffset, xframt);
       }
 
-// If we are sendfile enabled, then just send the file if possible
-//
-   if (myFile->sfEnabled && !isTLS && myIOLen >= as_minsfsz
-   &&  myOffset+myIOLen <= myFile->Stats.fSize)
-      {myFile->Stats.rdOps(myIOLen);
-       if (myFile->fdNum >= 0)
-          return Response.Send(myFile->fdNum, myOffset, myIOLen);
+// If we are sendfile enabled, then just send the file if possible. The SSI
+// file system (i.e. the one supporting SfsXio) knows the extent of its data
+// and hands us memory buffers, so size and TLS limits do not apply to it.
+// Any other plugin using SendData() is subject to the usual checks.
+//
+   if (myFile->sfEnabled
+   &&  ((myFile->fdNum < 0 && (fsFeatures & XrdSfs::hasSXIO))
+    ||  (!isTLS && myIOLen >= as_minsfsz
+                && myOffset+myIOLen <= myFile->Stats.fSize)))
+      {if (myFile->fdNum >= 0)
+          {myFile->Stats.rdOps(myIOLen);
+           return Response.Send(myFile->fdNum, myOffset, myIOLen);
+          }
+       xframt = myIOLen;
        rc = myFile->XrdSfsp->SendData((XrdSfsDio *)this, myOffset, myIOLen);
        if (rc == SFS_OK)
-          {if (!myIOLen)    return 0;
+          {if (!myIOLen)    {myFile->Stats.rdOps(xframt); return 0;}
            if (myIOLen < 0) return -1;  // Otherwise retry using read()
           } else return fsError(rc, 0, myFile->XrdSfsp->error, 0, 0);
       }
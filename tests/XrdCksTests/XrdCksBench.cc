@@ -0,0 +1,254 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C k s B e n c h . c c                         */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <vector>
+
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCalccrc32c.hh"
+#include "XrdCks/XrdCksCalcmd5.hh"
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdOuc/XrdOucCRC32.hh"
+
+using namespace std;
+
+/* This micro-benchmark measures the throughput of each checksum calculation
+   for a range of common buffer sizes. It also verifies that the accelerated
+   CRC32 implementations agree with their portable fallbacks and with zlib and
+   exits with a non-zero status if they do not.
+
+   Usage: xrdcksbench [-t <secs>] [<bsize> [...]]
+
+   -t <secs>  the minimum time to spend on each measurement (default 0.25).
+   <bsize>    buffer size to measure, suffixed by k or m. The default is
+              4k 64k 1m 16m.
+*/
+
+/******************************************************************************/
+/*                          U n i t   G l o b a l s                           */
+/******************************************************************************/
+
+namespace
+{
+typedef void (*calcFunc)(const char *buff, int blen);
+
+uint32_t    crcVal;
+XrdCksCalc *calcObj = 0;
+const char *MeMe    = "xrdcksbench: ";
+
+void calcCks(const char *buff, int blen) {calcObj->Update(buff, blen);}
+
+void calcZlib(const char *buff, int blen)
+            {crcVal = crc32(crcVal, (const Bytef *)buff, blen);}
+
+void calcZsw(const char *buff, int blen)
+            {crcVal = crc32z_sw(crcVal, buff, blen);}
+
+void calcZhw(const char *buff, int blen)
+            {crcVal = XrdOucCRC::Calc32(buff, blen, crcVal);}
+
+void calcPsw(const char *buff, int blen)
+            {crcVal = crc32p_sw(crcVal, buff, blen);}
+
+void calcPhw(const char *buff, int blen)
+            {crcVal = XrdOucCRC::Calc32P(buff, blen, crcVal);}
+
+void calcTab(const char *buff, int blen)
+            {crcVal ^= XrdOucCRC::CRC32((const unsigned char *)buff, blen);}
+
+double Now()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec/1000000000.0;
+}
+}
+
+/******************************************************************************/
+/*                                 B e n c h                                  */
+/******************************************************************************/
+
+double Bench(calcFunc func, const char *buff, int blen, double minTime)
+{
+   double tBeg, tEnd;
+   long long nBytes = 0;
+   int i, n = (blen >= 64*1024*1024 ? 1 : (64*1024*1024)/blen);
+
+// Run the calculation until enough time has elapsed
+//
+   tBeg = Now();
+   do {for (i = 0; i < n; i++) func(buff, blen);
+       nBytes += static_cast<long long>(n) * blen;
+      } while((tEnd = Now()) - tBeg < minTime);
+
+// Return MB/s
+//
+   return nBytes / (tEnd - tBeg) / (1024.0*1024.0);
+}
+
+/******************************************************************************/
+/*                                V e r i f y                                 */
+/******************************************************************************/
+
+int Verify(const char *buff, int blen)
+{
+   uint32_t zref, cksReg, posReg;
+   int i, n, bad = 0;
+
+// Check all lengths up to a few blocks and some odd ones as well as every
+// starting alignment. The zlib CRC must match zlib and the POSIX register must
+// be the same whether or not it was folded.
+//
+   for (n = 0; n <= blen && n < 4096; n += (n < 512 ? 1 : 61))
+       for (i = 0; i < 16 && i + n <= blen; i++)
+           {zref = crc32(0, (const Bytef *)buff+i, n);
+            if (XrdOucCRC::Calc32(buff+i, n) != zref
+            ||  crc32z_sw(0, buff+i, n) != zref
+            ||  XrdOucCRC::CRC32((const unsigned char *)buff+i, n) != zref)
+               {if (!bad++) cerr <<MeMe <<"zcrc32 mismatch at offset " <<i
+                                 <<" length " <<n <<endl;
+               }
+            cksReg = crc32p_sw(static_cast<uint32_t>(n), buff+i, n);
+            posReg = XrdOucCRC::Calc32P(buff+i, n, static_cast<uint32_t>(n));
+            if (cksReg != posReg)
+               {if (!bad++) cerr <<MeMe <<"crc32 mismatch at offset " <<i
+                                 <<" length " <<n <<endl;
+               }
+           }
+
+// Check a full buffer
+//
+   if (XrdOucCRC::Calc32(buff, blen) != crc32(0, (const Bytef *)buff, blen)
+   ||  XrdOucCRC::Calc32P(buff, blen, 0) != crc32p_sw(0, buff, blen))
+      {cerr <<MeMe <<"mismatch for length " <<blen <<endl; bad++;}
+   return bad;
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char *argv[])
+{
+   struct {const char *name; XrdCksCalc *obj; calcFunc func;} calcs[] =
+          {{"adler32",           new XrdCksCalcadler32, calcCks},
+           {"crc32",             new XrdCksCalccrc32,   calcCks},
+           {"crc32 (slice-by-8)", 0,                    calcPsw},
+           {"crc32 (register)",  0,                     calcPhw},
+           {"crc32c",            new XrdCksCalccrc32c,  calcCks},
+           {"md5",               new XrdCksCalcmd5,     calcCks},
+           {"zcrc32",            0,                     calcZhw},
+           {"zcrc32 (slice-by-8)", 0,                   calcZsw},
+           {"zcrc32 (zlib)",     0,                     calcZlib},
+           {"zcrc32 (bytewise)", 0,                     calcTab}
+          };
+   static const int numCalcs = sizeof(calcs)/sizeof(calcs[0]);
+   vector<int> bSizes;
+   double minTime = 0.25;
+   char *buff, *eP;
+   int c, i, j, bMax = 0;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "t:")) != -1)
+        {if (c == 't' && (minTime = strtod(optarg, &eP)) > 0 && !*eP) continue;
+         cerr <<"Usage: xrdcksbench [-t <secs>] [<bsize> [...]]" <<endl;
+         return 2;
+        }
+
+// Get the buffer sizes
+//
+   for (i = optind; i < argc; i++)
+       {long long bsz = strtoll(argv[i], &eP, 10);
+             if (*eP == 'k' || *eP == 'K') {bsz *= 1024; eP++;}
+        else if (*eP == 'm' || *eP == 'M') {bsz *= 1024*1024; eP++;}
+        if (*eP || bsz <= 0 || bsz > 1024*1024*1024)
+           {cerr <<MeMe <<"invalid buffer size - " <<argv[i] <<endl;
+            return 2;
+           }
+        bSizes.push_back(static_cast<int>(bsz));
+       }
+   if (bSizes.empty())
+      {bSizes.push_back(4*1024);    bSizes.push_back(64*1024);
+       bSizes.push_back(1024*1024); bSizes.push_back(16*1024*1024);
+      }
+   for (i = 0; i < (int)bSizes.size(); i++)
+       if (bSizes[i] > bMax) bMax = bSizes[i];
+
+// Fill a buffer with random data
+//
+   if (!(buff = (char *)malloc(bMax)))
+      {cerr <<MeMe <<"unable to allocate buffer" <<endl; return 1;}
+   srand(static_cast<unsigned int>(time(0)));
+   for (i = 0; i < bMax; i++) buff[i] = static_cast<char>(rand());
+
+// Verify the implementations first
+//
+   if (Verify(buff, bMax)) return 1;
+   cout <<"crc32 implementations verified; folding is "
+        <<(crc32_hw() ? "" : "not ") <<"available." <<endl;
+
+// Run each calculation at each buffer size
+//
+   printf("%-20s", "MB/s");
+   for (j = 0; j < (int)bSizes.size(); j++)
+       {char hdr[32];
+        if (bSizes[j] % (1024*1024) == 0)
+           snprintf(hdr, sizeof(hdr), "%dm", bSizes[j]/(1024*1024));
+           else snprintf(hdr, sizeof(hdr), "%dk", bSizes[j]/1024);
+        printf("%10s", hdr);
+       }
+   printf("\n");
+
+   for (i = 0; i < numCalcs; i++)
+       {printf("%-20s", calcs[i].name);
+        calcObj = calcs[i].obj;
+        for (j = 0; j < (int)bSizes.size(); j++)
+            {crcVal = 0;
+             if (calcObj) calcObj->Init();
+             printf("%10.0f", Bench(calcs[i].func, buff, bSizes[j], minTime));
+             fflush(stdout);
+            }
+        printf("\n");
+        if (calcObj) calcObj->Recycle();
+       }
+
+// All done
+//
+   free(buff);
+   return 0;
+}
@@ -0,0 +1,334 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d C m s C a c h e B e n c h . c c                    */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Xrd/XrdScheduler.hh"
+#include "XrdCms/XrdCmsCache.hh"
+#include "XrdCms/XrdCmsRRQ.hh"
+#include "XrdCms/XrdCmsTrace.hh"
+#include "XrdOuc/XrdOucTrace.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+using namespace std;
+
+/* This benchmark drives the cms file location cache with a synthetic lookup
+   workload as seen by a busy redirector: many threads looking up random
+   paths with an occasional location update. It then takes a snapshot of the
+   cache, loads it into a fresh cache as a restarting redirector would, and
+   verifies that the locations survived only for nodes that came back. It
+   exits with a non-zero status if they did not.
+
+   Usage: xrdcmscachebench [-n <paths>] [-s <snapfile>] [-t <secs>]
+                           [<threads> [...]]
+
+   -n <paths>    the number of distinct paths (default 1000000).
+   -s <snapfile> the snapshot file (default /tmp/xrdcmscachebench.<pid>).
+   -t <secs>     the time to spend on each measurement (default 1).
+   <threads>     number of lookup threads to measure. The default is 1 2 4 8.
+
+   The request queue is stubbed out; lookups never wait for a response.
+*/
+
+/******************************************************************************/
+/*                       G l o b a l   O b j e c t s                          */
+/******************************************************************************/
+
+namespace XrdCms
+{
+XrdSysLogger  Logger;
+XrdSysError   Say(&Logger, "bench_");
+XrdOucTrace   Trace(&Say);
+XrdScheduler *Sched = 0;
+XrdCmsRRQ     RRQ;
+}
+
+using namespace XrdCms;
+
+/******************************************************************************/
+/*                 R e q u e s t   Q u e u e   S t u b s                      */
+/******************************************************************************/
+
+XrdCmsRRQSlot::XrdCmsRRQSlot() : Link(this) {}
+
+short XrdCmsRRQ::Add(short Snum, XrdCmsRRQInfo *ip) {return 0;}
+
+void  XrdCmsRRQ::Del(short Snum, const void *Key) {}
+
+int   XrdCmsRRQ::Ready(int Snum, const void *Key, SMask_t mask1, SMask_t mask2)
+                      {return 0;}
+
+/******************************************************************************/
+/*                          U n i t   G l o b a l s                           */
+/******************************************************************************/
+
+namespace
+{
+const char   *MeMe     = "xrdcmscachebench: ";
+const int     numNodes = 16;
+const int     nodePort = 1094;
+int           numPaths = 1000000;
+double        minTime  = 1.0;
+volatile bool Stop     = false;
+
+struct ThreadArg
+      {pthread_t          tid;
+       long long          Lookups;
+       long long          Updates;
+       unsigned int       Seed;
+      };
+
+double Now()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec/1000000000.0;
+}
+
+int MakePath(char *buff, int blen, int n)
+{
+   return snprintf(buff, blen, "/store/data/run%06d/file%04d.root",
+                   n / 1000, n % 1000);
+}
+
+void NodeName(char *buff, int blen, int n)
+{
+   snprintf(buff, blen, "srv%02d.example.org", n);
+}
+
+SMask_t NodeMask(int n)
+{
+   return (1ULL << (n % numNodes)) | (1ULL << ((n + 5) % numNodes));
+}
+
+inline unsigned int Next(unsigned int &x)
+{
+   x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+   return x;
+}
+
+void *Worker(void *carg)
+{
+   ThreadArg *tP = (ThreadArg *)carg;
+   char pBuff[128];
+   int n, plen;
+
+// Look up random paths; one in sixteen is a location update
+//
+   while(!Stop)
+        {n = Next(tP->Seed) % numPaths;
+         plen = MakePath(pBuff, sizeof(pBuff), n);
+         XrdCmsSelect Sel(0, pBuff, plen);
+         if (Next(tP->Seed) & 0xf)
+            {Cache.GetFile(Sel, ~SMask_t(0)); tP->Lookups++;}
+            else {Sel.Opts = XrdCmsSelect::Advisory;
+                  Cache.AddFile(Sel, NodeMask(n)); tP->Updates++;
+                 }
+        }
+   return (void *)0;
+}
+}
+
+/******************************************************************************/
+/*                                 B e n c h                                  */
+/******************************************************************************/
+
+double Bench(int numThreads)
+{
+   ThreadArg *tArg = new ThreadArg[numThreads];
+   long long nOps = 0;
+   double tBeg, tEnd;
+   int i;
+
+// Start all of the threads
+//
+   Stop = false;
+   tBeg = Now();
+   for (i = 0; i < numThreads; i++)
+       {tArg[i].Lookups = tArg[i].Updates = 0;
+        tArg[i].Seed    = 2463534242U + i*7919;
+        if (XrdSysThread::Run(&tArg[i].tid, Worker, (void *)&tArg[i],
+                              XRDSYSTHREAD_HOLD, "cache bench"))
+           {cerr <<MeMe <<"unable to start thread; " <<strerror(errno) <<endl;
+            exit(1);
+           }
+       }
+
+// Let them run and then collect the results
+//
+   usleep(static_cast<useconds_t>(minTime * 1000000));
+   Stop = true;
+   for (i = 0; i < numThreads; i++)
+       {XrdSysThread::Join(tArg[i].tid, 0);
+        nOps += tArg[i].Lookups + tArg[i].Updates;
+       }
+   tEnd = Now();
+
+// Return operations per second
+//
+   delete [] tArg;
+   return nOps / (tEnd - tBeg);
+}
+
+/******************************************************************************/
+/*                                V e r i f y                                 */
+/******************************************************************************/
+
+int Verify(XrdCmsCache &theCache, int badNode)
+{
+   char pBuff[128];
+   SMask_t hfVec, badMask = 1ULL << badNode;
+   int i, plen, bad = 0;
+
+// Every path must be found with all of its locations, except those on the
+// node that came back with a different configuration. As that node must now
+// be queried, each lookup is reported as being in progress.
+//
+   for (i = 0; i < numPaths; i++)
+       {plen = MakePath(pBuff, sizeof(pBuff), i);
+        XrdCmsSelect Sel(0, pBuff, plen);
+        hfVec = NodeMask(i) & ~badMask;
+        if (theCache.GetFile(Sel, ~SMask_t(0)) != -1 || Sel.Vec.hf != hfVec
+        ||  !(Sel.Vec.bf & badMask))
+           {if (!bad++) cerr <<MeMe <<"wrong locations for " <<pBuff <<endl;
+           }
+       }
+   return bad;
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char *argv[])
+{
+   XrdCmsCache *newCache;
+   char hBuff[64], pBuff[128], sBuff[1024], *snapFile = 0, *eP;
+   double tBeg, tEnd;
+   int c, i, n, plen, numThreads;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "n:s:t:")) != -1)
+        {switch(c)
+               {case 'n': numPaths = strtol(optarg, &eP, 10);
+                          if (numPaths > 0 && !*eP) continue;
+                          break;
+                case 's': snapFile = optarg;
+                          continue;
+                case 't': minTime = strtod(optarg, &eP);
+                          if (minTime > 0 && !*eP) continue;
+                          break;
+                default:  break;
+               }
+         cerr <<"Usage: xrdcmscachebench [-n <paths>] [-s <snapfile>] "
+                "[-t <secs>] [<threads> [...]]" <<endl;
+         return 2;
+        }
+   if (!snapFile)
+      {snprintf(sBuff, sizeof(sBuff), "/tmp/xrdcmscachebench.%d",
+                static_cast<int>(getpid()));
+       snapFile = sBuff;
+      }
+
+// Log in the nodes and fill the cache
+//
+   for (i = 0; i < numNodes; i++)
+       {NodeName(hBuff, sizeof(hBuff), i);
+        Cache.Bounce(1ULL << i, i, hBuff, nodePort, 1);
+       }
+   tBeg = Now();
+   for (i = 0; i < numPaths; i++)
+       {plen = MakePath(pBuff, sizeof(pBuff), i);
+        XrdCmsSelect Sel(0, pBuff, plen);
+        Cache.AddFile(Sel, NodeMask(i));
+       }
+   tEnd = Now();
+   printf("%d paths added in %.2f seconds; %d shards\n", numPaths,
+          tEnd - tBeg, XrdCmsCache::ShardNum);
+
+// Run the lookup workload for each number of threads
+//
+   printf("%8s %14s\n", "threads", "ops/s");
+   for (i = optind; i < argc || i == optind; i++)
+       {if (i < argc)
+           {numThreads = strtol(argv[i], &eP, 10);
+            if (*eP || numThreads <= 0 || numThreads > 1024)
+               {cerr <<MeMe <<"invalid thread count - " <<argv[i] <<endl;
+                return 2;
+               }
+            printf("%8d %14.0f\n", numThreads, Bench(numThreads));
+           } else {
+            for (numThreads = 1; numThreads <= 8; numThreads *= 2)
+                {printf("%8d %14.0f\n", numThreads, Bench(numThreads));
+                 fflush(stdout);
+                }
+           }
+       }
+
+// Take a snapshot
+//
+   unlink(snapFile);
+   Cache.Init(8*60*60, 5, 5, 0, 0, snapFile, 3600);
+   tBeg = Now();
+   n = Cache.Save();
+   tEnd = Now();
+   printf("snapshot of %d locations written in %.2f seconds\n", n, tEnd-tBeg);
+
+// Load it into a new cache, as a restarted redirector would
+//
+   newCache = new XrdCmsCache;
+   tBeg = Now();
+   newCache->Init(8*60*60, 5, 5, 0, 0, snapFile, 3600);
+   tEnd = Now();
+   printf("snapshot loaded in %.2f seconds\n", tEnd - tBeg);
+
+// The nodes log in again, but one of them has a new configuration
+//
+   for (i = 0; i < numNodes; i++)
+       {NodeName(hBuff, sizeof(hBuff), i);
+        if (newCache->Slot4(hBuff, nodePort) != i)
+           {cerr <<MeMe <<hBuff <<" not assigned its old slot" <<endl;
+            return 1;
+           }
+        newCache->Bounce(1ULL << i, i, hBuff, nodePort, (i == 3 ? 2 : 1));
+       }
+   i = Verify(*newCache, 3);
+   unlink(snapFile);
+   if (i) return 1;
+   printf("snapshot locations verified\n");
+   return 0;
+}
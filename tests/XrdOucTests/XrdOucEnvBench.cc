@@ -0,0 +1,260 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O u c E n v B e n c h . c c                      */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucHash.hh"
+
+using namespace std;
+
+/* This micro-benchmark measures how fast XrdOucEnv parses the cgi strings a
+   redirector typically sees and compares it to the previous implementation,
+   which duplicated every value into an XrdOucHash. It also verifies that the
+   variables are found as expected and exits with a non-zero status if not.
+
+   Usage: xrdoucenvbench [-t <secs>]
+
+   -t <secs>  the minimum time to spend on each measurement (default 0.25).
+*/
+
+/******************************************************************************/
+/*                          U n i t   G l o b a l s                           */
+/******************************************************************************/
+
+namespace
+{
+const char *MeMe = "xrdoucenvbench: ";
+
+struct cgiInfo {const char *name; const char *cgi;};
+
+cgiInfo cgiList[] =
+{{"open",     "oss.asize=1048576&xrd.appname=xrdcp&xrdcl.requuid="
+              "f3b1c2de-94a1-4c7e-8a55-0e4f2d9a7b61"},
+ {"redirect", "tried=srv12.example.org,srv07.example.org&triedrc=enoent,ioerr"
+              "&xrd.wantprot=gsi,unix&xrdcl.requuid=6c1f0e7a-3b2d-4f41-9a8e-"
+              "51d0c3b7a2f9&xrd.gsiusrpxy=/tmp/x509up_u1000&cms.tried="
+              "srv12.example.org"},
+ {"token",    "authz=Bearer%20eyJ0eXAiOiJKV1QiLCJhbGciOiJSUzI1NiIsImtpZCI6InN"
+              "0cmF0dW0ifQ.eyJzdWIiOiI5ZjNlYzJhMC1hYjI3LTQ1ZjctOGE4Yi1mM2U1ZD"
+              "M4NzBlNmEiLCJzY29wZSI6InN0b3JhZ2UucmVhZDovIHN0b3JhZ2UubW9kaWZ5O"
+              "i9zY3JhdGNoIiwiaXNzIjoiaHR0cHM6Ly90b2tlbi5leGFtcGxlLm9yZyIsImV4"
+              "cCI6MTc5MjM0NTY3OCwiaWF0IjoxNzkyMzQyMDc4fQ.c2lnbmF0dXJl"
+              "&oss.asize=2147483648&oss.cgroup=default&xrd.appname=xrdcp"
+              "&xrd.wantprot=ztn,gsi,unix&xrdcl.requuid=0a9e6b2f-1c3d-4e5f-"
+              "8a7b-9c0d1e2f3a4b&tried=srv03.example.org&triedrc=srverr"
+              "&xrd.tpc=1&tpc.stage=copy&tpc.src=root://src.example.org:1094"
+              "&tpc.dlg=srv01.example.org&tpc.key=7d2c9a1b0e3f4a5b&tpc.ttl=60"
+              "&tpc.spr=root&tpc.tpr=root&tpc.scgi=oss.lcl%3D1"},
+ {"stat",     "xrdcl.requuid=2b4d6f80-a1c3-4e5f-9876-543210fedcba"}
+};
+static const int numCgi = sizeof(cgiList)/sizeof(cgiList[0]);
+
+double Now()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec/1000000000.0;
+}
+
+/******************************************************************************/
+/*                           L e g a c y   E n v                              */
+/******************************************************************************/
+
+// This is the parser as it was before values were indexed in place
+
+class legacyEnv
+{
+public:
+
+char *Get(const char *varname) {return env_Hash.Find(varname);}
+
+      legacyEnv(const char *vardata) : env_Hash(8,13)
+{
+   char *vdp, varsave, *varname, *varvalu;
+   int varlen = strlen(vardata);
+
+   global_env = (char *)malloc(varlen+2);
+   *global_env = '&'; vdp = global_env+1;
+   memcpy((void *)vdp, (const void *)vardata, (size_t)varlen);
+   *(vdp+varlen) = '\0';
+
+   while(*vdp)
+        {while(*vdp == '&') vdp++;
+         varname = vdp;
+
+         while(*vdp && *vdp != '=' && *vdp != '&') vdp++;
+         if (!*vdp) break;
+         if (*vdp == '&') continue;
+         *vdp = '\0';
+         varvalu = ++vdp;
+
+         while(*vdp && *vdp != '&') vdp++;
+         varsave = *vdp; *vdp = '\0';
+
+         if (*varname && *varvalu)
+            env_Hash.Rep(varname, strdup(varvalu), 0, Hash_dofree);
+
+         *vdp = varsave; *(varvalu-1) = '=';
+        }
+}
+     ~legacyEnv() {free(global_env);}
+
+private:
+
+XrdOucHash<char> env_Hash;
+char *global_env;
+};
+}
+
+/******************************************************************************/
+/*                                 B e n c h                                  */
+/******************************************************************************/
+
+template<class T>
+double Bench(const char *cgi, const char *var, double minTime)
+{
+   double tBeg, tEnd;
+   long long nOps = 0;
+   int i, n = 10000, hits = 0;
+
+// Parse the cgi and look up a variable, as a request would
+//
+   tBeg = Now();
+   do {for (i = 0; i < n; i++)
+           {T env(cgi);
+            if (env.Get(var)) hits++;
+           }
+       nOps += n;
+      } while((tEnd = Now()) - tBeg < minTime);
+
+// Return parses per second
+//
+   if (!hits) cerr <<MeMe <<"lookup failed!" <<endl;
+   return nOps / (tEnd - tBeg);
+}
+
+/******************************************************************************/
+/*                                V e r i f y                                 */
+/******************************************************************************/
+
+int Verify()
+{
+   char vBuff[64], *cP;
+   int i, envLen, bad = 0;
+
+// Every variable must be found with the same value as the legacy parser
+//
+   for (i = 0; i < numCgi; i++)
+       {XrdOucEnv myEnv(cgiList[i].cgi);
+        legacyEnv oldEnv(cgiList[i].cgi);
+        char *cgi = strdup(cgiList[i].cgi), *save = 0, *var, *val;
+        for (var = strtok_r(cgi, "&", &save); var; var = strtok_r(0,"&",&save))
+            {if (!(val = index(var, '='))) continue;
+             *val = '\0';
+             cP = myEnv.Get(var);
+             if (!cP || strcmp(cP, oldEnv.Get(var)))
+                {cerr <<MeMe <<cgiList[i].name <<" var " <<var
+                      <<" mismatch" <<endl; bad++;
+                }
+            }
+        free(cgi);
+        if (strcmp(myEnv.Env(envLen)+1, cgiList[i].cgi)
+        ||  envLen != (int)strlen(cgiList[i].cgi)+1)
+           {cerr <<MeMe <<cgiList[i].name <<" env mismatch" <<endl; bad++;}
+       }
+
+// Check the corner cases: empty values, missing values, duplicates
+//
+   {XrdOucEnv myEnv("&&a=1&b=&c&=d&a=2&e=x,y");
+    if (!myEnv.Get("a") || strcmp(myEnv.Get("a"), "2") || myEnv.Get("b")
+    ||  myEnv.Get("c")  || myEnv.Get("") || myEnv.Get("zz"))
+       {cerr <<MeMe <<"corner case mismatch" <<endl; bad++;}
+    if (!(cP = myEnv.Delimit(myEnv.Get("e"))) || strcmp(cP, "y")
+    ||  strcmp(myEnv.Get("e"), "x") || strcmp(myEnv.Env(envLen), "&a=1&b=&c&=d&a=2&e=x,y"))
+       {cerr <<MeMe <<"delimit mismatch" <<endl; bad++;}
+   }
+
+// Check that many variables make the hash table grow and that Put() replaces
+// values and adds new ones
+//
+   {XrdOucEnv myEnv("k0=v0&k1=v1");
+    for (i = 0; i < 100; i++)
+        {sprintf(vBuff, "k%d", i); myEnv.PutInt(vBuff, i);}
+    myEnv.Put("k1", "one");
+    myEnv.PutPtr("ptr*", (void *)&bad);
+    for (i = 0; i < 100; i++)
+        {sprintf(vBuff, "k%d", i);
+         if (myEnv.GetInt(vBuff) != (i == 1 ? 0 : i))
+            {cerr <<MeMe <<"put mismatch for " <<vBuff <<endl; bad++; break;}
+        }
+    if (strcmp(myEnv.Get("k1"), "one") || myEnv.GetPtr("ptr*") != &bad)
+       {cerr <<MeMe <<"put mismatch" <<endl; bad++;}
+   }
+   return bad;
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char *argv[])
+{
+   double minTime = 0.25, newRate, oldRate;
+   char *eP;
+   int c, i;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "t:")) != -1)
+        {if (c == 't' && (minTime = strtod(optarg, &eP)) > 0 && !*eP) continue;
+         cerr <<"Usage: xrdoucenvbench [-t <secs>]" <<endl;
+         return 2;
+        }
+
+// Verify the parser before measuring it
+//
+   if (Verify()) return 1;
+
+// Measure each cgi
+//
+   printf("%-10s %6s %14s %14s %8s\n", "cgi", "bytes", "legacy/s", "env/s",
+          "speedup");
+   for (i = 0; i < numCgi; i++)
+       {oldRate = Bench<legacyEnv>(cgiList[i].cgi, "xrdcl.requuid", minTime);
+        newRate = Bench<XrdOucEnv>(cgiList[i].cgi, "xrdcl.requuid", minTime);
+        printf("%-10s %6d %14.0f %14.0f %7.2fx\n", cgiList[i].name,
+               (int)strlen(cgiList[i].cgi), oldRate, newRate, newRate/oldRate);
+       }
+   return 0;
+}
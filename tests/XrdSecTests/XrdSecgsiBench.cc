@@ -0,0 +1,399 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d S e c g s i B e n c h . c c                      */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <errno.h>
+#include <iostream>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "XrdNet/XrdNetAddr.hh"
+#include "XrdOuc/XrdOucErrInfo.hh"
+#include "XrdSec/XrdSecInterface.hh"
+
+using namespace std;
+
+/* This benchmark measures the rate at which a server completes GSI
+   authentications from a client that keeps reconnecting with the same proxy,
+   as batch jobs do. The server side runs in a child process for each of the
+   configurations below, talking to the client over a socket pair; the
+   handshakes are serialized so the rate is bounded by the CPU time spent on
+   both sides, which is reported for the server alone.
+
+      dh               DH key agreement, every client chain verified
+      dh+chaincache    DH key agreement, verified client chains cached
+      ecdh+chaincache  ECDH (X25519) key agreement, chains cached
+
+   Usage: xrdsecgsibench -d <certdir> -c <hostcert> -k <hostkey> -p <proxy>
+                         [-h <hostname>] [-t <secs>]
+
+   -d <certdir>  directory with the CA certificates (and CRLs, if any).
+   -c <hostcert> server certificate; its CN must match <hostname>.
+   -k <hostkey>  server private key.
+   -p <proxy>    client proxy, e.g. as created by xrdgsiproxy.
+   -h <hostname> the name the client uses for the server (default localhost).
+   -t <secs>     the time to spend on each configuration (default 2).
+
+   It exits with a non-zero status if any authentication fails.
+*/
+
+extern "C"
+{
+char           *XrdSecProtocolgsiInit(const char mode, const char *parms,
+                                      XrdOucErrInfo *erp);
+XrdSecProtocol *XrdSecProtocolgsiObject(const char mode, const char *hostname,
+                                        XrdNetAddrInfo &endPoint,
+                                        const char *parms, XrdOucErrInfo *erp);
+}
+
+/******************************************************************************/
+/*                          U n i t   G l o b a l s                           */
+/******************************************************************************/
+
+namespace
+{
+const char   *MeMe     = "xrdsecgsibench: ";
+const char   *hostName = "localhost";
+double        minTime  = 2.0;
+
+struct BenchConfig
+      {const char *Name;
+       const char *Parms;
+       pid_t       Pid;
+       int         Fd;
+       char       *Token;
+      };
+
+BenchConfig   Configs[] = {{"dh",              "-chaincache:0 -ecdh:0", 0,-1,0},
+                           {"dh+chaincache",   "-chaincache:1000 -ecdh:0",0,-1,0},
+                           {"ecdh+chaincache", "-chaincache:1000 -ecdh:1",0,-1,0}
+                          };
+const int     numConfigs = sizeof(Configs)/sizeof(Configs[0]);
+
+// Message codes sent to the server; it replies with 1 (more), 0 (done) or
+// -1 (failed) followed by the parameters, the result or the error text.
+//
+enum MsgCode {msgNew = 1, msgCred, msgReset, msgCPU};
+
+double Now()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec/1000000000.0;
+}
+
+double CpuTime()
+{
+   struct rusage ru;
+   getrusage(RUSAGE_SELF, &ru);
+   return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec/1000000.0
+        + ru.ru_stime.tv_sec + ru.ru_stime.tv_usec/1000000.0;
+}
+
+bool Xfer(int fd, char *buff, int blen, bool snd)
+{
+   int n;
+
+   while(blen > 0)
+        {if (snd) n = write(fd, buff, blen);
+            else  n = read (fd, buff, blen);
+         if (n <= 0) {if (n < 0 && errno == EINTR) continue; return false;}
+         buff += n; blen -= n;
+        }
+   return true;
+}
+
+bool SendMsg(int fd, int code, const char *data, int dlen)
+{
+   int hdr[2] = {code, dlen};
+
+   return Xfer(fd, (char *)hdr, sizeof(hdr), true)
+       && Xfer(fd, (char *)data, dlen, true);
+}
+
+// The data, if any, is returned in a malloc'd buffer (XrdSecBuffer frees it)
+//
+bool RecvMsg(int fd, int &code, char *&data, int &dlen)
+{
+   int hdr[2];
+
+   data = 0;
+   if (!Xfer(fd, (char *)hdr, sizeof(hdr), false)) return false;
+   code = hdr[0]; dlen = hdr[1];
+   if (dlen <= 0) {dlen = 0; return true;}
+   data = (char *)malloc(dlen);
+   if (Xfer(fd, data, dlen, false)) return true;
+   free(data); data = 0;
+   return false;
+}
+}
+
+/******************************************************************************/
+/*                                S e r v e r                                 */
+/******************************************************************************/
+
+int Server(int fd, const char *parms)
+{
+   XrdOucErrInfo     eInfo;
+   XrdNetAddr        cAddr;
+   XrdSecProtocol   *prot = 0;
+   XrdSecParameters *sParms;
+   const char       *etxt;
+   char             *data, *token, cBuff[64];
+   double            cpuBeg = CpuTime();
+   int               code, dlen, rc;
+
+// Initialize the protocol and give the client the parameters it needs
+//
+   cAddr.Set("127.0.0.1:1094");
+   if (!(token = XrdSecProtocolgsiInit('s', parms, &eInfo)))
+      {etxt = eInfo.getErrText();
+       SendMsg(fd, -1, etxt, strlen(etxt)+1);
+       return 1;
+      }
+   SendMsg(fd, 0, token, strlen(token)+1);
+
+// Process requests until the client goes away
+//
+   while(RecvMsg(fd, code, data, dlen))
+        {switch(code)
+               {case msgNew:   if (prot) prot->Delete();
+                               prot = XrdSecProtocolgsiObject('s', hostName,
+                                                       cAddr, 0, &eInfo);
+                               if (!prot) {free(data);
+                                           SendMsg(fd, -1, "no protocol", 12);
+                                           continue;
+                                          }
+                               // Fall through
+                case msgCred: {XrdSecCredentials cred(data, dlen);
+                               sParms = 0;
+                               if (!prot) rc = -1;
+                                  else rc = prot->Authenticate(&cred, &sParms,
+                                                               &eInfo);
+                               if (rc > 0 && sParms)
+                                  SendMsg(fd, 1, sParms->buffer, sParms->size);
+                                  else if (!rc) SendMsg(fd, 0, 0, 0);
+                                  else {etxt = eInfo.getErrText();
+                                        SendMsg(fd, -1, etxt, strlen(etxt)+1);
+                                       }
+                               delete sParms;
+                               continue;
+                              }
+                case msgReset: cpuBeg = CpuTime();
+                               break;
+                case msgCPU:   snprintf(cBuff, sizeof(cBuff), "%.6f",
+                                        CpuTime() - cpuBeg);
+                               SendMsg(fd, 0, cBuff, strlen(cBuff)+1);
+                               break;
+                default:       break;
+               }
+         free(data);
+        }
+   if (prot) prot->Delete();
+   return 0;
+}
+
+/******************************************************************************/
+/*                             H a n d s h a k e                              */
+/******************************************************************************/
+
+bool Handshake(BenchConfig &cfg, XrdNetAddr &sAddr)
+{
+   XrdOucErrInfo      eInfo;
+   XrdSecProtocol    *prot;
+   XrdSecCredentials *cred;
+   XrdSecParameters  *parms = 0;
+   char *data;
+   int   code = msgNew, rc, dlen;
+   bool  ok = false;
+
+// Get a new client protocol object, as for a new connection
+//
+   if (!(prot = XrdSecProtocolgsiObject('c', hostName, sAddr, cfg.Token,
+                                        &eInfo)))
+      {cerr <<MeMe <<"unable to get client protocol; "
+            <<eInfo.getErrText() <<endl;
+       return false;
+      }
+
+// Exchange credentials and parameters until the server is satisfied
+//
+   while((cred = prot->getCredentials(parms, &eInfo)))
+        {delete parms; parms = 0;
+         if (!SendMsg(cfg.Fd, code, cred->buffer, cred->size)
+         ||  !RecvMsg(cfg.Fd, rc, data, dlen))
+            {cerr <<MeMe <<"lost the " <<cfg.Name <<" server" <<endl;
+             delete cred;
+             break;
+            }
+         delete cred;
+         code = msgCred;
+         if (rc > 0) {parms = new XrdSecParameters(data, dlen); continue;}
+         if (!rc) ok = true;
+            else cerr <<MeMe <<"authentication failed; "
+                      <<(data ? data : "?") <<endl;
+         free(data);
+         break;
+        }
+   if (!cred && !ok)
+      cerr <<MeMe <<"unable to get credentials; " <<eInfo.getErrText() <<endl;
+   delete parms;
+   prot->Delete();
+   return ok;
+}
+
+/******************************************************************************/
+/*                                 B e n c h                                  */
+/******************************************************************************/
+
+bool Bench(BenchConfig &cfg)
+{
+   XrdNetAddr sAddr;
+   char *data;
+   double tBeg, tEnd, srvCpu;
+   long long nAuth = 0;
+   int code, dlen;
+
+// The first authentication loads certificates and CA's on both sides
+//
+   sAddr.Set("127.0.0.1:1094");
+   if (!Handshake(cfg, sAddr)) return false;
+
+// Authenticate as fast as possible for the requested time
+//
+   SendMsg(cfg.Fd, msgReset, 0, 0);
+   tBeg = Now();
+   do {if (!Handshake(cfg, sAddr)) return false;
+       nAuth++;
+      } while((tEnd = Now()) - tBeg < minTime);
+
+// Get the server's cpu time
+//
+   if (!SendMsg(cfg.Fd, msgCPU, 0, 0) || !RecvMsg(cfg.Fd, code, data, dlen)
+   ||  !data) return false;
+   srvCpu = atof(data);
+   free(data);
+
+   printf("%-16s %10.1f %16.0f\n", cfg.Name, nAuth / (tEnd - tBeg),
+          srvCpu * 1000000.0 / nAuth);
+   fflush(stdout);
+   return true;
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char *argv[])
+{
+   XrdOucErrInfo eInfo;
+   const char *certDir = 0, *hostCert = 0, *hostKey = 0, *proxy = 0;
+   char sParms[4096], *data, *eP;
+   int c, i, code, dlen, sv[2], rc = 0;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "c:d:h:k:p:t:")) != -1)
+        {switch(c)
+               {case 'c': hostCert = optarg; continue;
+                case 'd': certDir  = optarg; continue;
+                case 'h': hostName = optarg; continue;
+                case 'k': hostKey  = optarg; continue;
+                case 'p': proxy    = optarg; continue;
+                case 't': minTime = strtod(optarg, &eP);
+                          if (minTime > 0 && !*eP) continue;
+                          break;
+                default:  break;
+               }
+         certDir = 0;
+         break;
+        }
+   if (!certDir || !hostCert || !hostKey || !proxy || optind < argc)
+      {cerr <<"Usage: xrdsecgsibench -d <certdir> -c <hostcert> -k <hostkey> "
+              "-p <proxy> [-h <hostname>] [-t <secs>]" <<endl;
+       return 2;
+      }
+   signal(SIGPIPE, SIG_IGN);
+
+// Start a server for each configuration before the client side is set up so
+// that none of them inherits client state
+//
+   for (i = 0; i < numConfigs; i++)
+       {snprintf(sParms, sizeof(sParms), "-certdir:%s -cert:%s -key:%s "
+                 "-gmapopt:0 -vomsat:0 %s", certDir, hostCert, hostKey,
+                 Configs[i].Parms);
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv))
+           {cerr <<MeMe <<"unable to create socket pair; " <<strerror(errno)
+                 <<endl;
+            return 1;
+           }
+        if (!(Configs[i].Pid = fork()))
+           {close(sv[0]);
+            for (int j = 0; j < i; j++) close(Configs[j].Fd);
+            _exit(Server(sv[1], sParms));
+           }
+        close(sv[1]);
+        Configs[i].Fd = sv[0];
+        if (Configs[i].Pid < 0 || !RecvMsg(sv[0], code, data, dlen) || code)
+           {cerr <<MeMe <<Configs[i].Name <<" server failed to initialize; "
+                 <<(data ? data : strerror(errno)) <<endl;
+            return 1;
+           }
+        Configs[i].Token = data;
+       }
+
+// Set up the client side
+//
+   setenv("XrdSecGSICADIR", certDir, 1);
+   setenv("XrdSecGSICRLDIR", certDir, 1);
+   setenv("XrdSecGSIUSERPROXY", proxy, 1);
+   setenv("XrdSecGSIDELEGPROXY", "0", 1);
+   if (!XrdSecProtocolgsiInit('c', 0, &eInfo))
+      {cerr <<MeMe <<"client initialization failed; " <<eInfo.getErrText()
+            <<endl;
+       return 1;
+      }
+
+// Run each configuration
+//
+   printf("%-16s %10s %16s\n", "config", "auth/s", "server-us/auth");
+   for (i = 0; i < numConfigs; i++)
+       {if (!Bench(Configs[i])) rc = 1;
+        close(Configs[i].Fd);
+        waitpid(Configs[i].Pid, 0, 0);
+       }
+   return rc;
+}
@@ -0,0 +1,318 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d S s i B e n c h . c c                         */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <iostream>
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "XrdSsi/XrdSsiErrInfo.hh"
+#include "XrdSsi/XrdSsiProvider.hh"
+#include "XrdSsi/XrdSsiRequest.hh"
+#include "XrdSsi/XrdSsiResource.hh"
+#include "XrdSsi/XrdSsiService.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+using namespace std;
+
+/******************************************************************************/
+/*                          U n i t   G l o b a l s                           */
+/******************************************************************************/
+
+extern XrdSsiProvider *XrdSsiProviderClient;
+
+namespace
+{
+   class                BenchReq;
+   XrdSsiService       *theService = 0;
+   XrdSysSemaphore      reqSlots(0);
+   XrdSysMutex          statMutex;
+   vector<long long>    latency;
+   vector<BenchReq *>   freeReqs;
+   const char          *MeMe  = "xrdssibench: ";
+   long long            xfrBytes = 0;
+   int                  numErrs  = 0;
+   int                  numBad   = 0;
+   int                  respSize = 0;
+}
+
+#define EMSG(x) cerr <<MeMe <<x <<endl
+
+/******************************************************************************/
+/*                       C l a s s   B e n c h R e q                          */
+/******************************************************************************/
+
+// Each request object is reused for the duration of the run. A request is
+// timed from the moment it is handed to the service until the complete
+// response has been received.
+//
+namespace
+{
+class BenchReq : public XrdSsiRequest
+{
+public:
+
+char *GetRequest(int &dlen) {dlen = reqLen; return reqBuff;}
+
+bool  ProcessResponse(const XrdSsiErrInfo  &eInfo,
+                      const XrdSsiRespInfo &rInfo)
+                     {if (eInfo.hasError())
+                         {EMSG("Request failed; " <<eInfo.Get());
+                          Done(false);
+                         }
+                      else if (rInfo.rType == XrdSsiRespInfo::isData)
+                              {rspLen = rInfo.blen; Done(true);}
+                      else if (rInfo.rType == XrdSsiRespInfo::isStream)
+                              {rspLen = 0; GetResponseData(rspBuff, rspBsz);}
+                      else Done(false);
+                      return true;
+                     }
+
+void  ProcessResponseData(const XrdSsiErrInfo &eInfo, char *buff,
+                          int blen, bool last)
+                         {if (eInfo.hasError()) {Done(false); return;}
+                          rspLen += blen;
+                          if (last) Done(true);
+                             else GetResponseData(rspBuff, rspBsz);
+                         }
+
+void  Start(XrdSsiResource &rDesc)
+           {startT = Now();
+            theService->ProcessRequest(*this, rDesc);
+           }
+
+static
+long long Now() {struct timespec ts;
+                 clock_gettime(CLOCK_MONOTONIC, &ts);
+                 return ts.tv_sec*1000000000LL + ts.tv_nsec;
+                }
+
+      BenchReq(int rqSz, int rsSz)
+              : reqBuff(new char[rqSz > 16 ? rqSz : 16]), reqLen(rqSz),
+                rspBuff(new char[rsSz > 65536 ? 65536 : (rsSz ? rsSz : 1)]),
+                rspBsz(rsSz > 65536 ? 65536 : (rsSz ? rsSz : 1)),
+                rspLen(0), startT(0)
+              {memset(reqBuff, 'q', (rqSz > 16 ? rqSz : 16));
+               int n = snprintf(reqBuff, 16, "%d", rsSz);
+               if (reqLen <= n) reqLen = n;
+                  else reqBuff[n] = ' ';
+              }
+     ~BenchReq() {delete [] reqBuff; delete [] rspBuff;}
+
+private:
+
+void  Done(bool isOK)
+          {long long elapsed = Now() - startT;
+           Finished(!isOK);
+           statMutex.Lock();
+           if (isOK) {latency.push_back(elapsed); xfrBytes += rspLen;
+                      if (rspLen != respSize) numBad++;
+                     } else numErrs++;
+           freeReqs.push_back(this);
+           statMutex.UnLock();
+           reqSlots.Post();
+          }
+
+char     *reqBuff;
+int       reqLen;
+char     *rspBuff;
+int       rspBsz;
+int       rspLen;
+long long startT;
+};
+}
+
+/******************************************************************************/
+/*                              S t a r t S r v                               */
+/******************************************************************************/
+
+// Start a local xrootd server running the benchmark service for a true
+// loopback run. Returns the child's process id or -1 upon failure.
+//
+pid_t StartSrv(const char *xrdPath, const char *svcLib, int port)
+{
+   char cfgFN[64], logFN[64], portBuff[16];
+   FILE *cfgF;
+   pid_t pid;
+
+   snprintf(cfgFN, sizeof(cfgFN), "/tmp/xrdssibench.%d.cf",  (int)getpid());
+   snprintf(logFN, sizeof(logFN), "/tmp/xrdssibench.%d.log", (int)getpid());
+   snprintf(portBuff, sizeof(portBuff), "%d", port);
+
+   if (!(cfgF = fopen(cfgFN, "w")))
+      {EMSG("Unable to create " <<cfgFN <<"; " <<strerror(errno)); return -1;}
+   fprintf(cfgF, "all.export /\nxrootd.fslib -2 libXrdSsi.so\n"
+                 "oss.statlib -2 -arevents libXrdSsi.so\n"
+                 "ssi.svclib %s\n", svcLib);
+   fclose(cfgF);
+
+   if ((pid = fork()) < 0)
+      {EMSG("Unable to fork; " <<strerror(errno)); return -1;}
+   if (!pid)
+      {execlp(xrdPath, xrdPath, "-p", portBuff, "-c", cfgFN, "-l", logFN,
+              (char *)0);
+       EMSG("Unable to exec " <<xrdPath <<"; " <<strerror(errno));
+       _exit(255);
+      }
+
+   XrdSysTimer::Snooze(2);
+   if (waitpid(pid, 0, WNOHANG) == pid)
+      {EMSG("Server failed to start; see " <<logFN); return -1;}
+   return pid;
+}
+
+/******************************************************************************/
+/*                                 U s a g e                                  */
+/******************************************************************************/
+  
+int Usage(int rc)
+{
+cerr <<"Usage:   xrdssibench [options]\n\n";
+cerr <<"options: [-c <contact>] [-n <reqs>] [-p <parallel>] [-q <reqsz>]\n"
+       "         [-r <rspsz>] [-R <resource>] [-s <xrootd> [-l <svclib>]]\n\n";
+cerr <<"-c the host:port of the server (default localhost:1094).\n"
+       "-n the number of requests to issue (default 100000).\n"
+       "-p the number of requests kept in flight (default 16).\n"
+       "-q the request  size in bytes (default 64).\n"
+       "-r the response size in bytes (default 64).\n"
+       "-R the resource name (default /bench).\n"
+       "-s start the specified xrootd locally with the benchmark service\n"
+       "   found in svclib (default libXrdSsiBenchSvc.so).\n";
+return rc;
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char **argv)
+{
+   extern char *optarg;
+   extern int optind, opterr;
+   XrdSsiErrInfo eInfo;
+   const char *xrdPath = 0, *svcLib = "libXrdSsiBenchSvc.so";
+   string contact("localhost:1094"), rName("/bench");
+   long long begT, endT;
+   pid_t srvPid = -1;
+   int c, numReqs = 100000, numPar = 16, reqSize = 64;
+
+// Process the options
+//
+   opterr = 0;
+   if (argc > 1 && '-' == *argv[1])
+      while ((c = getopt(argc,argv,":c:l:n:p:q:r:R:s:"))
+             && ((unsigned char)c != 0xff))
+     { switch(c)
+       {
+       case 'c': contact  = optarg;                       break;
+       case 'l': svcLib   = optarg;                       break;
+       case 'n': numReqs  = atoi(optarg);                 break;
+       case 'p': numPar   = atoi(optarg);                 break;
+       case 'q': reqSize  = atoi(optarg);                 break;
+       case 'r': respSize = atoi(optarg);                 break;
+       case 'R': rName    = optarg;                       break;
+       case 's': xrdPath  = optarg;                       break;
+       case ':': EMSG('-' <<char(optopt) <<" parameter not specified.");
+                 exit(Usage(1));
+                 break;
+       default:  EMSG('-' <<char(optopt) <<" is an invalid option.");
+                 exit(Usage(1));
+                 break;
+       }
+     }
+   if (optind < argc || numReqs < 1 || numPar < 1 || reqSize < 1
+   ||  respSize < 0) exit(Usage(1));
+   if (numPar > numReqs) numPar = numReqs;
+
+// Start a local server if so wanted
+//
+   if (xrdPath)
+      {int port = 20000 + (getpid() % 10000);
+       char buff[32];
+       if ((srvPid = StartSrv(xrdPath, svcLib, port)) < 0) exit(2);
+       snprintf(buff, sizeof(buff), "localhost:%d", port);
+       contact = buff;
+      }
+
+// Obtain a service object
+//
+   if (!(theService = XrdSsiProviderClient->GetService(eInfo, contact)))
+      {EMSG("Unable to get service object; " <<eInfo.Get());
+       if (srvPid > 0) kill(srvPid, SIGTERM);
+       exit(2);
+      }
+
+// Allocate the request objects and run the benchmark
+//
+   XrdSsiResource rDesc(rName);
+   latency.reserve(numReqs);
+   for (int i = 0; i < numPar; i++)
+       {freeReqs.push_back(new BenchReq(reqSize, respSize)); reqSlots.Post();}
+
+   begT = BenchReq::Now();
+   for (int i = 0; i < numReqs; i++)
+       {BenchReq *reqP;
+        reqSlots.Wait();
+        statMutex.Lock();
+        reqP = freeReqs.back(); freeReqs.pop_back();
+        statMutex.UnLock();
+        reqP->Start(rDesc);
+       }
+   for (int i = 0; i < numPar; i++) reqSlots.Wait();
+   endT = BenchReq::Now();
+
+// Report the results
+//
+   double secs = (endT - begT) / 1.0e9;
+   size_t numOK = latency.size();
+   cout <<"requests:  " <<numReqs <<" (" <<numErrs <<" failed, " <<numBad
+        <<" with wrong response size) in " <<secs <<" sec" <<endl;
+   cout <<"rate:      " <<(secs > 0 ? numReqs/secs : 0) <<" req/sec, "
+        <<(secs > 0 ? xfrBytes/secs/1048576.0 : 0) <<" MB/sec" <<endl;
+   if (numOK)
+      {sort(latency.begin(), latency.end());
+       cout <<"latency:   p50 " <<latency[numOK/2]/1000.0
+            <<" us, p99 " <<latency[(numOK*99)/100]/1000.0
+            <<" us, max " <<latency[numOK-1]/1000.0 <<" us" <<endl;
+      }
+
+// All done
+//
+   theService->Stop();
+   if (srvPid > 0) {kill(srvPid, SIGTERM); waitpid(srvPid, 0, 0);}
+   exit(numErrs ? 1 : 0);
+}
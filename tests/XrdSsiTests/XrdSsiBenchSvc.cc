@@ -0,0 +1,149 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d S s i B e n c h S v c . c c                      */
+/*                                                                            */
+/* (c) 2026 by the XRootD contributors                                        */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "XrdSsi/XrdSsiProvider.hh"
+#include "XrdSsi/XrdSsiRequest.hh"
+#include "XrdSsi/XrdSsiResource.hh"
+#include "XrdSsi/XrdSsiResponder.hh"
+#include "XrdSsi/XrdSsiService.hh"
+
+/******************************************************************************/
+/*                          U n i t   G l o b a l s                           */
+/******************************************************************************/
+
+// This is the server-side half of the xrdssibench loopback benchmark. Each
+// request carries the size of the response it wants as a decimal number at
+// the front of the request. The response is always served from one static
+// buffer so that the benchmark measures the framework and not the service.
+//
+namespace
+{
+   const int  maxRespSz = 16*1024*1024;
+   char      *respBuff  = 0;
+}
+
+/******************************************************************************/
+/*                      C l a s s   B e n c h R e s p                         */
+/******************************************************************************/
+
+namespace
+{
+class BenchResp : public XrdSsiResponder
+{
+public:
+
+void   Finished(      XrdSsiRequest  &rqstR,
+                const XrdSsiRespInfo &rInfo,
+                      bool            cancel=false)
+               {UnBindRequest(); delete this;}
+
+void   Respond(XrdSsiRequest &rqstR)
+              {char *rBuff;
+               int   rLen, rSize = 0;
+               BindRequest(rqstR);
+               if ((rBuff = GetRequest(rLen)) && rLen > 0)
+                  {char *eP, numBuff[16];
+                   if (rLen >= (int)sizeof(numBuff)) rLen = sizeof(numBuff)-1;
+                   memcpy(numBuff, rBuff, rLen); numBuff[rLen] = 0;
+                   rSize = strtol(numBuff, &eP, 10);
+                   if (rSize < 0 || rSize > maxRespSz) rSize = maxRespSz;
+                  }
+               ReleaseRequestBuffer();
+               SetResponse(respBuff, rSize);
+              }
+
+       BenchResp() {}
+      ~BenchResp() {}
+};
+}
+
+/******************************************************************************/
+/*                   C l a s s   B e n c h S e r v i c e                      */
+/******************************************************************************/
+
+namespace
+{
+class BenchService : public XrdSsiService
+{
+public:
+
+void   ProcessRequest(XrdSsiRequest  &reqRef, XrdSsiResource &resRef)
+                     {(new BenchResp)->Respond(reqRef);}
+
+       BenchService() {}
+      ~BenchService() {}
+};
+}
+
+/******************************************************************************/
+/*                  C l a s s   B e n c h P r o v i d e r                     */
+/******************************************************************************/
+
+namespace
+{
+class BenchProvider : public XrdSsiProvider
+{
+public:
+
+XrdSsiService *GetService(XrdSsiErrInfo     &eInfo,
+                          const std::string &contact,
+                          int                oHold=256)
+                         {return new BenchService;}
+
+bool           Init(XrdSsiLogger  *logP,
+                    XrdSsiCluster *clsP,
+                    std::string    cfgFn,
+                    std::string    parms,
+                    int            argc,
+                    char         **argv)
+                   {if (!respBuff && !(respBuff = (char *)malloc(maxRespSz)))
+                       return false;
+                    memset(respBuff, 'r', maxRespSz);
+                    return true;
+                   }
+
+rStat          QueryResource(const char *rName,
+                             const char *contact=0)
+                            {return isPresent;}
+
+               BenchProvider() {}
+virtual       ~BenchProvider() {}
+};
+
+BenchProvider benchProvider;
+}
+
+/******************************************************************************/
+/*                    P r o v i d e r   E n t r y   P o i n t s               */
+/******************************************************************************/
+
+XrdSsiProvider *XrdSsiProviderServer = &benchProvider;
+
+XrdSsiProvider *XrdSsiProviderLookup = &benchProvider;